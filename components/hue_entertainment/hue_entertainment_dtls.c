@@ -0,0 +1,201 @@
+/**
+ * @file hue_entertainment_dtls.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief DTLS 1.2 PSK client the stream sends frames over, built on mbedtls
+ *
+ * The bridge only accepts TLS_PSK_WITH_AES_128_GCM_SHA256, so no certificate is involved and the application key and
+ * client key are the whole authentication. Requires CONFIG_MBEDTLS_SSL_PROTO_DTLS and CONFIG_MBEDTLS_PSK_MODES with
+ * CONFIG_MBEDTLS_KEY_EXCHANGE_PSK (sdkconfig.defaults). Retransmission timers are kept on esp_timer_get_time(), as
+ * mbedtls' own timing module is not built in ESP-IDF.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/error.h"
+#include "mbedtls/net_sockets.h"
+#include "mbedtls/ssl.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "hue_entertainment_private.h"
+#include "hue_helpers.h"
+
+static const char* tag = "hue_entertainment_dtls";
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define DTLS_HANDSHAKE_MIN_TIMEOUT_MS 500 /**< First retransmission timeout, doubled on every retransmission */
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Open DTLS session */
+struct hue_entertainment_dtls {
+    mbedtls_net_context net;           /**< Connected UDP socket */
+    mbedtls_ssl_context ssl;           /**< DTLS session */
+    mbedtls_ssl_config conf;           /**< Client configuration with the PSK */
+    mbedtls_entropy_context entropy;   /**< Entropy source seeding ctr_drbg */
+    mbedtls_ctr_drbg_context ctr_drbg; /**< Random generator for the handshake */
+    int64_t timer_start_us;            /**< Time the retransmission timer was set */
+    uint32_t timer_int_ms;             /**< Intermediate delay of the retransmission timer */
+    uint32_t timer_fin_ms;             /**< Final delay of the retransmission timer, 0 while cancelled */
+};
+
+static const int ciphersuites[] = {MBEDTLS_TLS_PSK_WITH_AES_128_GCM_SHA256, 0}; /**< Only suite the bridge accepts */
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief mbedtls_ssl_set_timer_t callback, starts or cancels the retransmission timer
+ */
+static void dtls_set_delay(void* data, uint32_t int_ms, uint32_t fin_ms);
+
+/**
+ * @brief mbedtls_ssl_get_timer_t callback
+ *
+ * @return -1 if cancelled, 0 if no delay has passed, 1 if only the intermediate delay has passed, 2 if both have
+ */
+static int dtls_get_delay(void* data);
+
+/*====================================================================================================================*/
+/*======================================= Shared Private Function Definitions ========================================*/
+/*====================================================================================================================*/
+
+esp_err_t hue_entertainment_dtls_open(hue_entertainment_dtls_handle_t* p_dtls_handle, const char* host, uint16_t port,
+                                      const char* identity, const uint8_t* psk, size_t psk_length,
+                                      uint32_t timeout_ms) {
+    if (HUE_NULL_CHECK(tag, p_dtls_handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, host)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, identity)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, psk)) return ESP_ERR_INVALID_ARG;
+
+    hue_entertainment_dtls_handle_t dtls = calloc(1, sizeof(struct hue_entertainment_dtls));
+    if (!dtls) {
+        ESP_LOGE(tag, "Failed to allocate memory for DTLS session");
+        return ESP_ERR_NO_MEM;
+    }
+    mbedtls_net_init(&(dtls->net));
+    mbedtls_ssl_init(&(dtls->ssl));
+    mbedtls_ssl_config_init(&(dtls->conf));
+    mbedtls_entropy_init(&(dtls->entropy));
+    mbedtls_ctr_drbg_init(&(dtls->ctr_drbg));
+    *p_dtls_handle = dtls;
+
+    char port_str[6];
+    snprintf(port_str, sizeof(port_str), "%u", port);
+
+    int ret;
+    if ((ret = mbedtls_ctr_drbg_seed(&(dtls->ctr_drbg), mbedtls_entropy_func, &(dtls->entropy), NULL, 0)) != 0) {
+        ESP_LOGE(tag, "Failed to seed random generator, -0x%04x", -ret);
+        goto fail;
+    }
+    if ((ret = mbedtls_net_connect(&(dtls->net), host, port_str, MBEDTLS_NET_PROTO_UDP)) != 0) {
+        ESP_LOGE(tag, "Failed to connect UDP socket to %s:%s, -0x%04x", host, port_str, -ret);
+        goto fail;
+    }
+    if ((ret = mbedtls_ssl_config_defaults(&(dtls->conf), MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                           MBEDTLS_SSL_PRESET_DEFAULT)) != 0) {
+        ESP_LOGE(tag, "Failed to set DTLS defaults, -0x%04x", -ret);
+        goto fail;
+    }
+    mbedtls_ssl_conf_rng(&(dtls->conf), mbedtls_ctr_drbg_random, &(dtls->ctr_drbg));
+    mbedtls_ssl_conf_ciphersuites(&(dtls->conf), ciphersuites);
+    mbedtls_ssl_conf_max_tls_version(&(dtls->conf), MBEDTLS_SSL_VERSION_TLS1_2);
+    mbedtls_ssl_conf_handshake_timeout(&(dtls->conf), DTLS_HANDSHAKE_MIN_TIMEOUT_MS, timeout_ms);
+    mbedtls_ssl_conf_read_timeout(&(dtls->conf), timeout_ms);
+    if ((ret = mbedtls_ssl_conf_psk(&(dtls->conf), psk, psk_length, (const unsigned char*)identity,
+                                    strlen(identity))) != 0) {
+        ESP_LOGE(tag, "Failed to set PSK, -0x%04x", -ret);
+        goto fail;
+    }
+    if ((ret = mbedtls_ssl_setup(&(dtls->ssl), &(dtls->conf))) != 0) {
+        ESP_LOGE(tag, "Failed to set up DTLS session, -0x%04x", -ret);
+        goto fail;
+    }
+    mbedtls_ssl_set_bio(&(dtls->ssl), &(dtls->net), mbedtls_net_send, mbedtls_net_recv, mbedtls_net_recv_timeout);
+    mbedtls_ssl_set_timer_cb(&(dtls->ssl), dtls, dtls_set_delay, dtls_get_delay);
+
+    /* Blocking reads time out on the retransmission timer, so this loop only repeats for a retransmission */
+    do {
+        ret = mbedtls_ssl_handshake(&(dtls->ssl));
+    } while ((ret == MBEDTLS_ERR_SSL_WANT_READ) || (ret == MBEDTLS_ERR_SSL_WANT_WRITE));
+    if (ret != 0) {
+        ESP_LOGE(tag, "DTLS handshake failed, -0x%04x", -ret);
+        hue_entertainment_dtls_close(p_dtls_handle);
+        return (ret == MBEDTLS_ERR_SSL_TIMEOUT) ? ESP_ERR_TIMEOUT : ESP_FAIL;
+    }
+
+    ESP_LOGD(tag, "DTLS session open with %s", mbedtls_ssl_get_ciphersuite(&(dtls->ssl)));
+    return ESP_OK;
+
+fail:
+    hue_entertainment_dtls_close(p_dtls_handle);
+    return ESP_FAIL;
+}
+
+esp_err_t hue_entertainment_dtls_send(hue_entertainment_dtls_handle_t dtls_handle, const uint8_t* data,
+                                      size_t length) {
+    if (HUE_NULL_CHECK(tag, dtls_handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, data)) return ESP_ERR_INVALID_ARG;
+
+    /* A datagram is written whole or not at all, there is no partial write to continue */
+    int ret = mbedtls_ssl_write(&(dtls_handle->ssl), data, length);
+    if (ret != (int)length) {
+        ESP_LOGD(tag, "Frame not sent, -0x%04x", (ret < 0) ? -ret : 0);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+void hue_entertainment_dtls_close(hue_entertainment_dtls_handle_t* p_dtls_handle) {
+    /* If p_dtls_handle or the session handle are already NULL, nothing needs to be done */
+    if (!p_dtls_handle) return;
+    if (!(*p_dtls_handle)) return;
+
+    hue_entertainment_dtls_handle_t dtls = *p_dtls_handle;
+
+    /* close_notify lets the bridge end the stream right away, a session that never opened just ignores it */
+    mbedtls_ssl_close_notify(&(dtls->ssl));
+    mbedtls_net_free(&(dtls->net));
+    mbedtls_ssl_free(&(dtls->ssl));
+    mbedtls_ssl_config_free(&(dtls->conf));
+    mbedtls_ctr_drbg_free(&(dtls->ctr_drbg));
+    mbedtls_entropy_free(&(dtls->entropy));
+    free(dtls);
+
+    /* Sets the value of the session handle to NULL to ensure handle cannot be used to access deallocated memory */
+    *p_dtls_handle = NULL;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static void dtls_set_delay(void* data, uint32_t int_ms, uint32_t fin_ms) {
+    hue_entertainment_dtls_handle_t dtls = (hue_entertainment_dtls_handle_t)data;
+    dtls->timer_start_us = esp_timer_get_time();
+    dtls->timer_int_ms = int_ms;
+    dtls->timer_fin_ms = fin_ms;
+}
+
+static int dtls_get_delay(void* data) {
+    hue_entertainment_dtls_handle_t dtls = (hue_entertainment_dtls_handle_t)data;
+    if (dtls->timer_fin_ms == 0) return -1;
+
+    int64_t elapsed_ms = (esp_timer_get_time() - dtls->timer_start_us) / 1000;
+    if (elapsed_ms >= dtls->timer_fin_ms) return 2;
+    if (elapsed_ms >= dtls->timer_int_ms) return 1;
+    return 0;
+}
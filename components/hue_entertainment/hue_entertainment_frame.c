@@ -0,0 +1,98 @@
+/**
+ * @file hue_entertainment_frame.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Builds HueStream v2 frames in place in a fixed size buffer
+ *
+ * Frame layout, multi-byte values big-endian:
+ *  [0-8]   "HueStream"
+ *  [9-10]  Version 2.0
+ *  [11]    Sequence number
+ *  [12-13] Reserved, zero
+ *  [14]    Color space, 0 for RGB and 1 for XY + brightness
+ *  [15]    Reserved, zero
+ *  [16-51] Entertainment configuration ID as its 36 characters
+ *  [52-]   Per channel: channel ID, then three 16 bit values
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "hue_entertainment_private.h"
+#include "hue_helpers.h"
+
+static const char* tag = "hue_entertainment_frame";
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define FRAME_PROTOCOL "HueStream"   /**< Protocol name the frame starts with */
+#define FRAME_PROTOCOL_LENGTH 9      /**< Length of FRAME_PROTOCOL without null-terminating character */
+#define FRAME_VERSION_MAJOR 0x02     /**< Protocol major version, entertainment configurations need version 2 */
+#define FRAME_VERSION_MINOR 0x00     /**< Protocol minor version */
+#define FRAME_SEQUENCE_POS 11        /**< Position of the sequence number */
+#define FRAME_COLOR_SPACE_POS 14     /**< Position of the color space */
+#define FRAME_CONFIGURATION_POS 16   /**< Position of the entertainment configuration ID */
+
+_Static_assert(FRAME_CONFIGURATION_POS + HUE_RESOURCE_ID_LENGTH == HUE_ENTERTAINMENT_FRAME_HEADER_SIZE,
+               "HueStream header must end with the entertainment configuration ID");
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t hue_entertainment_frame_init(hue_entertainment_frame_t* p_frame, const char* entertainment_configuration_id,
+                                       hue_entertainment_color_space_t color_space) {
+    if (HUE_NULL_CHECK(tag, p_frame)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, entertainment_configuration_id)) return ESP_ERR_INVALID_ARG;
+    if (hue_validate_resource_id(entertainment_configuration_id) != ESP_OK) {
+        ESP_LOGE(tag, "Entertainment configuration ID is not in the correct format");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((color_space != HUE_ENTERTAINMENT_COLOR_SPACE_RGB) && (color_space != HUE_ENTERTAINMENT_COLOR_SPACE_XY)) {
+        ESP_LOGE(tag, "Unknown color space %d", color_space);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Reserved bytes and the sequence number start zeroed */
+    memset(p_frame->buff, 0, HUE_ENTERTAINMENT_FRAME_HEADER_SIZE);
+    memcpy(p_frame->buff, FRAME_PROTOCOL, FRAME_PROTOCOL_LENGTH);
+    p_frame->buff[FRAME_PROTOCOL_LENGTH] = FRAME_VERSION_MAJOR;
+    p_frame->buff[FRAME_PROTOCOL_LENGTH + 1] = FRAME_VERSION_MINOR;
+    p_frame->buff[FRAME_COLOR_SPACE_POS] = (uint8_t)color_space;
+    memcpy(&(p_frame->buff[FRAME_CONFIGURATION_POS]), entertainment_configuration_id, HUE_RESOURCE_ID_LENGTH);
+    p_frame->length = HUE_ENTERTAINMENT_FRAME_HEADER_SIZE;
+
+    return ESP_OK;
+}
+
+esp_err_t hue_entertainment_frame_fill(hue_entertainment_frame_t* p_frame, uint8_t sequence,
+                                       const hue_entertainment_channel_t* p_channels, uint8_t channel_count) {
+    if (HUE_NULL_CHECK(tag, p_frame)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_channels)) return ESP_ERR_INVALID_ARG;
+    if (channel_count > HUE_ENTERTAINMENT_MAX_CHANNELS) {
+        ESP_LOGE(tag, "%u channels is over the %d a frame can carry", channel_count, HUE_ENTERTAINMENT_MAX_CHANNELS);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t* p_pos = &(p_frame->buff[HUE_ENTERTAINMENT_FRAME_HEADER_SIZE]);
+    for (uint8_t i = 0; i < channel_count; i++) {
+        if (p_channels[i].channel_id >= HUE_ENTERTAINMENT_MAX_CHANNELS) {
+            ESP_LOGE(tag, "Channel ID %u is out of range", p_channels[i].channel_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        *(p_pos++) = p_channels[i].channel_id;
+        for (uint8_t value = 0; value < 3; value++) {
+            *(p_pos++) = p_channels[i].values[value] >> 8;
+            *(p_pos++) = p_channels[i].values[value] & 0xFF;
+        }
+    }
+
+    p_frame->buff[FRAME_SEQUENCE_POS] = sequence;
+    p_frame->length = HUE_ENTERTAINMENT_FRAME_HEADER_SIZE + (channel_count * HUE_ENTERTAINMENT_CHANNEL_SIZE);
+
+    return ESP_OK;
+}
@@ -0,0 +1,455 @@
+/**
+ * @file hue_entertainment_instance.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Implementation of starting, feeding and stopping Philips Hue Entertainment API streams
+ *
+ * A periodic esp_timer wakes the stream task every frame period, so frames keep microsecond pacing regardless of the
+ * FreeRTOS tick rate. Everything a frame needs is allocated at start, sending one only copies the channels into the
+ * frame buffer and writes it to the DTLS session.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_http_client.h"
+#include "esp_log.h"
+
+#include "hue_entertainment_private.h"
+#include "hue_helpers.h"
+
+static const char* tag = "hue_entertainment_instance";
+
+/* Signify root certificate embedded by hue_https, the bridge certificate is verified the same way for both */
+extern const char hue_signify_root_cert_pem_start[] asm("_binary_hue_signify_root_cert_pem_start");
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Verifies every config string and setting before anything is allocated
+ *
+ * @param[in] p_config Config to check
+ *
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG for the first invalid setting, which is logged
+ */
+static esp_err_t check_config(const hue_entertainment_config_t* p_config);
+
+/**
+ * @brief Copies a zero padded bridge IP without the padding, which socket APIs would read as octal
+ *
+ * @param[out] host Storage for at least HUE_BRIDGE_IP_LENGTH + 1 characters
+ * @param[in] bridge_ip Bridge IP already verified by hue_validate_bridge_ip()
+ */
+static void unpad_bridge_ip(char* host, const char* bridge_ip);
+
+/**
+ * @brief Packs the hexadecimal characters of a client key into PSK bytes
+ *
+ * @param[out] psk Storage for HUE_ENTERTAINMENT_PSK_SIZE bytes
+ * @param[in] client_key Client key already verified by hue_validate_client_key()
+ */
+static void pack_client_key(uint8_t* psk, const char* client_key);
+
+/**
+ * @brief Sends {"action":"<action>"} to the entertainment configuration over CLIP v2
+ *
+ * @param[in] handle Stream whose entertainment configuration is updated
+ * @param[in] action "start" or "stop"
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Bridge answered 200 OK
+ * @retval - @c ESP_ERR_NO_MEM – HTTP client could not be created
+ * @retval - @c ESP_ERR_INVALID_RESPONSE – Bridge answered with another status
+ * @retval - @c ESP_FAIL – Request could not be performed
+ */
+static esp_err_t put_action(hue_entertainment_handle_t handle, const char* action);
+
+/**
+ * @brief Frame timer callback, wakes the stream task
+ */
+static void hue_entertainment_frame_timer_callback(void* arg);
+
+/**
+ * @brief Task sending a frame every time the frame timer fires until told to exit
+ */
+static void hue_entertainment_stream_task(void* pvparameters);
+
+/**
+ * @brief Builds the frame from the current channels and sends it, recording how far its interval was off the period
+ *
+ * @param[in,out] handle Stream to send the frame for
+ */
+static void hue_entertainment_send_frame(hue_entertainment_handle_t handle);
+
+/**
+ * @brief Stops the timer and task if running and frees every resource of a stream that is allocated
+ *
+ * @param[in,out] p_handle Pointer to stream handle to free (Will be set to NULL after)
+ */
+static void free_hue_entertainment_instance(hue_entertainment_handle_t* p_handle);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t hue_entertainment_start(hue_entertainment_handle_t* p_handle, const hue_entertainment_config_t* p_config) {
+    if (HUE_NULL_CHECK(tag, p_handle)) return ESP_ERR_INVALID_ARG;
+    if (*p_handle) {
+        ESP_LOGE(tag, "Stream handle already started, stop previous stream before starting again");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (check_config(p_config) != ESP_OK) return ESP_ERR_INVALID_ARG;
+
+    /* Allocate zeroed memory for the stream, so free_hue_entertainment_instance() only frees what was created */
+    hue_entertainment_handle_t handle = calloc(1, sizeof(hue_entertainment_instance_t));
+    if (!handle) {
+        ESP_LOGE(tag, "Failed to allocate memory for stream");
+        return ESP_ERR_NO_MEM;
+    }
+    *p_handle = handle;
+
+    /* Zero padded octets would be read as octal, so the URL is built from the unpadded host */
+    unpad_bridge_ip(handle->host, p_config->bridge_ip);
+    snprintf(handle->url, sizeof(handle->url), "https://%s" HUE_ENTERTAINMENT_RESOURCE_PATH "%s", handle->host,
+             p_config->entertainment_configuration_id);
+    memcpy(handle->bridge_id, p_config->bridge_id, HUE_BRIDGE_ID_LENGTH + 1);
+    memcpy(handle->app_key, p_config->application_key, HUE_APPLICATION_KEY_LENGTH + 1);
+    pack_client_key(handle->psk, p_config->client_key);
+    handle->period_us = 1000000 / p_config->rate_hz;
+    hue_entertainment_frame_init(&(handle->frame), p_config->entertainment_configuration_id, p_config->color_space);
+
+    if (((handle->handle_evt = xEventGroupCreate()) == NULL) || ((handle->mutex = xSemaphoreCreateMutex()) == NULL)) {
+        ESP_LOGE(tag, "Failed to create Event Group or mutex");
+        free_hue_entertainment_instance(p_handle);
+        return ESP_ERR_NO_MEM;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = hue_entertainment_frame_timer_callback,
+        .arg = handle,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "hue_ent_frame",
+        .skip_unhandled_events = true, /* A late frame is sent once, not followed by a burst catching up */
+    };
+    if (esp_timer_create(&timer_args, &(handle->frame_timer)) != ESP_OK) {
+        ESP_LOGE(tag, "Failed to create frame timer");
+        free_hue_entertainment_instance(p_handle);
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* The bridge only accepts a stream for an entertainment configuration that was started first */
+    esp_err_t err;
+    if ((err = put_action(handle, "start")) != ESP_OK) {
+        free_hue_entertainment_instance(p_handle);
+        return err;
+    }
+
+    int64_t handshake_start_us = esp_timer_get_time();
+    if ((err = hue_entertainment_dtls_open(&(handle->dtls), handle->host, HUE_ENTERTAINMENT_PORT, handle->app_key,
+                                           handle->psk, sizeof(handle->psk),
+                                           HUE_ENTERTAINMENT_HANDSHAKE_TIMEOUT_MS)) != ESP_OK) {
+        ESP_LOGE(tag, "DTLS handshake with bridge failed, %s", esp_err_to_name(err));
+        put_action(handle, "stop");
+        free_hue_entertainment_instance(p_handle);
+        return err;
+    }
+    handle->stats.handshake_us = esp_timer_get_time() - handshake_start_us;
+
+    /* Create the stream task, pinned if a placement was given, then start pacing it */
+    UBaseType_t priority = HUE_ENTERTAINMENT_DEFAULT_TASK_PRIORITY;
+    BaseType_t core_id = tskNO_AFFINITY;
+    if (p_config->task_placement_set) {
+        priority = p_config->task_priority;
+        if (p_config->task_core_id != HUE_ENTERTAINMENT_TASK_ANY_CORE) core_id = p_config->task_core_id;
+    }
+    if (xTaskCreatePinnedToCore(hue_entertainment_stream_task, p_config->task_id, 4096, handle, priority,
+                                &(handle->task_handle), core_id) != pdPASS) {
+        ESP_LOGE(tag, "Failed to create stream task");
+        hue_entertainment_dtls_close(&(handle->dtls));
+        put_action(handle, "stop");
+        free_hue_entertainment_instance(p_handle);
+        return ESP_ERR_NO_MEM;
+    }
+    if ((err = esp_timer_start_periodic(handle->frame_timer, handle->period_us)) != ESP_OK) {
+        ESP_LOGE(tag, "Failed to start frame timer, %s", esp_err_to_name(err));
+        hue_entertainment_stop(p_handle);
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(tag, "Streaming at %u Hz, handshake took %lld us", p_config->rate_hz, handle->stats.handshake_us);
+    return ESP_OK;
+}
+
+esp_err_t hue_entertainment_stop(hue_entertainment_handle_t* p_handle) {
+    if (HUE_NULL_CHECK(tag, p_handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, *p_handle)) return ESP_ERR_INVALID_ARG;
+
+    hue_entertainment_handle_t handle = *p_handle;
+
+    /* No more frames are started, the one being sent finishes before the session is closed under it */
+    esp_timer_stop(handle->frame_timer);
+    xEventGroupSetBits(handle->handle_evt, HUE_ENTERTAINMENT_EVT_EXIT_BIT);
+    if (!(xEventGroupWaitBits(handle->handle_evt, HUE_ENTERTAINMENT_EVT_EXITED_BIT, pdFALSE, pdFALSE,
+                              pdMS_TO_TICKS(HUE_ENTERTAINMENT_STOP_TIMEOUT_MS)) &
+          HUE_ENTERTAINMENT_EVT_EXITED_BIT)) {
+        /* The task may still be inside a send, so it is deleted before the session it is using is freed */
+        ESP_LOGW(tag, "Stream task did not exit within %d ms, deleting it", HUE_ENTERTAINMENT_STOP_TIMEOUT_MS);
+        vTaskDelete(handle->task_handle);
+    }
+    handle->task_handle = NULL;
+    hue_entertainment_dtls_close(&(handle->dtls));
+
+    /* Stopping hands the lights back to the bridge right away instead of after its 10 second stream timeout */
+    esp_err_t err = put_action(handle, "stop");
+    free_hue_entertainment_instance(p_handle);
+    return err;
+}
+
+esp_err_t hue_entertainment_set_channels(hue_entertainment_handle_t handle,
+                                         const hue_entertainment_channel_t* p_channels, uint8_t channel_count) {
+    if (HUE_NULL_CHECK(tag, handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_channels)) return ESP_ERR_INVALID_ARG;
+    if ((channel_count == 0) || (channel_count > HUE_ENTERTAINMENT_MAX_CHANNELS)) {
+        ESP_LOGE(tag, "Channel count %u is not between 1 and %d", channel_count, HUE_ENTERTAINMENT_MAX_CHANNELS);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    for (uint8_t i = 0; i < channel_count; i++) {
+        if (p_channels[i].channel_id >= HUE_ENTERTAINMENT_MAX_CHANNELS) {
+            ESP_LOGE(tag, "Channel ID %u is out of range", p_channels[i].channel_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    if (!xSemaphoreTake(handle->mutex, pdMS_TO_TICKS(5000))) {
+        ESP_LOGE(tag, "Failed to acquire mutex within 5 seconds, channels not set");
+        return ESP_ERR_TIMEOUT;
+    }
+    memcpy(handle->channels, p_channels, channel_count * sizeof(hue_entertainment_channel_t));
+    handle->channel_count = channel_count;
+    xSemaphoreGive(handle->mutex);
+
+    return ESP_OK;
+}
+
+esp_err_t hue_entertainment_get_stats(hue_entertainment_handle_t handle, hue_entertainment_stats_t* p_stats) {
+    if (HUE_NULL_CHECK(tag, handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_stats)) return ESP_ERR_INVALID_ARG;
+
+    if (!xSemaphoreTake(handle->mutex, pdMS_TO_TICKS(5000))) {
+        ESP_LOGE(tag, "Failed to acquire mutex within 5 seconds, statistics not copied");
+        return ESP_ERR_TIMEOUT;
+    }
+    *p_stats = handle->stats;
+    xSemaphoreGive(handle->mutex);
+
+    return ESP_OK;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static esp_err_t check_config(const hue_entertainment_config_t* p_config) {
+    if (HUE_NULL_CHECK(tag, p_config)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_config->bridge_ip)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_config->bridge_id)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_config->application_key)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_config->client_key)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_config->entertainment_configuration_id)) return ESP_ERR_INVALID_ARG;
+
+    /* Verify that all config strings are in specified format before continuing */
+    if (hue_validate_bridge_ip(p_config->bridge_ip) != ESP_OK) {
+        ESP_LOGE(tag, "Bridge IP is not in the correct format");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (hue_validate_bridge_id(p_config->bridge_id) != ESP_OK) {
+        ESP_LOGE(tag, "Bridge ID is not in the correct format");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (hue_validate_app_key(p_config->application_key) != ESP_OK) {
+        ESP_LOGE(tag, "Application key is not in the correct format");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (hue_validate_client_key(p_config->client_key) != ESP_OK) {
+        ESP_LOGE(tag, "Client key is not in the correct format");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (hue_validate_resource_id(p_config->entertainment_configuration_id) != ESP_OK) {
+        ESP_LOGE(tag, "Entertainment configuration ID is not in the correct format");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if ((p_config->color_space != HUE_ENTERTAINMENT_COLOR_SPACE_RGB) &&
+        (p_config->color_space != HUE_ENTERTAINMENT_COLOR_SPACE_XY)) {
+        ESP_LOGE(tag, "Unknown color space %d", p_config->color_space);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((p_config->rate_hz < HUE_ENTERTAINMENT_MIN_RATE_HZ) || (p_config->rate_hz > HUE_ENTERTAINMENT_MAX_RATE_HZ)) {
+        ESP_LOGE(tag, "Rate %u Hz is not between %d and %d Hz", p_config->rate_hz, HUE_ENTERTAINMENT_MIN_RATE_HZ,
+                 HUE_ENTERTAINMENT_MAX_RATE_HZ);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Placement is checked here, an invalid core would otherwise only fail inside xTaskCreatePinnedToCore() */
+    if (p_config->task_placement_set) {
+        if ((p_config->task_priority == 0) || (p_config->task_priority >= configMAX_PRIORITIES)) {
+            ESP_LOGE(tag, "Task priority %u is not between 1 and %d", p_config->task_priority,
+                     configMAX_PRIORITIES - 1);
+            return ESP_ERR_INVALID_ARG;
+        }
+        if ((p_config->task_core_id != HUE_ENTERTAINMENT_TASK_ANY_CORE) &&
+            ((p_config->task_core_id < 0) || (p_config->task_core_id >= portNUM_PROCESSORS))) {
+            ESP_LOGE(tag, "Task core %d does not exist", p_config->task_core_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    return ESP_OK;
+}
+
+static void unpad_bridge_ip(char* host, const char* bridge_ip) {
+    size_t pos = 0;
+
+    /* Every octet is 3 digits followed by '.' or the end, leading zeros are dropped unless the octet is 0 */
+    for (uint8_t octet = 0; octet < 4; octet++) {
+        const char* p_octet = &(bridge_ip[octet * 4]);
+        uint8_t skip = 0;
+        while ((skip < 2) && (p_octet[skip] == '0')) skip++;
+        for (uint8_t digit = skip; digit < 3; digit++) host[pos++] = p_octet[digit];
+        if (octet < 3) host[pos++] = '.';
+    }
+    host[pos] = '\0';
+}
+
+static void pack_client_key(uint8_t* psk, const char* client_key) {
+    for (uint8_t i = 0; i < HUE_CLIENT_KEY_LENGTH; i++) {
+        char c = client_key[i];
+        uint8_t value = (c <= '9') ? (c - '0') : ((c | 0x20) - 'a' + 10); /* 0x20 lowercases A-F */
+
+        /* High nibble first, in the order the key is printed */
+        if (i % 2) {
+            psk[i / 2] |= value;
+        } else {
+            psk[i / 2] = value << 4;
+        }
+    }
+}
+
+static esp_err_t put_action(hue_entertainment_handle_t handle, const char* action) {
+    char body[24];
+    snprintf(body, sizeof(body), "{\"action\":\"%s\"}", action);
+
+    /* Only used to start and stop the stream, so a client is created for each request instead of kept open */
+    esp_http_client_config_t client_config = {
+        .url = handle->url,
+        .cert_pem = hue_signify_root_cert_pem_start, /* CA Cert for TLS */
+        .common_name = handle->bridge_id,            /* CN for TLS verification */
+        .timeout_ms = 5000,
+        .method = HTTP_METHOD_PUT,
+    };
+    esp_http_client_handle_t client = esp_http_client_init(&client_config);
+    if (!client) {
+        ESP_LOGE(tag, "Failed to create HTTP client");
+        return ESP_ERR_NO_MEM;
+    }
+    esp_http_client_set_header(client, "hue-application-key", handle->app_key);
+    esp_http_client_set_header(client, "Content-Type", "application/json");
+    esp_http_client_set_post_field(client, body, strlen(body));
+
+    esp_err_t err = esp_http_client_perform(client);
+    if (err != ESP_OK) {
+        ESP_LOGE(tag, "Entertainment configuration %s request failed, %s", action, esp_err_to_name(err));
+        err = ESP_FAIL;
+    } else if (esp_http_client_get_status_code(client) != HttpStatus_Ok) {
+        ESP_LOGE(tag, "Entertainment configuration %s answered %d", action, esp_http_client_get_status_code(client));
+        err = ESP_ERR_INVALID_RESPONSE;
+    }
+
+    esp_http_client_cleanup(client);
+    return err;
+}
+
+static void hue_entertainment_frame_timer_callback(void* arg) {
+    xEventGroupSetBits(((hue_entertainment_handle_t)arg)->handle_evt, HUE_ENTERTAINMENT_EVT_FRAME_BIT);
+}
+
+static void hue_entertainment_stream_task(void* pvparameters) {
+    if (HUE_NULL_CHECK(tag, pvparameters)) vTaskDelete(NULL);
+
+    hue_entertainment_handle_t handle = (hue_entertainment_handle_t)pvparameters;
+    EventBits_t bits;
+
+    while (true) {
+        bits = xEventGroupWaitBits(handle->handle_evt, HUE_ENTERTAINMENT_EVT_FRAME_BIT | HUE_ENTERTAINMENT_EVT_EXIT_BIT,
+                                   pdFALSE, pdFALSE, portMAX_DELAY);
+        if (bits & HUE_ENTERTAINMENT_EVT_EXIT_BIT) break;
+
+        xEventGroupClearBits(handle->handle_evt, HUE_ENTERTAINMENT_EVT_FRAME_BIT);
+        hue_entertainment_send_frame(handle);
+    }
+
+    xEventGroupSetBits(handle->handle_evt, HUE_ENTERTAINMENT_EVT_EXITED_BIT);
+    vTaskDelete(NULL);
+}
+
+static void hue_entertainment_send_frame(hue_entertainment_handle_t handle) {
+    /* Channels are copied straight into the frame buffer, the mutex is only held for the copy */
+    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    uint8_t channel_count = handle->channel_count;
+    if (channel_count) {
+        hue_entertainment_frame_fill(&(handle->frame), handle->sequence, handle->channels, channel_count);
+    }
+    xSemaphoreGive(handle->mutex);
+
+    /* Nothing is streamed until there is a color to show, the bridge keeps the lights as they were */
+    if (!channel_count) return;
+
+    int64_t now_us = esp_timer_get_time();
+    esp_err_t err = hue_entertainment_dtls_send(handle->dtls, handle->frame.buff, handle->frame.length);
+    handle->sequence++;
+
+    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    hue_entertainment_stats_t* p_stats = &(handle->stats);
+    if (err != ESP_OK) {
+        if (!p_stats->send_failures) ESP_LOGW(tag, "Failed to send frame, further failures are only counted");
+        p_stats->send_failures++;
+        xSemaphoreGive(handle->mutex);
+        return;
+    }
+    p_stats->frames_sent++;
+
+    /* Jitter is the interval between sent frames against the period, the first frame has no interval */
+    if (handle->last_frame_us) {
+        int64_t jitter = (now_us - handle->last_frame_us) - handle->period_us;
+        if (jitter < 0) jitter = -jitter;
+        p_stats->last_jitter_us = jitter;
+        p_stats->total_jitter_us += jitter;
+        if (jitter > p_stats->max_jitter_us) p_stats->max_jitter_us = jitter;
+        if (jitter > (handle->period_us / 2)) p_stats->frames_late++;
+    }
+    handle->last_frame_us = now_us;
+    xSemaphoreGive(handle->mutex);
+}
+
+static void free_hue_entertainment_instance(hue_entertainment_handle_t* p_handle) {
+    /* If p_handle or the stream handle are already NULL, nothing needs to be done */
+    if (!p_handle) return;
+    if (!(*p_handle)) return;
+
+    /* Free any resources that are allocated, the timer first so it cannot set bits in a deleted event group */
+    if ((*p_handle)->frame_timer) {
+        esp_timer_stop((*p_handle)->frame_timer);
+        esp_timer_delete((*p_handle)->frame_timer);
+    }
+    if ((*p_handle)->task_handle) vTaskDelete((*p_handle)->task_handle);
+    if ((*p_handle)->dtls) hue_entertainment_dtls_close(&((*p_handle)->dtls));
+    if ((*p_handle)->handle_evt) vEventGroupDelete((*p_handle)->handle_evt);
+    if ((*p_handle)->mutex) vSemaphoreDelete((*p_handle)->mutex);
+
+    free(*p_handle);
+
+    /* Sets the value of the stream handle to NULL to ensure handle cannot be used to access deallocated memory */
+    *p_handle = NULL;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file hue_entertainment.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Declarations for all public functions used for streaming light colors with the Philips Hue Entertainment API
+ *
+ * A stream starts an entertainment configuration over CLIP v2 and then sends HueStream frames carrying the color of
+ * every channel in it to the bridge over DTLS, authenticated by the application key and its client key as PSK. Frames
+ * are sent at a fixed rate whether colors changed or not, the bridge smooths between them and ends the stream if none
+ * arrive for 10 seconds. Unlike hue_https requests, frames are not limited to a few commands a second.
+ */
+
+#ifndef H_HUE_ENTERTAINMENT
+#define H_HUE_ENTERTAINMENT
+
+#include "esp_types.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define HUE_ENTERTAINMENT_PORT 2100 /**< UDP port the bridge receives DTLS streams on */
+
+#define HUE_ENTERTAINMENT_MIN_RATE_HZ 25 /**< Lowest frame rate, below it the bridge's smoothing shows steps */
+#define HUE_ENTERTAINMENT_MAX_RATE_HZ 50 /**< Highest frame rate, the bridge drops frames sent faster than this */
+
+/** Channels a frame can carry, the most an entertainment configuration has */
+#define HUE_ENTERTAINMENT_MAX_CHANNELS 20
+/** HueStream v2 header: protocol name, version, sequence, color space and entertainment configuration ID */
+#define HUE_ENTERTAINMENT_FRAME_HEADER_SIZE 52
+/** Channel ID byte followed by three 16 bit color values */
+#define HUE_ENTERTAINMENT_CHANNEL_SIZE 7
+/** Size of a frame carrying every channel */
+#define HUE_ENTERTAINMENT_FRAME_MAX_SIZE                                                                               \
+    (HUE_ENTERTAINMENT_FRAME_HEADER_SIZE + (HUE_ENTERTAINMENT_MAX_CHANNELS * HUE_ENTERTAINMENT_CHANNEL_SIZE))
+
+/** Stream task priority used unless a placement is set, above hue_https so frames keep their pace */
+#define HUE_ENTERTAINMENT_DEFAULT_TASK_PRIORITY 21
+/** Value of task_core_id letting the scheduler run the stream task on either core */
+#define HUE_ENTERTAINMENT_TASK_ANY_CORE -1
+
+/*====================================================================================================================*/
+/*=========================================== Public Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Color space of the channel values in a frame */
+typedef enum {
+    HUE_ENTERTAINMENT_COLOR_SPACE_RGB = 0, /**< Values are red, green and blue */
+    HUE_ENTERTAINMENT_COLOR_SPACE_XY,      /**< Values are CIE x, CIE y and brightness */
+} hue_entertainment_color_space_t;
+
+/** @brief Color of one channel of an entertainment configuration */
+typedef struct {
+    uint8_t channel_id; /**< [0-(HUE_ENTERTAINMENT_MAX_CHANNELS - 1)] Channel ID from the entertainment configuration */
+    uint16_t values[3]; /**< [0-65535] Red, green and blue, or CIE x, CIE y and brightness, scaled to the full range */
+} hue_entertainment_channel_t;
+
+/**
+ * @brief HueStream frame, sized for every channel so frames are built in place without allocating
+ *
+ * @note The header is written once by hue_entertainment_frame_init(), filling a frame only writes the sequence number
+ * and channels
+ */
+typedef struct {
+    uint8_t buff[HUE_ENTERTAINMENT_FRAME_MAX_SIZE]; /**< Frame as sent */
+    size_t length;                                  /**< Bytes of buff in use */
+} hue_entertainment_frame_t;
+
+/**
+ * @brief Philips Hue bridge information, keys and entertainment configuration to stream to
+ *
+ * @attention The client key is only returned when the application key is created with "generateclientkey": true
+ */
+typedef struct {
+    const char* bridge_ip;       /**< IP address of bridge from https://discovery.meethue.com */
+    const char* bridge_id;       /**< Bridge ID from https://discovery.meethue.com */
+    const char* application_key; /**< Application key, also the PSK identity of the stream */
+    const char* client_key;      /**< Client key returned with the application key, 32 hexadecimal characters of PSK */
+
+    /** ID of the entertainment configuration to start, its channels are the lights being streamed to */
+    const char* entertainment_configuration_id;
+    const char* const task_id;                   /**< ID to assign to the stream task */
+    hue_entertainment_color_space_t color_space; /**< Color space of the channel values */
+    uint8_t rate_hz; /**< [HUE_ENTERTAINMENT_MIN_RATE_HZ-HUE_ENTERTAINMENT_MAX_RATE_HZ] Frames sent per second */
+
+    /** Use task_priority and task_core_id, otherwise the task is unpinned at HUE_ENTERTAINMENT_DEFAULT_TASK_PRIORITY */
+    bool task_placement_set;
+    uint8_t task_priority; /**< [1-(configMAX_PRIORITIES - 1)] Priority of the stream task */
+    int8_t task_core_id;   /**< Core to pin the stream task to, or HUE_ENTERTAINMENT_TASK_ANY_CORE */
+} hue_entertainment_config_t;
+
+/** @brief Frame statistics of a stream */
+typedef struct {
+    uint32_t frames_sent;    /**< Frames sent to the bridge */
+    uint32_t send_failures;  /**< Frames that could not be sent */
+    uint32_t frames_late;    /**< Frames sent over half a period later than one period after the previous frame */
+    int64_t last_jitter_us;  /**< Difference between the most recent interval between sent frames and the period */
+    int64_t max_jitter_us;   /**< Largest difference between an interval and the period */
+    int64_t total_jitter_us; /**< Sum of all interval differences, for averaging with frames_sent - 1 intervals */
+    int64_t handshake_us;    /**< Time taken by the DTLS handshake */
+} hue_entertainment_stats_t;
+
+typedef struct hue_entertainment_instance* hue_entertainment_handle_t; /**< Handle for a running stream */
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/* hue_entertainment_frame.c */
+
+/**
+ * @brief Writes the HueStream header of an empty frame
+ *
+ * @param[out] p_frame Frame to initialize
+ * @param[in] entertainment_configuration_id ID of the entertainment configuration being streamed to
+ * @param[in] color_space Color space of the channel values
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Frame initialized
+ * @retval - @c ESP_ERR_INVALID_ARG – p_frame or entertainment_configuration_id are NULL, the ID is not in the correct
+ * format as specified by the Philips Hue API, or color_space is unknown
+ */
+esp_err_t hue_entertainment_frame_init(hue_entertainment_frame_t* p_frame, const char* entertainment_configuration_id,
+                                       hue_entertainment_color_space_t color_space);
+
+/**
+ * @brief Writes the sequence number and channels of a frame initialized by hue_entertainment_frame_init()
+ *
+ * @param[in,out] p_frame Frame to fill
+ * @param[in] sequence Sequence number, incremented by one for every frame sent
+ * @param[in] p_channels Channels to write in order
+ * @param[in] channel_count Number of channels in p_channels
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Frame filled, p_frame->length is the size to send
+ * @retval - @c ESP_ERR_INVALID_ARG – p_frame or p_channels are NULL, or a channel ID is out of range
+ * @retval - @c ESP_ERR_INVALID_SIZE – channel_count is over HUE_ENTERTAINMENT_MAX_CHANNELS
+ */
+esp_err_t hue_entertainment_frame_fill(hue_entertainment_frame_t* p_frame, uint8_t sequence,
+                                       const hue_entertainment_channel_t* p_channels, uint8_t channel_count);
+
+/* hue_entertainment_instance.c */
+
+/**
+ * @brief Starts the entertainment configuration, opens the DTLS stream and starts sending frames
+ *
+ * Blocks for the CLIP v2 request and DTLS handshake, so WiFi must be connected. Frames are only sent once channels are
+ * set with hue_entertainment_set_channels().
+ *
+ * @param[out] p_handle Handle to store the running stream into
+ * @param[in] p_config Bridge, keys and stream settings
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Stream running
+ * @retval - @c ESP_ERR_INVALID_ARG – p_handle, p_config, or p_config's internal pointers are NULL, a config string is
+ * not in the correct format, the rate or task placement are out of range, or *p_handle is already a stream
+ * @retval - @c ESP_ERR_NO_MEM – Failed to allocate the stream or create its task, timer or synchronization primitives
+ * @retval - @c ESP_ERR_INVALID_RESPONSE – Bridge did not answer the start request with 200 OK
+ * @retval - @c ESP_ERR_TIMEOUT – DTLS handshake did not complete in time
+ * @retval - @c ESP_FAIL – Bridge could not be reached or the DTLS handshake failed
+ */
+esp_err_t hue_entertainment_start(hue_entertainment_handle_t* p_handle, const hue_entertainment_config_t* p_config);
+
+/**
+ * @brief Stops sending frames, closes the DTLS stream and stops the entertainment configuration
+ *
+ * @param[in,out] p_handle Pointer to stream handle to stop (Will be set to NULL after)
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Stream stopped
+ * @retval - @c ESP_ERR_INVALID_ARG – p_handle or *p_handle are NULL
+ * @retval - @c ESP_ERR_INVALID_RESPONSE – Bridge did not answer the stop request with 200 OK, the stream is still
+ * stopped and freed, the bridge ends the configuration itself 10 seconds after the last frame
+ */
+esp_err_t hue_entertainment_stop(hue_entertainment_handle_t* p_handle);
+
+/**
+ * @brief Replaces the channels sent from the next frame on
+ *
+ * All channels are replaced at once, so a frame never mixes colors from two calls
+ *
+ * @param[in] handle Stream to update
+ * @param[in] p_channels Channels to send, usually one for every channel of the entertainment configuration
+ * @param[in] channel_count Number of channels in p_channels
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Channels replaced
+ * @retval - @c ESP_ERR_INVALID_ARG – handle or p_channels are NULL, or a channel ID is out of range
+ * @retval - @c ESP_ERR_INVALID_SIZE – channel_count is 0 or over HUE_ENTERTAINMENT_MAX_CHANNELS
+ * @retval - @c ESP_ERR_TIMEOUT – Stream mutex could not be acquired
+ */
+esp_err_t hue_entertainment_set_channels(hue_entertainment_handle_t handle,
+                                         const hue_entertainment_channel_t* p_channels, uint8_t channel_count);
+
+/**
+ * @brief Copies the frame statistics of a stream
+ *
+ * @param[in] handle Stream to query
+ * @param[out] p_stats Storage for the statistics
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Statistics copied
+ * @retval - @c ESP_ERR_INVALID_ARG – handle or p_stats are NULL
+ * @retval - @c ESP_ERR_TIMEOUT – Stream mutex could not be acquired
+ */
+esp_err_t hue_entertainment_get_stats(hue_entertainment_handle_t handle, hue_entertainment_stats_t* p_stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HUE_ENTERTAINMENT */
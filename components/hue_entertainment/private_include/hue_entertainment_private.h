@@ -0,0 +1,128 @@
+/**
+ * @file hue_entertainment_private.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Declarations of all structures and functions shared between component modules but private to component use
+ */
+
+#ifndef H_HUE_ENTERTAINMENT_PRIVATE
+#define H_HUE_ENTERTAINMENT_PRIVATE
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "esp_bit_defs.h"
+#include "esp_timer.h"
+
+#include "hue_entertainment.h"
+#include "hue_validate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+/** Philips Hue path to the entertainment configuration resource */
+#define HUE_ENTERTAINMENT_RESOURCE_PATH "/clip/v2/resource/entertainment_configuration/"
+/** Length of HUE_ENTERTAINMENT_RESOURCE_PATH */
+#define HUE_ENTERTAINMENT_RESOURCE_PATH_LENGTH 46
+/** Size of "https://" + IPV4 address + HUE_ENTERTAINMENT_RESOURCE_PATH + resource ID */
+#define HUE_ENTERTAINMENT_URL_SIZE \
+    (8 + HUE_BRIDGE_IP_LENGTH + HUE_ENTERTAINMENT_RESOURCE_PATH_LENGTH + HUE_RESOURCE_ID_LENGTH + 1)
+
+/** Bytes of PSK packed from the HUE_CLIENT_KEY_LENGTH hexadecimal characters of the client key */
+#define HUE_ENTERTAINMENT_PSK_SIZE (HUE_CLIENT_KEY_LENGTH / 2)
+
+#define HUE_ENTERTAINMENT_HANDSHAKE_TIMEOUT_MS 5000 /**< Longest the DTLS handshake may take, with retransmissions */
+#define HUE_ENTERTAINMENT_STOP_TIMEOUT_MS 5000      /**< Longest the stream task may take to finish its last frame */
+
+#define HUE_ENTERTAINMENT_EVT_FRAME_BIT BIT0   /**< Frame period elapsed, set by the frame timer */
+#define HUE_ENTERTAINMENT_EVT_EXIT_BIT BIT1    /**< Stream task must exit */
+#define HUE_ENTERTAINMENT_EVT_EXITED_BIT BIT2  /**< Stream task exited, nothing uses the DTLS session anymore */
+
+/*====================================================================================================================*/
+/*======================================= Shared Private Structure Definitions =======================================*/
+/*====================================================================================================================*/
+
+typedef struct hue_entertainment_dtls* hue_entertainment_dtls_handle_t; /**< Handle for an open DTLS session */
+
+/** @brief Storage for all required data for a stream */
+typedef struct hue_entertainment_instance {
+    TaskHandle_t task_handle;         /**< Task sending frames */
+    EventGroupHandle_t handle_evt;    /**< Event group waking the stream task */
+    esp_timer_handle_t frame_timer;   /**< Periodic timer setting HUE_ENTERTAINMENT_EVT_FRAME_BIT every period */
+    hue_entertainment_dtls_handle_t dtls; /**< DTLS session frames are sent over, only used by the stream task */
+
+    char url[HUE_ENTERTAINMENT_URL_SIZE];         /**< Entertainment configuration URL for start and stop */
+    char bridge_id[HUE_BRIDGE_ID_LENGTH + 1];     /**< Bridge ID needed for CA Cert verification */
+    char app_key[HUE_APPLICATION_KEY_LENGTH + 1]; /**< Application key for requests and PSK identity */
+    char host[HUE_BRIDGE_IP_LENGTH + 1];          /**< Bridge IP without zero padding, for the URL and UDP socket */
+    uint8_t psk[HUE_ENTERTAINMENT_PSK_SIZE];      /**< Client key as bytes */
+    int64_t period_us;                            /**< Time between frames */
+
+    /* Frame and sequence are only used by the stream task, built in place every period */
+    hue_entertainment_frame_t frame; /**< Frame being sent, header written once at start */
+    uint8_t sequence;                /**< Sequence number of the next frame */
+    int64_t last_frame_us;           /**< Time the previous frame was sent, 0 before the first */
+
+    SemaphoreHandle_t mutex;                                          /**< Protects the fields below */
+    hue_entertainment_channel_t channels[HUE_ENTERTAINMENT_MAX_CHANNELS]; /**< Channels sent in every frame */
+    uint8_t channel_count;                                            /**< Channels set, no frames are sent while 0 */
+    hue_entertainment_stats_t stats;                                  /**< Frame statistics */
+} hue_entertainment_instance_t;
+
+/*====================================================================================================================*/
+/*======================================= Shared Private Function Declarations =======================================*/
+/*====================================================================================================================*/
+
+/* hue_entertainment_dtls.c */
+
+/**
+ * @brief Connects a UDP socket to the bridge and performs the DTLS 1.2 handshake with a PSK cipher suite
+ *
+ * @param[out] p_dtls_handle Handle to store the open session into
+ * @param[in] host Bridge IP address
+ * @param[in] port Bridge port, HUE_ENTERTAINMENT_PORT
+ * @param[in] identity PSK identity, the application key
+ * @param[in] psk PSK, the client key as bytes
+ * @param[in] psk_length Number of bytes in psk
+ * @param[in] timeout_ms Longest the handshake may take
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Session open
+ * @retval - @c ESP_ERR_NO_MEM – Failed to allocate the session
+ * @retval - @c ESP_ERR_TIMEOUT – Handshake did not complete within timeout_ms
+ * @retval - @c ESP_FAIL – Socket could not be connected or the handshake failed
+ */
+esp_err_t hue_entertainment_dtls_open(hue_entertainment_dtls_handle_t* p_dtls_handle, const char* host, uint16_t port,
+                                      const char* identity, const uint8_t* psk, size_t psk_length,
+                                      uint32_t timeout_ms);
+
+/**
+ * @brief Sends one datagram over an open session, without allocating
+ *
+ * @param[in] dtls_handle Session to send over
+ * @param[in] data Datagram payload
+ * @param[in] length Number of bytes in data
+ *
+ * @return ESP_OK once the whole datagram was sent, ESP_FAIL otherwise
+ */
+esp_err_t hue_entertainment_dtls_send(hue_entertainment_dtls_handle_t dtls_handle, const uint8_t* data,
+                                      size_t length);
+
+/**
+ * @brief Sends close_notify, closes the socket and frees the session
+ *
+ * @param[in,out] p_dtls_handle Pointer to session handle to close (Will be set to NULL after)
+ */
+void hue_entertainment_dtls_close(hue_entertainment_dtls_handle_t* p_dtls_handle);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HUE_ENTERTAINMENT_PRIVATE */
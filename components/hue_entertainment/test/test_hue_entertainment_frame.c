@@ -0,0 +1,112 @@
+#include <string.h>
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#include "hue_entertainment.h"
+
+#define TEST_CONFIGURATION_ID "1a8d99cc-967b-44f2-9202-43f976c0fa6b"
+
+/*======================= Basic NULL testing =======================*/
+TEST_CASE("NULL frame", "[hue_entertainment][hue_entertainment_frame][empty]") {
+    hue_entertainment_channel_t channel = {};
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG,
+                      hue_entertainment_frame_init(NULL, TEST_CONFIGURATION_ID, HUE_ENTERTAINMENT_COLOR_SPACE_RGB));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_entertainment_frame_fill(NULL, 0, &channel, 1));
+}
+
+TEST_CASE("NULL configuration ID and channels", "[hue_entertainment][hue_entertainment_frame][empty]") {
+    hue_entertainment_frame_t frame;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG,
+                      hue_entertainment_frame_init(&frame, NULL, HUE_ENTERTAINMENT_COLOR_SPACE_RGB));
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_init(&frame, TEST_CONFIGURATION_ID,
+                                                           HUE_ENTERTAINMENT_COLOR_SPACE_RGB));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_entertainment_frame_fill(&frame, 0, NULL, 1));
+}
+
+/*========================= Header testing =========================*/
+TEST_CASE("Header RGB", "[hue_entertainment][hue_entertainment_frame][header]") {
+    hue_entertainment_frame_t frame;
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_init(&frame, TEST_CONFIGURATION_ID,
+                                                           HUE_ENTERTAINMENT_COLOR_SPACE_RGB));
+    static const uint8_t expected[16] = {'H', 'u', 'e', 'S', 't', 'r', 'e', 'a', 'm', 0x02, 0x00, 0x00, 0x00, 0x00,
+                                         0x00, 0x00};
+    TEST_ASSERT_EQUAL(HUE_ENTERTAINMENT_FRAME_HEADER_SIZE, frame.length);
+    TEST_ASSERT_EQUAL_MEMORY(expected, frame.buff, sizeof(expected));
+    TEST_ASSERT_EQUAL_MEMORY(TEST_CONFIGURATION_ID, &frame.buff[16], 36);
+}
+
+TEST_CASE("Header XY", "[hue_entertainment][hue_entertainment_frame][header]") {
+    hue_entertainment_frame_t frame;
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_init(&frame, TEST_CONFIGURATION_ID,
+                                                           HUE_ENTERTAINMENT_COLOR_SPACE_XY));
+    TEST_ASSERT_EQUAL(0x01, frame.buff[14]);
+}
+
+TEST_CASE("Header invalid", "[hue_entertainment][hue_entertainment_frame][header]") {
+    hue_entertainment_frame_t frame;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_entertainment_frame_init(&frame, "1a8d99cc-967b-44f2-9202-43f976c0fa6",
+                                                                        HUE_ENTERTAINMENT_COLOR_SPACE_RGB));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG,
+                      hue_entertainment_frame_init(&frame, TEST_CONFIGURATION_ID, (hue_entertainment_color_space_t)2));
+}
+
+/*======================== Channel testing =========================*/
+TEST_CASE("Channels big-endian", "[hue_entertainment][hue_entertainment_frame][channels]") {
+    hue_entertainment_frame_t frame;
+    hue_entertainment_channel_t channels[2] = {
+        {.channel_id = 0, .values = {0xFFFF, 0x0000, 0x1234}},
+        {.channel_id = 19, .values = {0x00FF, 0xFF00, 0x8001}},
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_init(&frame, TEST_CONFIGURATION_ID,
+                                                           HUE_ENTERTAINMENT_COLOR_SPACE_RGB));
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_fill(&frame, 7, channels, 2));
+
+    static const uint8_t expected[14] = {0x00, 0xFF, 0xFF, 0x00, 0x00, 0x12, 0x34,
+                                         0x13, 0x00, 0xFF, 0xFF, 0x00, 0x80, 0x01};
+    TEST_ASSERT_EQUAL(HUE_ENTERTAINMENT_FRAME_HEADER_SIZE + 14, frame.length);
+    TEST_ASSERT_EQUAL(7, frame.buff[11]);
+    TEST_ASSERT_EQUAL_MEMORY(expected, &frame.buff[HUE_ENTERTAINMENT_FRAME_HEADER_SIZE], sizeof(expected));
+    TEST_ASSERT_EQUAL_MEMORY(TEST_CONFIGURATION_ID, &frame.buff[16], 36);
+}
+
+TEST_CASE("Refill shrinks frame", "[hue_entertainment][hue_entertainment_frame][channels]") {
+    hue_entertainment_frame_t frame;
+    hue_entertainment_channel_t channels[3] = {{.channel_id = 0}, {.channel_id = 1}, {.channel_id = 2}};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_init(&frame, TEST_CONFIGURATION_ID,
+                                                           HUE_ENTERTAINMENT_COLOR_SPACE_RGB));
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_fill(&frame, 0, channels, 3));
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_fill(&frame, 1, channels, 1));
+    TEST_ASSERT_EQUAL(HUE_ENTERTAINMENT_FRAME_HEADER_SIZE + HUE_ENTERTAINMENT_CHANNEL_SIZE, frame.length);
+    TEST_ASSERT_EQUAL(1, frame.buff[11]);
+}
+
+TEST_CASE("Every channel", "[hue_entertainment][hue_entertainment_frame][channels]") {
+    hue_entertainment_frame_t frame;
+    hue_entertainment_channel_t channels[HUE_ENTERTAINMENT_MAX_CHANNELS];
+    for (uint8_t i = 0; i < HUE_ENTERTAINMENT_MAX_CHANNELS; i++) {
+        channels[i] = (hue_entertainment_channel_t){.channel_id = i, .values = {i, i, i}};
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_init(&frame, TEST_CONFIGURATION_ID,
+                                                           HUE_ENTERTAINMENT_COLOR_SPACE_RGB));
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_fill(&frame, 255, channels, HUE_ENTERTAINMENT_MAX_CHANNELS));
+    TEST_ASSERT_EQUAL(HUE_ENTERTAINMENT_FRAME_MAX_SIZE, frame.length);
+    TEST_ASSERT_EQUAL(19, frame.buff[HUE_ENTERTAINMENT_FRAME_MAX_SIZE - HUE_ENTERTAINMENT_CHANNEL_SIZE]);
+}
+
+TEST_CASE("Too many channels", "[hue_entertainment][hue_entertainment_frame][out_of_range]") {
+    hue_entertainment_frame_t frame;
+    hue_entertainment_channel_t channels[HUE_ENTERTAINMENT_MAX_CHANNELS + 1] = {};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_init(&frame, TEST_CONFIGURATION_ID,
+                                                           HUE_ENTERTAINMENT_COLOR_SPACE_RGB));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE,
+                      hue_entertainment_frame_fill(&frame, 0, channels, HUE_ENTERTAINMENT_MAX_CHANNELS + 1));
+}
+
+TEST_CASE("Channel ID out of range", "[hue_entertainment][hue_entertainment_frame][out_of_range]") {
+    hue_entertainment_frame_t frame;
+    hue_entertainment_channel_t channel = {.channel_id = HUE_ENTERTAINMENT_MAX_CHANNELS};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_entertainment_frame_init(&frame, TEST_CONFIGURATION_ID,
+                                                           HUE_ENTERTAINMENT_COLOR_SPACE_RGB));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_entertainment_frame_fill(&frame, 0, &channel, 1));
+}
@@ -0,0 +1,168 @@
+/**
+ * @file bench_hue_validate.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Micro-benchmarks comparing the table-driven hue_validate checks with the strlen and sscanf checks they
+ * replaced
+ *
+ * Runs as Unity test cases tagged [hue_validate_bench], through hue_test_app on device (timed with the CPU cycle
+ * counter) and through the host test runner (timed with CLOCK_MONOTONIC). Cases only fail if the two checks disagree,
+ * the printed numbers are meant to be compared between builds.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#include "hue_validate.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#else
+#include <time.h>
+#endif
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#ifdef ESP_PLATFORM
+#define BENCH_ITERATIONS 1000 /**< Calls timed per case */
+#else
+#define BENCH_ITERATIONS 100000 /**< Calls timed per case */
+#endif
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Validator under test */
+typedef esp_err_t (*bench_check_t)(const char* str);
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Times a table-driven check against the sscanf check it replaced for one input and prints the results
+ *
+ * @param[in] name Name of the input printed with the results
+ * @param[in] input String to check
+ * @param[in] table_check hue_validate check
+ * @param[in] scanf_check Previous sscanf based check
+ */
+static void bench_check(const char* name, const char* input, bench_check_t table_check, bench_check_t scanf_check);
+
+/**
+ * @brief Previous checks, strlen followed by sscanf with %n counting the characters matching the format
+ */
+static esp_err_t scanf_check_bridge_ip(const char* bridge_ip);
+static esp_err_t scanf_check_bridge_id(const char* bridge_id);
+static esp_err_t scanf_check_app_key(const char* app_key);
+static esp_err_t scanf_check_resource_id(const char* resource_id);
+
+/**
+ * @brief Returns a timestamp in platform specific ticks, CPU cycles on device and nanoseconds on host
+ */
+static uint32_t bench_ticks(void);
+
+/**
+ * @brief Converts a difference of bench_ticks() values to nanoseconds
+ */
+static double bench_ticks_to_ns(uint32_t ticks);
+
+/*====================================================================================================================*/
+/*=================================================== Test Cases =====================================================*/
+/*====================================================================================================================*/
+
+TEST_CASE("Bench bridge IP", "[hue_helpers][hue_validate_bench]") {
+    bench_check("bridge IP", "192.168.001.002", hue_validate_bridge_ip, scanf_check_bridge_ip);
+}
+
+TEST_CASE("Bench bridge ID", "[hue_helpers][hue_validate_bench]") {
+    bench_check("bridge ID", "001788fffe4b1e55", hue_validate_bridge_id, scanf_check_bridge_id);
+}
+
+TEST_CASE("Bench application key", "[hue_helpers][hue_validate_bench]") {
+    bench_check("application key", "aZ09-_aZ09-_aZ09-_aZ09-_aZ09-_aZ09-_aZ09", hue_validate_app_key,
+                scanf_check_app_key);
+}
+
+TEST_CASE("Bench resource ID", "[hue_helpers][hue_validate_bench]") {
+    bench_check("resource ID", "8c2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f5a6b", hue_validate_resource_id,
+                scanf_check_resource_id);
+    bench_check("resource ID early fail", "8c2e1f6g-3b4d-4e5f-9a0b-1c2d3e4f5a6b", hue_validate_resource_id,
+                scanf_check_resource_id);
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static void bench_check(const char* name, const char* input, bench_check_t table_check, bench_check_t scanf_check) {
+    /* Both checks must agree on the input for the comparison to mean anything */
+    esp_err_t expected = scanf_check(input);
+    TEST_ASSERT_EQUAL(expected, table_check(input));
+
+    /* Results are accumulated so the calls cannot be optimized out */
+    uint32_t failures = 0;
+    uint32_t start = bench_ticks();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) failures += (table_check(input) != ESP_OK);
+    uint32_t table_elapsed = bench_ticks() - start;
+
+    start = bench_ticks();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) failures += (scanf_check(input) != ESP_OK);
+    uint32_t scanf_elapsed = bench_ticks() - start;
+
+    TEST_ASSERT_EQUAL((expected == ESP_OK) ? 0 : 2 * BENCH_ITERATIONS, failures);
+
+    double table_ns = bench_ticks_to_ns(table_elapsed) / BENCH_ITERATIONS;
+    double scanf_ns = bench_ticks_to_ns(scanf_elapsed) / BENCH_ITERATIONS;
+    printf("hue_validate_bench %-24s table %8.1f ns/op  sscanf %8.1f ns/op  %5.1fx\n", name, table_ns, scanf_ns,
+           (table_ns > 0) ? scanf_ns / table_ns : 0.0);
+}
+
+static esp_err_t scanf_check_bridge_ip(const char* bridge_ip) {
+    int chars_received = 0;
+    if (strlen(bridge_ip) != HUE_BRIDGE_IP_LENGTH) return ESP_FAIL;
+    sscanf(bridge_ip, "%*3u.%*3u.%*3u.%*3u%n", &chars_received);
+    return (chars_received == HUE_BRIDGE_IP_LENGTH) ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t scanf_check_bridge_id(const char* bridge_id) {
+    int chars_received = 0;
+    if (strlen(bridge_id) != HUE_BRIDGE_ID_LENGTH) return ESP_FAIL;
+    sscanf(bridge_id, "%*16x%n", &chars_received);
+    return (chars_received == HUE_BRIDGE_ID_LENGTH) ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t scanf_check_app_key(const char* app_key) {
+    int chars_received = 0;
+    if (strlen(app_key) != HUE_APPLICATION_KEY_LENGTH) return ESP_FAIL;
+    sscanf(app_key, "%*40[-_0-9a-zA-Z]%n", &chars_received);
+    return (chars_received == HUE_APPLICATION_KEY_LENGTH) ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t scanf_check_resource_id(const char* resource_id) {
+    int chars_received = 0;
+    if (strlen(resource_id) != HUE_RESOURCE_ID_LENGTH) return ESP_FAIL;
+    sscanf(resource_id, "%*8x-%*4x-%*4x-%*4x-%*12x%n", &chars_received);
+    return (chars_received == HUE_RESOURCE_ID_LENGTH) ? ESP_OK : ESP_FAIL;
+}
+
+#ifdef ESP_PLATFORM
+static uint32_t bench_ticks(void) { return esp_cpu_get_cycle_count(); }
+
+static double bench_ticks_to_ns(uint32_t ticks) { return (ticks * 1000.0) / esp_rom_get_cpu_ticks_per_us(); }
+#else
+static uint32_t bench_ticks(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec); /* Wraps after ~4 s, differences stay valid */
+}
+
+static double bench_ticks_to_ns(uint32_t ticks) { return ticks; }
+#endif
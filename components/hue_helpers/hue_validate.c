@@ -0,0 +1,93 @@
+/**
+ * @file hue_validate.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Implementation of the table-driven validators for Philips Hue bridge and resource strings
+ */
+
+#include "esp_bit_defs.h"
+
+#include "hue_validate.h"
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define HUE_CLASS_HEX BIT0   /**< 0-9, a-f, A-F */
+#define HUE_CLASS_DIGIT BIT1 /**< 0-9 */
+#define HUE_CLASS_KEY BIT2   /**< URL Base64: 0-9, a-z, A-Z, '-', '_' */
+#define HUE_CLASS_DASH BIT3  /**< '-' */
+#define HUE_CLASS_DOT BIT4   /**< '.' */
+
+/* Lengths are used for buffer sizes without the patterns, so both must stay in step */
+_Static_assert(sizeof(HUE_BRIDGE_IP_PATTERN) - 1 == HUE_BRIDGE_IP_LENGTH, "Bridge IP pattern and length differ");
+_Static_assert(sizeof(HUE_BRIDGE_ID_PATTERN) - 1 == HUE_BRIDGE_ID_LENGTH, "Bridge ID pattern and length differ");
+_Static_assert(sizeof(HUE_APPLICATION_KEY_PATTERN) - 1 == HUE_APPLICATION_KEY_LENGTH, "Key pattern and length differ");
+_Static_assert(sizeof(HUE_RESOURCE_ID_PATTERN) - 1 == HUE_RESOURCE_ID_LENGTH, "Resource ID pattern and length differ");
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** Classes of every input character, the null-terminating character and non-ASCII bytes belong to none */
+static const uint8_t char_classes[256] = {
+    ['0' ... '9'] = HUE_CLASS_HEX | HUE_CLASS_DIGIT | HUE_CLASS_KEY,
+    ['a' ... 'f'] = HUE_CLASS_HEX | HUE_CLASS_KEY,
+    ['g' ... 'z'] = HUE_CLASS_KEY,
+    ['A' ... 'F'] = HUE_CLASS_HEX | HUE_CLASS_KEY,
+    ['G' ... 'Z'] = HUE_CLASS_KEY,
+    ['-'] = HUE_CLASS_KEY | HUE_CLASS_DASH,
+    ['_'] = HUE_CLASS_KEY,
+    ['.'] = HUE_CLASS_DOT,
+};
+
+/** Classes accepted by each pattern character, patterns are ASCII so the table is indexed with the low 7 bits */
+static const uint8_t pattern_classes[128] = {
+    ['h'] = HUE_CLASS_HEX,  ['d'] = HUE_CLASS_DIGIT, ['k'] = HUE_CLASS_KEY,
+    ['-'] = HUE_CLASS_DASH, ['.'] = HUE_CLASS_DOT,
+};
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t hue_validate_pattern(const char* str, const char* pattern) {
+    if (!str || !pattern) return ESP_ERR_INVALID_ARG;
+
+    /* A null-terminating character in str belongs to no class, so the scan stops there without a separate strlen */
+    size_t i;
+    for (i = 0; pattern[i]; i++) {
+        if (!(char_classes[(uint8_t)str[i]] & pattern_classes[pattern[i] & 0x7F])) return ESP_FAIL;
+    }
+
+    return (str[i] == '\0') ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t hue_validate_bridge_ip(const char* bridge_ip) {
+    esp_err_t err = hue_validate_pattern(bridge_ip, HUE_BRIDGE_IP_PATTERN);
+    if (err != ESP_OK) return err;
+
+    /* Shape is known, so octets are at fixed positions "ddd.ddd.ddd.ddd" */
+    for (size_t i = 0; i < HUE_BRIDGE_IP_LENGTH; i += 4) {
+        int octet = (bridge_ip[i] - '0') * 100 + (bridge_ip[i + 1] - '0') * 10 + (bridge_ip[i + 2] - '0');
+        if (octet > 255) return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t hue_validate_bridge_id(const char* bridge_id) {
+    return hue_validate_pattern(bridge_id, HUE_BRIDGE_ID_PATTERN);
+}
+
+esp_err_t hue_validate_app_key(const char* app_key) {
+    return hue_validate_pattern(app_key, HUE_APPLICATION_KEY_PATTERN);
+}
+
+esp_err_t hue_validate_client_key(const char* client_key) {
+    return hue_validate_pattern(client_key, HUE_CLIENT_KEY_PATTERN);
+}
+
+esp_err_t hue_validate_resource_id(const char* resource_id) {
+    return hue_validate_pattern(resource_id, HUE_RESOURCE_ID_PATTERN);
+}
@@ -0,0 +1,138 @@
+/**
+ * @file hue_validate.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Table-driven validators for the strings identifying a Philips Hue bridge and its resources
+ *
+ * Each format is a pattern with one character per input character: 'h' is a hexadecimal digit, 'd' a decimal digit,
+ * 'k' a URL Base64 character, and '-' or '.' must match exactly. Patterns are string literals, so their lengths are
+ * compile time constants that constants such as Kconfig values can be checked against with HUE_VALIDATE_STATIC_LENGTH.
+ */
+
+#ifndef H_HUE_VALIDATE
+#define H_HUE_VALIDATE
+
+#include "esp_types.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+/** Bridge IP pattern, IPV4 with every octet zero padded to 3 digits */
+#define HUE_BRIDGE_IP_PATTERN "ddd.ddd.ddd.ddd"
+/** Length of bridge IP without null-terminating character */
+#define HUE_BRIDGE_IP_LENGTH 15
+
+/** Bridge ID pattern with 16 hexadecimal characters */
+#define HUE_BRIDGE_ID_PATTERN "hhhhhhhhhhhhhhhh"
+/** Length of bridge ID without null-terminating character */
+#define HUE_BRIDGE_ID_LENGTH 16
+
+/** Application key pattern with 40 URL Base64 characters */
+#define HUE_APPLICATION_KEY_PATTERN "kkkkkkkkkkkkkkkkkkkkkkkkkkkkkkkkkkkkkkkk"
+/** Length of application key without null-terminating character */
+#define HUE_APPLICATION_KEY_LENGTH 40
+
+/** Client key pattern with 32 hexadecimal characters, the entertainment PSK issued with the application key */
+#define HUE_CLIENT_KEY_PATTERN "hhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhh"
+/** Length of client key without null-terminating character */
+#define HUE_CLIENT_KEY_LENGTH 32
+
+/** Resource ID pattern using hexadecimal characters: "[8 chars]-[4 chars]-[4 chars]-[4 chars]-[12 chars]" */
+#define HUE_RESOURCE_ID_PATTERN "hhhhhhhh-hhhh-hhhh-hhhh-hhhhhhhhhhhh"
+/** Length of resource ID format without null-terminating character */
+#define HUE_RESOURCE_ID_LENGTH 36
+
+/**
+ * Fails compilation unless a string literal is exactly as long as a pattern, e.g.
+ * HUE_VALIDATE_STATIC_LENGTH(CONFIG_HUE_BRIDGE_ID, HUE_BRIDGE_ID_PATTERN);
+ */
+#define HUE_VALIDATE_STATIC_LENGTH(literal, pattern)                                                                   \
+    _Static_assert(sizeof(literal) == sizeof(pattern), #literal " does not match the length of " #pattern)
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Verifies that a string matches a pattern in a single pass, without reading past its null-terminating character
+ *
+ * @param[in] str String to check
+ * @param[in] pattern Pattern as described in hue_validate.h
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – String matches the pattern and has the same length
+ * @retval - @c ESP_ERR_INVALID_ARG – str or pattern are NULL
+ * @retval - @c ESP_FAIL – String does not match the pattern
+ */
+esp_err_t hue_validate_pattern(const char* str, const char* pattern);
+
+/**
+ * @brief Verifies that a bridge IP matches HUE_BRIDGE_IP_PATTERN and every octet is at most 255
+ *
+ * @param[in] bridge_ip Bridge IP to check
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Bridge IP is formatted as expected
+ * @retval - @c ESP_ERR_INVALID_ARG – bridge_ip is NULL
+ * @retval - @c ESP_FAIL – Bridge IP is incorrectly formatted
+ */
+esp_err_t hue_validate_bridge_ip(const char* bridge_ip);
+
+/**
+ * @brief Verifies that a bridge ID matches HUE_BRIDGE_ID_PATTERN
+ *
+ * @param[in] bridge_id Bridge ID to check
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Bridge ID is formatted as expected
+ * @retval - @c ESP_ERR_INVALID_ARG – bridge_id is NULL
+ * @retval - @c ESP_FAIL – Bridge ID is incorrectly formatted
+ */
+esp_err_t hue_validate_bridge_id(const char* bridge_id);
+
+/**
+ * @brief Verifies that an application key matches HUE_APPLICATION_KEY_PATTERN
+ *
+ * @param[in] app_key Application key to check
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Application key is formatted as expected
+ * @retval - @c ESP_ERR_INVALID_ARG – app_key is NULL
+ * @retval - @c ESP_FAIL – Application key is incorrectly formatted
+ */
+esp_err_t hue_validate_app_key(const char* app_key);
+
+/**
+ * @brief Verifies that a client key matches HUE_CLIENT_KEY_PATTERN
+ *
+ * @param[in] client_key Client key to check
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Client key is formatted as expected
+ * @retval - @c ESP_ERR_INVALID_ARG – client_key is NULL
+ * @retval - @c ESP_FAIL – Client key is incorrectly formatted
+ */
+esp_err_t hue_validate_client_key(const char* client_key);
+
+/**
+ * @brief Verifies that a resource ID matches HUE_RESOURCE_ID_PATTERN
+ *
+ * @param[in] resource_id Resource ID to check
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Resource ID is formatted as expected
+ * @retval - @c ESP_ERR_INVALID_ARG – resource_id is NULL
+ * @retval - @c ESP_FAIL – Resource ID is incorrectly formatted
+ */
+esp_err_t hue_validate_resource_id(const char* resource_id);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HUE_VALIDATE */
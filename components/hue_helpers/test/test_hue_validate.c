@@ -0,0 +1,95 @@
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#include "hue_validate.h"
+
+/*======================= Basic NULL testing =======================*/
+TEST_CASE("NULL string", "[hue_helpers][hue_validate][empty]") {
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_validate_pattern(NULL, HUE_BRIDGE_ID_PATTERN));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_validate_bridge_ip(NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_validate_bridge_id(NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_validate_app_key(NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_validate_client_key(NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_validate_resource_id(NULL));
+}
+
+TEST_CASE("NULL pattern", "[hue_helpers][hue_validate][empty]") {
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_validate_pattern("001788fffe4b1e55", NULL));
+}
+
+TEST_CASE("Empty strings", "[hue_helpers][hue_validate][empty]") {
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_ip(""));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_id(""));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_app_key(""));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_client_key(""));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_resource_id(""));
+}
+
+/*======================== Bridge IP testing =======================*/
+TEST_CASE("Bridge IP valid", "[hue_helpers][hue_validate][bridge_ip]") {
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_bridge_ip("192.168.001.002"));
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_bridge_ip("255.255.255.255"));
+}
+
+TEST_CASE("Bridge IP octet over 255", "[hue_helpers][hue_validate][bridge_ip]") {
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_ip("256.168.001.002"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_ip("192.168.001.999"));
+}
+
+TEST_CASE("Bridge IP wrong shape", "[hue_helpers][hue_validate][bridge_ip]") {
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_ip("192.168.1.2"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_ip("192.168.001.0022"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_ip("192.168.001-002"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_ip("+92.168.001.002"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_ip(" 92.168.001.002"));
+}
+
+/*======================== Bridge ID testing =======================*/
+TEST_CASE("Bridge ID valid", "[hue_helpers][hue_validate][bridge_id]") {
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_bridge_id("001788fffe4b1e55"));
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_bridge_id("001788FFFE4B1E55"));
+}
+
+TEST_CASE("Bridge ID invalid", "[hue_helpers][hue_validate][bridge_id]") {
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_id("001788fffe4b1e5"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_id("001788fffe4b1e555"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_id("001788fffe4b1e5g"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_bridge_id("0x1788fffe4b1e55"));
+}
+
+/*===================== Application key testing ====================*/
+TEST_CASE("Application key valid", "[hue_helpers][hue_validate][app_key]") {
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_app_key("aZ09-_aZ09-_aZ09-_aZ09-_aZ09-_aZ09-_aZ09"));
+}
+
+TEST_CASE("Application key invalid", "[hue_helpers][hue_validate][app_key]") {
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_app_key("aZ09-_aZ09-_aZ09-_aZ09-_aZ09-_aZ09-_aZ0"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_app_key("aZ09-_aZ09-_aZ09-_aZ09-_aZ09-_aZ09-_aZ09-"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_app_key("aZ09-_aZ09-_aZ09+_aZ09-_aZ09-_aZ09-_aZ09"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_app_key("aZ09-_aZ09-_aZ09/_aZ09-_aZ09-_aZ09-_aZ09"));
+}
+
+/*======================= Client key testing =======================*/
+TEST_CASE("Client key valid", "[hue_helpers][hue_validate][client_key]") {
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_client_key("0123456789abcdef0123456789ABCDEF"));
+}
+
+TEST_CASE("Client key invalid", "[hue_helpers][hue_validate][client_key]") {
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_client_key("0123456789abcdef0123456789ABCDE"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_client_key("0123456789abcdef0123456789ABCDEF0"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_client_key("0123456789abcdef0123456789ABCDEG"));
+}
+
+/*======================= Resource ID testing ======================*/
+TEST_CASE("Resource ID valid", "[hue_helpers][hue_validate][resource_id]") {
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_resource_id("8c2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f5a6b"));
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_resource_id("8C2E1F6A-3B4D-4E5F-9A0B-1C2D3E4F5A6B"));
+}
+
+TEST_CASE("Resource ID invalid", "[hue_helpers][hue_validate][resource_id]") {
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_resource_id("8c2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f5a6"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_resource_id("8c2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f5a6bb"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_resource_id("8c2e1f6a3b4d-4e5f-9a0b-1c2d3e4f5a6b-"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_resource_id("0x2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f5a6b"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, hue_validate_resource_id("8c2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f5a6\xff"));
+}
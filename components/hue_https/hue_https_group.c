@@ -0,0 +1,420 @@
+/**
+ * @file hue_https_group.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Room and zone membership of a Hue HTTPS instance, and light batches consolidated into grouped light requests
+ *
+ * A batch is planned on resource table indices, so membership is interned once when it is set and a batch only compares
+ * bytes. Rooms and zones are picked greedily by the number of batch lights they add, which is optimal for rooms as
+ * they never share lights and close to it for zones overlapping them. Each is only used while the token buckets say
+ * its grouped light request lets the batch finish no later than its light requests would.
+ */
+
+#include <string.h>
+#include <strings.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "hue_https.h"
+#include "hue_https_private.h"
+#include "hue_helpers.h"
+
+static const char* tag = "hue_https_group";
+
+/* The lights of a batch a room or zone covers are kept as a bit per light */
+_Static_assert(HUE_HTTPS_GROUP_MAX_LIGHTS <= 32, "HUE_HTTPS_GROUP_MAX_LIGHTS must fit in a 32 bit coverage mask");
+
+/** Fewest batch lights a room or zone must add to be sent as a grouped light request, whatever the buckets hold */
+#define HUE_HTTPS_GROUP_MIN_COVERAGE 2
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Token bucket of one resource type as a light batch is planned against it, copied under the instance mutex */
+typedef struct {
+    int64_t full_us;     /**< When the bucket is full again, no earlier than when the batch was planned */
+    int64_t interval_us; /**< Time a token takes to refill at the current send rate, 0 if the type is unpaced */
+    uint8_t burst;       /**< Tokens the bucket holds */
+} hue_https_bucket_plan_t;
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Checks a resource ID is in the format specified by the Philips Hue API
+ *
+ * @param[in] resource_id Resource ID to check
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Resource ID is formatted as expected
+ * @retval - @c ESP_ERR_INVALID_ARG – Resource ID is NULL or not in the correct format
+ */
+static esp_err_t check_resource_id(const char* resource_id);
+
+/**
+ * @brief Checks the light count and every resource ID of a room or zone
+ *
+ * @param[in] p_group Membership to check
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Membership can be interned
+ * @retval - @c ESP_ERR_INVALID_ARG – A resource ID is NULL or not in the correct format, or light_count is out of range
+ */
+static esp_err_t check_group(const hue_https_group_t* p_group);
+
+/**
+ * @brief Returns resource ID n of a room or zone, its grouped light followed by its lights
+ *
+ * @param[in] p_group Room or zone
+ * @param[in] n [0-light_count] Resource ID to return
+ *
+ * @return Resource ID
+ */
+static const char* group_resource_id(const hue_https_group_t* p_group, uint8_t n);
+
+/**
+ * @brief Counts the distinct resource IDs of rooms and zones that are not interned yet
+ *
+ * @param[in] p_groups Memberships already checked by check_group()
+ * @param[in] group_count Number of entries in p_groups
+ *
+ * @return Resource table entries interning the memberships would add
+ */
+static uint16_t count_new_resource_ids(const hue_https_group_t* p_groups, uint8_t group_count);
+
+/**
+ * @brief Interns the resource IDs of a room or zone, dropping duplicate lights
+ *
+ * @param[in] p_group Membership already checked by check_group()
+ * @param[out] p_entry Storage for the interned membership
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Membership interned
+ * @retval - @c ESP_ERR_NO_MEM – Resource table is full
+ * @retval - @c ESP_ERR_TIMEOUT – Failed to acquire resource table mutex within 5 seconds
+ */
+static esp_err_t intern_group(const hue_https_group_t* p_group, hue_https_group_entry_t* p_entry);
+
+/**
+ * @brief Copies the token bucket of a resource type, as hue_https_take_token() will find it
+ *
+ * @param[in] hue_https_handle Instance to copy the bucket of, with request_handle_mutex held
+ * @param[in] resource_type Resource type of the bucket
+ * @param[in] now_us Time the batch is planned at
+ * @param[out] p_bucket Storage for the bucket
+ */
+static void plan_bucket(hue_https_handle_t hue_https_handle, uint8_t resource_type, int64_t now_us,
+                        hue_https_bucket_plan_t* p_bucket);
+
+/**
+ * @brief Returns when the last of several requests sent back to back gets its token
+ *
+ * @param[in] p_bucket Bucket the requests take their tokens from
+ * @param[in] requests Number of requests, 0 for none
+ * @param[in] now_us Time the batch is planned at
+ *
+ * @return Time the last request can be sent, now_us if it can be sent straight away
+ */
+static int64_t token_time(const hue_https_bucket_plan_t* p_bucket, uint8_t requests, int64_t now_us);
+
+/**
+ * @brief Finds which lights of a batch a room or zone covers
+ *
+ * @param[in] p_group Room or zone to check
+ * @param[in] light_indices Distinct lights of the batch
+ * @param[in] light_count Number of entries in light_indices
+ *
+ * @return Bit n set for each light_indices[n] in the room or zone, 0 if any light of the room or zone is not in the
+ * batch as its grouped light would set that light too
+ */
+static uint32_t group_coverage(const hue_https_group_entry_t* p_group, const uint8_t* light_indices,
+                               uint8_t light_count);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t hue_https_set_groups(hue_https_handle_t hue_https_handle, const hue_https_group_t* p_groups,
+                               uint8_t group_count) {
+    if (HUE_NULL_CHECK(tag, hue_https_handle)) return ESP_ERR_INVALID_ARG;
+    if (group_count > HUE_HTTPS_GROUPS_SIZE) {
+        ESP_LOGE(tag, "%u rooms and zones given, at most %d are held", (unsigned)group_count, HUE_HTTPS_GROUPS_SIZE);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (group_count && !p_groups) {
+        ESP_LOGE(tag, "p_groups is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Every entry is checked and the table space counted before any is interned, as interned IDs are never removed
+     * and a membership that fails part way would otherwise use up entries for good */
+    for (uint8_t i = 0; i < group_count; i++) {
+        if (check_group(&p_groups[i]) != ESP_OK) return ESP_ERR_INVALID_ARG;
+    }
+    uint16_t new_count = count_new_resource_ids(p_groups, group_count);
+    if (new_count > hue_https_resource_free_count()) {
+        ESP_LOGE(tag, "Rooms and zones add %u resource IDs, only %u more fit in the resource table",
+                 (unsigned)new_count, (unsigned)hue_https_resource_free_count());
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* Interned before the mutex is taken, so an invalid entry leaves the previous membership in place */
+    hue_https_group_entry_t entries[HUE_HTTPS_GROUPS_SIZE];
+    for (uint8_t i = 0; i < group_count; i++) {
+        esp_err_t err = intern_group(&p_groups[i], &entries[i]);
+        if (err != ESP_OK) return err;
+    }
+
+    if (!xSemaphoreTake(hue_https_handle->request_handle_mutex, pdMS_TO_TICKS(5000))) {
+        ESP_LOGE(tag, "Failed to acquire mutex within 5 seconds, rooms and zones not set");
+        return ESP_ERR_TIMEOUT;
+    }
+    memcpy(hue_https_handle->groups, entries, group_count * sizeof(hue_https_group_entry_t));
+    hue_https_handle->group_count = group_count;
+    xSemaphoreGive(hue_https_handle->request_handle_mutex);
+
+    return ESP_OK;
+}
+
+esp_err_t hue_https_perform_light_batch(hue_https_handle_t hue_https_handle, const char* const* light_ids,
+                                        uint8_t light_count, const hue_light_data_t* p_light_data, bool force_through,
+                                        hue_https_batch_result_t* p_result) {
+    if (HUE_NULL_CHECK(tag, hue_https_handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, light_ids)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_light_data)) return ESP_ERR_INVALID_ARG;
+    if (!light_count || (light_count > HUE_HTTPS_GROUP_MAX_LIGHTS)) {
+        ESP_LOGE(tag, "Light batch of %u lights, must be 1 to %d", (unsigned)light_count, HUE_HTTPS_GROUP_MAX_LIGHTS);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Trigger is taken before any work so the latency of every request of the batch includes planning it */
+    int64_t trigger_time_us = esp_timer_get_time();
+
+    /* Every ID is checked before any is interned, so a malformed one uses up no table entries */
+    for (uint8_t i = 0; i < light_count; i++) {
+        if (check_resource_id(light_ids[i]) != ESP_OK) return ESP_ERR_INVALID_ARG;
+    }
+    uint8_t light_indices[HUE_HTTPS_GROUP_MAX_LIGHTS];
+    uint8_t unique_count = 0;
+    for (uint8_t i = 0; i < light_count; i++) {
+        uint8_t index;
+        esp_err_t err = hue_https_resource_intern(light_ids[i], &index);
+        if (err != ESP_OK) return err;
+        if (!memchr(light_indices, index, unique_count)) light_indices[unique_count++] = index;
+    }
+
+    /* Membership is copied out, as queueing the requests takes the mutex again */
+    hue_https_group_entry_t groups[HUE_HTTPS_GROUPS_SIZE];
+    if (!xSemaphoreTake(hue_https_handle->request_handle_mutex, pdMS_TO_TICKS(5000))) {
+        ESP_LOGE(tag, "Failed to acquire mutex within 5 seconds, light batch not sent");
+        return ESP_ERR_TIMEOUT;
+    }
+    uint8_t group_count = hue_https_handle->group_count;
+    memcpy(groups, hue_https_handle->groups, group_count * sizeof(hue_https_group_entry_t));
+
+    int64_t now_us = esp_timer_get_time();
+    hue_https_bucket_plan_t light_bucket;
+    hue_https_bucket_plan_t grouped_bucket;
+    plan_bucket(hue_https_handle, HUE_HTTPS_RESOURCE_LIGHT, now_us, &light_bucket);
+    plan_bucket(hue_https_handle, HUE_HTTPS_RESOURCE_GROUPED_LIGHT, now_us, &grouped_bucket);
+    xSemaphoreGive(hue_https_handle->request_handle_mutex);
+
+    /* Grouped lights are rendered without effects, so a batch playing one cannot be consolidated */
+    if ((p_light_data->effect != HUE_EFFECT_NONE) || (p_light_data->timed_effect != HUE_TIMED_EFFECT_NONE)) {
+        group_count = 0;
+    }
+
+    /* Grouped light requests go first, each covering lights none picked before it did */
+    uint8_t targets[HUE_HTTPS_GROUP_MAX_LIGHTS];
+    uint8_t target_lights[HUE_HTTPS_GROUP_MAX_LIGHTS];
+    uint8_t grouped_count = 0;
+    uint32_t coverage[HUE_HTTPS_GROUPS_SIZE];
+    for (uint8_t g = 0; g < group_count; g++) {
+        coverage[g] = group_coverage(&groups[g], light_indices, unique_count);
+    }
+    uint32_t covered = 0;
+    uint8_t residual = unique_count;
+    int64_t grouped_done_us = now_us;
+    while (true) {
+        int best = -1;
+        int best_added = HUE_HTTPS_GROUP_MIN_COVERAGE - 1;
+        for (uint8_t g = 0; g < group_count; g++) {
+            int added = __builtin_popcount(coverage[g] & ~covered);
+            if (added > best_added) {
+                best = g;
+                best_added = added;
+            }
+        }
+        if (best < 0) break;
+
+        /* The batch is done once both buckets have given their last token, a grouped light request that would be
+         * sent after its lights could have been one by one is not worth its token. Fewer lights only make that worse */
+        int64_t light_done_us = token_time(&light_bucket, residual, now_us);
+        int64_t without_us = (grouped_done_us > light_done_us) ? grouped_done_us : light_done_us;
+        int64_t grouped_us = token_time(&grouped_bucket, grouped_count + 1, now_us);
+        light_done_us = token_time(&light_bucket, residual - best_added, now_us);
+        int64_t with_us = (grouped_us > light_done_us) ? grouped_us : light_done_us;
+        if (with_us > without_us) break;
+        residual -= best_added;
+        grouped_done_us = grouped_us;
+
+        target_lights[grouped_count] = best_added;
+        targets[grouped_count++] = groups[best].grouped_light_index;
+        covered |= coverage[best];
+        coverage[best] = 0;
+    }
+
+    /* Each grouped light covers at least HUE_HTTPS_GROUP_MIN_COVERAGE lights, so the residual lights fit after them */
+    uint8_t target_count = grouped_count;
+    for (uint8_t i = 0; i < unique_count; i++) {
+        if (!(covered & (1UL << i))) targets[target_count++] = light_indices[i];
+    }
+
+    hue_https_request_instance_t request = {0};
+    hue_https_pack_light_data(&request, p_light_data);
+    esp_err_t err = ESP_OK;
+    uint8_t queued = 0;
+    uint8_t requests_saved = 0;
+    for (; queued < target_count; queued++) {
+        bool grouped = (queued < grouped_count);
+        request.resource_type = grouped ? HUE_HTTPS_RESOURCE_GROUPED_LIGHT : HUE_HTTPS_RESOURCE_LIGHT;
+        request.resource_index = targets[queued];
+
+        /* Only one interactive request can wait, later ones would replace it, so the rest queue as background work */
+        request.priority = queued ? HUE_HTTPS_PRIORITY_BACKGROUND : HUE_HTTPS_PRIORITY_INTERACTIVE;
+        err = hue_https_queue_request(hue_https_handle, &request, force_through, trigger_time_us, 0);
+        if (err != ESP_OK) break;
+        if (grouped) requests_saved += target_lights[queued] - 1;
+    }
+
+    /* Only what was queued is counted, a full background queue leaves the rest of the batch unsent */
+    uint8_t grouped_queued = (queued < grouped_count) ? queued : grouped_count;
+    if (err != ESP_OK) {
+        ESP_LOGE(tag, "Light batch stopped after %u of %u requests", (unsigned)queued, (unsigned)target_count);
+    } else {
+        ESP_LOGD(tag, "Light batch of %u lights sent as %u grouped light and %u light requests",
+                 (unsigned)unique_count, (unsigned)grouped_count, (unsigned)(target_count - grouped_count));
+    }
+    if (requests_saved) {
+        if (xSemaphoreTake(hue_https_handle->request_handle_mutex, pdMS_TO_TICKS(5000))) {
+            hue_https_handle->stats.requests_consolidated += requests_saved;
+            xSemaphoreGive(hue_https_handle->request_handle_mutex);
+        } else {
+            ESP_LOGW(tag, "Failed to acquire mutex within 5 seconds, consolidated requests not counted");
+        }
+    }
+
+    if (p_result) {
+        p_result->lights = unique_count;
+        p_result->grouped_requests = grouped_queued;
+        p_result->light_requests = queued - grouped_queued;
+        p_result->requests_saved = requests_saved;
+    }
+    return err;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static esp_err_t check_resource_id(const char* resource_id) {
+    if (HUE_NULL_CHECK(tag, resource_id)) return ESP_ERR_INVALID_ARG;
+
+    /* Validated like the IDs of single requests, the table only checks the characters it packs */
+    if (hue_validate_resource_id(resource_id) != ESP_OK) {
+        ESP_LOGE(tag, "Resource ID provided is not in the correct format for a resource ID");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t check_group(const hue_https_group_t* p_group) {
+    if (HUE_NULL_CHECK(tag, p_group->light_ids)) return ESP_ERR_INVALID_ARG;
+    if (!p_group->light_count || (p_group->light_count > HUE_HTTPS_GROUP_MAX_LIGHTS)) {
+        ESP_LOGE(tag, "Room or zone of %u lights, must be 1 to %d", (unsigned)p_group->light_count,
+                 HUE_HTTPS_GROUP_MAX_LIGHTS);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (uint8_t n = 0; n <= p_group->light_count; n++) {
+        if (check_resource_id(group_resource_id(p_group, n)) != ESP_OK) return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+static const char* group_resource_id(const hue_https_group_t* p_group, uint8_t n) {
+    return n ? p_group->light_ids[n - 1] : p_group->grouped_light_id;
+}
+
+static uint16_t count_new_resource_ids(const hue_https_group_t* p_groups, uint8_t group_count) {
+    uint16_t new_count = 0;
+
+    for (uint8_t g = 0; g < group_count; g++) {
+        for (uint8_t n = 0; n <= p_groups[g].light_count; n++) {
+            const char* resource_id = group_resource_id(&p_groups[g], n);
+            uint8_t index;
+            if (hue_https_resource_find(resource_id, &index) == ESP_OK) continue;
+
+            /* Checked IDs have their separators in the same places, so equal UUIDs only differ in letter case */
+            bool seen = false;
+            for (uint8_t h = 0; (h <= g) && !seen; h++) {
+                uint8_t end = (h < g) ? p_groups[h].light_count + 1 : n;
+                for (uint8_t m = 0; (m < end) && !seen; m++) {
+                    seen = (strcasecmp(group_resource_id(&p_groups[h], m), resource_id) == 0);
+                }
+            }
+            if (!seen) new_count++;
+        }
+    }
+    return new_count;
+}
+
+static esp_err_t intern_group(const hue_https_group_t* p_group, hue_https_group_entry_t* p_entry) {
+    esp_err_t err = hue_https_resource_intern(p_group->grouped_light_id, &(p_entry->grouped_light_index));
+    if (err != ESP_OK) return err;
+
+    p_entry->light_count = 0;
+    for (uint8_t i = 0; i < p_group->light_count; i++) {
+        uint8_t index;
+        err = hue_https_resource_intern(p_group->light_ids[i], &index);
+        if (err != ESP_OK) return err;
+        if (!memchr(p_entry->light_indices, index, p_entry->light_count)) {
+            p_entry->light_indices[p_entry->light_count++] = index;
+        }
+    }
+
+    return ESP_OK;
+}
+
+static void plan_bucket(hue_https_handle_t hue_https_handle, uint8_t resource_type, int64_t now_us,
+                        hue_https_bucket_plan_t* p_bucket) {
+    /* Paced at the scheduler's own send rate, as hue_https_take_token() does */
+    const hue_https_rate_limit_t* p_rate_limit = &(hue_https_handle->rate_limits[resource_type]);
+    int64_t full_us = hue_https_handle->bucket_full_us[resource_type];
+    p_bucket->full_us = (full_us > now_us) ? full_us : now_us;
+    p_bucket->interval_us = (int64_t)p_rate_limit->interval_ms * 1000 * 100 / hue_https_handle->send_rate_percent;
+    p_bucket->burst = p_rate_limit->burst;
+}
+
+static int64_t token_time(const hue_https_bucket_plan_t* p_bucket, uint8_t requests, int64_t now_us) {
+    if (!requests || !(p_bucket->interval_us)) return now_us;
+
+    /* Request n takes its token once the bucket, n - 1 tokens emptier, is less than burst tokens short of full */
+    int64_t token_us = p_bucket->full_us + ((int64_t)requests - p_bucket->burst) * p_bucket->interval_us;
+    return (token_us > now_us) ? token_us : now_us;
+}
+
+static uint32_t group_coverage(const hue_https_group_entry_t* p_group, const uint8_t* light_indices,
+                               uint8_t light_count) {
+    uint32_t coverage = 0;
+    for (uint8_t i = 0; i < p_group->light_count; i++) {
+        const uint8_t* p_light = memchr(light_indices, p_group->light_indices[i], light_count);
+        if (!p_light) return 0;
+        coverage |= 1UL << (p_light - light_indices);
+    }
+    return coverage;
+}
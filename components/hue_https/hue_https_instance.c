@@ -5,11 +5,17 @@
  * @brief Implementation of all functions relating to the creation of Hue HTTPS instances
  */
 
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "hue_helpers.h"
 #include "hue_https.h"
 #include "hue_https_private.h"
+#include "wifi_connect.h"
 
 static const char* tag = "hue_https_instance";
 
@@ -24,18 +30,147 @@ extern const char hue_signify_root_cert_pem_end[] asm("_binary_hue_signify_root_
  * @brief Function for perfoming current request to be looped in hue_https_send_request() for retrying
  *
  * @param[in,out] https_handle Handle for Hue HTTPS instance to send request under
+ * @param[in] cancel_bits Event bits that abort the request before it is sent, HUE_HTTPS_EVT_EXIT_BIT at least
  *
  * @return ESP Error code
  * @retval - @c ESP_OK – Request successfully performed
- * @retval - @c ESP_FAIL – Request aborted with WiFi disconnection, new request incoming, or Hue HTTPS instance exiting
+ * @retval - @c ESP_FAIL – Request aborted with WiFi disconnection or one of cancel_bits set
  * @retval - @c ESP_ERR_INVALID_STATE – Client handle failed to be created
  * @retval - @c ESP_ERR_INVALID_RESPONSE – Request successfully performed, but response status was not 200 OK
  * @retval - @c ESP_ERR_NOT_FINISHED – Request failed to perform and should be retried
+ * @retval - @c ESP_ERR_NOT_ALLOWED – Bridge answered 429 or 503, the send rate was lowered and the retry is paced by it
+ */
+static esp_err_t hue_https_request_loop(hue_https_handle_t https_handle, EventBits_t cancel_bits);
+
+/**
+ * @brief AIMD send rate controller shared by every request, halving the rate and backing off for the Retry-After of a
+ * throttling response or raising the rate a step after a 200 OK
+ *
+ * @param[in,out] https_handle Handle for Hue HTTPS instance the response was received under
+ * @param[in] throttled If the response was 429 or 503, with its Retry-After in the instance's response
+ */
+static void hue_https_adjust_send_rate(hue_https_handle_t https_handle, bool throttled);
+
+/**
+ * @brief Blocks for a time unless one of the cancel bits is set first
+ *
+ * @param[in] https_handle Handle for Hue HTTPS instance owning the event group
+ * @param[in] wait_us Time to wait
+ * @param[in] cancel_bits Event bits that end the wait
+ *
+ * @return true if cancelled, false once the time has passed
+ */
+static bool hue_https_wait_cancelled(hue_https_handle_t https_handle, int64_t wait_us, EventBits_t cancel_bits);
+
+/**
+ * @brief Creates the instance's keep-alive client with the Hue API headers set, if it does not exist yet
+ *
+ * @param[in,out] https_handle Handle for Hue HTTPS instance to create the client for
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Client exists
+ * @retval - @c ESP_ERR_INVALID_STATE – Client handle failed to be created
+ */
+static esp_err_t hue_https_open_client(hue_https_handle_t https_handle);
+
+/**
+ * @brief Brings the bridge connection in line with the WiFi connected bit, opening and verifying a new connection if
+ * connected and tearing down the existing one otherwise
+ *
+ * @param[in,out] https_handle Handle for Hue HTTPS instance to update the connection of
+ */
+static void hue_https_update_connection(hue_https_handle_t https_handle);
+
+/**
+ * @brief Renders a request and performs it, retrying up to the instance's retry attempts and taking a token from the
+ * request's resource type bucket before every attempt
+ *
+ * @param[in,out] https_handle Handle for Hue HTTPS instance to send request under
+ * @param[in] p_request Request to perform
+ * @param[in] trigger_us Trigger timestamp of the request, the start of its deadline
+ * @param[in] cancel_bits Event bits that end the wait for a token or abort the request before it is sent,
+ * HUE_HTTPS_EVT_EXIT_BIT at least
+ * @param[out] p_start_us Set to the time the first attempt was sent, left untouched if none was, may be NULL
+ *
+ * @return Final result from hue_https_request_loop(), the render error if the request could not be rendered,
+ * ESP_FAIL if the wait for a token was cancelled, or ESP_ERR_TIMEOUT if the deadline passed or would have before the
+ * next attempt
+ */
+static esp_err_t hue_https_perform_with_retries(hue_https_handle_t https_handle,
+                                                const hue_https_request_instance_t* p_request, int64_t trigger_us,
+                                                EventBits_t cancel_bits, int64_t* p_start_us);
+
+/**
+ * @brief Takes a token from a resource type's bucket, blocking until one refills
+ *
+ * @param[in,out] https_handle Handle for Hue HTTPS instance owning the bucket
+ * @param[in] resource_type Resource type of the request about to be sent, as hue_https_resource_t
+ * @param[in] deadline_us Timestamp the request must be sent by, INT64_MAX for none
+ * @param[in] cancel_bits Event bits that end the wait without taking a token
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Token taken
+ * @retval - @c ESP_FAIL – One of cancel_bits was set before a token refilled
+ * @retval - @c ESP_ERR_TIMEOUT – A token would only refill after deadline_us, none was taken
+ */
+static esp_err_t hue_https_take_token(hue_https_handle_t https_handle, uint8_t resource_type, int64_t deadline_us,
+                                      EventBits_t cancel_bits);
+
+/**
+ * @brief Updates instance statistics with the result of the current request, must be called while holding the request
+ * handle mutex
+ *
+ * @param[in,out] https_handle Handle for Hue HTTPS instance the request was sent under
+ * @param[in] err Final result of the request from hue_https_perform_with_retries()
+ */
+static void record_request_result(hue_https_handle_t https_handle, esp_err_t err);
+
+/**
+ * @brief Puts a request into a table of one request per resource, replacing or keeping any entry for the same resource
+ *
+ * @param[in,out] p_table Table to put the request into, in the order requests first arrived for each resource
+ * @param[in,out] p_count Number of entries in p_table
+ * @param[in] size Capacity of p_table
+ * @param[in] p_request Request to put
+ * @param[in] trigger_us Trigger timestamp of the request
+ * @param[in] replace If an entry for the same resource is replaced, false for requests older than any entry
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Request added as a new entry
+ * @retval - @c ESP_ERR_INVALID_STATE – An entry for the same resource exists, replaced if replace is set
+ * @retval - @c ESP_ERR_NO_MEM – Table is full, request not added
+ */
+static esp_err_t hue_https_table_put(hue_https_queued_request_t* p_table, uint8_t* p_count, uint8_t size,
+                                     const hue_https_request_instance_t* p_request, int64_t trigger_us, bool replace);
+
+/**
+ * @brief Moves the next request to run into the current position, an interactive next request before the oldest
+ * background request, must be called while holding the request handle mutex
+ *
+ * @param[in,out] https_handle Handle for Hue HTTPS instance to advance
+ */
+static void hue_https_advance_requests(hue_https_handle_t https_handle);
+
+/**
+ * @brief Sends every request held while WiFi was disconnected, one after another over the pre-warmed connection
+ *
+ * @param[in,out] https_handle Handle for Hue HTTPS instance holding the requests
+ * @param[in] reconnect_us Timestamp WiFi reconnection was handled at, the start of last_converge_us
+ */
+static void hue_https_flush_held_requests(hue_https_handle_t https_handle, int64_t reconnect_us);
+
+/**
+ * @brief Sends interactive requests made while held requests are being sent, dropping the held requests they replace
+ *
+ * @param[in,out] https_handle Handle for Hue HTTPS instance to send requests under
+ * @param[in,out] p_held Held requests not sent yet
+ * @param[in,out] p_held_count Number of entries in p_held
  */
-static esp_err_t hue_https_request_loop(hue_https_handle_t https_handle);
+static void hue_https_send_interactive(hue_https_handle_t https_handle, hue_https_queued_request_t* p_held,
+                                       uint8_t* p_held_count);
 
 /**
- * @brief Performs request pointed to by the current_request_handle
+ * @brief Performs the request copied into current_request
  *
  * @param[in,out] https_handle Handle for Hue HTTPS instance to send request under
  */
@@ -48,6 +183,16 @@ static void hue_https_send_request(hue_https_handle_t https_handle);
  */
 static void hue_https_request_task(void* pvparameters);
 
+/**
+ * @brief Event handler for WIFI_CONNECT_EVENT, as defined by esp_event
+ *
+ * @param[in] arg Hue HTTPS handle the handler was registered for
+ * @param[in] event_base Event base, always WIFI_CONNECT_EVENT
+ * @param[in] event_id Event ID, as wifi_connect_event_t
+ * @param[in] event_data Event data, unused
+ */
+static void hue_https_wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data);
+
 /**
  * @brief Converts HTTP Event ID enum into string representation
  *
@@ -77,19 +222,28 @@ static esp_err_t hue_https_event_handler(esp_http_client_event_t* evt);
  */
 static esp_err_t check_bridge_ip(const char* bridge_ip);
 
+/**
+ * @brief Converts a bridge IP to a host order integer
+ *
+ * @param[in] bridge_ip Zero padded IPV4 address already verified by check_bridge_ip()
+ *
+ * @return Bridge IP as a host order integer
+ */
+static uint32_t parse_bridge_ip(const char* bridge_ip);
+
 /**
  * @brief Creates Hue HTTPS handle's url base with the specified IP address
  *
- * @param[out] hue_https_handle Hue HTTPS handle to print bridge_ip to
- * @param[in] bridge_ip IPV4 address as string to add to Hue HTTPS handle
+ * @param[out] hue_https_handle Hue HTTPS handle to print bridge_ip_addr to
+ * @param[in] bridge_ip_addr IPV4 address as a host order integer, printed in dotted decimal without zero padding
  *
  * @return ESP Error Code
  * @retval - @c ESP_OK – URL base successfully printed to Hue HTTPS handle buffer
- * @retval - @c ESP_ERR_INVALID_ARG – hue_https_handle or bridge_ip is NULL or bridge_ip is not in expected format
+ * @retval - @c ESP_ERR_INVALID_ARG – hue_https_handle is NULL
  * @retval - @c ESP_ERR_INVALID_RESPONSE – Encoding error occurred during printing
  * @retval - @c ESP_ERR_INVALID_SIZE – URL base printed was larger than expected
  */
-static esp_err_t fill_bridge_url_base(hue_https_handle_t hue_https_handle, const char* bridge_ip);
+static esp_err_t fill_bridge_url_base(hue_https_handle_t hue_https_handle, uint32_t bridge_ip_addr);
 
 /**
  * @brief Verifies that the Bridge ID is in the format specified by the Philips Hue API
@@ -106,12 +260,11 @@ static esp_err_t check_bridge_id(const char* bridge_id);
  * @brief Creates Hue HTTPS handle's Bridge ID with the specified Bridge ID
  *
  * @param[out] hue_https_handle Hue HTTPS handle to copy bridge_id to
- * @param[in] bridge_id Bridge ID to copy over to Hue HTTPS handle
+ * @param[in] bridge_id Bridge ID to copy over to Hue HTTPS handle, already verified by check_bridge_id()
  *
  * @return ESP Error Code
  * @retval - @c ESP_OK – Bridge ID successfully copied to Hue HTTPS handle buffer
- * @retval - @c ESP_ERR_INVALID_ARG – hue_https_handle or bridge_id is NULL or bridge_id is not in expected format
- * @retval - @c ESP_ERR_INVALID_RESPONSE – Bridge ID copied failed Bridge ID check
+ * @retval - @c ESP_ERR_INVALID_ARG – hue_https_handle or bridge_id is NULL
  */
 static esp_err_t fill_bridge_id(hue_https_handle_t hue_https_handle, const char* bridge_id);
 
@@ -130,12 +283,11 @@ static esp_err_t check_app_key(const char* app_key);
  * @brief Creates Hue HTTPS handle's Application Key with the specified Application Key
  *
  * @param[out] hue_https_handle Hue HTTPS handle to copy app_key to
- * @param[in] app_key Application Key to copy over to Hue HTTPS handle
+ * @param[in] app_key Application Key to copy over to Hue HTTPS handle, already verified by check_app_key()
  *
  * @return ESP Error Code
  * @retval - @c ESP_OK – Application Key successfully copied to Hue HTTPS handle buffer
- * @retval - @c ESP_ERR_INVALID_ARG – hue_https_handle or app_key is NULL or app_key is not in expected format
- * @retval - @c ESP_ERR_INVALID_RESPONSE – Application Key copied failed Application Key check
+ * @retval - @c ESP_ERR_INVALID_ARG – hue_https_handle or app_key is NULL
  */
 static esp_err_t fill_app_key(hue_https_handle_t hue_https_handle, const char* app_key);
 
@@ -162,6 +314,7 @@ static void free_hue_https_instance(hue_https_handle_t* p_hue_https_handle);
  * @retval - @c ESP_ERR_INVALID_RESPONSE – Encoding error encountered with Bridge URL base sprintf call
  * @retval - @c ESP_ERR_INVALID_SIZE – Bridge IP, ID, or Application Key in p_hue_https_config are not valid
  * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory or to create Event Group or Mutex for Hue HTTPS instance
+ * @retval - @c ESP_ERR_INVALID_STATE – WiFi event handler could not be registered on the default event loop
  */
 static esp_err_t alloc_hue_https_instance(hue_https_handle_t* p_hue_https_handle,
                                           hue_https_config_t* p_hue_https_config);
@@ -177,22 +330,56 @@ esp_err_t hue_https_create_instance(hue_https_handle_t* p_hue_https_handle, hue_
         return ESP_ERR_INVALID_ARG;
     }
     if (HUE_NULL_CHECK(tag, p_hue_https_config)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, p_hue_https_config->bridge_ip)) return ESP_ERR_INVALID_ARG;
     if (HUE_NULL_CHECK(tag, p_hue_https_config->bridge_id)) return ESP_ERR_INVALID_ARG;
     if (HUE_NULL_CHECK(tag, p_hue_https_config->application_key)) return ESP_ERR_INVALID_ARG;
 
-    /* Verify that all config strings are in specified format before continuing */
-    if (check_bridge_ip(p_hue_https_config->bridge_ip) != ESP_OK) return ESP_ERR_INVALID_ARG;
+    /* Verify that all config strings are in specified format before continuing, the bridge IP string is only needed
+     * when the address was not given already parsed */
+    if (!(p_hue_https_config->bridge_ip_addr)) {
+        if (HUE_NULL_CHECK(tag, p_hue_https_config->bridge_ip)) return ESP_ERR_INVALID_ARG;
+        if (check_bridge_ip(p_hue_https_config->bridge_ip) != ESP_OK) return ESP_ERR_INVALID_ARG;
+    }
     if (check_bridge_id(p_hue_https_config->bridge_id) != ESP_OK) return ESP_ERR_INVALID_ARG;
     if (check_app_key(p_hue_https_config->application_key) != ESP_OK) return ESP_ERR_INVALID_ARG;
 
+    /* Placement is checked here, an invalid core would otherwise only fail inside xTaskCreatePinnedToCore() */
+    if (p_hue_https_config->task_placement_set) {
+        if ((p_hue_https_config->task_priority == 0) || (p_hue_https_config->task_priority >= configMAX_PRIORITIES)) {
+            ESP_LOGE(tag, "Task priority %u is not between 1 and %d", p_hue_https_config->task_priority,
+                     configMAX_PRIORITIES - 1);
+            return ESP_ERR_INVALID_ARG;
+        }
+        if ((p_hue_https_config->task_core_id != HUE_HTTPS_TASK_ANY_CORE) &&
+            ((p_hue_https_config->task_core_id < 0) || (p_hue_https_config->task_core_id >= portNUM_PROCESSORS))) {
+            ESP_LOGE(tag, "Task core %d does not exist", p_hue_https_config->task_core_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    /* A bucket that refills must hold at least one token, or no request of its type could ever be sent */
+    if (p_hue_https_config->rate_limits_set) {
+        for (size_t i = 0; i < HUE_HTTPS_RESOURCE_COUNT; i++) {
+            const hue_https_rate_limit_t* p_rate_limit = &(p_hue_https_config->rate_limits[i]);
+            if ((p_rate_limit->interval_ms > 0) && (p_rate_limit->burst == 0)) {
+                ESP_LOGE(tag, "Rate limit for resource type %u has no burst", (unsigned)i);
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+    }
+
     /* Allocate all resources needed for instance and return if an error is encountered */
     esp_err_t err = alloc_hue_https_instance(p_hue_https_handle, p_hue_https_config);
     if (err != ESP_OK) return err;
 
-    /* Create task for main loop and return if an error is encountered */
-    if (xTaskCreate(hue_https_request_task, p_hue_https_config->task_id, 8192, *p_hue_https_handle,
-                    configMAX_PRIORITIES - 5, &((*p_hue_https_handle)->task_handle)) != pdPASS) {
+    /* Create task for main loop, pinned if a placement was given, and return if an error is encountered */
+    UBaseType_t priority = HUE_HTTPS_DEFAULT_TASK_PRIORITY;
+    BaseType_t core_id = tskNO_AFFINITY;
+    if (p_hue_https_config->task_placement_set) {
+        priority = p_hue_https_config->task_priority;
+        if (p_hue_https_config->task_core_id != HUE_HTTPS_TASK_ANY_CORE) core_id = p_hue_https_config->task_core_id;
+    }
+    if (xTaskCreatePinnedToCore(hue_https_request_task, p_hue_https_config->task_id, 8192, *p_hue_https_handle,
+                                priority, &((*p_hue_https_handle)->task_handle), core_id) != pdPASS) {
         ESP_LOGE(tag, "Failed to create Hue HTTPS instance task");
         free_hue_https_instance(p_hue_https_handle);
         return ESP_ERR_NO_MEM;
@@ -204,87 +391,559 @@ esp_err_t hue_https_create_instance(hue_https_handle_t* p_hue_https_handle, hue_
 /* TODO: Instance destroy */
 esp_err_t hue_https_destroy_instance(hue_https_handle_t* p_hue_https_handle) {return ESP_ERR_NOT_FINISHED;}
 
+esp_err_t hue_https_get_stats(hue_https_handle_t hue_https_handle, hue_https_stats_t* p_stats) {
+    if (HUE_NULL_CHECK(tag, hue_https_handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_stats)) return ESP_ERR_INVALID_ARG;
+
+    if (!xSemaphoreTake(hue_https_handle->request_handle_mutex, pdMS_TO_TICKS(5000))) {
+        ESP_LOGE(tag, "Failed to acquire mutex within 5 seconds, statistics not copied");
+        return ESP_ERR_TIMEOUT;
+    }
+    *p_stats = hue_https_handle->stats;
+    xSemaphoreGive(hue_https_handle->request_handle_mutex);
+
+    return ESP_OK;
+}
+
+esp_err_t hue_https_get_queue_footprint(hue_https_handle_t hue_https_handle, size_t* p_bytes) {
+    if (HUE_NULL_CHECK(tag, hue_https_handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_bytes)) return ESP_ERR_INVALID_ARG;
+
+    if (!xSemaphoreTake(hue_https_handle->request_handle_mutex, pdMS_TO_TICKS(5000))) {
+        ESP_LOGE(tag, "Failed to acquire mutex within 5 seconds, queue footprint not measured");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    /* Each request is a single fixed size descriptor copy, JSON only exists in the instance's scratch buffer */
+    size_t queued = 0;
+    if (hue_https_handle->current_pending) queued++;
+    if (hue_https_handle->next_pending) queued++;
+    queued += hue_https_handle->held_count + hue_https_handle->background_count;
+    *p_bytes = queued * sizeof(hue_https_request_instance_t);
+    xSemaphoreGive(hue_https_handle->request_handle_mutex);
+
+    return ESP_OK;
+}
+
+/*====================================================================================================================*/
+/*======================================= Shared Private Function Definitions ========================================*/
+/*====================================================================================================================*/
+
+esp_err_t hue_https_hold_request(hue_https_handle_t https_handle, const hue_https_request_instance_t* p_request,
+                                 int64_t trigger_us, bool replace) {
+    esp_err_t err = hue_https_table_put(https_handle->held, &(https_handle->held_count), HUE_HTTPS_HELD_REQUESTS_SIZE,
+                                        p_request, trigger_us, replace);
+    if (err == ESP_OK) {
+        https_handle->stats.requests_held++;
+    } else if (err == ESP_ERR_INVALID_STATE) {
+        https_handle->stats.requests_coalesced++;
+    } else {
+        ESP_LOGE(tag, "Requests held for %d resources already, request dropped", HUE_HTTPS_HELD_REQUESTS_SIZE);
+        https_handle->stats.requests_failed++;
+    }
+    return err;
+}
+
+esp_err_t hue_https_queue_background_request(hue_https_handle_t https_handle,
+                                             const hue_https_request_instance_t* p_request, int64_t trigger_us,
+                                             bool replace) {
+    esp_err_t err = hue_https_table_put(https_handle->background, &(https_handle->background_count),
+                                        HUE_HTTPS_BACKGROUND_QUEUE_SIZE, p_request, trigger_us, replace);
+    if (err == ESP_ERR_INVALID_STATE) {
+        https_handle->stats.requests_coalesced++;
+    } else if (err == ESP_ERR_NO_MEM) {
+        ESP_LOGE(tag, "Background requests queued for %d resources already, request dropped",
+                 HUE_HTTPS_BACKGROUND_QUEUE_SIZE);
+        https_handle->stats.requests_failed++;
+    }
+    return err;
+}
+
+void hue_https_response_reset(hue_https_response_t* p_response) {
+    p_response->length = 0;
+    p_response->buff[0] = '\0';
+    p_response->retry_after_ms = -1;
+}
+
+void hue_https_response_parse_retry_after(hue_https_response_t* p_response, const char* value) {
+    p_response->retry_after_ms = -1;
+    if (!value) return;
+
+    while (*value == ' ') value++;
+    if ((*value < '0') || (*value > '9')) return;
+
+    /* Saturate rather than overflow, anything past the cap is capped anyway */
+    uint32_t seconds = 0;
+    for (; (*value >= '0') && (*value <= '9'); value++) {
+        if (seconds <= HUE_HTTPS_RETRY_AFTER_MAX_MS / 1000) seconds = seconds * 10 + (*value - '0');
+    }
+    while (*value == ' ') value++;
+    if (*value != '\0') return;
+
+    p_response->retry_after_ms = (seconds < HUE_HTTPS_RETRY_AFTER_MAX_MS / 1000) ? seconds * 1000
+                                                                                 : HUE_HTTPS_RETRY_AFTER_MAX_MS;
+}
+
+void hue_https_response_append(hue_https_response_t* p_response, const char* data, int data_len) {
+    if ((data_len <= 0) || !data) return;
+
+    /* Chunks are sized by data_len rather than null-terminated, copy only what still fits */
+    size_t space = HUE_REQUEST_BUFFER_SIZE - 1 - p_response->length;
+    size_t copy_len = ((size_t)data_len < space) ? (size_t)data_len : space;
+
+    memcpy(&(p_response->buff[p_response->length]), data, copy_len);
+    p_response->length += copy_len;
+    p_response->buff[p_response->length] = '\0';
+}
+
 /*====================================================================================================================*/
 /*=========================================== Private Function Definitions ===========================================*/
 /*====================================================================================================================*/
 
-static esp_err_t hue_https_request_loop(hue_https_handle_t https_handle) {
+static esp_err_t hue_https_request_loop(hue_https_handle_t https_handle, EventBits_t cancel_bits) {
     EventBits_t bits = xEventGroupGetBits(https_handle->handle_evt);
     esp_err_t err = ESP_FAIL;
 
-    /* Return ESP_FAIL if Connected Bit is not set or Abort/Exit Bits are set*/
-    if ((bits ^ HUE_HTTPS_EVT_WIFI_CONNECTED_BIT) & HUE_HTTPS_EVT_ABORT_BIT & HUE_HTTPS_EVT_EXIT_BIT) return ESP_FAIL;
-    esp_http_client_handle_t client = esp_http_client_init(&(https_handle->client_config));
-
-    if (!client) {
-        ESP_LOGE(tag, "Client handle failed to be created");
-        return ESP_ERR_INVALID_STATE;
+    /* Return ESP_FAIL if Connected Bit is not set or any of the cancel bits are set */
+    if (!(bits & HUE_HTTPS_EVT_WIFI_CONNECTED_BIT) || (bits & cancel_bits)) {
+        return ESP_FAIL;
     }
 
-    /* Set headers used by Hue API */
-    esp_http_client_set_header(client, "hue-application-key", https_handle->app_key);
-    esp_http_client_set_header(client, "Content-Type", "application/json");
+    /* Normally the client pre-warmed on connection, only created here if that failed */
+    if ((err = hue_https_open_client(https_handle)) != ESP_OK) return err;
+    esp_http_client_handle_t client = https_handle->client;
+
+    /* Same host as the open connection, so changing the URL keeps it */
+    esp_http_client_set_url(client, https_handle->buff_url);
+    esp_http_client_set_method(client, HTTP_METHOD_PUT);
 
-    /* Add generated actions to request */
-    char* body = https_handle->current_request_handle->request_body;
+    /* Add actions rendered from the request descriptor to request */
+    char* body = https_handle->request_json.buff;
     esp_http_client_set_post_field(client, body, strlen(body));
 
     if ((err = esp_http_client_perform(client)) == ESP_OK) {
+        int status = esp_http_client_get_status_code(client);
+
+        /* Throttling is the bridge asking for fewer requests, not a failure of this one */
+        if ((status == HttpStatus_TooManyRequests) || (status == HttpStatus_ServiceUnavailable)) {
+            ESP_LOGW(tag, "Bridge throttled request with %d, Retry-After %ld ms", status,
+                     (long)https_handle->response.retry_after_ms);
+            hue_https_adjust_send_rate(https_handle, true);
+            return ESP_ERR_NOT_ALLOWED;
+        }
+
         /* If response status code is not 200 OK, log actual status and set for return ESP_ERR_INVALID_RESPONSE */
-        if (esp_http_client_get_status_code(client) != HttpStatus_Ok) {
+        if (status != HttpStatus_Ok) {
             ESP_LOGE(tag, "HTTP response status not 200 OK, recieved %d", esp_http_client_get_status_code(client));
+            ESP_LOGD(tag, "Response body: %s", https_handle->response.buff);
             err = ESP_ERR_INVALID_RESPONSE;
+        } else {
+            hue_https_adjust_send_rate(https_handle, false);
         }
     } else {
         err = ESP_ERR_NOT_FINISHED;
     }
 
-    /* Clean up connection and return ESP_OK, ESP_ERR_INVALID_RESPONSE, or ESP_ERR_NOT_FINISHED */
-    esp_http_client_cleanup(client);
+    /* The connection stays open for the next request, a failed one is reconnected by the client on the next perform */
     return err;
 }
 
+static esp_err_t hue_https_open_client(hue_https_handle_t https_handle) {
+    if (https_handle->client) return ESP_OK;
+
+    if (!(https_handle->client = esp_http_client_init(&(https_handle->client_config)))) {
+        ESP_LOGE(tag, "Client handle failed to be created");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Set headers used by Hue API */
+    esp_http_client_set_header(https_handle->client, "hue-application-key", https_handle->app_key);
+    esp_http_client_set_header(https_handle->client, "Content-Type", "application/json");
+
+    return ESP_OK;
+}
+
+static void hue_https_update_connection(hue_https_handle_t https_handle) {
+    bool connected = xEventGroupGetBits(https_handle->handle_evt) & HUE_HTTPS_EVT_WIFI_CONNECTED_BIT;
+    int64_t reconnect_us = esp_timer_get_time();
+
+    /* Any open connection predates this change and may be dead, so it is dropped either way */
+    if (https_handle->client) {
+        esp_http_client_cleanup(https_handle->client);
+        https_handle->client = NULL;
+    }
+    if (!connected) {
+        ESP_LOGI(tag, "WiFi disconnected, bridge connection closed");
+        return;
+    }
+    if (hue_https_open_client(https_handle) != ESP_OK) return;
+
+    /* Fetching the bridge resource completes the TLS handshake and checks both the certificate and application key */
+    esp_http_client_handle_t client = https_handle->client;
+    memcpy(&(https_handle->buff_url[https_handle->url_res_path_pos]), HUE_PREWARM_RESOURCE,
+           sizeof(HUE_PREWARM_RESOURCE));
+    esp_http_client_set_url(client, https_handle->buff_url);
+    esp_http_client_set_method(client, HTTP_METHOD_GET);
+    esp_http_client_set_post_field(client, NULL, 0);
+
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t err = esp_http_client_perform(client);
+    if ((err == ESP_OK) && (esp_http_client_get_status_code(client) == HttpStatus_Ok)) {
+        ESP_LOGI(tag, "Bridge connection verified in %lld us", esp_timer_get_time() - start_us);
+        if (xSemaphoreTake(https_handle->request_handle_mutex, portMAX_DELAY)) {
+            https_handle->stats.connections_prewarmed++;
+            xSemaphoreGive(https_handle->request_handle_mutex);
+        }
+    } else if (err == ESP_OK) {
+        /* The bridge answered but refused, most likely a 403 for an application key it does not know */
+        ESP_LOGE(tag, "Bridge connection check failed with status %d", esp_http_client_get_status_code(client));
+        ESP_LOGD(tag, "Response body: %s", https_handle->response.buff);
+    } else {
+        ESP_LOGW(tag, "Failed to open bridge connection, first request will retry");
+    }
+
+    hue_https_flush_held_requests(https_handle, reconnect_us);
+}
+
 static void hue_https_send_request(hue_https_handle_t https_handle) {
     if (!https_handle) return;
-    if (!(https_handle->current_request_handle)) return;
-    if (!(https_handle->current_request_handle->resource_path)) return;
-    if (!(https_handle->current_request_handle->request_body)) return;
+    if (!(https_handle->current_pending)) return;
 
     uint8_t url_res_pos = https_handle->url_res_path_pos;
     if ((url_res_pos > HUE_URL_BASE_MAX_LENGTH) || (url_res_pos < HUE_URL_BASE_MIN_LENGTH)) return;
 
-    /* Add resource path to URL */
-    char* res_path = https_handle->current_request_handle->resource_path;
-    strncpy(&(https_handle->buff_url[url_res_pos]), res_path, HUE_URL_BUFFER_SIZE - url_res_pos);
+    /* A forced request aborts this one while it waits for a token, so whichever is sent holds the latest state. A
+     * background request also gives way to any interactive one while it waits, and is queued again */
+    EventBits_t cancel_bits = HUE_HTTPS_EVT_ABORT_BIT | HUE_HTTPS_EVT_EXIT_BIT;
+    bool background = (https_handle->current_request.priority == HUE_HTTPS_PRIORITY_BACKGROUND);
+    if (background) cancel_bits |= HUE_HTTPS_EVT_YIELD_BIT;
+
+    int64_t start_us = 0;
+    esp_err_t err = hue_https_perform_with_retries(https_handle, &(https_handle->current_request),
+                                                   https_handle->current_trigger_us, cancel_bits, &start_us);
+
+    /* Protect request handles with mutex */
+    if (xSemaphoreTake(https_handle->request_handle_mutex, portMAX_DELAY)) {
+        /* Queueing delay ends with the first attempt, however the request ends */
+        if (start_us) {
+            hue_https_class_stats_t* p_class = &(https_handle->stats.classes[https_handle->current_request.priority]);
+            int64_t delay_us = start_us - https_handle->current_trigger_us;
+            p_class->requests_started++;
+            p_class->last_queue_delay_us = delay_us;
+            p_class->total_queue_delay_us += delay_us;
+            if (delay_us > p_class->max_queue_delay_us) p_class->max_queue_delay_us = delay_us;
+        }
+
+        /* A request that failed for lack of WiFi is held, unless a newer one for the same resource already is */
+        EventBits_t bits = xEventGroupGetBits(https_handle->handle_evt);
+        if ((err == ESP_FAIL) && !(bits & HUE_HTTPS_EVT_WIFI_CONNECTED_BIT)) {
+            hue_https_hold_request(https_handle, &(https_handle->current_request), https_handle->current_trigger_us,
+                                   false);
+        } else if ((err == ESP_FAIL) && (bits & (HUE_HTTPS_EVT_ABORT_BIT | HUE_HTTPS_EVT_YIELD_BIT)) && background) {
+            /* Background work still has to be done, it only made way for the interactive request */
+            if (hue_https_queue_background_request(https_handle, &(https_handle->current_request),
+                                                   https_handle->current_trigger_us, false) == ESP_OK) {
+                https_handle->stats.requests_preempted++;
+            }
+        } else if ((err == ESP_FAIL) && (bits & HUE_HTTPS_EVT_ABORT_BIT)) {
+            https_handle->stats.requests_coalesced++;
+        } else {
+            record_request_result(https_handle, err);
+        }
+
+        hue_https_advance_requests(https_handle);
+
+        /* If another request was pending, set the trigger event bit to start the next request */
+        if (https_handle->current_pending) {
+            xEventGroupSetBits(https_handle->handle_evt, HUE_HTTPS_EVT_TRIGGER_BIT);
+        }
+
+        /* Clear abort and yield bits if they were set */
+        xEventGroupClearBits(https_handle->handle_evt, HUE_HTTPS_EVT_ABORT_BIT | HUE_HTTPS_EVT_YIELD_BIT);
+    }
+    xSemaphoreGive(https_handle->request_handle_mutex);
+}
+
+static esp_err_t hue_https_perform_with_retries(hue_https_handle_t https_handle,
+                                                const hue_https_request_instance_t* p_request, int64_t trigger_us,
+                                                EventBits_t cancel_bits, int64_t* p_start_us) {
+    uint8_t url_res_pos = https_handle->url_res_path_pos;
+
+    /* A stale action is worse than none, so one whose deadline passed while it was queued or held is never sent */
+    bool has_deadline = (p_request->ttl_ms != 0);
+    int64_t deadline_us = has_deadline ? trigger_us + (int64_t)p_request->ttl_ms * 1000 : INT64_MAX;
+    if (esp_timer_get_time() >= deadline_us) {
+        ESP_LOGW(tag, "Request deadline passed %lld us ago, request discarded", esp_timer_get_time() - deadline_us);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    /* Render the request body into the scratch buffer and the resource path straight into the URL */
+    esp_err_t err = hue_https_render_request(p_request, &(https_handle->request_json),
+                                             &(https_handle->buff_url[url_res_pos]), HUE_URL_BUFFER_SIZE - url_res_pos);
+    if (err != ESP_OK) {
+        ESP_LOGE(tag, "Failed to render request, request not sent");
+        return err;
+    }
 
-    esp_err_t err;
     uint8_t attempt_num = 0;
+    uint8_t throttled_num = 0;
+
+    /* Retry request perform until ESP_ERR_NOT_FINISHED is not returned or, without a deadline, the max attempts have
+     * been reached. With a deadline only time bounds the retries */
+    while (has_deadline || (attempt_num <= (https_handle->retry_attempts))) {
+        err = hue_https_take_token(https_handle, p_request->resource_type, deadline_us, cancel_bits);
+        if (err != ESP_OK) break;
+        if (p_start_us && (attempt_num == 0) && (throttled_num == 0)) *p_start_us = esp_timer_get_time();
 
-    /* Retry request perform until the max attempts have been reached or until ESP_ERR_NOT_FINISHED is not returned */
-    while (attempt_num <= (https_handle->retry_attempts)) {
-        err = hue_https_request_loop(https_handle);
+        /* Yielding only applies while waiting, a background request that has its token is sent rather than waste it */
+        err = hue_https_request_loop(https_handle, cancel_bits & ~HUE_HTTPS_EVT_YIELD_BIT);
+
+        /* Throttled retries are spaced by the send rate controller rather than a fixed delay and use no attempt */
+        if ((err == ESP_ERR_NOT_ALLOWED) && (has_deadline || (++throttled_num <= HUE_HTTPS_THROTTLE_RETRIES))) continue;
         if (err != ESP_ERR_NOT_FINISHED) break;
         attempt_num++;
-        ESP_LOGI(tag, "Request attempt #%d failed, %s", attempt_num,
-                 (attempt_num <= (https_handle->retry_attempts) ? "retrying" : "max attempts reached"));
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        if (!has_deadline && (attempt_num > (https_handle->retry_attempts))) {
+            ESP_LOGI(tag, "Request attempt #%d failed, max attempts reached", attempt_num);
+            break;
+        }
+        if (esp_timer_get_time() + HUE_HTTPS_RETRY_DELAY_US >= deadline_us) {
+            ESP_LOGW(tag, "Request attempt #%d failed, next attempt would pass the deadline", attempt_num);
+            err = ESP_ERR_TIMEOUT;
+            break;
+        }
+        ESP_LOGI(tag, "Request attempt #%d failed, retrying", attempt_num);
+        vTaskDelay(pdMS_TO_TICKS(HUE_HTTPS_RETRY_DELAY_US / 1000));
     }
 
-    /* Protect request handles with mutex */
+    return err;
+}
+
+static esp_err_t hue_https_take_token(hue_https_handle_t https_handle, uint8_t resource_type, int64_t deadline_us,
+                                      EventBits_t cancel_bits) {
+    int64_t wait_us;
+
+    /* A throttling response holds every type until its Retry-After has passed */
+    while ((wait_us = https_handle->backoff_until_us - esp_timer_get_time()) > 0) {
+        if (https_handle->backoff_until_us > deadline_us) return ESP_ERR_TIMEOUT;
+        if (hue_https_wait_cancelled(https_handle, wait_us, cancel_bits)) return ESP_FAIL;
+    }
+
+    /* Paced types refill slower while the send rate is lowered, unpaced ones only honour Retry-After */
+    int64_t interval_us = (int64_t)https_handle->rate_limits[resource_type].interval_ms * 1000;
+    if (interval_us == 0) return ESP_OK;
+    interval_us = interval_us * 100 / https_handle->send_rate_percent;
+
+    /* A token is free once the bucket is less than burst tokens short of full */
+    int64_t* p_full_us = &(https_handle->bucket_full_us[resource_type]);
+    int64_t slack_us = (https_handle->rate_limits[resource_type].burst - 1) * interval_us;
+    while ((wait_us = *p_full_us - slack_us - esp_timer_get_time()) > 0) {
+        if (*p_full_us - slack_us > deadline_us) return ESP_ERR_TIMEOUT;
+        if (hue_https_wait_cancelled(https_handle, wait_us, cancel_bits)) return ESP_FAIL;
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    int64_t full_us = ((*p_full_us > now_us) ? *p_full_us : now_us) + interval_us;
+
+    /* Only this task writes the buckets, under the mutex as light batches read them to decide what to consolidate */
     if (xSemaphoreTake(https_handle->request_handle_mutex, portMAX_DELAY)) {
-        /* Move next request to current */
-        https_handle->current_request_handle = https_handle->next_request_handle;
-        https_handle->next_request_handle = NULL;
+        *p_full_us = full_us;
+        xSemaphoreGive(https_handle->request_handle_mutex);
+    }
+    return ESP_OK;
+}
 
-        /* If another request was pending, set the trigger event bit to start the next request */
-        if (https_handle->current_request_handle) {
-            xEventGroupSetBits(https_handle->handle_evt, HUE_HTTPS_EVT_TRIGGER_BIT);
+static bool hue_https_wait_cancelled(hue_https_handle_t https_handle, int64_t wait_us, EventBits_t cancel_bits) {
+    TickType_t ticks = pdMS_TO_TICKS((wait_us + 999) / 1000);
+    EventBits_t bits = xEventGroupWaitBits(https_handle->handle_evt, cancel_bits, pdFALSE, pdFALSE,
+                                           (ticks > 0) ? ticks : 1);
+    return bits & cancel_bits;
+}
+
+static void hue_https_adjust_send_rate(hue_https_handle_t https_handle, bool throttled) {
+    uint8_t rate = https_handle->send_rate_percent;
+
+    if (throttled) {
+        /* Multiplicative decrease, and nothing is sent until the bridge says it is ready again */
+        int32_t retry_after_ms = https_handle->response.retry_after_ms;
+        if (retry_after_ms < 0) retry_after_ms = HUE_HTTPS_RETRY_AFTER_DEFAULT_MS;
+        https_handle->backoff_until_us = esp_timer_get_time() + (int64_t)retry_after_ms * 1000;
+        rate = (rate / 2 > HUE_HTTPS_SEND_RATE_MIN_PERCENT) ? rate / 2 : HUE_HTTPS_SEND_RATE_MIN_PERCENT;
+    } else {
+        /* Additive increase back towards the configured rates */
+        if (rate == 100) return;
+        rate = (rate + HUE_HTTPS_SEND_RATE_INCREASE_PERCENT < 100) ? rate + HUE_HTTPS_SEND_RATE_INCREASE_PERCENT : 100;
+    }
+    /* Written under the mutex like the buckets, light batches plan against both */
+    if (xSemaphoreTake(https_handle->request_handle_mutex, portMAX_DELAY)) {
+        https_handle->send_rate_percent = rate;
+        if (throttled) https_handle->stats.responses_throttled++;
+        https_handle->stats.send_rate_percent = rate;
+        xSemaphoreGive(https_handle->request_handle_mutex);
+    }
+}
+
+static esp_err_t hue_https_table_put(hue_https_queued_request_t* p_table, uint8_t* p_count, uint8_t size,
+                                     const hue_https_request_instance_t* p_request, int64_t trigger_us, bool replace) {
+    /* Only the end state matters, so an entry for the same resource is the one to replace */
+    for (uint8_t i = 0; i < *p_count; i++) {
+        hue_https_request_instance_t* p_entry = &(p_table[i].request);
+        if ((p_entry->resource_type != p_request->resource_type) ||
+            (p_entry->resource_index != p_request->resource_index)) {
+            continue;
         }
+        if (replace) {
+            p_table[i].request = *p_request;
+            p_table[i].trigger_us = trigger_us;
+        }
+        return ESP_ERR_INVALID_STATE;
+    }
 
-        /* Clear abort bit if it was set */
-        xEventGroupClearBits(https_handle->handle_evt, HUE_HTTPS_EVT_ABORT_BIT);
+    if (*p_count == size) return ESP_ERR_NO_MEM;
+    p_table[*p_count].request = *p_request;
+    p_table[*p_count].trigger_us = trigger_us;
+    (*p_count)++;
+    return ESP_OK;
+}
+
+static void hue_https_advance_requests(hue_https_handle_t https_handle) {
+    if (https_handle->next_pending) {
+        https_handle->current_request = https_handle->next_request;
+        https_handle->current_trigger_us = https_handle->next_trigger_us;
+        https_handle->current_pending = true;
+        https_handle->next_pending = false;
+    } else if (https_handle->background_count > 0) {
+        /* Background requests go out oldest first, the table is small enough that shifting it down is cheapest */
+        https_handle->current_request = https_handle->background[0].request;
+        https_handle->current_trigger_us = https_handle->background[0].trigger_us;
+        https_handle->current_pending = true;
+        https_handle->background_count--;
+        memmove(&(https_handle->background[0]), &(https_handle->background[1]),
+                https_handle->background_count * sizeof(hue_https_queued_request_t));
+    } else {
+        https_handle->current_pending = false;
+    }
+}
+
+static void hue_https_flush_held_requests(hue_https_handle_t https_handle, int64_t reconnect_us) {
+    hue_https_queued_request_t held[HUE_HTTPS_HELD_REQUESTS_SIZE];
+    uint8_t held_count = 0;
+
+    /* Take every held request at once, background requests made from here on are sent after them */
+    if (xSemaphoreTake(https_handle->request_handle_mutex, portMAX_DELAY)) {
+        held_count = https_handle->held_count;
+        memcpy(held, https_handle->held, held_count * sizeof(hue_https_queued_request_t));
+        https_handle->held_count = 0;
+        xSemaphoreGive(https_handle->request_handle_mutex);
+    }
+    if (held_count == 0) return;
+
+    ESP_LOGI(tag, "WiFi reconnected, sending %u held requests", held_count);
+    uint8_t sent = 0;
+    while (true) {
+        /* Requests made since reconnecting are newer than every held one, an interactive one goes before the rest */
+        uint8_t remaining = held_count - sent;
+        hue_https_send_interactive(https_handle, &(held[sent]), &remaining);
+        held_count = sent + remaining;
+        if (sent == held_count) break;
+
+        /* Only exiting cancels a held request, an abort is meant for the forced request's predecessor */
+        esp_err_t err = hue_https_perform_with_retries(https_handle, &(held[sent].request), held[sent].trigger_us,
+                                                       HUE_HTTPS_EVT_EXIT_BIT, NULL);
+        bool connected = xEventGroupGetBits(https_handle->handle_evt) & HUE_HTTPS_EVT_WIFI_CONNECTED_BIT;
+        if ((err == ESP_FAIL) && !connected) break;
+
+        /* Held requests waited on WiFi rather than the bridge, so they are left out of the latency statistics */
+        if (xSemaphoreTake(https_handle->request_handle_mutex, portMAX_DELAY)) {
+            if (err == ESP_OK) {
+                https_handle->stats.requests_ok++;
+            } else if (err == ESP_ERR_TIMEOUT) {
+                https_handle->stats.requests_expired++;
+            } else {
+                https_handle->stats.requests_failed++;
+            }
+            xSemaphoreGive(https_handle->request_handle_mutex);
+        }
+        sent++;
+    }
+
+    if (sent < held_count) {
+        /* WiFi dropped again, hold whatever was not sent behind anything requested since */
+        if (xSemaphoreTake(https_handle->request_handle_mutex, portMAX_DELAY)) {
+            for (uint8_t i = sent; i < held_count; i++) {
+                hue_https_hold_request(https_handle, &(held[i].request), held[i].trigger_us, false);
+            }
+            xSemaphoreGive(https_handle->request_handle_mutex);
+        }
+        ESP_LOGW(tag, "WiFi disconnected while sending held requests, %u still held", held_count - sent);
+        return;
+    }
+
+    int64_t converge_us = esp_timer_get_time() - reconnect_us;
+    if (xSemaphoreTake(https_handle->request_handle_mutex, portMAX_DELAY)) {
+        https_handle->stats.last_converge_us = converge_us;
+        xSemaphoreGive(https_handle->request_handle_mutex);
+    }
+    ESP_LOGI(tag, "Held requests sent %lld us after reconnecting", converge_us);
+}
+
+static void hue_https_send_interactive(hue_https_handle_t https_handle, hue_https_queued_request_t* p_held,
+                                       uint8_t* p_held_count) {
+    while (true) {
+        bool interactive = false;
+        if (xSemaphoreTake(https_handle->request_handle_mutex, portMAX_DELAY)) {
+            /* A background request in front of an interactive one is queued again as soon as it is sent */
+            hue_https_request_instance_t* p_current = &(https_handle->current_request);
+            interactive = https_handle->current_pending &&
+                          ((p_current->priority == HUE_HTTPS_PRIORITY_INTERACTIVE) || https_handle->next_pending);
+
+            /* Only the end state matters, so a held request for the same resource would only undo this one */
+            if (interactive && (p_current->priority == HUE_HTTPS_PRIORITY_INTERACTIVE)) {
+                uint8_t kept = 0;
+                for (uint8_t i = 0; i < *p_held_count; i++) {
+                    if ((p_held[i].request.resource_type == p_current->resource_type) &&
+                        (p_held[i].request.resource_index == p_current->resource_index)) {
+                        https_handle->stats.requests_coalesced++;
+                        continue;
+                    }
+                    p_held[kept++] = p_held[i];
+                }
+                *p_held_count = kept;
+            }
+            xSemaphoreGive(https_handle->request_handle_mutex);
+        }
+        if (!interactive) return;
+
+        /* Sent here rather than by the task, which is busy flushing, so its trigger is consumed the same way */
+        xEventGroupClearBits(https_handle->handle_evt, HUE_HTTPS_EVT_TRIGGER_BIT);
+        hue_https_send_request(https_handle);
+    }
+}
+
+static void record_request_result(hue_https_handle_t https_handle, esp_err_t err) {
+    hue_https_stats_t* p_stats = &(https_handle->stats);
+
+    if (err == ESP_ERR_TIMEOUT) {
+        p_stats->requests_expired++;
+        return;
+    }
+    if (err != ESP_OK) {
+        p_stats->requests_failed++;
+        return;
+    }
+
+    /* Latency covers everything from the triggering event to the 200 OK, including queueing and retries */
+    int64_t latency = esp_timer_get_time() - https_handle->current_trigger_us;
+    p_stats->requests_ok++;
+    p_stats->last_latency_us = latency;
+    p_stats->total_latency_us += latency;
+    if (latency > p_stats->max_latency_us) p_stats->max_latency_us = latency;
+
+    if (latency > HUE_HTTPS_LATENCY_TARGET_US) {
+        p_stats->latency_over_target++;
+        ESP_LOGW(tag, "Request completed in %lld us, over latency target", latency);
+    } else {
+        ESP_LOGD(tag, "Request completed in %lld us", latency);
     }
-    xSemaphoreGive(https_handle->request_handle_mutex);
 }
 
 static void hue_https_request_task(void* pvparameters) {
@@ -296,13 +955,40 @@ static void hue_https_request_task(void* pvparameters) {
     while (true) {
         bits = xEventGroupWaitBits(https_handle->handle_evt, HUE_HTTPS_EVT_WAIT_BITS, pdFALSE, pdFALSE, portMAX_DELAY);
         if (bits & HUE_HTTPS_EVT_EXIT_BIT) break;
-        if (!(bits & (HUE_HTTPS_EVT_WIFI_CONNECTED_BIT | HUE_HTTPS_EVT_TRIGGER_BIT))) continue;
+
+        /* Connection changes go first so a request triggered alongside a connection uses the pre-warmed connection */
+        if (bits & HUE_HTTPS_EVT_LINK_CHANGED_BIT) {
+            xEventGroupClearBits(https_handle->handle_evt, HUE_HTTPS_EVT_LINK_CHANGED_BIT);
+            hue_https_update_connection(https_handle);
+        }
+        if (!(bits & HUE_HTTPS_EVT_TRIGGER_BIT)) continue;
+
+        /* Consume the trigger so the task blocks once idle, hue_https_send_request() sets it again if one is pending */
+        xEventGroupClearBits(https_handle->handle_evt, HUE_HTTPS_EVT_TRIGGER_BIT);
         hue_https_send_request(https_handle);
     }
 
     vTaskDelete(NULL);
 }
 
+static void hue_https_wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data) {
+    hue_https_handle_t https_handle = (hue_https_handle_t)arg;
+
+    /* Only the bits are updated here, the instance task owns the client and opens or closes the connection itself */
+    switch (event_id) {
+        case WIFI_CONNECT_EVENT_CONNECTED:
+            xEventGroupSetBits(https_handle->handle_evt,
+                               HUE_HTTPS_EVT_WIFI_CONNECTED_BIT | HUE_HTTPS_EVT_LINK_CHANGED_BIT);
+            break;
+        case WIFI_CONNECT_EVENT_DISCONNECTED:
+            xEventGroupClearBits(https_handle->handle_evt, HUE_HTTPS_EVT_WIFI_CONNECTED_BIT);
+            xEventGroupSetBits(https_handle->handle_evt, HUE_HTTPS_EVT_LINK_CHANGED_BIT);
+            break;
+        default:
+            break;
+    }
+}
+
 static const char* http_event_id_to_str(esp_http_client_event_id_t id) {
     switch (id) {
         case HTTP_EVENT_ERROR:
@@ -327,33 +1013,27 @@ static const char* http_event_id_to_str(esp_http_client_event_id_t id) {
 }
 
 static esp_err_t hue_https_event_handler(esp_http_client_event_t* evt) {
-    static size_t chars_output = 0; /* Number of characters output to buffer */
-
     switch (evt->event_id) {
+        case HTTP_EVENT_HEADERS_SENT: /* New request sent, clear the previous response */
+            ESP_LOGD(tag, "HTTP Event HTTP_EVENT_HEADERS_SENT");
+            if (evt->user_data) hue_https_response_reset(evt->user_data);
+            break;
         case HTTP_EVENT_ON_HEADER: /* Header recieved from server */
             ESP_LOGD(tag, "HTTP Event HTTP_EVENT_ON_HEADER, %s: %s", evt->header_key, evt->header_value);
+            if (evt->user_data && evt->header_key && (strcasecmp(evt->header_key, "Retry-After") == 0)) {
+                hue_https_response_parse_retry_after(evt->user_data, evt->header_value);
+            }
             break;
         case HTTP_EVENT_ON_DATA: /* Data recieved from server */
-            ESP_LOGD(tag, "HTTP Event HTTP_EVENT_ON_DATA\n\tData length = %d\n\t%.*s", evt->data_len, evt->data_len - 2,
+            ESP_LOGD(tag, "HTTP Event HTTP_EVENT_ON_DATA\n\tData length = %d\n\t%.*s", evt->data_len, evt->data_len,
                      (char*)evt->data);
-            if (!evt->user_data) break;
-
-            /* If no data has been output, clear output buffer */
-            if (chars_output == 0) memset(evt->user_data, 0, HUE_REQUEST_BUFFER_SIZE);
-
-            /* Append output data to buffer, ensuring data cannot overflow the buffer */
-            if ((HUE_REQUEST_BUFFER_SIZE - 1 - chars_output) > 0) {
-                strncat(evt->user_data, evt->data, HUE_REQUEST_BUFFER_SIZE - 1 - chars_output);
-                chars_output = strlen(evt->user_data); /* Update the number of characters output */
-            }
+            if (evt->user_data) hue_https_response_append(evt->user_data, evt->data, evt->data_len);
             break;
         case HTTP_EVENT_DISCONNECTED: /* Connection has been disconnected */
             ESP_LOGD(tag, "HTTP Event HTTP_EVENT_DISCONNECTED");
-            chars_output = 0; /* Reset for allowing buffer to clear and for proper data appending to buffer */
             break;
         case HTTP_EVENT_ON_FINISH: /* HTTP session finished */
             ESP_LOGD(tag, "HTTP Event HTTP_EVENT_ON_FINISH");
-            chars_output = 0; /* Reset for allowing buffer to clear and for proper data appending to buffer */
             break;
         default:
             /* Log event ID for debug */
@@ -364,38 +1044,40 @@ static esp_err_t hue_https_event_handler(esp_http_client_event_t* evt) {
 }
 
 static esp_err_t check_bridge_ip(const char* bridge_ip) {
-    if (strlen(bridge_ip) != HUE_BRIDGE_IP_LENGTH) {
-        ESP_LOGE(tag, "Bridge IP provided is not the correct length for an IPV4 address");
+    /* Single table-driven pass over the string, stopping at its null-terminating character */
+    if (hue_validate_bridge_ip(bridge_ip) != ESP_OK) {
+        ESP_LOGE(tag, "Bridge IP provided is not in the correct format for an IPV4 address");
         return ESP_FAIL;
     }
 
-    /* Storage for the number of correctly formatted characters scanned */
-    int chars_received = 0;
+    /* Bridge IP passed the check */
+    return ESP_OK;
+}
 
-    /* Scans the Bridge IP against the specified format, storing the number of characters scanned */
-    sscanf(bridge_ip, HUE_BRIDGE_IP_FORMAT "%n", &chars_received);
+static uint32_t parse_bridge_ip(const char* bridge_ip) {
+    uint32_t bridge_ip_addr = 0;
 
-    /* All characters should match the specified format */
-    if (chars_received != HUE_BRIDGE_IP_LENGTH) {
-        ESP_LOGE(tag, "Bridge IP provided is not in the correct format for an IPV4 address");
-        return ESP_FAIL;
+    /* Every octet is 3 digits followed by '.' or the end */
+    for (uint8_t octet = 0; octet < 4; octet++) {
+        const char* p_octet = &(bridge_ip[octet * 4]);
+        uint32_t value = (p_octet[0] - '0') * 100 + (p_octet[1] - '0') * 10 + (p_octet[2] - '0');
+        bridge_ip_addr = (bridge_ip_addr << 8) | value;
     }
 
-    /* Bridge IP passed the check */
-    return ESP_OK;
+    return bridge_ip_addr;
 }
 
-static esp_err_t fill_bridge_url_base(hue_https_handle_t hue_https_handle, const char* bridge_ip) {
+static esp_err_t fill_bridge_url_base(hue_https_handle_t hue_https_handle, uint32_t bridge_ip_addr) {
     if (HUE_NULL_CHECK(tag, hue_https_handle)) return ESP_ERR_INVALID_ARG;
 
-    /* Redundant checking to ensure string has not been modified before copying */
-    if (check_bridge_ip(bridge_ip) != ESP_OK) return ESP_ERR_INVALID_ARG;
-
     /* Ensure that buffer is clear */
     memset(hue_https_handle->buff_url, 0, HUE_URL_BUFFER_SIZE);
 
-    /* Print URL base using set IP address */
-    esp_err_t err = snprintf(hue_https_handle->buff_url, HUE_URL_BASE_SIZE, "https://%s" HUE_RESOURCE_PATH, bridge_ip);
+    /* Print URL base using set IP address, without zero padding since lwIP reads an octet with a leading zero as
+     * octal */
+    esp_err_t err = snprintf(hue_https_handle->buff_url, HUE_URL_BASE_SIZE, "https://%u.%u.%u.%u" HUE_RESOURCE_PATH,
+                             (unsigned)((bridge_ip_addr >> 24) & 0xFF), (unsigned)((bridge_ip_addr >> 16) & 0xFF),
+                             (unsigned)((bridge_ip_addr >> 8) & 0xFF), (unsigned)(bridge_ip_addr & 0xFF));
 
     /* Verify that URL base is within expected length */
     if (err < 0) {
@@ -414,19 +1096,8 @@ static esp_err_t fill_bridge_url_base(hue_https_handle_t hue_https_handle, const
 }
 
 static esp_err_t check_bridge_id(const char* bridge_id) {
-    if (strlen(bridge_id) != HUE_BRIDGE_ID_LENGTH) {
-        ESP_LOGE(tag, "Bridge ID provided is not the correct length for a Bridge ID");
-        return ESP_FAIL;
-    }
-
-    /* Storage for the number of correctly formatted characters scanned */
-    int chars_received = 0;
-
-    /* Scans the Bridge ID against the specified format, storing the number of characters scanned */
-    sscanf(bridge_id, HUE_BRIDGE_ID_FORMAT "%n", &chars_received);
-
-    /* All characters should match the specified format */
-    if (chars_received != HUE_BRIDGE_ID_LENGTH) {
+    /* Single table-driven pass over the string, stopping at its null-terminating character */
+    if (hue_validate_bridge_id(bridge_id) != ESP_OK) {
         ESP_LOGE(tag, "Bridge ID provided is not in the correct format for a Bridge ID");
         return ESP_FAIL;
     }
@@ -437,33 +1108,18 @@ static esp_err_t check_bridge_id(const char* bridge_id) {
 
 static esp_err_t fill_bridge_id(hue_https_handle_t hue_https_handle, const char* bridge_id) {
     if (HUE_NULL_CHECK(tag, hue_https_handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, bridge_id)) return ESP_ERR_INVALID_ARG;
 
-    /* Redundant checking to ensure string has not been modified before copying */
-    if (check_bridge_id(bridge_id) != ESP_OK) return ESP_ERR_INVALID_ARG;
-
-    /* Copy set Bridge ID to instance buffer */
-    strncpy(hue_https_handle->bridge_id, bridge_id, HUE_BRIDGE_ID_LENGTH);
-
-    /* Verify that copied Bridge ID is of the expected format */
-    if (check_bridge_id(hue_https_handle->bridge_id) != ESP_OK) return ESP_ERR_INVALID_RESPONSE;
+    /* Copy set Bridge ID to instance buffer, its exact length is known from check_bridge_id() */
+    memcpy(hue_https_handle->bridge_id, bridge_id, HUE_BRIDGE_ID_LENGTH);
+    hue_https_handle->bridge_id[HUE_BRIDGE_ID_LENGTH] = '\0';
 
     return ESP_OK;
 }
 
 static esp_err_t check_app_key(const char* app_key) {
-    if (strlen(app_key) != HUE_APPLICATION_KEY_LENGTH) {
-        ESP_LOGE(tag, "Application Key provided is not the correct length for an Application Key");
-        return ESP_FAIL;
-    }
-
-    /* Storage for the number of correctly formatted characters scanned */
-    int chars_received = 0;
-
-    /* Scans the Application Key against the specified format, storing the number of characters scanned */
-    sscanf(app_key, HUE_APPLICATION_KEY_FORMAT "%n", &chars_received);
-
-    /* All characters should match the specified format */
-    if (chars_received != HUE_APPLICATION_KEY_LENGTH) {
+    /* Single table-driven pass over the string, stopping at its null-terminating character */
+    if (hue_validate_app_key(app_key) != ESP_OK) {
         ESP_LOGE(tag, "Application Key provided is not in the correct format for an Application Key");
         return ESP_FAIL;
     }
@@ -474,15 +1130,11 @@ static esp_err_t check_app_key(const char* app_key) {
 
 static esp_err_t fill_app_key(hue_https_handle_t hue_https_handle, const char* app_key) {
     if (HUE_NULL_CHECK(tag, hue_https_handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, app_key)) return ESP_ERR_INVALID_ARG;
 
-    /* Redundant checking to ensure string has not been modified before copying */
-    if (check_app_key(app_key) != ESP_OK) return ESP_ERR_INVALID_ARG;
-
-    /* Copy set Application Key to instance buffer */
-    strncpy(hue_https_handle->app_key, app_key, HUE_APPLICATION_KEY_LENGTH);
-
-    /* Verify that copied Application Key is of the expected format */
-    if (check_app_key(hue_https_handle->app_key) != ESP_OK) return ESP_ERR_INVALID_RESPONSE;
+    /* Copy set Application Key to instance buffer, its exact length is known from check_app_key() */
+    memcpy(hue_https_handle->app_key, app_key, HUE_APPLICATION_KEY_LENGTH);
+    hue_https_handle->app_key[HUE_APPLICATION_KEY_LENGTH] = '\0';
 
     return ESP_OK;
 }
@@ -492,8 +1144,13 @@ static void free_hue_https_instance(hue_https_handle_t* p_hue_https_handle) {
     if (!p_hue_https_handle) return;
     if (!(*p_hue_https_handle)) return;
 
-    /* Free any resources that are allocated */
+    /* Free any resources that are allocated, the WiFi handler first so it cannot set bits in a deleted event group */
+    if ((*p_hue_https_handle)->wifi_handler) {
+        esp_event_handler_instance_unregister(WIFI_CONNECT_EVENT, ESP_EVENT_ANY_ID,
+                                              (*p_hue_https_handle)->wifi_handler);
+    }
     if ((*p_hue_https_handle)->task_handle) vTaskDelete((*p_hue_https_handle)->task_handle);
+    if ((*p_hue_https_handle)->client) esp_http_client_cleanup((*p_hue_https_handle)->client);
     if ((*p_hue_https_handle)->handle_evt) vEventGroupDelete((*p_hue_https_handle)->handle_evt);
     if ((*p_hue_https_handle)->request_handle_mutex) vSemaphoreDelete((*p_hue_https_handle)->request_handle_mutex);
 
@@ -509,8 +1166,8 @@ static esp_err_t alloc_hue_https_instance(hue_https_handle_t* p_hue_https_handle
     if (HUE_NULL_CHECK(tag, p_hue_https_handle)) return ESP_ERR_INVALID_ARG;
     if (HUE_NULL_CHECK(tag, p_hue_https_config)) return ESP_ERR_INVALID_ARG;
 
-    /* Allocate memory for the Hue HTTPS instance and set handle value to the instance pointer */
-    (*p_hue_https_handle) = malloc(sizeof(hue_https_instance_t));
+    /* Allocate zeroed memory for the Hue HTTPS instance, so free_hue_https_instance() only frees what was created */
+    (*p_hue_https_handle) = calloc(1, sizeof(hue_https_instance_t));
     if (!(*p_hue_https_handle)) {
         ESP_LOGE(tag, "Failed to allocate memory for Hue HTTPS instance");
         return ESP_ERR_NO_MEM;
@@ -519,7 +1176,9 @@ static esp_err_t alloc_hue_https_instance(hue_https_handle_t* p_hue_https_handle
     esp_err_t err;
 
     /* Fill buff_url with URL base and set url_resource_path pointer, returning if error encountered */
-    if ((err = fill_bridge_url_base(*p_hue_https_handle, p_hue_https_config->bridge_ip)) != ESP_OK) {
+    uint32_t bridge_ip_addr = p_hue_https_config->bridge_ip_addr;
+    if (!bridge_ip_addr) bridge_ip_addr = parse_bridge_ip(p_hue_https_config->bridge_ip);
+    if ((err = fill_bridge_url_base(*p_hue_https_handle, bridge_ip_addr)) != ESP_OK) {
         free_hue_https_instance(p_hue_https_handle);
         return err;
     }
@@ -549,19 +1208,54 @@ static esp_err_t alloc_hue_https_instance(hue_https_handle_t* p_hue_https_handle
     }
 
     /* Set all undefined pointers to NULL */
-    (*p_hue_https_handle)->current_request_handle = NULL;
-    (*p_hue_https_handle)->next_request_handle = NULL;
+    (*p_hue_https_handle)->current_pending = false;
+    (*p_hue_https_handle)->next_pending = false;
     (*p_hue_https_handle)->task_handle = NULL;
 
-    /* Set up HTTP Client Config */
+    /* Clear request timestamps and statistics */
+    (*p_hue_https_handle)->current_trigger_us = 0;
+    (*p_hue_https_handle)->next_trigger_us = 0;
+    memset(&((*p_hue_https_handle)->stats), 0, sizeof(hue_https_stats_t));
+    hue_https_response_reset(&((*p_hue_https_handle)->response));
+
+    /* Set up HTTP Client Config, clearing all options not set here to their defaults */
+    memset(&((*p_hue_https_handle)->client_config), 0, sizeof(esp_http_client_config_t));
     (*p_hue_https_handle)->client_config.url = (*p_hue_https_handle)->buff_url;
     (*p_hue_https_handle)->client_config.cert_pem = hue_signify_root_cert_pem_start;     /* CA Cert for TLS */
     (*p_hue_https_handle)->client_config.common_name = (*p_hue_https_handle)->bridge_id; /* CN for TLS verification */
     (*p_hue_https_handle)->client_config.event_handler = hue_https_event_handler;
+    (*p_hue_https_handle)->client_config.user_data = &((*p_hue_https_handle)->response); /* Response body storage */
     (*p_hue_https_handle)->client_config.timeout_ms = 5000;        /* Max time to attempt request before failing */
-    (*p_hue_https_handle)->client_config.method = HTTP_METHOD_PUT; /* Currently only PUT requests implemented */
+    (*p_hue_https_handle)->client_config.method = HTTP_METHOD_PUT; /* Set per request, GET only to pre-warm */
+    (*p_hue_https_handle)->client_config.keep_alive_enable = true; /* Probe the idle connection kept between requests */
 
     (*p_hue_https_handle)->retry_attempts = p_hue_https_config->retry_attempts;
+    (*p_hue_https_handle)->preempt_background = p_hue_https_config->preempt_background;
+
+    /* Buckets start full, bucket_full_us and backoff_until_us are already zeroed */
+    (*p_hue_https_handle)->send_rate_percent = 100;
+    (*p_hue_https_handle)->stats.send_rate_percent = 100;
+    if (p_hue_https_config->rate_limits_set) {
+        memcpy((*p_hue_https_handle)->rate_limits, p_hue_https_config->rate_limits,
+               sizeof((*p_hue_https_handle)->rate_limits));
+    } else {
+        static const hue_https_rate_limit_t default_rate_limits[HUE_HTTPS_RESOURCE_COUNT] = {
+            [HUE_HTTPS_RESOURCE_LIGHT] = HUE_HTTPS_RATE_LIMIT_LIGHT,
+            [HUE_HTTPS_RESOURCE_GROUPED_LIGHT] = HUE_HTTPS_RATE_LIMIT_GROUPED_LIGHT,
+            [HUE_HTTPS_RESOURCE_SMART_SCENE] = HUE_HTTPS_RATE_LIMIT_SMART_SCENE,
+            [HUE_HTTPS_RESOURCE_SCENE] = HUE_HTTPS_RATE_LIMIT_SCENE,
+        };
+        memcpy((*p_hue_https_handle)->rate_limits, default_rate_limits, sizeof(default_rate_limits));
+    }
+
+    /* Follow WiFi connection to open and close the bridge connection, WiFi connecting later sets the connected bit */
+    if ((err = esp_event_handler_instance_register(WIFI_CONNECT_EVENT, ESP_EVENT_ANY_ID, hue_https_wifi_event_handler,
+                                                   *p_hue_https_handle, &((*p_hue_https_handle)->wifi_handler))) !=
+        ESP_OK) {
+        ESP_LOGE(tag, "Failed to register WiFi event handler, %s", esp_err_to_name(err));
+        free_hue_https_instance(p_hue_https_handle);
+        return err;
+    }
 
     return ESP_OK;
 }
\ No newline at end of file
@@ -5,7 +5,10 @@
  * @brief Implementation for all functions related to the creation of Hue HTTPS request instances
  */
 
+#include <string.h>
+
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "hue_https.h"
 #include "hue_https_private.h"
@@ -39,50 +42,20 @@ static esp_err_t check_resource_id(const char* resource_id);
 static void free_request_instance(hue_https_request_handle_t* p_request_handle);
 
 /**
- * @brief Allocates memory for the body of the HTTP request based on the size of the JSON in the buffer and copies over
- * the JSON from the buffer
- *
- * @param[in,out] request_handle Handle for the request instance to create the body for
- * @param[in] p_json_buffer JSON buffer filled by hue_json_builder from hue data structure
- *
- * @return ESP Error code
- * @retval - @c ESP_OK – Request body successfully allocated and filled
- * @retval - @c ESP_ERR_INVALID_ARG – request_handle, p_json_buffer, or p_json_buffer's internal buffer are NULL
- * @retval - @c ESP_ERR_INVALID_SIZE – Data in p_json_buffer is empty/out of buffer range or JSON did not copy correctly
- * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory for request body
- */
-static esp_err_t alloc_request_body(hue_https_request_handle_t request_handle, hue_json_buffer_t* p_json_buffer);
-
-/**
- * @brief Allocates memory for the resource path of the HTTP request URL based on the size of the resource type and ID
- * strings stored in p_json_buffer
- *
- * @param[in,out] request_handle Handle for the request instance to create the resource path for
- * @param[in] p_json_buffer JSON buffer filled by hue_json_builder from hue data structure
- *
- * @return ESP Error code
- * @retval - @c ESP_OK – Resource path successfully allocated and filled
- * @retval - @c ESP_ERR_INVALID_ARG – request_handle, p_json_buffer, or resource type/ID from p_json_buffer are NULL
- * @retval - @c ESP_ERR_INVALID_SIZE – Resource type/ID strings are of unexpected length or resource path print failed
- * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory for resource
- */
-static esp_err_t alloc_resource_path(hue_https_request_handle_t request_handle, hue_json_buffer_t* p_json_buffer);
-
-/**
- * @brief Allocates all memory for request instance and fills the request body and resource path buffers with data from
- * p_json_buffer
+ * @brief Allocates a request descriptor for a resource, with every action cleared
  *
  * @param[out] p_request_handle Request handle to store instance into to be used with hue https instance
- * @param[in] p_json_buffer JSON generated by hue_json_builder using hue data structure
+ * @param[in] resource_type Resource type the request targets
+ * @param[in] resource_id Resource ID already verified by check_resource_id()
  *
  * @return ESP Error code
- * @retval - @c ESP_OK – Request instance successfully allocated and filled
- * @retval - @c ESP_ERR_INVALID_ARG – p_request_handle, p_json_buffer, or p_json_buffer's internal pointers are NULL
- * @retval - @c ESP_ERR_INVALID_SIZE – Data in p_json_buffer is out of expected bounds or request instance buffers
- * failed to be copied to
- * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory for request instance
+ * @retval - @c ESP_OK – Request instance successfully allocated
+ * @retval - @c ESP_ERR_INVALID_ARG – p_request_handle or resource_id are NULL or resource_id failed to parse
+ * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory for request instance or the resource table is full
  */
-static esp_err_t alloc_request_instance(hue_https_request_handle_t* p_request_handle, hue_json_buffer_t* p_json_buffer);
+static esp_err_t alloc_request_instance(hue_https_request_handle_t* p_request_handle,
+                                        hue_https_resource_t resource_type, const char* resource_id);
+
 
 /*====================================================================================================================*/
 /*=========================================== Public Function Definitions ============================================*/
@@ -100,13 +73,12 @@ esp_err_t hue_https_create_light_request(hue_https_request_handle_t* p_request_h
     /* Verify that resource ID given is in the correct format */
     if (check_resource_id(p_light_data->resource_id) != ESP_OK) return ESP_ERR_INVALID_ARG;
 
-    /* Generate JSON from p_light_data */
-    hue_json_buffer_t json_buffer;
-    esp_err_t err = hue_light_data_to_json(&json_buffer, p_light_data);
+    /* Only the packed actions are stored, JSON is rendered by the Hue HTTPS instance when the request is sent */
+    esp_err_t err = alloc_request_instance(p_request_handle, HUE_HTTPS_RESOURCE_LIGHT, p_light_data->resource_id);
     if (err != ESP_OK) return err;
 
-    /* Allocate and fill request instance */
-    return alloc_request_instance(p_request_handle, &json_buffer);
+    hue_https_pack_light_data(*p_request_handle, p_light_data);
+    return ESP_OK;
 }
 
 esp_err_t hue_https_create_grouped_light_request(hue_https_request_handle_t* p_request_handle,
@@ -122,13 +94,13 @@ esp_err_t hue_https_create_grouped_light_request(hue_https_request_handle_t* p_r
     /* Verify that resource ID given is in the correct format */
     if (check_resource_id(p_grouped_light_data->resource_id) != ESP_OK) return ESP_ERR_INVALID_ARG;
 
-    /* Generate JSON from p_grouped_light_data */
-    hue_json_buffer_t json_buffer;
-    esp_err_t err = hue_grouped_light_data_to_json(&json_buffer, p_grouped_light_data);
+    /* Only the packed actions are stored, JSON is rendered by the Hue HTTPS instance when the request is sent */
+    esp_err_t err = alloc_request_instance(p_request_handle, HUE_HTTPS_RESOURCE_GROUPED_LIGHT,
+                                           p_grouped_light_data->resource_id);
     if (err != ESP_OK) return err;
 
-    /* Allocate and fill request instance */
-    return alloc_request_instance(p_request_handle, &json_buffer);
+    hue_https_pack_light_data(*p_request_handle, p_grouped_light_data);
+    return ESP_OK;
 }
 
 esp_err_t hue_https_create_smart_scene_request(hue_https_request_handle_t* p_request_handle,
@@ -144,46 +116,276 @@ esp_err_t hue_https_create_smart_scene_request(hue_https_request_handle_t* p_req
     /* Verify that resource ID given is in the correct format */
     if (check_resource_id(p_smart_scene_data->resource_id) != ESP_OK) return ESP_ERR_INVALID_ARG;
 
-    /* Generate JSON from p_smart_scene_data */
-    hue_json_buffer_t json_buffer;
-    esp_err_t err = hue_smart_scene_data_to_json(&json_buffer, p_smart_scene_data);
+    /* Only the packed actions are stored, JSON is rendered by the Hue HTTPS instance when the request is sent */
+    esp_err_t err = alloc_request_instance(p_request_handle, HUE_HTTPS_RESOURCE_SMART_SCENE,
+                                           p_smart_scene_data->resource_id);
     if (err != ESP_OK) return err;
 
-    /* Allocate and fill request instance */
-    return alloc_request_instance(p_request_handle, &json_buffer);
+    (*p_request_handle)->off = p_smart_scene_data->deactivate;
+    return ESP_OK;
+}
+
+esp_err_t hue_https_create_scene_request(hue_https_request_handle_t* p_request_handle, hue_scene_data_t* p_scene_data) {
+    if (HUE_NULL_CHECK(tag, p_request_handle)) return ESP_ERR_INVALID_ARG;
+    if (*p_request_handle) {
+        ESP_LOGE(tag, "Request handle already created, destroy previous handle before re-creating");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (HUE_NULL_CHECK(tag, p_scene_data)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_scene_data->resource_id)) return ESP_ERR_INVALID_ARG;
+
+    /* Verify that resource ID given is in the correct format */
+    if (check_resource_id(p_scene_data->resource_id) != ESP_OK) return ESP_ERR_INVALID_ARG;
+
+    /* Only the packed actions are stored, JSON is rendered by the Hue HTTPS instance when the request is sent */
+    esp_err_t err = alloc_request_instance(p_request_handle, HUE_HTTPS_RESOURCE_SCENE, p_scene_data->resource_id);
+    if (err != ESP_OK) return err;
+
+    (*p_request_handle)->scene_action = p_scene_data->action;
+    (*p_request_handle)->set_duration = p_scene_data->set_duration;
+    (*p_request_handle)->duration = p_scene_data->duration;
+    (*p_request_handle)->brightness_action = p_scene_data->set_brightness ? HUE_ACTION_SET : HUE_ACTION_NONE;
+    (*p_request_handle)->brightness = p_scene_data->brightness;
+    return ESP_OK;
 }
 
 /* TODO: destructor */
-esp_err_t hue_https_destroy_request(hue_https_request_handle_t* p_request_handle) { return ESP_ERR_NOT_FINISHED; }
+esp_err_t hue_https_destroy_request(hue_https_request_handle_t* p_request_handle) {
+    if (HUE_NULL_CHECK(tag, p_request_handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, *p_request_handle)) return ESP_ERR_INVALID_ARG;
+
+    free_request_instance(p_request_handle);
+    return ESP_OK;
+}
+
+esp_err_t hue_https_set_request_ttl(hue_https_request_handle_t request_handle, uint16_t ttl_ms) {
+    if (HUE_NULL_CHECK(tag, request_handle)) return ESP_ERR_INVALID_ARG;
+
+    request_handle->ttl_ms = ttl_ms;
+    return ESP_OK;
+}
+
+esp_err_t hue_https_set_request_priority(hue_https_request_handle_t request_handle, hue_https_priority_t priority) {
+    if (HUE_NULL_CHECK(tag, request_handle)) return ESP_ERR_INVALID_ARG;
+    if (priority >= HUE_HTTPS_PRIORITY_COUNT) {
+        ESP_LOGE(tag, "Unknown priority class %u", (unsigned)priority);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    request_handle->priority = priority;
+    return ESP_OK;
+}
 
 void hue_https_perform_request(hue_https_handle_t hue_https_handle, hue_https_request_handle_t request_handle,
                                bool force_through) {
+    hue_https_perform_triggered_request(hue_https_handle, request_handle, force_through, esp_timer_get_time(), 0);
+}
+
+void hue_https_perform_triggered_request(hue_https_handle_t hue_https_handle, hue_https_request_handle_t request_handle,
+                                         bool force_through, int64_t trigger_time_us, uint16_t ttl_ms) {
     if (HUE_NULL_CHECK(tag, hue_https_handle)) return;
     if (HUE_NULL_CHECK(tag, request_handle)) return;
 
-    /* Take mutex to ensure that the Hue HTTPS instance task cannot modify the request handles during */
+    hue_https_queue_request(hue_https_handle, request_handle, force_through, trigger_time_us, ttl_ms);
+}
+
+void hue_https_perform_template(hue_https_handle_t hue_https_handle, const hue_https_request_template_t* p_template,
+                                bool force_through) {
+    hue_https_perform_triggered_template(hue_https_handle, p_template, force_through, esp_timer_get_time(), 0);
+}
+
+void hue_https_perform_triggered_template(hue_https_handle_t hue_https_handle,
+                                          const hue_https_request_template_t* p_template, bool force_through,
+                                          int64_t trigger_time_us, uint16_t ttl_ms) {
+    if (HUE_NULL_CHECK(tag, hue_https_handle)) return;
+    if (HUE_NULL_CHECK(tag, p_template)) return;
+    if (p_template->resource_type >= HUE_HTTPS_RESOURCE_COUNT) {
+        ESP_LOGE(tag, "Template has unknown resource type %u, request not sent", (unsigned)p_template->resource_type);
+        return;
+    }
+
+    /* UUID is already packed, so interning is a memcmp scan of the resource table and no text is parsed */
+    uint8_t resource_index;
+    if (hue_https_resource_intern_packed(p_template->resource_id, &resource_index) != ESP_OK) {
+        ESP_LOGE(tag, "Failed to intern template resource ID, request not sent");
+        return;
+    }
+
+    /* Descriptor only lives on the stack until it is copied into the instance */
+    hue_https_request_instance_t request = {
+        .resource_index = resource_index,
+        .resource_type = p_template->resource_type,
+        .off = p_template->off,
+        .brightness_action = p_template->brightness_action,
+        .brightness = p_template->brightness,
+        .color_temp_action = p_template->color_temp_action,
+        .color_temp = p_template->color_temp,
+        .set_color = p_template->set_color,
+        .color_gamut_x = p_template->color_gamut_x,
+        .color_gamut_y = p_template->color_gamut_y,
+        .priority = p_template->priority,
+        .ttl_ms = p_template->ttl_ms,
+        .set_duration = p_template->set_duration,
+        .duration = p_template->duration,
+        .effect = p_template->effect,
+        .timed_effect = p_template->timed_effect,
+        .scene_action = p_template->scene_action,
+    };
+    hue_https_queue_request(hue_https_handle, &request, force_through, trigger_time_us, ttl_ms);
+}
+
+/*====================================================================================================================*/
+/*======================================= Shared Private Function Definitions ========================================*/
+/*====================================================================================================================*/
+
+esp_err_t hue_https_render_request(const hue_https_request_instance_t* p_request, hue_json_buffer_t* p_json_buffer,
+                                   char* resource_path, size_t resource_path_size) {
+    if (HUE_NULL_CHECK(tag, p_request)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_json_buffer)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, resource_path)) return ESP_ERR_INVALID_ARG;
+
+    /* Resource IDs are only printed as text here, for the URL and the JSON builder */
+    char resource_id[HUE_RESOURCE_ID_LENGTH + 1];
+    hue_https_resource_id_to_str(p_request->resource_index, resource_id);
+
+    esp_err_t err;
+    switch (p_request->resource_type) {
+        case HUE_HTTPS_RESOURCE_LIGHT:
+        case HUE_HTTPS_RESOURCE_GROUPED_LIGHT: {
+            hue_light_data_t light_data = {
+                .resource_id = resource_id,
+                .off = p_request->off,
+                .brightness_action = p_request->brightness_action,
+                .brightness = p_request->brightness,
+                .color_temp_action = p_request->color_temp_action,
+                .color_temp = p_request->color_temp,
+                .set_color = p_request->set_color,
+                .color_gamut_x = p_request->color_gamut_x,
+                .color_gamut_y = p_request->color_gamut_y,
+                .set_duration = p_request->set_duration,
+                .duration = p_request->duration,
+                .effect = p_request->effect,
+                .timed_effect = p_request->timed_effect,
+            };
+            err = (p_request->resource_type == HUE_HTTPS_RESOURCE_LIGHT)
+                      ? hue_light_data_to_json(p_json_buffer, &light_data)
+                      : hue_grouped_light_data_to_json(p_json_buffer, &light_data);
+            break;
+        }
+        case HUE_HTTPS_RESOURCE_SMART_SCENE: {
+            hue_smart_scene_data_t smart_scene_data = {.resource_id = resource_id,
+                                                       .deactivate = p_request->off};
+            err = hue_smart_scene_data_to_json(p_json_buffer, &smart_scene_data);
+            break;
+        }
+        case HUE_HTTPS_RESOURCE_SCENE: {
+            hue_scene_data_t scene_data = {
+                .resource_id = resource_id,
+                .action = p_request->scene_action,
+                .set_duration = p_request->set_duration,
+                .duration = p_request->duration,
+                .set_brightness = (p_request->brightness_action == HUE_ACTION_SET),
+                .brightness = p_request->brightness,
+            };
+            err = hue_scene_data_to_json(p_json_buffer, &scene_data);
+            break;
+        }
+        default:
+            ESP_LOGE(tag, "Request has unknown resource type %u", (unsigned)p_request->resource_type);
+            return ESP_ERR_INVALID_ARG;
+    }
+    if (err != ESP_OK) return err;
+
+    /* Put "[resource type]/[resource id]" into resource path */
+    int str_len = snprintf(resource_path, resource_path_size, "%s/%s", p_json_buffer->resource_type, resource_id);
+
+    /* resource_id only lives for this call, do not leave the buffer pointing at it */
+    p_json_buffer->resource_id = NULL;
+
+    if (unlikely(str_len < 0)) {
+        ESP_LOGE(tag, "Encoding error while printing resource path");
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    if (unlikely((size_t)str_len >= resource_path_size)) {
+        ESP_LOGE(tag, "Resource path buffer too small");
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    return ESP_OK;
+}
+
+void hue_https_pack_light_data(hue_https_request_handle_t request_handle, const hue_light_data_t* p_light_data) {
+    /* Bitfields are the same widths as hue_light_data_t, so packing is lossless and clamping is left to rendering */
+    request_handle->off = p_light_data->off;
+    request_handle->brightness_action = p_light_data->brightness_action;
+    request_handle->brightness = p_light_data->brightness;
+    request_handle->color_temp_action = p_light_data->color_temp_action;
+    request_handle->color_temp = p_light_data->color_temp;
+    request_handle->set_color = p_light_data->set_color;
+    request_handle->color_gamut_x = p_light_data->color_gamut_x;
+    request_handle->color_gamut_y = p_light_data->color_gamut_y;
+    request_handle->set_duration = p_light_data->set_duration;
+    request_handle->duration = p_light_data->duration;
+    request_handle->effect = p_light_data->effect;
+    request_handle->timed_effect = p_light_data->timed_effect;
+}
+
+esp_err_t hue_https_queue_request(hue_https_handle_t hue_https_handle, const hue_https_request_instance_t* p_request,
+                                  bool force_through, int64_t trigger_time_us, uint16_t ttl_ms) {
+    /* A deadline given at perform time only applies to this copy, the handle or template keeps its own */
+    hue_https_request_instance_t request = *p_request;
+    if (ttl_ms) request.ttl_ms = ttl_ms;
+    p_request = &request;
+
+    /* Take mutex to ensure that the Hue HTTPS instance task cannot modify the requests during */
+    esp_err_t err = ESP_OK;
     if (xSemaphoreTake(hue_https_handle->request_handle_mutex, pdMS_TO_TICKS(5000))) {
-        /* If there is already a handle in the current position, a request is currently running */
-        if (hue_https_handle->current_request_handle) {
-            if (!force_through) {
+        /* Without WiFi the request could only fail, so it is held and sent once WiFi reconnects */
+        if (!(xEventGroupGetBits(hue_https_handle->handle_evt) & HUE_HTTPS_EVT_WIFI_CONNECTED_BIT)) {
+            ESP_LOGD(tag, "WiFi disconnected, holding request until reconnected");
+            err = hue_https_hold_request(hue_https_handle, p_request, trigger_time_us, true);
+            xSemaphoreGive(hue_https_handle->request_handle_mutex);
+            return (err == ESP_ERR_NO_MEM) ? err : ESP_OK;
+        }
+
+        /* If the current position holds a request, a request is currently running */
+        bool current_background = (hue_https_handle->current_request.priority == HUE_HTTPS_PRIORITY_BACKGROUND);
+        if (hue_https_handle->current_pending && (p_request->priority == HUE_HTTPS_PRIORITY_BACKGROUND)) {
+            /* Background work never replaces or aborts what is running, it waits behind every interactive request */
+            ESP_LOGD(tag, "A request is currently running, queueing background request");
+            err = hue_https_queue_background_request(hue_https_handle, p_request, trigger_time_us, true);
+        } else if (hue_https_handle->current_pending) {
+            if (!force_through && !current_background) {
                 ESP_LOGW(tag,
                          "A request is currently running and the force_through argument was not set, new request has "
                          "been ignored");
-                return;
+                xSemaphoreGive(hue_https_handle->request_handle_mutex);
+                return ESP_ERR_INVALID_STATE;
+            }
+            /* Adds the new request to be next, ahead of any queued background request, and if forced or preempting a
+             * background request sends abort bit to stop the currently running request. A background request that
+             * has not been sent yet always yields */
+            ESP_LOGD(tag, "A request is currently running, setting next request");
+            if (hue_https_handle->next_pending) hue_https_handle->stats.requests_coalesced++;
+            hue_https_handle->next_request = *p_request;
+            hue_https_handle->next_pending = true;
+            hue_https_handle->next_trigger_us = trigger_time_us;
+            if (force_through || (current_background && hue_https_handle->preempt_background)) {
+                xEventGroupSetBits(hue_https_handle->handle_evt, HUE_HTTPS_EVT_ABORT_BIT);
+            } else if (current_background) {
+                xEventGroupSetBits(hue_https_handle->handle_evt, HUE_HTTPS_EVT_YIELD_BIT);
             }
-            /* If enabled, sends abort bit to stop currently running request and adds the new request to be next */
-            ESP_LOGD(tag, "A request is currently running, setting next request and aborting current");
-            hue_https_handle->next_request_handle = request_handle;
-            xEventGroupSetBits(hue_https_handle->handle_evt, HUE_HTTPS_EVT_ABORT_BIT);
         } else { /* No request is currently running */
             ESP_LOGD(tag, "No request currently running, sending new request through");
 
-            /* Assign new request to the current handle */
-            hue_https_handle->current_request_handle = request_handle;
-            hue_https_handle->next_request_handle = NULL;
+            /* Copy new request to the current position */
+            hue_https_handle->current_request = *p_request;
+            hue_https_handle->current_pending = true;
+            hue_https_handle->current_trigger_us = trigger_time_us;
+            hue_https_handle->next_pending = false;
 
-            /* Clear the abort bit to ensure the request will not be cancelled erroneously */
-            xEventGroupClearBits(hue_https_handle->handle_evt, HUE_HTTPS_EVT_ABORT_BIT);
+            /* Clear the abort and yield bits to ensure the request will not be cancelled erroneously */
+            xEventGroupClearBits(hue_https_handle->handle_evt, HUE_HTTPS_EVT_ABORT_BIT | HUE_HTTPS_EVT_YIELD_BIT);
 
             /* Set the trigger bit to initiate the request */
             xEventGroupSetBits(hue_https_handle->handle_evt, HUE_HTTPS_EVT_TRIGGER_BIT);
@@ -191,7 +393,11 @@ void hue_https_perform_request(hue_https_handle_t hue_https_handle, hue_https_re
         xSemaphoreGive(hue_https_handle->request_handle_mutex);
     } else {
         ESP_LOGE(tag, "Failed to acquire mutex within 5 seconds, request not sent");
+        return ESP_ERR_TIMEOUT;
     }
+
+    /* A request replacing a queued one for the same resource is still sent, only a dropped one is an error */
+    return (err == ESP_ERR_NO_MEM) ? err : ESP_OK;
 }
 
 /*====================================================================================================================*/
@@ -199,19 +405,8 @@ void hue_https_perform_request(hue_https_handle_t hue_https_handle, hue_https_re
 /*====================================================================================================================*/
 
 static esp_err_t check_resource_id(const char* resource_id) {
-    if (strlen(resource_id) != HUE_RESOURCE_ID_LENGTH) {
-        ESP_LOGE(tag, "Resource ID provided is not the correct length for a resource ID");
-        return ESP_FAIL;
-    }
-
-    /* Storage for the number of correctly formatted characters scanned */
-    int chars_received = 0;
-
-    /* Scans the resource ID against the specified format, storing the number of characters scanned */
-    sscanf(resource_id, HUE_RESOURCE_ID_FORMAT "%n", &chars_received);
-
-    /* All characters should match the specified format */
-    if (chars_received != HUE_RESOURCE_ID_LENGTH) {
+    /* Single table-driven pass over the string, stopping at its null-terminating character */
+    if (hue_validate_resource_id(resource_id) != ESP_OK) {
         ESP_LOGE(tag, "Resource ID provided is not in the correct format for a resource ID");
         return ESP_FAIL;
     }
@@ -225,129 +420,35 @@ static void free_request_instance(hue_https_request_handle_t* p_request_handle)
     if (!p_request_handle) return;
     if (!(*p_request_handle)) return;
 
-    /* Free any resources that are allocated */
-    if ((*p_request_handle)->request_body) free((*p_request_handle)->request_body);
-    if ((*p_request_handle)->resource_path) free((*p_request_handle)->resource_path);
-
-    /* Free the request instance */
+    /* The descriptor is a single allocation with no internal buffers */
     free(*p_request_handle);
 
     /* Sets the value of the request handle to NULL to ensure handle cannot be used to access deallocated memory */
     *p_request_handle = NULL;
 }
 
-static esp_err_t alloc_request_body(hue_https_request_handle_t request_handle, hue_json_buffer_t* p_json_buffer) {
-    if (HUE_NULL_CHECK(tag, request_handle)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, p_json_buffer)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, p_json_buffer->buff)) return ESP_ERR_INVALID_ARG;
-
-    /* Get the size of the JSON generated for the request */
-    size_t str_len = strlen(p_json_buffer->buff);
-
-    if (str_len == 0) { /* Buffer exists but is empty */
-        ESP_LOGE(tag, "JSON buffer not filled");
-        return ESP_ERR_INVALID_SIZE;
-    } else if (str_len >= HUE_JSON_BUFFER_SIZE) { /* Prevent copying out of bounds without null-terminating character */
-        ESP_LOGE(tag, "JSON buffer has no null-terminating character");
-        return ESP_ERR_INVALID_SIZE;
-    }
-
-    /* If request body is already allocated, free before overwriting pointer */
-    if (request_handle->request_body) free(request_handle->request_body);
-
-    /* Allocate request body to exactly fit the JSON generated for the request */
-    request_handle->request_body = calloc(str_len + 1, sizeof(char));
-    if (!request_handle->request_body) {
-        ESP_LOGE(tag, "Failed to allocate memory for request body");
-        return ESP_ERR_NO_MEM;
-    }
-
-    /* Copy the generated JSON over to the request body buffer */
-    strncpy(request_handle->request_body, p_json_buffer->buff, str_len);
-
-    /* Redundant checking to ensure that JSON has been fully copied */
-    if (unlikely(strlen(request_handle->request_body) != str_len)) {
-        ESP_LOGE(tag, "Failed to copy JSON to request handle");
-        return ESP_ERR_INVALID_SIZE;
-    }
-
-    return ESP_OK;
-}
-
-static esp_err_t alloc_resource_path(hue_https_request_handle_t request_handle, hue_json_buffer_t* p_json_buffer) {
-    if (HUE_NULL_CHECK(tag, request_handle)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, p_json_buffer)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, p_json_buffer->resource_type)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, p_json_buffer->resource_id)) return ESP_ERR_INVALID_ARG;
-
-    /* Get the size of the resource type + '/' + resource ID */
-    size_t str_len = strlen(p_json_buffer->resource_type) + 1 + strlen(p_json_buffer->resource_id);
-
-    /* Resource ID should be verified by this point & resource type should be one of 4 static strings, so unlikely to be
-     * improperly sized, but check for improper lengths anyway */
-    if (unlikely(str_len < (HUE_RESOURCE_TYPE_MIN + HUE_RESOURCE_ID_LENGTH))) {
-        ESP_LOGE(tag, "Resource type and/or ID are too short");
-        return ESP_ERR_INVALID_SIZE;
-    }
-    if (unlikely(str_len > (HUE_RESOURCE_TYPE_SIZE + HUE_RESOURCE_ID_LENGTH))) {
-        ESP_LOGE(tag, "Resource type and/or ID are too long");
-        return ESP_ERR_INVALID_SIZE;
-    }
-
-    /* If resource path is already allocated, free before overwriting pointer */
-    if (request_handle->resource_path) free(request_handle->resource_path);
-
-    /* Allocate resource path to exactly fit "[resource type]/[resource id]" */
-    request_handle->resource_path = calloc(str_len + 1, sizeof(char));
-    if (!request_handle->resource_path) {
-        ESP_LOGE(tag, "Failed to allocate memory for resource path");
-        return ESP_ERR_NO_MEM;
-    }
-
-    /* Put "[resource type]/[resource id]" into request resource path */
-    int err = snprintf(request_handle->resource_path, str_len + 1, "%s/%s", p_json_buffer->resource_type,
-                       p_json_buffer->resource_id);
-
-    /* Verify that resource path has been properly put into buffer */
-    if (unlikely((err != str_len) || (strlen(request_handle->resource_path) != str_len))) {
-        ESP_LOGE(tag, "Failed to put resource path into request buffer");
-        return ESP_ERR_INVALID_SIZE;
-    }
-
-    return ESP_OK;
-}
-
 static esp_err_t alloc_request_instance(hue_https_request_handle_t* p_request_handle,
-                                        hue_json_buffer_t* p_json_buffer) {
+                                        hue_https_resource_t resource_type, const char* resource_id) {
     if (HUE_NULL_CHECK(tag, p_request_handle)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, p_json_buffer)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, resource_id)) return ESP_ERR_INVALID_ARG;
 
-    /* Allocate memory for the request instance and set handle value to the instance pointer */
-    (*p_request_handle) = malloc(sizeof(hue_https_request_instance_t));
+    /* Allocate the request instance with every action cleared and set handle value to the instance pointer */
+    (*p_request_handle) = calloc(1, sizeof(hue_https_request_instance_t));
     if (!(*p_request_handle)) {
         ESP_LOGE(tag, "Failed to allocate memory for request instance");
         return ESP_ERR_NO_MEM;
     }
 
-    /* Set internal unallocated buffer pointers to NULL */
-    (*p_request_handle)->request_body = NULL;
-    (*p_request_handle)->resource_path = NULL;
-
-    /* Allocate and fill request body buffer from p_json_buffer */
-    esp_err_t err = alloc_request_body(*p_request_handle, p_json_buffer);
-    if (err != ESP_OK) {
-        /* Free all potentially allocated resources before returning allocation error code */
-        free_request_instance(p_request_handle);
-        return err;
-    }
+    (*p_request_handle)->resource_type = resource_type;
 
-    /* Allocate and fill resource path buffer from p_json_buffer */
-    err = alloc_resource_path(*p_request_handle, p_json_buffer);
+    /* Requests for the same resource share one table entry and are compared by index */
+    uint8_t resource_index;
+    esp_err_t err = hue_https_resource_intern(resource_id, &resource_index);
     if (err != ESP_OK) {
-        /* Free all potentially allocated resources before returning allocation error code */
         free_request_instance(p_request_handle);
         return err;
     }
+    (*p_request_handle)->resource_index = resource_index;
 
     return ESP_OK;
 }
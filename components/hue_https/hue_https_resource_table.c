@@ -0,0 +1,216 @@
+/**
+ * @file hue_https_resource_table.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Interning table parsing each Hue resource ID once into its 16 byte UUID and assigning it a small index
+ *
+ * Entries are only ever appended and never change once published, so the Hue HTTPS instance tasks and lookups of
+ * resources already in the table read them without taking the table mutex. The mutex only serializes adding entries.
+ */
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "hue_https_private.h"
+#include "hue_helpers.h"
+
+static const char* tag = "hue_https_resource";
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/* Indices are stored in 8 bits and the count must be able to reach the table size */
+_Static_assert(HUE_RESOURCE_TABLE_SIZE <= UINT8_MAX, "HUE_RESOURCE_TABLE_SIZE must fit in the 8 bit resource index");
+
+static uint8_t resource_table[HUE_RESOURCE_TABLE_SIZE][HUE_RESOURCE_ID_PACKED_SIZE]; /**< Interned resource UUIDs */
+static atomic_uint_fast8_t resource_count;              /**< Number of published entries in resource_table */
+static _Atomic(SemaphoreHandle_t) resource_table_mutex; /**< Serializes appends, created on first use */
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Packs a resource ID string into the raw bytes of its UUID
+ *
+ * @param[out] packed_id Storage for the HUE_RESOURCE_ID_PACKED_SIZE bytes of the UUID
+ * @param[in] resource_id Resource ID in the format specified by the Philips Hue API
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Resource ID packed
+ * @retval - @c ESP_FAIL – Resource ID contains characters other than hexadecimal digits and separators, or does not
+ * end after its 32nd hexadecimal digit
+ */
+static esp_err_t pack_resource_id(uint8_t* packed_id, const char* resource_id);
+
+/**
+ * @brief Returns the table mutex, creating it if this is the first use of the table
+ *
+ * @return Mutex handle, or NULL if it could not be created
+ */
+static SemaphoreHandle_t get_table_mutex(void);
+
+/*====================================================================================================================*/
+/*======================================= Shared Private Function Definitions ========================================*/
+/*====================================================================================================================*/
+
+esp_err_t hue_https_resource_intern(const char* resource_id, uint8_t* p_index) {
+    if (HUE_NULL_CHECK(tag, resource_id)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_index)) return ESP_ERR_INVALID_ARG;
+
+    uint8_t packed_id[HUE_RESOURCE_ID_PACKED_SIZE];
+    if (pack_resource_id(packed_id, resource_id) != ESP_OK) return ESP_ERR_INVALID_ARG;
+
+    return hue_https_resource_intern_packed(packed_id, p_index);
+}
+
+esp_err_t hue_https_resource_find(const char* resource_id, uint8_t* p_index) {
+    if (HUE_NULL_CHECK(tag, resource_id)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_index)) return ESP_ERR_INVALID_ARG;
+
+    uint8_t packed_id[HUE_RESOURCE_ID_PACKED_SIZE];
+    if (pack_resource_id(packed_id, resource_id) != ESP_OK) return ESP_ERR_INVALID_ARG;
+
+    /* Published entries never change, so the search needs no mutex */
+    uint8_t published = atomic_load_explicit(&resource_count, memory_order_acquire);
+    for (uint8_t index = 0; index < published; index++) {
+        if (memcmp(resource_table[index], packed_id, HUE_RESOURCE_ID_PACKED_SIZE) == 0) {
+            *p_index = index;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+uint8_t hue_https_resource_free_count(void) {
+    return HUE_RESOURCE_TABLE_SIZE - atomic_load_explicit(&resource_count, memory_order_acquire);
+}
+
+esp_err_t hue_https_resource_intern_packed(const uint8_t* packed_id, uint8_t* p_index) {
+    if (HUE_NULL_CHECK(tag, packed_id)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_index)) return ESP_ERR_INVALID_ARG;
+
+    /* Published entries never change, so a resource already in the table is found without taking the mutex */
+    uint8_t published = atomic_load_explicit(&resource_count, memory_order_acquire);
+    for (uint8_t index = 0; index < published; index++) {
+        if (memcmp(resource_table[index], packed_id, HUE_RESOURCE_ID_PACKED_SIZE) == 0) {
+            *p_index = index;
+            return ESP_OK;
+        }
+    }
+
+    SemaphoreHandle_t mutex = get_table_mutex();
+    if (!mutex) {
+        ESP_LOGE(tag, "Failed to create resource table mutex");
+        return ESP_ERR_NO_MEM;
+    }
+    if (!xSemaphoreTake(mutex, pdMS_TO_TICKS(5000))) {
+        ESP_LOGE(tag, "Failed to acquire mutex within 5 seconds, resource ID not interned");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    /* Only appends change the table and they hold the mutex, so the count cannot change during the search */
+    uint8_t count = atomic_load_explicit(&resource_count, memory_order_relaxed);
+    esp_err_t err = ESP_OK;
+    uint8_t index;
+    for (index = 0; index < count; index++) {
+        if (memcmp(resource_table[index], packed_id, HUE_RESOURCE_ID_PACKED_SIZE) == 0) break;
+    }
+
+    if (index == count) {
+        if (count < HUE_RESOURCE_TABLE_SIZE) {
+            /* Entry is written before the count is released so readers never see a partially copied UUID */
+            memcpy(resource_table[index], packed_id, HUE_RESOURCE_ID_PACKED_SIZE);
+            atomic_store_explicit(&resource_count, count + 1, memory_order_release);
+        } else {
+            ESP_LOGE(tag, "Resource table full, only %d different resource IDs can be used", HUE_RESOURCE_TABLE_SIZE);
+            err = ESP_ERR_NO_MEM;
+        }
+    }
+    xSemaphoreGive(mutex);
+
+    if (err == ESP_OK) *p_index = index;
+    return err;
+}
+
+void hue_https_resource_id_to_str(uint8_t index, char* resource_id) {
+    static const char hex_chars[] = "0123456789abcdef";
+
+    /* Indices only come from hue_https_resource_intern(), an unpublished one prints as the nil UUID */
+    static const uint8_t nil_id[HUE_RESOURCE_ID_PACKED_SIZE] = {0};
+    const uint8_t* packed_id =
+        (index < atomic_load_explicit(&resource_count, memory_order_acquire)) ? resource_table[index] : nil_id;
+
+    /* Separators go before bytes 4, 6, 8, and 10: "[8 chars]-[4 chars]-[4 chars]-[4 chars]-[12 chars]" */
+    size_t pos = 0;
+    for (size_t i = 0; i < HUE_RESOURCE_ID_PACKED_SIZE; i++) {
+        if ((i == 4) || (i == 6) || (i == 8) || (i == 10)) resource_id[pos++] = '-';
+        resource_id[pos++] = hex_chars[packed_id[i] >> 4];
+        resource_id[pos++] = hex_chars[packed_id[i] & 0x0F];
+    }
+    resource_id[pos] = '\0';
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static esp_err_t pack_resource_id(uint8_t* packed_id, const char* resource_id) {
+    uint8_t nibbles = 0;
+    const char* p_char = resource_id;
+
+    /* Every character is checked again while packing so the table never depends on callers validating the ID */
+    for (; *p_char && (nibbles < (HUE_RESOURCE_ID_PACKED_SIZE * 2)); p_char++) {
+        if (*p_char == '-') continue;
+
+        uint8_t value;
+        if ((*p_char >= '0') && (*p_char <= '9')) {
+            value = *p_char - '0';
+        } else if ((*p_char >= 'a') && (*p_char <= 'f')) {
+            value = *p_char - 'a' + 10;
+        } else if ((*p_char >= 'A') && (*p_char <= 'F')) {
+            value = *p_char - 'A' + 10;
+        } else {
+            ESP_LOGE(tag, "Resource ID provided contains a non-hexadecimal character");
+            return ESP_FAIL;
+        }
+
+        /* High nibble first, matching the order the characters are printed back in */
+        if (nibbles % 2) {
+            packed_id[nibbles / 2] |= value;
+        } else {
+            packed_id[nibbles / 2] = value << 4;
+        }
+        nibbles++;
+    }
+
+    if (nibbles != (HUE_RESOURCE_ID_PACKED_SIZE * 2)) {
+        ESP_LOGE(tag, "Resource ID provided does not contain 32 hexadecimal characters");
+        return ESP_FAIL;
+    }
+
+    /* Anything past the last digit would otherwise be ignored, interning a longer string as the UUID it starts with */
+    if (*p_char) {
+        ESP_LOGE(tag, "Resource ID provided continues past 32 hexadecimal characters");
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+static SemaphoreHandle_t get_table_mutex(void) {
+    SemaphoreHandle_t mutex = atomic_load(&resource_table_mutex);
+    if (mutex) return mutex;
+
+    /* Requests may be created from several tasks at once, only the first mutex created is kept */
+    SemaphoreHandle_t created = xSemaphoreCreateMutex();
+    if (!created) return NULL;
+    if (!atomic_compare_exchange_strong(&resource_table_mutex, &mutex, created)) {
+        vSemaphoreDelete(created);
+        return mutex;
+    }
+    return created;
+}
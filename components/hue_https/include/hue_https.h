@@ -17,26 +17,163 @@
 extern "C" {
 #endif
 
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+/** Number of bytes in a resource ID UUID once packed from its 32 hexadecimal characters */
+#define HUE_RESOURCE_ID_PACKED_SIZE 16
+
+/** Instance task priority used unless a placement is set, below the network stack and proximity monitor tasks */
+#define HUE_HTTPS_DEFAULT_TASK_PRIORITY 20
+/** Value of task_core_id letting the scheduler run the instance task on either core */
+#define HUE_HTTPS_TASK_ANY_CORE -1
+
+/** Default pacing of light requests, the bridge handles roughly 10 light commands a second */
+#define HUE_HTTPS_RATE_LIMIT_LIGHT {.interval_ms = 100, .burst = 2}
+/** Default pacing of grouped light requests, the bridge handles roughly 1 group command a second and holds no burst,
+ * so requests are spaced 10% wider than that for send and network jitter not to earn a 429 */
+#define HUE_HTTPS_RATE_LIMIT_GROUPED_LIGHT {.interval_ms = 1100, .burst = 1}
+/** Default pacing of smart scene requests, a scene fans out to group commands so it shares their budget */
+#define HUE_HTTPS_RATE_LIMIT_SMART_SCENE {.interval_ms = 1100, .burst = 1}
+/** Default pacing of scene requests, a scene recall is a single group command for every light in it */
+#define HUE_HTTPS_RATE_LIMIT_SCENE {.interval_ms = 1100, .burst = 1}
+
+/** Number of rooms and zones an instance holds the membership of for consolidating light batches */
+#define HUE_HTTPS_GROUPS_SIZE 8
+/** Number of lights a room or zone, and a light batch, can hold */
+#define HUE_HTTPS_GROUP_MAX_LIGHTS 16
+
 /*====================================================================================================================*/
 /*=========================================== Public Structure Definitions ===========================================*/
 /*====================================================================================================================*/
 
+/** @brief Resource types a request can target */
+typedef enum {
+    HUE_HTTPS_RESOURCE_LIGHT = 0,     /**< Light resource, rendered by hue_light_data_to_json() */
+    HUE_HTTPS_RESOURCE_GROUPED_LIGHT, /**< Grouped light resource, rendered by hue_grouped_light_data_to_json() */
+    HUE_HTTPS_RESOURCE_SMART_SCENE,   /**< Smart scene resource, rendered by hue_smart_scene_data_to_json() */
+    HUE_HTTPS_RESOURCE_SCENE,         /**< Scene resource, rendered by hue_scene_data_to_json() */
+    HUE_HTTPS_RESOURCE_COUNT,         /**< Number of resource types, not a resource type */
+} hue_https_resource_t;
+
+/** @brief Priority classes requests are scheduled by */
+typedef enum {
+    HUE_HTTPS_PRIORITY_INTERACTIVE = 0, /**< Actuation someone is waiting on, such as a presence transition */
+    HUE_HTTPS_PRIORITY_BACKGROUND,      /**< Work nobody is waiting on, such as state sync, discovery or telemetry */
+    HUE_HTTPS_PRIORITY_COUNT,           /**< Number of priority classes, not a priority class */
+} hue_https_priority_t;
+
+/** @brief Token bucket pacing the requests of one resource type to the bridge's command budget */
+typedef struct {
+    uint16_t interval_ms; /**< Time for one token to refill, 0 sends requests of the type without pacing */
+    uint8_t burst;        /**< Tokens the bucket holds, the requests that can be sent back to back after idling */
+} hue_https_rate_limit_t;
+
 /**
  * @brief Philips Hue bridge information and application key for requests
  *
  * @attention Information must be aquired while on the same network as the bridge
  */
 typedef struct {
-    const char* bridge_ip; /**< IP address of bridge from https://discovery.meethue.com */
+    const char* bridge_ip; /**< Bridge IP from https://discovery.meethue.com, zero padded to ddd.ddd.ddd.ddd */
     const char* bridge_id; /**< Bridge ID from https://discovery.meethue.com */
 
+    /** Bridge IP as a host order integer (e.g. HUE_CONFIG_BRIDGE_IP_U32), used instead of bridge_ip when not 0 */
+    uint32_t bridge_ip_addr;
+
     /** Application key obtained by following API tutorial on
      * https://developers.meethue.com/develop/hue-api-v2/getting-started/ */
     const char* application_key;
     const char* const task_id; /**< ID to assign to Hue HTTPS instance task */
-    uint8_t retry_attempts;    /**< Maximum number of times to retry HTTPS request before failing */
+    uint8_t retry_attempts;    /**< Maximum number of times to retry HTTPS request before failing, without a deadline */
+
+    /** Use task_priority and task_core_id, otherwise the task is unpinned at HUE_HTTPS_DEFAULT_TASK_PRIORITY */
+    bool task_placement_set;
+    uint8_t task_priority; /**< [1-(configMAX_PRIORITIES - 1)] Priority of the instance task */
+    int8_t task_core_id;   /**< Core to pin the instance task to, or HUE_HTTPS_TASK_ANY_CORE */
+
+    /** Use rate_limits, otherwise each resource type is paced by its HUE_HTTPS_RATE_LIMIT_[type] default */
+    bool rate_limits_set;
+    hue_https_rate_limit_t rate_limits[HUE_HTTPS_RESOURCE_COUNT]; /**< Indexed by hue_https_resource_t */
+
+    /** Interactive requests abort a background request being sent instead of waiting for it, which is queued again */
+    bool preempt_background;
 } hue_https_config_t;
 
+/** @brief Queueing statistics of one priority class */
+typedef struct {
+    uint32_t requests_started;    /**< Requests of the class whose first attempt was sent */
+    int64_t last_queue_delay_us;  /**< Trigger to first attempt of the most recent request, including token waits */
+    int64_t max_queue_delay_us;   /**< Largest trigger to first attempt delay of any request */
+    int64_t total_queue_delay_us; /**< Sum of all trigger to first attempt delays, for averaging */
+} hue_https_class_stats_t;
+
+/** @brief Request statistics for a Hue HTTPS instance */
+typedef struct {
+    uint32_t requests_ok;           /**< Requests completed with a 200 OK response */
+    uint32_t requests_failed;       /**< Requests that failed or received a non-200 response */
+    uint32_t latency_over_target;   /**< Successful requests with trigger to 200 OK latency over 1 second */
+    int64_t last_latency_us;        /**< Trigger to 200 OK latency of the most recent successful request */
+    int64_t max_latency_us;         /**< Largest trigger to 200 OK latency of any successful request */
+    int64_t total_latency_us;       /**< Sum of all trigger to 200 OK latencies, for averaging with requests_ok */
+    uint32_t connections_prewarmed; /**< Bridge connections opened and verified on WiFi connection */
+    uint32_t requests_held;         /**< Requests held while WiFi was disconnected, sent once reconnected */
+    uint32_t requests_coalesced;    /**< Requests replaced by a later request before being sent */
+    int64_t last_converge_us;       /**< Reconnection to the last held request being answered, for the latest flush */
+    uint32_t responses_throttled;   /**< 429 and 503 responses, each retried after the bridge's Retry-After */
+    uint8_t send_rate_percent;      /**< Share of the configured rate limits currently sent at */
+    uint32_t requests_expired;      /**< Requests discarded because their deadline passed before they were answered */
+    uint32_t requests_preempted;    /**< Background requests aborted by an interactive request and queued again */
+    uint32_t requests_consolidated; /**< Light requests saved by sending light batches as grouped light requests */
+    hue_https_class_stats_t classes[HUE_HTTPS_PRIORITY_COUNT]; /**< Queueing delay, indexed by hue_https_priority_t */
+} hue_https_stats_t;
+
+/** @brief Room or zone membership, the lights one grouped_light request sets all at once */
+typedef struct {
+    const char* grouped_light_id; /**< Resource ID of the room or zone's grouped_light */
+    const char* const* light_ids; /**< Resource IDs of every light in the room or zone */
+    uint8_t light_count;          /**< [1-HUE_HTTPS_GROUP_MAX_LIGHTS] Number of resource IDs in light_ids */
+} hue_https_group_t;
+
+/** @brief How a light batch was sent, see hue_https_perform_light_batch() */
+typedef struct {
+    uint8_t lights;           /**< Distinct lights in the batch */
+    uint8_t grouped_requests; /**< Grouped light requests sent for rooms and zones wholly in the batch */
+    uint8_t light_requests;   /**< Light requests sent for the lights no such room or zone covered */
+    uint8_t requests_saved;   /**< Requests the batch would have cost as light requests, less those sent */
+} hue_https_batch_result_t;
+
+/**
+ * @brief Predefined request for a fixed action, performed directly with hue_https_perform_template()
+ *
+ * Declare templates const (e.g. a static const table of named actions) so they are placed in flash and cost no RAM or
+ * startup time. The resource ID is stored as UUID bytes, such as the HUE_CONFIG_[resource]_UUID initializers generated
+ * from sdkconfig, and is only entered into the resource table the first time the template is performed.
+ *
+ * @note Fields match hue_light_data_t, smart scene templates use off to deactivate the smart scene. Scene templates
+ * recall with scene_action and duration, and a brightness_action of HUE_ACTION_SET overrides the scene's brightness
+ */
+typedef struct {
+    uint8_t resource_id[HUE_RESOURCE_ID_PACKED_SIZE]; /**< Resource ID UUID bytes, in the order they are printed */
+    hue_https_resource_t resource_type : 3; /**< Resource targeted */
+    bool off : 1;                           /**< Light off, or smart scene deactivate */
+    hue_action_t brightness_action : 2;     /**< How brightness should be adjusted */
+    uint8_t brightness : 7;                 /**< [0-100] Amount brightness should be adjusted by or set to */
+    hue_action_t color_temp_action : 2;     /**< How color temp should be adjusted */
+    uint16_t color_temp : 9;                /**< Amount color temp should be adjusted by [0-347] or set to [153-500] */
+    bool set_color : 1;                     /**< If color_gamut values should be used */
+    uint16_t color_gamut_x : 14;            /**< CIE X gamut position decimal value (e.g. 123 = 0.0123, >=10000 = 1) */
+    uint16_t color_gamut_y : 14;            /**< CIE Y gamut position decimal value (e.g. 123 = 0.0123, >=10000 = 1) */
+    uint8_t priority : 1;                   /**< Priority class, as hue_https_priority_t */
+    uint16_t ttl_ms;                        /**< Deadline as time from trigger, see hue_https_set_request_ttl() */
+    bool set_duration : 1;                  /**< If duration should be used */
+    uint16_t duration : 16;                 /**< Transition or timed effect length in HUE_DURATION_STEP_MS steps */
+    hue_effect_t effect : 4;                /**< Effect loop to play */
+    hue_timed_effect_t timed_effect : 2;    /**< Timed effect to play, over duration */
+    hue_scene_action_t scene_action : 2;    /**< How a scene should be recalled, scene templates only */
+} hue_https_request_template_t;
+
 typedef struct hue_https_instance* hue_https_handle_t;                 /**< Handle for hue_https session */
 typedef struct hue_https_request_instance* hue_https_request_handle_t; /**< Handle for created request */
 
@@ -56,10 +193,10 @@ typedef struct hue_https_request_instance* hue_https_request_handle_t; /**< Hand
  * @retval - @c ESP_OK – Request instance successfully created
  * @retval - @c ESP_ERR_INVALID_ARG – p_request_handle, p_light_data, or p_light_data's resource ID are NULL or resource
  * ID is not in the correct format as specified by the Philips Hue API
- * @retval - @c ESP_ERR_INVALID_RESPONSE – Encoding error encountered during JSON generation
- * @retval - @c ESP_ERR_INVALID_SIZE – JSON buffer was too small or a failure occurred with copying of data to request
- * instance
  * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory for request instance
+ *
+ * @note Actions are stored packed and only rendered to JSON when the request is sent, values out of range for Hue's
+ * API are clipped at that point
  */
 esp_err_t hue_https_create_light_request(hue_https_request_handle_t* p_request_handle, hue_light_data_t* p_light_data);
 
@@ -73,10 +210,10 @@ esp_err_t hue_https_create_light_request(hue_https_request_handle_t* p_request_h
  * @retval - @c ESP_OK – Request instance successfully created
  * @retval - @c ESP_ERR_INVALID_ARG – p_request_handle, p_grouped_light_data, or p_grouped_light_data's resource ID are
  * NULL or resource ID is not in the correct format as specified by the Philips Hue API
- * @retval - @c ESP_ERR_INVALID_RESPONSE – Encoding error encountered during JSON generation
- * @retval - @c ESP_ERR_INVALID_SIZE – JSON buffer was too small or a failure occurred with copying of data to request
- * instance
  * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory for request instance
+ *
+ * @note Actions are stored packed and only rendered to JSON when the request is sent, values out of range for Hue's
+ * API are clipped at that point
  */
 esp_err_t hue_https_create_grouped_light_request(hue_https_request_handle_t* p_request_handle,
                                                  hue_grouped_light_data_t* p_grouped_light_data);
@@ -91,14 +228,33 @@ esp_err_t hue_https_create_grouped_light_request(hue_https_request_handle_t* p_r
  * @retval - @c ESP_OK – Request instance successfully created
  * @retval - @c ESP_ERR_INVALID_ARG – p_request_handle, p_smart_scene_data, or p_smart_scene_data's resource ID are NULL
  * or resource ID is not in the correct format as specified by the Philips Hue API
- * @retval - @c ESP_ERR_INVALID_RESPONSE – Encoding error encountered during JSON generation
- * @retval - @c ESP_ERR_INVALID_SIZE – JSON buffer was too small or a failure occurred with copying of data to request
- * instance
  * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory for request instance
+ *
+ * @note Actions are stored packed and only rendered to JSON when the request is sent
  */
 esp_err_t hue_https_create_smart_scene_request(hue_https_request_handle_t* p_request_handle,
                                                hue_smart_scene_data_t* p_smart_scene_data);
 
+/**
+ * @brief Create HTTPS request instance using hue scene data for actions to perform
+ *
+ * Recalling a scene sets every light in it with one bridge command, where setting the same lights directly takes a
+ * light request each.
+ *
+ * @param[out] p_request_handle Request handle to store instance into to be used with hue https instance
+ * @param[in] p_scene_data Actions to be performed on specified scene resource
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Request instance successfully created
+ * @retval - @c ESP_ERR_INVALID_ARG – p_request_handle, p_scene_data, or p_scene_data's resource ID are NULL or resource
+ * ID is not in the correct format as specified by the Philips Hue API
+ * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory for request instance
+ *
+ * @note Actions are stored packed and only rendered to JSON when the request is sent, values out of range for Hue's
+ * API are clipped at that point
+ */
+esp_err_t hue_https_create_scene_request(hue_https_request_handle_t* p_request_handle, hue_scene_data_t* p_scene_data);
+
 /**
  * @brief Destroys HTTPS request instance and frees all associated resources
  *
@@ -106,9 +262,46 @@ esp_err_t hue_https_create_smart_scene_request(hue_https_request_handle_t* p_req
  *
  * @return ESP Error code
  * @retval - @c ESP_OK – Request instance successfully destroyed and freed
+ * @retval - @c ESP_ERR_INVALID_ARG – p_request_handle or the request handle it points to are NULL
+ *
+ * @note Hue HTTPS instances keep their own copy of performed requests, so a request may be destroyed while pending
  */
 esp_err_t hue_https_destroy_request(hue_https_request_handle_t* p_request_handle);
 
+/**
+ * @brief Sets the deadline of a request, as the time from its trigger after which it is discarded instead of sent
+ *
+ * @param[in] request_handle Request handle to set the deadline of (from hue_https_create_[type]_request())
+ * @param[in] ttl_ms Time from trigger the request may still be sent in, 0 for no deadline (the default)
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Deadline set
+ * @retval - @c ESP_ERR_INVALID_ARG – request_handle is NULL
+ *
+ * @note A request with a deadline is dropped if it is still queued or held when the deadline passes, and is retried
+ * until the deadline instead of retry_attempts times. A retry or back off that would only start after the deadline is
+ * given up on rather than waited for. Either way it counts as requests_expired.
+ */
+esp_err_t hue_https_set_request_ttl(hue_https_request_handle_t request_handle, uint16_t ttl_ms);
+
+/**
+ * @brief Sets the priority class of a request
+ *
+ * @param[in] request_handle Request handle to set the priority class of (from hue_https_create_[type]_request())
+ * @param[in] priority Priority class, requests are created HUE_HTTPS_PRIORITY_INTERACTIVE
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Priority class set
+ * @retval - @c ESP_ERR_INVALID_ARG – request_handle is NULL or priority is not a priority class
+ *
+ * @note Background requests are never ignored or forced through. Performed while another request is running they
+ * are queued, one per resource with the latest replacing any queued one, and only sent once no interactive request is
+ * waiting. Interactive requests performed while a background request is running become the next request even without
+ * force_through. A background request still waiting for a token gives way to them and is queued again, one already
+ * being sent is only aborted and queued again with force_through or preempt_background.
+ */
+esp_err_t hue_https_set_request_priority(hue_https_request_handle_t request_handle, hue_https_priority_t priority);
+
 /**
  * @brief Sends request handle to Hue HTTPS instance to be performed
  *
@@ -117,11 +310,126 @@ esp_err_t hue_https_destroy_request(hue_https_request_handle_t* p_request_handle
  * @param[in] force_through If true, the request will abort any currently running request and send the new one,
  * otherwise the new request will be ignored if a request is currently running
  * 
+ * @note While WiFi is disconnected the request is held instead, replacing any held request for the same resource, and
+ * all held requests are sent together once WiFi reconnects. Interactive requests made while they are sent go between
+ * them, replacing any still held for the same resource. Held requests count towards the statistics but not the
+ * latencies, the time to send all of them is last_converge_us.
  * @note Will only attempt to acquire mutex for 5 seconds before failing to prevent permanent blocking
  */
 void hue_https_perform_request(hue_https_handle_t hue_https_handle, hue_https_request_handle_t request_handle,
                                bool force_through);
-                               
+
+/**
+ * @brief Sends request handle to Hue HTTPS instance to be performed, measuring latency from an earlier trigger time
+ *
+ * @param[in] hue_https_handle Hue HTTPS handle to send request with (from hue_https_create_instance())
+ * @param[in] request_handle Request handle to send (from hue_https_create_[type]_request())
+ * @param[in] force_through If true, the request will abort any currently running request and send the new one,
+ * otherwise the new request will be ignored if a request is currently running
+ * @param[in] trigger_time_us esp_timer_get_time() timestamp of the event that triggered the request (e.g. the beacon
+ * sample that crossed the proximity threshold), used as the start of the latency reported in hue_https_stats_t
+ * @param[in] ttl_ms Deadline as time from trigger_time_us, replacing the request's own, 0 to keep the request's own
+ *
+ * @note The request is handed directly to the Hue HTTPS instance task without passing through an event loop, so this
+ * is safe to call from latency sensitive contexts such as a proximity edge callback
+ * @note Will only attempt to acquire mutex for 5 seconds before failing to prevent permanent blocking
+ */
+void hue_https_perform_triggered_request(hue_https_handle_t hue_https_handle, hue_https_request_handle_t request_handle,
+                                         bool force_through, int64_t trigger_time_us, uint16_t ttl_ms);
+
+/**
+ * @brief Sends a predefined request to Hue HTTPS instance to be performed, without creating a request handle
+ *
+ * @param[in] hue_https_handle Hue HTTPS handle to send request with (from hue_https_create_instance())
+ * @param[in] p_template Request to send, usually a const template in flash
+ * @param[in] force_through If true, the request will abort any currently running request and send the new one,
+ * otherwise the new request will be ignored if a request is currently running
+ *
+ * @note Will only attempt to acquire mutex for 5 seconds before failing to prevent permanent blocking
+ */
+void hue_https_perform_template(hue_https_handle_t hue_https_handle, const hue_https_request_template_t* p_template,
+                                bool force_through);
+
+/**
+ * @brief Sends a predefined request to Hue HTTPS instance to be performed, measuring latency from an earlier trigger
+ * time
+ *
+ * @param[in] hue_https_handle Hue HTTPS handle to send request with (from hue_https_create_instance())
+ * @param[in] p_template Request to send, usually a const template in flash
+ * @param[in] force_through If true, the request will abort any currently running request and send the new one,
+ * otherwise the new request will be ignored if a request is currently running
+ * @param[in] trigger_time_us esp_timer_get_time() timestamp of the event that triggered the request, used as the start
+ * of the latency reported in hue_https_stats_t
+ * @param[in] ttl_ms Deadline as time from trigger_time_us, replacing the template's own, 0 to keep the template's own
+ *
+ * @note Safe to call from latency sensitive contexts, see hue_https_perform_triggered_request()
+ * @note Will only attempt to acquire mutex for 5 seconds before failing to prevent permanent blocking
+ */
+void hue_https_perform_triggered_template(hue_https_handle_t hue_https_handle,
+                                          const hue_https_request_template_t* p_template, bool force_through,
+                                          int64_t trigger_time_us, uint16_t ttl_ms);
+
+/* hue_https_group.c */
+
+/**
+ * @brief Sets the rooms and zones light batches are consolidated with, replacing any set before
+ *
+ * @param[in] hue_https_handle Hue HTTPS handle to set the membership of (from hue_https_create_instance())
+ * @param[in] p_groups Membership of each room or zone, e.g. from the app's configuration or its own GET of the bridge's
+ * room and zone resources, copied, may be NULL if group_count is 0
+ * @param[in] group_count [0-HUE_HTTPS_GROUPS_SIZE] Number of entries in p_groups, 0 to stop consolidating
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Membership set
+ * @retval - @c ESP_ERR_INVALID_ARG – hue_https_handle or a resource ID are NULL, p_groups is NULL with a group_count,
+ * group_count or a light_count are out of range, or a resource ID is not in the correct format as specified by the
+ * Philips Hue API
+ * @retval - @c ESP_ERR_NO_MEM – Resource table has no room for the resource IDs not used before, none are added
+ * @retval - @c ESP_ERR_TIMEOUT – Failed to acquire instance mutex within 5 seconds
+ *
+ * @note Membership is kept as it was on any error. The bridge does not report membership changes, so set it again
+ * whenever rooms or zones are edited, a stale room would set a light that was moved out of it.
+ */
+esp_err_t hue_https_set_groups(hue_https_handle_t hue_https_handle, const hue_https_group_t* p_groups,
+                               uint8_t group_count);
+
+/**
+ * @brief Performs the same light actions on several lights, sending one grouped light request for every room or zone
+ * whose lights are all in the batch and light requests only for the rest
+ *
+ * @param[in] hue_https_handle Hue HTTPS handle to send the requests with (from hue_https_create_instance())
+ * @param[in] light_ids Resource IDs of the lights to act on, duplicates are sent once
+ * @param[in] light_count [1-HUE_HTTPS_GROUP_MAX_LIGHTS] Number of resource IDs in light_ids
+ * @param[in] p_light_data Actions to perform on every light, resource_id is not used
+ * @param[in] force_through If true, the batch will abort any currently running request, otherwise the batch will be
+ * ignored if a request is currently running
+ * @param[out] p_result Storage for how the batch was sent, may be NULL. Only covers the requests queued, also when the
+ * batch stopped part way through
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Batch sent, held or queued
+ * @retval - @c ESP_ERR_INVALID_ARG – hue_https_handle, light_ids, p_light_data, or a resource ID are NULL, light_count
+ * is out of range, or a resource ID is not in the correct format as specified by the Philips Hue API
+ * @retval - @c ESP_ERR_NO_MEM – Resource table is full, or the background queue or held requests filled up and the
+ * rest of the batch was not queued
+ * @retval - @c ESP_ERR_INVALID_STATE – A request was running and force_through was not set, batch ignored
+ * @retval - @c ESP_ERR_TIMEOUT – Failed to acquire instance mutex within 5 seconds, the rest of the batch was not
+ * queued
+ *
+ * @note A grouped light request takes as much of the bridge's command budget as about ten light requests, so a room
+ * or zone covering at least two lights of the batch not covered yet is only used when, given the tokens each bucket
+ * holds right now, the batch finishes no later with its grouped light request than with its light requests. An idle
+ * room of 8 is sent as one grouped light request, while just after another grouped light request its lights go one by
+ * one when that is sooner. Rooms and zones covering the most are picked first.
+ * @note Only the first request of the batch is interactive, the others are queued as background requests so none
+ * replaces another, and are sent in order ahead of background requests queued later.
+ * @note Grouped lights cannot play effects, so a batch with an effect or timed effect is always sent as light requests
+ * @note Will only attempt to acquire mutex for 5 seconds before failing to prevent permanent blocking
+ */
+esp_err_t hue_https_perform_light_batch(hue_https_handle_t hue_https_handle, const char* const* light_ids,
+                                        uint8_t light_count, const hue_light_data_t* p_light_data, bool force_through,
+                                        hue_https_batch_result_t* p_result);
+
 /* hue_https_instance.c */
 
 /**
@@ -138,6 +446,24 @@ void hue_https_perform_request(hue_https_handle_t hue_https_handle, hue_https_re
  * @retval - @c ESP_ERR_INVALID_SIZE – Bridge IP, ID, or Application Key in p_hue_https_config are not valid
  * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory or to create Event Group, Mutex, or Task for Hue HTTPS
  * instance
+ * @retval - @c ESP_ERR_INVALID_STATE – Default event loop has not been created
+ *
+ * @note Requests wait for a token from their resource type's bucket before every attempt, so bursts are spread to the
+ * bridge's command budget instead of earning 429 responses. A forced request arriving meanwhile replaces the waiting
+ * one, so the request sent once a token frees up always holds the latest state.
+ * @note 429 and 503 responses halve the send rate of every paced type and hold all requests for the response's
+ * Retry-After, each 200 OK raises it again by a few percent up to the configured rates. Throttled requests are retried
+ * without using up retry_attempts.
+ * @note Requests with a deadline (see hue_https_set_request_ttl()) are retried until it passes rather than
+ * retry_attempts times, and are discarded instead of sent late.
+ *
+ * @attention The instance follows \c WIFI_CONNECT_EVENT events on the default event loop, so it must be created before
+ * wifi_connect() is called. Requests are only sent while connected. On connection the bridge connection is opened and
+ * verified straight away, so the first request only costs its own round trip, and on disconnection it is torn down.
+ *
+ * @note With task_placement_set, an out of range priority or a core the chip does not have returns
+ * ESP_ERR_INVALID_ARG. Pinning the task to the core not running the WiFi and Bluetooth stacks (core 1 by default on
+ * ESP32) keeps TLS handshakes and request rendering from competing with the radio.
  */
 esp_err_t hue_https_create_instance(hue_https_handle_t* p_hue_https_handle, hue_https_config_t* p_hue_https_config);
 
@@ -151,6 +477,35 @@ esp_err_t hue_https_create_instance(hue_https_handle_t* p_hue_https_handle, hue_
  */
 esp_err_t hue_https_destroy_instance(hue_https_handle_t* p_hue_https_handle);
 
+/**
+ * @brief Copies the request statistics of a Hue HTTPS instance
+ *
+ * @param[in] hue_https_handle Hue HTTPS handle to get statistics of
+ * @param[out] p_stats Storage for the statistics
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Statistics copied
+ * @retval - @c ESP_ERR_INVALID_ARG – hue_https_handle or p_stats are NULL
+ * @retval - @c ESP_ERR_TIMEOUT – Failed to acquire instance mutex within 5 seconds
+ */
+esp_err_t hue_https_get_stats(hue_https_handle_t hue_https_handle, hue_https_stats_t* p_stats);
+
+/**
+ * @brief Gets the exact number of bytes held by requests being performed or waiting in a Hue HTTPS instance
+ *
+ * @param[in] hue_https_handle Hue HTTPS handle to measure
+ * @param[out] p_bytes Storage for the number of bytes
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Footprint measured
+ * @retval - @c ESP_ERR_INVALID_ARG – hue_https_handle or p_bytes are NULL
+ * @retval - @c ESP_ERR_TIMEOUT – Failed to acquire instance mutex within 5 seconds
+ *
+ * @note Requests are copied in as packed descriptors and rendered to JSON in a single buffer owned by the instance when
+ * sent, so the footprint grows by a fixed descriptor size per request and does not depend on the actions requested
+ */
+esp_err_t hue_https_get_queue_footprint(hue_https_handle_t hue_https_handle, size_t* p_bytes);
+
 #ifdef __cplusplus
 }
 #endif
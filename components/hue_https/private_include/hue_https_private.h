@@ -13,10 +13,12 @@
 #include "freertos/semphr.h"
 #include "freertos/task.h"
 
+#include "esp_event.h"
 #include "esp_http_client.h"
 #include "esp_bit_defs.h"
 
 #include "hue_https.h"
+#include "hue_validate.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,33 +28,21 @@ extern "C" {
 /*===================================================== Defines ======================================================*/
 /*====================================================================================================================*/
 
-#define HUE_REQUEST_BUFFER_SIZE 512
+#define HUE_REQUEST_BUFFER_SIZE 512 /**< Size of buffer storing the response body, longer bodies are truncated */
 
-/** Bridge ID scanf format with 16 hexadecimal characters */
-#define HUE_BRIDGE_ID_FORMAT "%*16x"
-/** Length of bridge ID without null-terminating character */
-#define HUE_BRIDGE_ID_LENGTH 16
-
-/** Bridge IP scanf format with standard 4 byte IP formatting */
-#define HUE_BRIDGE_IP_FORMAT "%*3u.%*3u.%*3u.%*3u"
-/** Length of bridge IP without null-terminating character */
-#define HUE_BRIDGE_IP_LENGTH 15
-
-/** Application key scanf format with 40 URL Base64 characters */
-#define HUE_APPLICATION_KEY_FORMAT "%*40[-_0-9a-zA-Z]"
-/** Length of application key without null-terminating character */
-#define HUE_APPLICATION_KEY_LENGTH 40
-
-/** Resource ID scanf format using hexadecimal characters: "[8 chars]-[4 chars]-[4 chars]-[4 chars]-[12 chars]" */
-#define HUE_RESOURCE_ID_FORMAT "%*8x-%*4x-%*4x-%*4x-%*12x"
-/** Length of resource ID format without null-terminating character */
-#define HUE_RESOURCE_ID_LENGTH 36
+/** Number of different resource IDs that can be interned, every light and grouped light of HUE_HTTPS_GROUPS_SIZE full
+ * rooms and zones and 64 more for other resources and memberships set since. Must fit the 8 bit resource_index of
+ * request instances */
+#define HUE_RESOURCE_TABLE_SIZE (HUE_HTTPS_GROUPS_SIZE * (HUE_HTTPS_GROUP_MAX_LIGHTS + 1) + 64)
 
 /** Philips Hue path to resource */
 #define HUE_RESOURCE_PATH "/clip/v2/resource/"
 /** Length of HUE_RESOURCE_PATH without null-terminating character */
 #define HUE_RESOURCE_PATH_LENGTH 18
 
+/** Resource path fetched to open and verify the bridge connection, checks both the certificate and application key */
+#define HUE_PREWARM_RESOURCE "bridge"
+
 /** Length of "https://" + strlen("0.0.0.0") + HUE_RESOURCE_PATH */
 #define HUE_URL_BASE_MIN_LENGTH 8 + 7 + HUE_RESOURCE_PATH_LENGTH
 /** Length of "https://" + strlen("000.000.000.000") + HUE_RESOURCE_PATH */
@@ -64,17 +54,94 @@ extern "C" {
 /** Size of "https://" + IPV4 address + HUE_RESOURCE_PATH + longest resource type id + resource id length */
 #define HUE_URL_BUFFER_SIZE HUE_URL_BASE_SIZE + HUE_URL_RES_PATH_LENGTH
 
+/** Number of resources requests can be held for while WiFi is disconnected, only the latest per resource is held */
+#define HUE_HTTPS_HELD_REQUESTS_SIZE 16
+
+/** Number of resources background requests can be queued for, only the latest per resource is queued */
+#define HUE_HTTPS_BACKGROUND_QUEUE_SIZE 16
+
+/* Adaptive send rate, every paced interval is stretched by 100 / send rate percent */
+#define HUE_HTTPS_SEND_RATE_MIN_PERCENT 6      /**< Send rate floor, about a sixteenth of the configured rate */
+#define HUE_HTTPS_SEND_RATE_INCREASE_PERCENT 5 /**< Additive increase after every 200 OK */
+#define HUE_HTTPS_THROTTLE_RETRIES 5           /**< Throttled responses retried per request, on top of retry_attempts */
+#define HUE_HTTPS_RETRY_AFTER_DEFAULT_MS 1000  /**< Back off used when a throttling response has no Retry-After */
+#define HUE_HTTPS_RETRY_AFTER_MAX_MS 30000     /**< Longest Retry-After honoured, so a bad header cannot stall sends */
+
+/** Delay between attempts of a request that failed to perform */
+#define HUE_HTTPS_RETRY_DELAY_US 1000000
+
+/** Trigger to 200 OK latency that successful requests are expected to stay under */
+#define HUE_HTTPS_LATENCY_TARGET_US 1000000
+
 #define HUE_HTTPS_EVT_WIFI_CONNECTED_BIT BIT0
 #define HUE_HTTPS_EVT_TRIGGER_BIT BIT1
 #define HUE_HTTPS_EVT_ABORT_BIT BIT2
 #define HUE_HTTPS_EVT_EXIT_BIT BIT3
+#define HUE_HTTPS_EVT_LINK_CHANGED_BIT BIT4 /**< WiFi connected or disconnected, the bridge connection must follow */
+#define HUE_HTTPS_EVT_YIELD_BIT BIT5        /**< Interactive request waiting, background ones waiting on tokens yield */
 
-#define HUE_HTTPS_EVT_WAIT_BITS HUE_HTTPS_EVT_WIFI_CONNECTED_BIT | HUE_HTTPS_EVT_TRIGGER_BIT | HUE_HTTPS_EVT_EXIT_BIT
+/* WIFI_CONNECTED is a level rather than a wake up, waiting on it would spin for as long as WiFi is connected */
+#define HUE_HTTPS_EVT_WAIT_BITS HUE_HTTPS_EVT_LINK_CHANGED_BIT | HUE_HTTPS_EVT_TRIGGER_BIT | HUE_HTTPS_EVT_EXIT_BIT
 
 /*====================================================================================================================*/
 /*======================================= Shared Private Structure Definitions =======================================*/
 /*====================================================================================================================*/
 
+/** @brief Response body accumulated from HTTP_EVENT_ON_DATA chunks */
+typedef struct {
+    char buff[HUE_REQUEST_BUFFER_SIZE]; /**< Response body, always null-terminated, truncated if too long */
+    size_t length;                      /**< Number of characters stored in buff */
+    int32_t retry_after_ms;             /**< Retry-After header of the response, -1 if not sent or not understood */
+} hue_https_response_t;
+
+/**
+ * @brief Packed descriptor of a request, the HTTP request body and URL resource path are rendered from it by the Hue
+ * HTTPS instance task when the request is sent
+ *
+ * @note Bitfields match hue_light_data_t, smart scene requests store deactivate in off and scene requests store a
+ * brightness override as a brightness_action of HUE_ACTION_SET. Two requests target the same resource when both
+ * resource_type and resource_index are equal. The deadline is kept relative, so a copy queued with its trigger
+ * timestamp needs no separate deadline.
+ */
+typedef struct hue_https_request_instance {
+    uint64_t resource_index : 8;    /**< Resource ID, as an index from hue_https_resource_intern() */
+    uint64_t resource_type : 2;     /**< Resource targeted, as hue_https_resource_t */
+    uint64_t off : 1;               /**< Light off, or smart scene deactivate */
+    uint64_t brightness_action : 2; /**< How brightness should be adjusted, as hue_action_t */
+    uint64_t brightness : 7;        /**< Amount brightness should be adjusted by or set to */
+    uint64_t color_temp_action : 2; /**< How color temp should be adjusted, as hue_action_t */
+    uint64_t color_temp : 9;        /**< Amount color temp should be adjusted by or set to */
+    uint64_t set_color : 1;         /**< If color_gamut values should be used */
+    uint64_t color_gamut_x : 14;    /**< CIE X gamut position decimal value */
+    uint64_t color_gamut_y : 14;    /**< CIE Y gamut position decimal value */
+    uint64_t priority : 1;          /**< Priority class, as hue_https_priority_t */
+    uint16_t ttl_ms;                /**< Time from trigger the request may still be sent in, 0 for no deadline */
+    uint32_t set_duration : 1;      /**< If duration should be used */
+    uint32_t duration : 16;         /**< Transition or timed effect length in HUE_DURATION_STEP_MS steps */
+    uint32_t effect : 4;            /**< Effect loop to play, as hue_effect_t */
+    uint32_t timed_effect : 2;      /**< Timed effect to play, as hue_timed_effect_t */
+    uint32_t scene_action : 2;      /**< How a scene should be recalled, as hue_scene_action_t */
+} hue_https_request_instance_t;
+
+/* resource_type has no spare value left, a fifth resource type needs a wider field rather than a silently wrapped one */
+_Static_assert(HUE_HTTPS_RESOURCE_COUNT <= 4, "hue_https_resource_t must fit the 2 bit resource_type");
+/* Every queue and table copies descriptors by value, so growing past 16 bytes would grow all of them */
+_Static_assert(sizeof(hue_https_request_instance_t) == 16, "hue_https_request_instance_t must stay 16 bytes");
+
+/** @brief Request waiting in a table of one request per resource, held while WiFi is disconnected or queued behind
+ * interactive requests */
+typedef struct {
+    hue_https_request_instance_t request; /**< Latest request for its resource */
+    int64_t trigger_us;                   /**< Trigger timestamp of request */
+} hue_https_queued_request_t;
+
+/** @brief Room or zone membership, as resource table indices */
+typedef struct {
+    uint8_t grouped_light_index;                       /**< Index of the room or zone's grouped_light */
+    uint8_t light_count;                               /**< Number of entries in light_indices */
+    uint8_t light_indices[HUE_HTTPS_GROUP_MAX_LIGHTS]; /**< Index of every light in the room or zone */
+} hue_https_group_entry_t;
+
 /** @brief Storage for all required data for hue_https instance */
 typedef struct hue_https_instance {
     TaskHandle_t task_handle;      /**< Task handle for performing requests with instance */
@@ -85,23 +152,219 @@ typedef struct hue_https_instance {
     char bridge_id[HUE_BRIDGE_ID_LENGTH + 1];     /**< Bridge ID needed for CA Cert verification*/
     char app_key[HUE_APPLICATION_KEY_LENGTH + 1]; /**< Application key needed for requests */
     esp_http_client_config_t client_config;       /**< Config for http clients under this instance */
+    esp_http_client_handle_t client;              /**< Keep-alive client, only used by the instance task */
+    esp_event_handler_instance_t wifi_handler;    /**< WIFI_CONNECT_EVENT registration */
+    hue_https_response_t response;                /**< Body of the most recent response, set as client user_data */
+    hue_json_buffer_t request_json;               /**< Scratch buffer the current request body is rendered into */
+
+    /* Requests are copied in when performed, so handles can be destroyed and templates need no handle at all */
+    SemaphoreHandle_t request_handle_mutex;       /**< Protects requests from parallel tasks */
+    hue_https_request_instance_t current_request; /**< Request being performed, valid while current_pending */
+    hue_https_request_instance_t next_request;    /**< Request to replace current, valid while next_pending */
+    bool current_pending;                         /**< If current_request holds a request */
+    bool next_pending;                            /**< If next_request holds a request */
+    int64_t current_trigger_us;                   /**< Trigger timestamp of current request */
+    int64_t next_trigger_us;                      /**< Trigger timestamp of next request */
+    uint8_t retry_attempts;  /**< Maximum number of times to retry HTTPS request before failing */
+    bool preempt_background; /**< If interactive requests abort a running background request */
+
+    /* Token buckets are only taken by the instance task, each kept as the time it will be full again */
+    hue_https_rate_limit_t rate_limits[HUE_HTTPS_RESOURCE_COUNT]; /**< Pacing per resource type */
+    int64_t bucket_full_us[HUE_HTTPS_RESOURCE_COUNT];             /**< When each bucket refills, written under mutex */
+    uint8_t send_rate_percent; /**< Share of the configured rates sent at, lowered by 429s, written under mutex */
+    int64_t backoff_until_us;  /**< No request of any type is sent before this, set from Retry-After */
+
+    /* Held requests are protected by request_handle_mutex and sent by the instance task once WiFi reconnects */
+    hue_https_queued_request_t held[HUE_HTTPS_HELD_REQUESTS_SIZE]; /**< At most one request per resource */
+    uint8_t held_count;                                            /**< Number of entries in held */
+
+    /* Background requests are protected by request_handle_mutex and sent in order once no interactive one waits */
+    hue_https_queued_request_t background[HUE_HTTPS_BACKGROUND_QUEUE_SIZE]; /**< At most one request per resource */
+    uint8_t background_count;                                               /**< Number of entries in background */
 
-    SemaphoreHandle_t request_handle_mutex;            /**< Protects request handles from parallel tasks */
-    hue_https_request_handle_t current_request_handle; /**< Handle for request being performed */
-    hue_https_request_handle_t next_request_handle;    /**< Handle for request to replace current */
-    uint8_t retry_attempts; /**< Maximum number of times to retry HTTPS request before failing */
+    /* Room and zone membership is protected by request_handle_mutex and only read when a light batch is planned */
+    hue_https_group_entry_t groups[HUE_HTTPS_GROUPS_SIZE]; /**< Rooms and zones light batches are consolidated with */
+    uint8_t group_count;                                   /**< Number of entries in groups */
+
+    hue_https_stats_t stats; /**< Request statistics, protected by request_handle_mutex */
 } hue_https_instance_t;
 
-/** @brief Storage for HTTP request body and URL resource path */
-typedef struct hue_https_request_instance {
-    char* request_body;  /**< Body of HTTP request storing Philips Hue actions */
-    char* resource_path; /**< URL path to resource with resource type and ID */
-} hue_https_request_instance_t;
 
 /*====================================================================================================================*/
 /*======================================= Shared Private Function Declarations =======================================*/
 /*====================================================================================================================*/
 
+/* hue_https_instance.c */
+
+/**
+ * @brief Empties a response buffer before a new response is received
+ *
+ * @param[out] p_response Response buffer to empty
+ */
+void hue_https_response_reset(hue_https_response_t* p_response);
+
+/**
+ * @brief Appends a received body chunk to a response buffer, truncating anything past the end of the buffer
+ *
+ * @param[in,out] p_response Response buffer to append to
+ * @param[in] data Chunk data, not null-terminated and may contain null characters
+ * @param[in] data_len Number of characters in data
+ */
+void hue_https_response_append(hue_https_response_t* p_response, const char* data, int data_len);
+
+/**
+ * @brief Parses a Retry-After header value into a response, only delay-seconds are understood
+ *
+ * @param[in,out] p_response Response to store retry_after_ms into, capped at HUE_HTTPS_RETRY_AFTER_MAX_MS
+ * @param[in] value Null-terminated header value, an HTTP date or anything else not all digits sets retry_after_ms -1
+ */
+void hue_https_response_parse_retry_after(hue_https_response_t* p_response, const char* value);
+
+/**
+ * @brief Holds a request until WiFi reconnects, replacing any held request for the same resource, must be called while
+ * holding the request handle mutex
+ *
+ * @param[in,out] https_handle Hue HTTPS instance to hold the request in
+ * @param[in] p_request Request to hold
+ * @param[in] trigger_us Trigger timestamp of the request
+ * @param[in] replace If a held request for the same resource is replaced, false for requests older than any held one
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Request held
+ * @retval - @c ESP_ERR_INVALID_STATE – A request for the same resource was already held, counted as coalesced
+ * @retval - @c ESP_ERR_NO_MEM – Held requests are full, request dropped and counted as failed
+ */
+esp_err_t hue_https_hold_request(hue_https_handle_t https_handle, const hue_https_request_instance_t* p_request,
+                                 int64_t trigger_us, bool replace);
+
+/**
+ * @brief Queues a background request behind every interactive request, replacing any queued request for the same
+ * resource, must be called while holding the request handle mutex
+ *
+ * @param[in,out] https_handle Hue HTTPS instance to queue the request in
+ * @param[in] p_request Request to queue
+ * @param[in] trigger_us Trigger timestamp of the request
+ * @param[in] replace If a queued request for the same resource is replaced, false for requests older than any queued
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Request queued
+ * @retval - @c ESP_ERR_INVALID_STATE – A request for the same resource was already queued, counted as coalesced
+ * @retval - @c ESP_ERR_NO_MEM – Queue is full, request dropped and counted as failed
+ */
+esp_err_t hue_https_queue_background_request(hue_https_handle_t https_handle,
+                                             const hue_https_request_instance_t* p_request, int64_t trigger_us,
+                                             bool replace);
+
+/* hue_https_request_instance.c */
+
+/**
+ * @brief Renders a request descriptor into its HTTP request body and URL resource path
+ *
+ * @param[in] p_request Request to render
+ * @param[out] p_json_buffer Buffer to render the request body into
+ * @param[out] resource_path Buffer to print "[resource type]/[resource ID]" into
+ * @param[in] resource_path_size Size of resource_path, including space for the null-terminating character
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Request body and resource path rendered
+ * @retval - @c ESP_ERR_INVALID_ARG – p_request, p_json_buffer, or resource_path are NULL or the descriptor's
+ * resource type is unknown
+ * @retval - @c ESP_ERR_INVALID_RESPONSE – Encoding error encountered during JSON generation
+ * @retval - @c ESP_ERR_INVALID_SIZE – JSON buffer or resource_path were too small
+ */
+esp_err_t hue_https_render_request(const hue_https_request_instance_t* p_request, hue_json_buffer_t* p_json_buffer,
+                                   char* resource_path, size_t resource_path_size);
+
+/**
+ * @brief Packs light actions into a request descriptor
+ *
+ * @param[out] request_handle Request descriptor to fill
+ * @param[in] p_light_data Light actions to pack, resource_id is not used
+ */
+void hue_https_pack_light_data(hue_https_request_handle_t request_handle, const hue_light_data_t* p_light_data);
+
+/**
+ * @brief Copies a request into a Hue HTTPS instance, as the current request or as the next one if one is running, or
+ * holds it while WiFi is disconnected
+ *
+ * @param[in] hue_https_handle Hue HTTPS handle to send request with
+ * @param[in] p_request Request descriptor to copy
+ * @param[in] force_through If true, the request will abort any currently running request and send the new one,
+ * otherwise the new request will be ignored if a request is currently running
+ * @param[in] trigger_time_us Timestamp of the event that triggered the request
+ * @param[in] ttl_ms Deadline replacing the request's own, 0 to keep the request's own
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Request copied in, held or queued as background work
+ * @retval - @c ESP_ERR_INVALID_STATE – An interactive request was running and force_through was not set, request
+ * ignored
+ * @retval - @c ESP_ERR_NO_MEM – Request was to be held or queued as background work but there was no room, request
+ * dropped
+ * @retval - @c ESP_ERR_TIMEOUT – Failed to acquire instance mutex within 5 seconds, request not sent
+ */
+esp_err_t hue_https_queue_request(hue_https_handle_t hue_https_handle, const hue_https_request_instance_t* p_request,
+                                  bool force_through, int64_t trigger_time_us, uint16_t ttl_ms);
+
+/* hue_https_resource_table.c */
+
+/**
+ * @brief Parses a resource ID into its UUID and returns its index in the resource table, adding it if not yet present
+ *
+ * @param[in] resource_id Resource ID in the format specified by the Philips Hue API
+ * @param[out] p_index Storage for the index, equal for every call with the same UUID regardless of letter case
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Resource ID interned
+ * @retval - @c ESP_ERR_INVALID_ARG – resource_id or p_index are NULL or resource_id is not 32 hexadecimal characters
+ * @retval - @c ESP_ERR_NO_MEM – Resource table is full or its mutex could not be created
+ * @retval - @c ESP_ERR_TIMEOUT – Failed to acquire resource table mutex within 5 seconds
+ *
+ * @note Entries live for the rest of the program, the table holds at most HUE_RESOURCE_TABLE_SIZE resource IDs
+ */
+esp_err_t hue_https_resource_intern(const char* resource_id, uint8_t* p_index);
+
+/**
+ * @brief Returns the index of an already packed resource UUID in the resource table, adding it if not yet present
+ *
+ * @param[in] packed_id HUE_RESOURCE_ID_PACKED_SIZE bytes of the UUID, in the order they are printed
+ * @param[out] p_index Storage for the index, equal to the one hue_https_resource_intern() gives for the same UUID
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Resource UUID interned
+ * @retval - @c ESP_ERR_INVALID_ARG – packed_id or p_index are NULL
+ * @retval - @c ESP_ERR_NO_MEM – Resource table is full or its mutex could not be created
+ * @retval - @c ESP_ERR_TIMEOUT – Failed to acquire resource table mutex within 5 seconds
+ */
+esp_err_t hue_https_resource_intern_packed(const uint8_t* packed_id, uint8_t* p_index);
+
+/**
+ * @brief Returns the index of a resource ID in the resource table without adding it
+ *
+ * @param[in] resource_id Resource ID in the format specified by the Philips Hue API
+ * @param[out] p_index Storage for the index, set only if the resource ID is interned
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Resource ID found
+ * @retval - @c ESP_ERR_INVALID_ARG – resource_id or p_index are NULL or resource_id is not 32 hexadecimal characters
+ * @retval - @c ESP_ERR_NOT_FOUND – Resource ID is not interned
+ */
+esp_err_t hue_https_resource_find(const char* resource_id, uint8_t* p_index);
+
+/**
+ * @brief Returns the number of resource IDs that can still be interned
+ *
+ * @return Free entries of the resource table
+ */
+uint8_t hue_https_resource_free_count(void);
+
+/**
+ * @brief Prints an interned resource ID in the lowercase format specified by the Philips Hue API
+ *
+ * @param[in] index Index from hue_https_resource_intern()
+ * @param[out] resource_id Buffer of at least HUE_RESOURCE_ID_LENGTH + 1 characters
+ */
+void hue_https_resource_id_to_str(uint8_t index, char* resource_id);
+
 #ifdef __cplusplus
 }
 #endif
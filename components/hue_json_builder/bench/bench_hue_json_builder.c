@@ -0,0 +1,198 @@
+/**
+ * @file bench_hue_json_builder.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Micro-benchmarks for hue_light_data_to_json(), reporting time per call, bytes written and stack used for each
+ * action combination
+ *
+ * Runs as Unity test cases tagged [hue_json_bench], through hue_test_app on device (timed with the CPU cycle counter)
+ * and through the host test runner (timed with CLOCK_MONOTONIC). Cases only fail if the serializer fails, the printed
+ * numbers are meant to be compared between builds.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#include "hue_json_builder.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#else
+#include <time.h>
+#endif
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#ifdef ESP_PLATFORM
+#define BENCH_ITERATIONS 1000       /**< Calls timed per case */
+#define BENCH_STACK_PAINT_SIZE 2048 /**< Bytes below the caller painted before measuring stack use */
+#else
+/* glibc's vsnprintf alone uses more than 2 KB of stack */
+#define BENCH_ITERATIONS 100000      /**< Calls timed per case */
+#define BENCH_STACK_PAINT_SIZE 16384 /**< Bytes below the caller painted before measuring stack use */
+#endif
+
+#define BENCH_STACK_PAINT_BYTE 0x5A /**< Value painted stack is filled with */
+
+#define BENCH_RESOURCE_ID "8c2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f5a6b"
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Times hue_light_data_to_json() for one light configuration and prints the results
+ *
+ * @param[in] name Name of the action combination printed with the results
+ * @param[in] p_light Light data to serialize
+ */
+static void bench_light(const char* name, hue_light_data_t* p_light);
+
+/**
+ * @brief Returns a timestamp in platform specific ticks, CPU cycles on device and nanoseconds on host
+ */
+static uint32_t bench_ticks(void);
+
+/**
+ * @brief Converts a difference of bench_ticks() values to nanoseconds
+ */
+static double bench_ticks_to_ns(uint32_t ticks);
+
+/**
+ * @brief Fills the BENCH_STACK_PAINT_SIZE bytes of stack below the caller's frame with BENCH_STACK_PAINT_BYTE
+ *
+ * @return Lowest painted address, to pass to bench_stack_used()
+ */
+static uintptr_t bench_stack_paint(void);
+
+/**
+ * @brief Returns how many bytes of the painted stack have been overwritten since bench_stack_paint()
+ *
+ * @param[in] painted Value returned by bench_stack_paint() from the same caller
+ */
+static size_t bench_stack_used(uintptr_t painted);
+
+/*====================================================================================================================*/
+/*=================================================== Test Cases =====================================================*/
+/*====================================================================================================================*/
+
+TEST_CASE("Bench on/off", "[hue_json_builder][hue_json_bench]") {
+    hue_light_data_t light = {.resource_id = BENCH_RESOURCE_ID};
+    bench_light("on", &light);
+    light.off = true;
+    bench_light("off", &light);
+}
+
+TEST_CASE("Bench brightness", "[hue_json_builder][hue_json_bench]") {
+    hue_light_data_t light = {.resource_id = BENCH_RESOURCE_ID, .brightness = 50};
+    light.brightness_action = HUE_ACTION_SET;
+    bench_light("brightness set", &light);
+    light.brightness_action = HUE_ACTION_ADD;
+    bench_light("brightness add", &light);
+    light.brightness_action = HUE_ACTION_SUBTRACT;
+    bench_light("brightness subtract", &light);
+}
+
+TEST_CASE("Bench color temp", "[hue_json_builder][hue_json_bench]") {
+    hue_light_data_t light = {.resource_id = BENCH_RESOURCE_ID, .color_temp = 300};
+    light.color_temp_action = HUE_ACTION_SET;
+    bench_light("color temp set", &light);
+    light.color_temp_action = HUE_ACTION_ADD;
+    bench_light("color temp add", &light);
+    light.color_temp_action = HUE_ACTION_SUBTRACT;
+    bench_light("color temp subtract", &light);
+}
+
+TEST_CASE("Bench xy color", "[hue_json_builder][hue_json_bench]") {
+    hue_light_data_t light = {.resource_id = BENCH_RESOURCE_ID, .set_color = true, .color_gamut_x = 3127,
+                              .color_gamut_y = 3290};
+    bench_light("xy color", &light);
+}
+
+TEST_CASE("Bench dynamics and effects", "[hue_json_builder][hue_json_bench]") {
+    hue_light_data_t light = {.resource_id = BENCH_RESOURCE_ID, .brightness_action = HUE_ACTION_SET, .brightness = 100,
+                              .set_duration = true, .duration = 30};
+    bench_light("fade", &light);
+    light.effect = HUE_EFFECT_CANDLE;
+    bench_light("fade with effect", &light);
+    light.timed_effect = HUE_TIMED_EFFECT_SUNRISE;
+    bench_light("sunrise", &light);
+}
+
+TEST_CASE("Bench every tag", "[hue_json_builder][hue_json_bench]") {
+    hue_light_data_t light = {
+        .resource_id = BENCH_RESOURCE_ID,
+        .brightness_action = HUE_ACTION_SET,
+        .brightness = 100,
+        .color_temp_action = HUE_ACTION_SUBTRACT,
+        .color_temp = 347,
+        .set_color = true,
+        .color_gamut_x = 9999,
+        .color_gamut_y = 10000,
+        .set_duration = true,
+        .duration = UINT16_MAX,
+        .effect = HUE_EFFECT_UNDERWATER,
+        .timed_effect = HUE_TIMED_EFFECT_NO_EFFECT,
+    };
+    bench_light("every tag", &light);
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static void bench_light(const char* name, hue_light_data_t* p_light) {
+    hue_json_buffer_t buffer;
+
+    /* Stack is measured on a single untimed call so painting does not disturb the timing */
+    uintptr_t painted = bench_stack_paint();
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, p_light));
+    size_t stack_used = bench_stack_used(painted);
+    size_t bytes = strlen(buffer.buff);
+
+    uint32_t start = bench_ticks();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) hue_light_data_to_json(&buffer, p_light);
+    uint32_t elapsed = bench_ticks() - start;
+
+    /* Output of the timed calls must match the measured call */
+    TEST_ASSERT_EQUAL(bytes, strlen(buffer.buff));
+
+    /* Stack use reaching the painted size means the real figure is at least that */
+    printf("hue_json_bench %-20s %9.1f ns/op %4u bytes %s%5u stack bytes\n", name,
+           bench_ticks_to_ns(elapsed) / BENCH_ITERATIONS, (unsigned)bytes,
+           (stack_used == BENCH_STACK_PAINT_SIZE) ? ">=" : "", (unsigned)stack_used);
+}
+
+#ifdef ESP_PLATFORM
+static uint32_t bench_ticks(void) { return esp_cpu_get_cycle_count(); }
+
+static double bench_ticks_to_ns(uint32_t ticks) { return (ticks * 1000.0) / esp_rom_get_cpu_ticks_per_us(); }
+#else
+static uint32_t bench_ticks(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec); /* Wraps after ~4 s, differences stay valid */
+}
+
+static double bench_ticks_to_ns(uint32_t ticks) { return ticks; }
+#endif
+
+static __attribute__((noinline)) uintptr_t bench_stack_paint(void) {
+    volatile uint8_t paint[BENCH_STACK_PAINT_SIZE];
+    for (size_t i = 0; i < BENCH_STACK_PAINT_SIZE; i++) paint[i] = BENCH_STACK_PAINT_BYTE;
+    return (uintptr_t)paint;
+}
+
+static __attribute__((noinline)) size_t bench_stack_used(uintptr_t painted) {
+    /* Stack grows down, so the lowest painted bytes still untouched mark the deepest point reached */
+    const volatile uint8_t* p_paint = (const volatile uint8_t*)painted;
+    size_t untouched = 0;
+    while ((untouched < BENCH_STACK_PAINT_SIZE) && (p_paint[untouched] == BENCH_STACK_PAINT_BYTE)) untouched++;
+    return BENCH_STACK_PAINT_SIZE - untouched;
+}
@@ -16,12 +16,27 @@
 
 static const char* tag = "hue_json_builder";
 
-/* TODO: Hue Scene Resource JSON construction (more testing of request needed to implement properly)
- *  [ ] scene
- *       [ ] recall:{action: str[active, static],
- *                   duration: uint,
- *                   dimming:{brightness: int[1-100]}}
- */
+/** @brief Scene "recall" action names, indexed by hue_scene_action_t */
+static const char* const scene_action_names[] = {
+    [HUE_SCENE_ACTION_ACTIVE] = "active",
+    [HUE_SCENE_ACTION_STATIC] = "static",
+    [HUE_SCENE_ACTION_DYNAMIC_PALETTE] = "dynamic_palette",
+};
+
+/** @brief "effects" tag names, indexed by hue_effect_t and sized for every value of the 4 bit field, NULL is skipped */
+static const char* const effect_names[16] = {
+    [HUE_EFFECT_NO_EFFECT] = "no_effect", [HUE_EFFECT_SPARKLE] = "sparkle",       [HUE_EFFECT_FIRE] = "fire",
+    [HUE_EFFECT_CANDLE] = "candle",       [HUE_EFFECT_PRISM] = "prism",           [HUE_EFFECT_OPAL] = "opal",
+    [HUE_EFFECT_GLISTEN] = "glisten",     [HUE_EFFECT_UNDERWATER] = "underwater", [HUE_EFFECT_COSMOS] = "cosmos",
+    [HUE_EFFECT_SUNBEAM] = "sunbeam",     [HUE_EFFECT_ENCHANT] = "enchant",
+};
+
+/** @brief "timed_effects" tag names, indexed by hue_timed_effect_t, sized for every value of the 2 bit field */
+static const char* const timed_effect_names[4] = {
+    [HUE_TIMED_EFFECT_NO_EFFECT] = "no_effect",
+    [HUE_TIMED_EFFECT_SUNRISE] = "sunrise",
+    [HUE_TIMED_EFFECT_SUNSET] = "sunset",
+};
 
 /*====================================================================================================================*/
 /*========================================== Private Function Declarations ===========================================*/
@@ -60,10 +75,7 @@ static esp_err_t hue_json_sprintf_and_check(hue_json_buffer_t* json_buffer, cons
 esp_err_t hue_light_data_to_json(hue_json_buffer_t* json_buffer, hue_light_data_t* hue_data) {
     if (HUE_NULL_CHECK(tag, json_buffer)) return ESP_ERR_INVALID_ARG;
     if (HUE_NULL_CHECK(tag, json_buffer->buff)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, json_buffer->resource_id)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, json_buffer->resource_type)) return ESP_ERR_INVALID_ARG;
     if (HUE_NULL_CHECK(tag, hue_data)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, hue_data->resource_id)) return ESP_ERR_INVALID_ARG;
 
     /* Pass resource type and ID to json_buffer */
     json_buffer->resource_type = "light";
@@ -129,13 +141,49 @@ esp_err_t hue_light_data_to_json(hue_json_buffer_t* json_buffer, hue_light_data_
         if (ret != ESP_OK) return ret; /* Return if any error found during printing */
     }
 
+    /* A sunrise or sunset plays over the duration, otherwise the duration is the transition of the changes above */
+    bool timed_duration = (hue_data->timed_effect == HUE_TIMED_EFFECT_SUNRISE) ||
+                          (hue_data->timed_effect == HUE_TIMED_EFFECT_SUNSET);
+    uint32_t duration_ms = (uint32_t)hue_data->duration * HUE_DURATION_STEP_MS;
+
+    /* Prints "dynamics" tag if enabled and checks if successful */
+    if (hue_data->set_duration && !timed_duration) {
+        ret = hue_json_sprintf_and_check(json_buffer, ",\"dynamics\":{\"duration\":%lu}", (unsigned long)duration_ms);
+        if (ret != ESP_OK) return ret; /* Return if any error found during printing */
+    }
+
+    /* Prints "effects" tag if enabled and checks if successful, values without a name are ignored */
+    if (effect_names[hue_data->effect]) {
+        ret = hue_json_sprintf_and_check(json_buffer, ",\"effects\":{\"effect\":\"%s\"}",
+                                         effect_names[hue_data->effect]);
+        if (ret != ESP_OK) return ret; /* Return if any error found during printing */
+    }
+
+    /* Prints "timed_effects" tag if enabled and checks if successful, with the duration only if one was given */
+    if (timed_effect_names[hue_data->timed_effect]) {
+        if (timed_duration && hue_data->set_duration) {
+            ret = hue_json_sprintf_and_check(json_buffer, ",\"timed_effects\":{\"effect\":\"%s\",\"duration\":%lu}",
+                                             timed_effect_names[hue_data->timed_effect], (unsigned long)duration_ms);
+        } else {
+            ret = hue_json_sprintf_and_check(json_buffer, ",\"timed_effects\":{\"effect\":\"%s\"}",
+                                             timed_effect_names[hue_data->timed_effect]);
+        }
+        if (ret != ESP_OK) return ret; /* Return if any error found during printing */
+    }
+
     /* Print closing bracket and return final error code, ESP_OK will return only if no issues have occurred anywhere */
     return hue_json_sprintf_and_check(json_buffer, "}");
 }
 
 esp_err_t hue_grouped_light_data_to_json(hue_json_buffer_t* json_buffer, hue_grouped_light_data_t* hue_data) {
-    /* Grouped lights and light resources currently use the same tags, so no need for separate function */
-    esp_err_t err = hue_light_data_to_json(json_buffer, hue_data);
+    if (HUE_NULL_CHECK(tag, hue_data)) return ESP_ERR_INVALID_ARG;
+
+    /* Grouped lights take every light tag except the effects, so the light function is reused without them */
+    hue_grouped_light_data_t group_data = *hue_data;
+    group_data.effect = HUE_EFFECT_NONE;
+    group_data.timed_effect = HUE_TIMED_EFFECT_NONE;
+    esp_err_t err = hue_light_data_to_json(json_buffer, &group_data);
+    if (err == ESP_ERR_INVALID_ARG) return err; /* json_buffer may be NULL */
 
     /* Pass resource type and ID to json_buffer */
     json_buffer->resource_type = "grouped_light";
@@ -147,9 +195,7 @@ esp_err_t hue_grouped_light_data_to_json(hue_json_buffer_t* json_buffer, hue_gro
 esp_err_t hue_smart_scene_data_to_json(hue_json_buffer_t* json_buffer, hue_smart_scene_data_t* hue_data) {
     if (HUE_NULL_CHECK(tag, json_buffer)) return ESP_ERR_INVALID_ARG;
     if (HUE_NULL_CHECK(tag, json_buffer->buff)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, json_buffer->resource_id)) return ESP_ERR_INVALID_ARG;
     if (HUE_NULL_CHECK(tag, hue_data)) return ESP_ERR_INVALID_ARG;
-    if (HUE_NULL_CHECK(tag, hue_data->resource_id)) return ESP_ERR_INVALID_ARG;
 
     /* Pass resource type and ID to json_buffer */
     json_buffer->resource_type = "smart_scene";
@@ -162,6 +208,45 @@ esp_err_t hue_smart_scene_data_to_json(hue_json_buffer_t* json_buffer, hue_smart
                                       hue_data->deactivate ? "\"deactivate\"" : "\"activate\"");
 }
 
+esp_err_t hue_scene_data_to_json(hue_json_buffer_t* json_buffer, hue_scene_data_t* hue_data) {
+    if (HUE_NULL_CHECK(tag, json_buffer)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, json_buffer->buff)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, hue_data)) return ESP_ERR_INVALID_ARG;
+
+    /* Pass resource type and ID to json_buffer */
+    json_buffer->resource_type = "scene";
+    json_buffer->resource_id = hue_data->resource_id;
+
+    esp_err_t ret = ESP_OK;                             /* Error code variable for print error checking */
+    memset(json_buffer->buff, 0, HUE_JSON_BUFFER_SIZE); /* Clear output buffer, as printing function appends */
+
+    /* Prints "recall" tag with its action and checks if successful, the 2 bit field has one value without a name */
+    hue_scene_action_t action = hue_data->action;
+    if (action > HUE_SCENE_ACTION_DYNAMIC_PALETTE) {
+        ESP_LOGW(tag, "Unknown scene action %d, recalled as active", action);
+        action = HUE_SCENE_ACTION_ACTIVE;
+    }
+    ret = hue_json_sprintf_and_check(json_buffer, "{\"recall\":{\"action\":\"%s\"", scene_action_names[action]);
+    if (ret != ESP_OK) return ret; /* Return if any error found during printing */
+
+    /* Prints "duration" tag if enabled and checks if successful */
+    if (hue_data->set_duration) {
+        ret = hue_json_sprintf_and_check(json_buffer, ",\"duration\":%lu",
+                                         (unsigned long)hue_data->duration * HUE_DURATION_STEP_MS);
+        if (ret != ESP_OK) return ret; /* Return if any error found during printing */
+    }
+
+    /* Prints "dimming" tag with value clamping if enabled and checks if successful */
+    if (hue_data->set_brightness) {
+        ret = hue_json_sprintf_and_check(json_buffer, ",\"dimming\":{\"brightness\":%d}",
+                                         hue_clamp(hue_data->brightness, HUE_MIN_B_SET, HUE_MAX_B_SET));
+        if (ret != ESP_OK) return ret; /* Return if any error found during printing */
+    }
+
+    /* Print closing brackets and return final error code, ESP_OK will return only if no issues have occurred */
+    return hue_json_sprintf_and_check(json_buffer, "}}");
+}
+
 /*====================================================================================================================*/
 /*=========================================== Private Function Definitions ===========================================*/
 /*====================================================================================================================*/
@@ -19,10 +19,10 @@ extern "C" {
 /*===================================================== Defines ======================================================*/
 /*====================================================================================================================*/
 
-#define HUE_JSON_BUFFER_SIZE 256 /**< Maximum number of characters for JSON buffer */
+#define HUE_JSON_BUFFER_SIZE 320 /**< Maximum number of characters for JSON buffer, fits every light tag at once */
 
 #define HUE_RESOURCE_TYPE_SIZE 14 /**< Length of "grouped_light/", the longest supported resource identifier */
-#define HUE_RESOURCE_TYPE_MIN 6   /**< Length of "light/", the shortest supported resource identifier */
+#define HUE_RESOURCE_TYPE_MIN 6   /**< Length of "light/" and "scene/", the shortest supported resource identifiers */
 
 /* Brightness setting bounds */
 #define HUE_MIN_B_SET 1   /**< Minimum value for brightness setting */
@@ -36,6 +36,8 @@ extern "C" {
 #define HUE_MIN_CT_ADD 0   /**< Minimum value for color temp modifying */
 #define HUE_MAX_CT_ADD 347 /**< Maximum value for color temp modifying */
 
+#define HUE_DURATION_STEP_MS 100 /**< Milliseconds per step of a light duration */
+
 /*====================================================================================================================*/
 /*=========================================== Public Structure Definitions ===========================================*/
 /*====================================================================================================================*/
@@ -55,7 +57,36 @@ typedef enum {
     HUE_ACTION_SUBTRACT  /**< Subtract from hue's value */
 } hue_action_t;
 
-/** @brief Settings for Philips Hue light resources */
+/** @brief Bridge-side effect loop a light should play, "effects" tag */
+typedef enum {
+    HUE_EFFECT_NONE = 0,   /**< Leave the effect as it is */
+    HUE_EFFECT_NO_EFFECT,  /**< Stop the current effect */
+    HUE_EFFECT_SPARKLE,    /**< "sparkle" effect */
+    HUE_EFFECT_FIRE,       /**< "fire" effect */
+    HUE_EFFECT_CANDLE,     /**< "candle" effect */
+    HUE_EFFECT_PRISM,      /**< "prism" effect */
+    HUE_EFFECT_OPAL,       /**< "opal" effect */
+    HUE_EFFECT_GLISTEN,    /**< "glisten" effect */
+    HUE_EFFECT_UNDERWATER, /**< "underwater" effect */
+    HUE_EFFECT_COSMOS,     /**< "cosmos" effect */
+    HUE_EFFECT_SUNBEAM,    /**< "sunbeam" effect */
+    HUE_EFFECT_ENCHANT,    /**< "enchant" effect */
+} hue_effect_t;
+
+/** @brief Bridge-side effect a light should play once over a duration, "timed_effects" tag */
+typedef enum {
+    HUE_TIMED_EFFECT_NONE = 0,  /**< Leave the timed effect as it is */
+    HUE_TIMED_EFFECT_NO_EFFECT, /**< Stop the current timed effect */
+    HUE_TIMED_EFFECT_SUNRISE,   /**< "sunrise" effect */
+    HUE_TIMED_EFFECT_SUNSET,    /**< "sunset" effect */
+} hue_timed_effect_t;
+
+/**
+ * @brief Settings for Philips Hue light resources
+ *
+ * @note duration is sent as "dynamics", the transition of every other change in the request, unless a sunrise or sunset
+ * timed effect is set, which takes it as the length of the timed effect instead
+ */
 typedef struct {
     const char* resource_id; /**< Hue resource ID */
     bool off : 1;                           /**< Light off (true) or on (false) */
@@ -66,6 +97,10 @@ typedef struct {
     bool set_color : 1;                     /**< If color_gamut values should be used */
     uint16_t color_gamut_x : 14;            /**< CIE X gamut position decimal value (e.g. 123 = 0.0123, >=10000 = 1) */
     uint16_t color_gamut_y : 14;            /**< CIE Y gamut position decimal value (e.g. 123 = 0.0123, >=10000 = 1) */
+    bool set_duration : 1;                  /**< If duration should be used */
+    uint16_t duration : 16;                 /**< Transition or timed effect length in HUE_DURATION_STEP_MS steps */
+    hue_effect_t effect : 4;                /**< Effect loop to play */
+    hue_timed_effect_t timed_effect : 2;    /**< Timed effect to play, over duration */
 } hue_light_data_t;
 
 /** @brief Settings for Philips Hue light group resources */
@@ -77,11 +112,22 @@ typedef struct {
     bool deactivate : 1;                    /**< Dectivate (true) or activate (false) smart scene */
 } hue_smart_scene_data_t;
 
-// TODO: Implement hue_scene_data_t structure
+/** @brief How a scene should be recalled */
+typedef enum {
+    HUE_SCENE_ACTION_ACTIVE = 0,      /**< Recall the scene, starting its palette if it is dynamic */
+    HUE_SCENE_ACTION_STATIC,          /**< Recall the scene without its palette */
+    HUE_SCENE_ACTION_DYNAMIC_PALETTE, /**< Recall the scene and cycle through its palette */
+} hue_scene_action_t;
+
 /** @brief Settings for Philips Hue scene resources */
-/* typedef struct {
-    const char* resource_id;
-} hue_scene_data_t; */
+typedef struct {
+    const char* resource_id; /**< Hue resource ID */
+    hue_scene_action_t action : 2;          /**< How the scene should be recalled */
+    bool set_duration : 1;                  /**< If duration should be used */
+    uint16_t duration : 16;                 /**< Transition to the scene in HUE_DURATION_STEP_MS steps */
+    bool set_brightness : 1;                /**< If brightness should override the brightness stored in the scene */
+    uint8_t brightness : 7;                 /**< [1-100] Brightness of every light in the scene */
+} hue_scene_data_t;
 
 /*====================================================================================================================*/
 /*=========================================== Public Function Declarations ===========================================*/
@@ -115,7 +161,8 @@ esp_err_t hue_light_data_to_json(hue_json_buffer_t* json_buffer, hue_light_data_
  * @retval - @c ESP_ERR_INVALID_RESPONSE – Encoding failure during buffer writing
  * @retval - @c ESP_ERR_INVALID_SIZE – Buffer is too small for JSON output
  *
- * @note This function will clip values out of range for Hue's API
+ * @note This function will clip values out of range for Hue's API. effect and timed_effect are ignored, as grouped
+ * lights have no effects, so a duration is always sent as "dynamics"
  */
 esp_err_t hue_grouped_light_data_to_json(hue_json_buffer_t* json_buffer, hue_grouped_light_data_t* hue_data);
 
@@ -133,6 +180,22 @@ esp_err_t hue_grouped_light_data_to_json(hue_json_buffer_t* json_buffer, hue_gro
  */
 esp_err_t hue_smart_scene_data_to_json(hue_json_buffer_t* json_buffer, hue_smart_scene_data_t* hue_data);
 
+/**
+ * @brief Converts hue_scene_data structure into JSON for HTTP request
+ *
+ * @param[out] json_buffer Buffer to store output string, custom type to enforce buffer size
+ * @param[in] hue_data Hue API JSON tags as data structure
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Buffer successfully filled with JSON conversion
+ * @retval - @c ESP_ERR_INVALID_ARG – json_buffer, hue_data, or their internal buffers are NULL
+ * @retval - @c ESP_ERR_INVALID_RESPONSE – Encoding failure during buffer writing
+ * @retval - @c ESP_ERR_INVALID_SIZE – Buffer is too small for JSON output
+ *
+ * @note This function will clip values out of range for Hue's API, an unknown action is recalled as active
+ */
+esp_err_t hue_scene_data_to_json(hue_json_buffer_t* json_buffer, hue_scene_data_t* hue_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -289,3 +289,21 @@ TEST_CASE("Color set x > 10000, y > 10000", "[hue_json_builder][hue_json_grouped
     TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"color\":{\"xy\":{\"x\":1.0,\"y\":1.0}}}",
                              buffer.buff);
 }
+
+/*===================== "dynamics" tag testing =====================*/
+TEST_CASE("Duration set with brightness", "[hue_json_builder][hue_json_grouped_light][hue_json_grouped_light_dynamics][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_grouped_light_data_t grouped_light = {.brightness_action = HUE_ACTION_SET, .brightness = 80,
+                                              .set_duration = true, .duration = 30};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_grouped_light_data_to_json(&buffer, &grouped_light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"dimming\":{\"brightness\":80},\"dynamics\":{\"duration\":3000}}",
+                             buffer.buff);
+}
+
+TEST_CASE("Effects ignored", "[hue_json_builder][hue_json_grouped_light][hue_json_grouped_light_dynamics][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_grouped_light_data_t grouped_light = {.set_duration = true, .duration = 6000, .effect = HUE_EFFECT_CANDLE,
+                                              .timed_effect = HUE_TIMED_EFFECT_SUNRISE};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_grouped_light_data_to_json(&buffer, &grouped_light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"dynamics\":{\"duration\":600000}}", buffer.buff);
+}
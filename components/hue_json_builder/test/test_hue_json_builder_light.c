@@ -288,4 +288,105 @@ TEST_CASE("Color set x > 10000, y > 10000", "[hue_json_builder][hue_json_light][
     TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
     TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"color\":{\"xy\":{\"x\":1.0,\"y\":1.0}}}",
                              buffer.buff);
-}
\ No newline at end of file
+}
+/*===================== "dynamics" tag testing =====================*/
+TEST_CASE("Duration not set", "[hue_json_builder][hue_json_light][hue_json_light_dynamics][empty]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.duration = 30};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true}}", buffer.buff);
+}
+
+TEST_CASE("Duration set no value", "[hue_json_builder][hue_json_light][hue_json_light_dynamics][empty]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.set_duration = true};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"dynamics\":{\"duration\":0}}", buffer.buff);
+}
+
+TEST_CASE("Duration set with brightness", "[hue_json_builder][hue_json_light][hue_json_light_dynamics][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.brightness_action = HUE_ACTION_SET, .brightness = 80, .set_duration = true,
+                              .duration = 30};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"dimming\":{\"brightness\":80},\"dynamics\":{\"duration\":3000}}",
+                             buffer.buff);
+}
+
+TEST_CASE("Duration set max value", "[hue_json_builder][hue_json_light][hue_json_light_dynamics][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.set_duration = true, .duration = UINT16_MAX};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"dynamics\":{\"duration\":6553500}}", buffer.buff);
+}
+
+/*===================== "effects" tag testing ======================*/
+TEST_CASE("Effect set", "[hue_json_builder][hue_json_light][hue_json_light_effects][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.effect = HUE_EFFECT_CANDLE};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"effects\":{\"effect\":\"candle\"}}", buffer.buff);
+}
+
+TEST_CASE("Effect stop", "[hue_json_builder][hue_json_light][hue_json_light_effects][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.effect = HUE_EFFECT_NO_EFFECT};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"effects\":{\"effect\":\"no_effect\"}}", buffer.buff);
+}
+
+TEST_CASE("Effect over range", "[hue_json_builder][hue_json_light][hue_json_light_effects][over_range][out_of_range]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.effect = 15};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true}}", buffer.buff);
+}
+
+TEST_CASE("Effect with duration", "[hue_json_builder][hue_json_light][hue_json_light_effects][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.set_duration = true, .duration = 5, .effect = HUE_EFFECT_FIRE};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"dynamics\":{\"duration\":500},\"effects\":{\"effect\":\"fire\"}}",
+                             buffer.buff);
+}
+
+/*================== "timed_effects" tag testing ===================*/
+TEST_CASE("Timed effect set no duration", "[hue_json_builder][hue_json_light][hue_json_light_timed_effects][empty]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.timed_effect = HUE_TIMED_EFFECT_SUNRISE};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"timed_effects\":{\"effect\":\"sunrise\"}}", buffer.buff);
+}
+
+TEST_CASE("Timed effect takes duration", "[hue_json_builder][hue_json_light][hue_json_light_timed_effects][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.set_duration = true, .duration = 6000, .timed_effect = HUE_TIMED_EFFECT_SUNSET};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":true},\"timed_effects\":{\"effect\":\"sunset\",\"duration\":600000}}",
+                             buffer.buff);
+}
+
+TEST_CASE("Timed effect stop keeps dynamics", "[hue_json_builder][hue_json_light][hue_json_light_timed_effects][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.set_duration = true, .duration = 10, .timed_effect = HUE_TIMED_EFFECT_NO_EFFECT};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"on\":{\"on\":true},\"dynamics\":{\"duration\":1000},\"timed_effects\":{\"effect\":\"no_effect\"}}",
+        buffer.buff);
+}
+
+/*==================== Every tag at its longest ====================*/
+TEST_CASE("Every tag fits buffer", "[hue_json_builder][hue_json_light][over_range]") {
+    hue_json_buffer_t buffer;
+    hue_light_data_t light = {.off = true, .brightness_action = HUE_ACTION_SUBTRACT, .brightness = 100,
+                              .color_temp_action = HUE_ACTION_SUBTRACT, .color_temp = 347, .set_color = true,
+                              .color_gamut_x = 9999, .color_gamut_y = 9999, .set_duration = true,
+                              .duration = UINT16_MAX, .effect = HUE_EFFECT_UNDERWATER,
+                              .timed_effect = HUE_TIMED_EFFECT_NO_EFFECT};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_light_data_to_json(&buffer, &light));
+    TEST_ASSERT_EQUAL_STRING("{\"on\":{\"on\":false},\"dimming_delta\":{\"action\":\"down\",\"brightness_delta\":100},"
+                             "\"color_temperature_delta\":{\"action\":\"down\",\"mirek_delta\":347},"
+                             "\"color\":{\"xy\":{\"x\":0.9999,\"y\":0.9999}},\"dynamics\":{\"duration\":6553500},"
+                             "\"effects\":{\"effect\":\"underwater\"},\"timed_effects\":{\"effect\":\"no_effect\"}}",
+                             buffer.buff);
+}
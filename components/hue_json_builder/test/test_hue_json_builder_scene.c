@@ -0,0 +1,83 @@
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#include "hue_json_builder.h"
+
+/*======================= Basic NULL testing =======================*/
+TEST_CASE("NULL buffer", "[hue_json_builder][hue_json_scene][empty]") {
+    hue_scene_data_t scene;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_scene_data_to_json(NULL, &scene));
+}
+
+TEST_CASE("NULL scene data", "[hue_json_builder][hue_json_scene][empty]") {
+    hue_json_buffer_t buffer;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, hue_scene_data_to_json(&buffer, NULL));
+}
+
+TEST_CASE("Empty scene data", "[hue_json_builder][hue_json_scene][empty]") {
+    hue_json_buffer_t buffer;
+    hue_scene_data_t scene = {};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_scene_data_to_json(&buffer, &scene));
+    TEST_ASSERT_EQUAL_STRING("{\"recall\":{\"action\":\"active\"}}", buffer.buff);
+    TEST_ASSERT_EQUAL_STRING("scene", buffer.resource_type);
+}
+
+/*====================== "recall" tag testing ======================*/
+TEST_CASE("Recall static", "[hue_json_builder][hue_json_scene][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_scene_data_t scene = {.action = HUE_SCENE_ACTION_STATIC};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_scene_data_to_json(&buffer, &scene));
+    TEST_ASSERT_EQUAL_STRING("{\"recall\":{\"action\":\"static\"}}", buffer.buff);
+}
+
+TEST_CASE("Recall dynamic palette", "[hue_json_builder][hue_json_scene][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_scene_data_t scene = {.action = HUE_SCENE_ACTION_DYNAMIC_PALETTE};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_scene_data_to_json(&buffer, &scene));
+    TEST_ASSERT_EQUAL_STRING("{\"recall\":{\"action\":\"dynamic_palette\"}}", buffer.buff);
+}
+
+TEST_CASE("Recall unknown action", "[hue_json_builder][hue_json_scene][over_range][out_of_range]") {
+    hue_json_buffer_t buffer;
+    hue_scene_data_t scene = {.action = 3};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_scene_data_to_json(&buffer, &scene));
+    TEST_ASSERT_EQUAL_STRING("{\"recall\":{\"action\":\"active\"}}", buffer.buff);
+}
+
+TEST_CASE("Recall with duration", "[hue_json_builder][hue_json_scene][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_scene_data_t scene = {.set_duration = true, .duration = 20};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_scene_data_to_json(&buffer, &scene));
+    TEST_ASSERT_EQUAL_STRING("{\"recall\":{\"action\":\"active\",\"duration\":2000}}", buffer.buff);
+}
+
+TEST_CASE("Recall brightness not set", "[hue_json_builder][hue_json_scene][empty]") {
+    hue_json_buffer_t buffer;
+    hue_scene_data_t scene = {.brightness = 40};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_scene_data_to_json(&buffer, &scene));
+    TEST_ASSERT_EQUAL_STRING("{\"recall\":{\"action\":\"active\"}}", buffer.buff);
+}
+
+TEST_CASE("Recall brightness under range", "[hue_json_builder][hue_json_scene][under_range][out_of_range]") {
+    hue_json_buffer_t buffer;
+    hue_scene_data_t scene = {.set_brightness = true, .brightness = 0};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_scene_data_to_json(&buffer, &scene));
+    TEST_ASSERT_EQUAL_STRING("{\"recall\":{\"action\":\"active\",\"dimming\":{\"brightness\":1}}}", buffer.buff);
+}
+
+TEST_CASE("Recall brightness over range", "[hue_json_builder][hue_json_scene][over_range][out_of_range]") {
+    hue_json_buffer_t buffer;
+    hue_scene_data_t scene = {.set_brightness = true, .brightness = 127};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_scene_data_to_json(&buffer, &scene));
+    TEST_ASSERT_EQUAL_STRING("{\"recall\":{\"action\":\"active\",\"dimming\":{\"brightness\":100}}}", buffer.buff);
+}
+
+TEST_CASE("Recall every tag", "[hue_json_builder][hue_json_scene][in_range]") {
+    hue_json_buffer_t buffer;
+    hue_scene_data_t scene = {.action = HUE_SCENE_ACTION_DYNAMIC_PALETTE, .set_duration = true,
+                              .duration = UINT16_MAX, .set_brightness = true, .brightness = 50};
+    TEST_ASSERT_EQUAL(ESP_OK, hue_scene_data_to_json(&buffer, &scene));
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"recall\":{\"action\":\"dynamic_palette\",\"duration\":6553500,\"dimming\":{\"brightness\":50}}}",
+        buffer.buff);
+}
@@ -14,4 +14,23 @@ void run_tests(void) {
     UNITY_BEGIN();
     unity_run_tests_by_tag("[hue_json_smart_scene]", false);
     UNITY_END();
-}
\ No newline at end of file
+    UNITY_BEGIN();
+    unity_run_tests_by_tag("[hue_json_scene]", false);
+    UNITY_END();
+    UNITY_BEGIN();
+    unity_run_tests_by_tag("[hue_validate]", false);
+    UNITY_END();
+    UNITY_BEGIN();
+    unity_run_tests_by_tag("[hue_entertainment_frame]", false);
+    UNITY_END();
+}
+
+void run_benchmarks(void) {
+    printf("Starting benchmarks\n");
+    UNITY_BEGIN();
+    unity_run_tests_by_tag("[hue_json_bench]", false);
+    UNITY_END();
+    UNITY_BEGIN();
+    unity_run_tests_by_tag("[hue_validate_bench]", false);
+    UNITY_END();
+}
@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 void run_tests(void);
+void run_benchmarks(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,183 @@
+/**
+ * @file proximity.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Declarations for the RSSI averaging filter and presence state machine used for proximity detection
+ */
+
+#ifndef H_PROXIMITY
+#define H_PROXIMITY
+
+#include "esp_types.h"
+#include "esp_err.h"
+
+#include "rssi_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define PROXIMITY_MAX_WINDOW 32 /**< Maximum number of RSSI samples that can be averaged by the filter */
+
+/** Monitor task priority used unless a placement is set, above the Hue HTTPS task so edges are never delayed by it */
+#define PROXIMITY_DEFAULT_TASK_PRIORITY 21
+/** Value of task_core_id letting the scheduler run the monitor task on either core */
+#define PROXIMITY_TASK_ANY_CORE -1
+
+/*====================================================================================================================*/
+/*=========================================== Public Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Presence states reported by the proximity state machine */
+typedef enum {
+    PROXIMITY_STATE_ABSENT = 0, /**< Beacon is out of range or has not been seen */
+    PROXIMITY_STATE_PRESENT     /**< Beacon is within range */
+} proximity_state_t;
+
+/** @brief Proximity filter and state machine configuration */
+typedef struct {
+    int8_t enter_rssi;        /**< Averaged RSSI at or above which the beacon is considered present */
+    int8_t exit_rssi;         /**< Averaged RSSI below which the beacon is considered absent, must be <= enter_rssi */
+    uint8_t window_size;      /**< Number of samples averaged, must be in range [1-PROXIMITY_MAX_WINDOW] */
+    uint8_t debounce_samples; /**< Consecutive averaged samples past a threshold needed before changing state */
+    uint32_t exit_timeout_ms; /**< Time without any samples before the beacon is considered absent (0 to disable) */
+} proximity_config_t;
+
+/** @brief Presence transition reported by the proximity state machine */
+typedef struct {
+    proximity_state_t state;  /**< State that was entered */
+    int64_t crossing_time_us; /**< Timestamp of the sample whose average first crossed the threshold */
+    int64_t edge_time_us;     /**< Timestamp of the sample (or tick) that committed the state change */
+    int8_t average_rssi;      /**< Averaged RSSI at the time of the state change */
+} proximity_edge_t;
+
+/** @brief Storage for the RSSI averaging window and presence state of a single beacon */
+typedef struct {
+    proximity_config_t config;           /**< Configuration the filter was initialized with */
+    int8_t window[PROXIMITY_MAX_WINDOW]; /**< Ring buffer of the most recent RSSI samples */
+    int16_t window_sum;                  /**< Sum of all samples currently in the window */
+    uint8_t window_pos;                  /**< Position in the window the next sample will be written to */
+    uint8_t window_count;                /**< Number of samples currently in the window */
+    uint8_t pending_count;               /**< Number of consecutive averages past the threshold of the other state */
+    proximity_state_t state;             /**< Current presence state */
+    int64_t crossing_time_us;            /**< Timestamp of the first sample of the pending state change */
+    int64_t last_sample_us;              /**< Timestamp of the most recent sample */
+} proximity_filter_t;
+
+/**
+ * @brief Callback for presence transitions, called directly from the proximity monitor task
+ *
+ * @param[in] p_edge Transition details, only valid for the duration of the callback
+ * @param[in] ctx Context pointer given in the proximity monitor configuration
+ *
+ * @attention Runs in the proximity monitor task, so should only hand work off (e.g. hue_https_perform_request()) and
+ * must not block for long periods
+ */
+typedef void (*proximity_edge_cb_t)(const proximity_edge_t* p_edge, void* ctx);
+
+/** @brief Proximity monitor task configuration */
+typedef struct {
+    proximity_config_t filter_config; /**< Filter and state machine configuration for the tracked beacon */
+    proximity_edge_cb_t edge_cb;      /**< Called on every presence transition */
+    void* edge_cb_ctx;                /**< Context passed to edge_cb */
+    const char* task_id;              /**< Name to assign to the monitor task */
+    uint8_t queue_length;             /**< Number of samples that can be pending before new samples are dropped */
+    rssi_trace_writer_t* p_trace;     /**< Optional trace writer to record every sample to, may be NULL */
+
+    /** Use task_priority and task_core_id, otherwise the task is unpinned at PROXIMITY_DEFAULT_TASK_PRIORITY */
+    bool task_placement_set;
+    uint8_t task_priority; /**< [1-(configMAX_PRIORITIES - 1)] Priority of the monitor task */
+    int8_t task_core_id;   /**< Core to pin the monitor task to, or PROXIMITY_TASK_ANY_CORE */
+} proximity_monitor_config_t;
+
+typedef struct proximity_monitor* proximity_monitor_handle_t; /**< Handle for proximity monitor task */
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/* proximity.c */
+
+/**
+ * @brief Initializes a proximity filter in the absent state with an empty averaging window
+ *
+ * @param[out] p_filter Filter to initialize
+ * @param[in] p_config Filter and state machine configuration
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Filter successfully initialized
+ * @retval - @c ESP_ERR_INVALID_ARG – p_filter or p_config are NULL, window size is out of range, or exit RSSI is above
+ * enter RSSI
+ */
+esp_err_t proximity_filter_init(proximity_filter_t* p_filter, const proximity_config_t* p_config);
+
+/**
+ * @brief Adds an RSSI sample to the averaging window and advances the presence state machine
+ *
+ * @param[in,out] p_filter Filter to add sample to
+ * @param[in] rssi RSSI of the received beacon advertisement
+ * @param[in] timestamp_us Time the sample was received in microseconds, must not decrease between calls
+ * @param[out] p_edge Filled with the transition details when a state change occurs, may be NULL
+ *
+ * @return true if the sample caused a presence state change, false otherwise
+ *
+ * @note A sample arriving after the exit timeout first commits the absent edge, which is the only edge reported for
+ * that sample. The sample still enters the window and counts towards debouncing, so a re-entry it starts is committed
+ * by the next update even with debounce_samples of 1.
+ */
+bool proximity_filter_update(proximity_filter_t* p_filter, int8_t rssi, int64_t timestamp_us,
+                             proximity_edge_t* p_edge);
+
+/**
+ * @brief Advances the presence state machine without a new sample, used for detecting beacon loss by exit timeout
+ *
+ * @param[in,out] p_filter Filter to check
+ * @param[in] timestamp_us Current time in microseconds
+ * @param[out] p_edge Filled with the transition details when a state change occurs, may be NULL
+ *
+ * @return true if the exit timeout caused a state change to absent, false otherwise
+ */
+bool proximity_filter_tick(proximity_filter_t* p_filter, int64_t timestamp_us, proximity_edge_t* p_edge);
+
+/* proximity_monitor.c */
+
+/**
+ * @brief Creates a task that filters submitted RSSI samples and calls the edge callback on presence transitions
+ *
+ * @param[out] p_monitor_handle Proximity monitor handle to store instance into
+ * @param[in] p_monitor_config Proximity monitor configuration
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Proximity monitor successfully created
+ * @retval - @c ESP_ERR_INVALID_ARG – p_monitor_handle, p_monitor_config, or the edge callback are NULL, queue length is
+ * 0, filter configuration is invalid, or the task placement priority or core are out of range
+ * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory or to create Queue or Task for proximity monitor
+ *
+ * @note Pinning the task to the core running the Bluetooth stack keeps samples local to the core that submits them,
+ * the edge callback only hands requests off to the Hue HTTPS task wherever it runs
+ */
+esp_err_t proximity_monitor_create(proximity_monitor_handle_t* p_monitor_handle,
+                                   const proximity_monitor_config_t* p_monitor_config);
+
+/**
+ * @brief Submits an RSSI sample to the proximity monitor without blocking, e.g. from a BLE scan result callback
+ *
+ * @param[in] monitor_handle Proximity monitor to submit sample to
+ * @param[in] rssi RSSI of the received beacon advertisement
+ * @param[in] timestamp_us esp_timer_get_time() timestamp of when the advertisement was received
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Sample queued
+ * @retval - @c ESP_ERR_INVALID_ARG – monitor_handle is NULL
+ * @retval - @c ESP_ERR_NO_MEM – Sample queue is full and the sample was dropped
+ */
+esp_err_t proximity_monitor_submit(proximity_monitor_handle_t monitor_handle, int8_t rssi, int64_t timestamp_us);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_PROXIMITY */
@@ -0,0 +1,168 @@
+/**
+ * @file rssi_trace.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Declarations for writing and reading compact binary RSSI traces for offline replay of proximity detection
+ *
+ * Trace layout:
+ *  - Header: RSSI_TRACE_MAGIC followed by one byte of RSSI_TRACE_VERSION
+ *  - Records: [varint time delta (ms)][varint (address index << 1) | marker flag][int8 value]
+ *
+ * Sample records store the received RSSI as the value. Marker records store ground truth presence (1 present, 0
+ * absent) recorded alongside the samples, and are used by the replay tool to measure detection latency.
+ */
+
+#ifndef H_RSSI_TRACE
+#define H_RSSI_TRACE
+
+#include "esp_types.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define RSSI_TRACE_MAGIC "RSTR"      /**< Magic bytes at the start of every trace */
+#define RSSI_TRACE_MAGIC_LENGTH 4    /**< Length of RSSI_TRACE_MAGIC without null-terminating character */
+#define RSSI_TRACE_VERSION 1         /**< Version of the trace record layout */
+#define RSSI_TRACE_HEADER_LENGTH 5   /**< Length of the magic bytes and version */
+#define RSSI_TRACE_RECORD_MAX 9      /**< Largest encoded record, 5 byte time delta + 3 byte address + 1 byte value */
+#define RSSI_TRACE_MAX_ADDRESS 0x7FFF /**< Largest supported address index */
+
+#define RSSI_TRACE_BUFFER_SIZE 128 /**< Number of bytes buffered by the writer before being passed to the sink */
+
+/*====================================================================================================================*/
+/*=========================================== Public Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Output function for trace data, e.g. a wrapper around uart_write_bytes() or esp_partition_write()
+ *
+ * @param[in] ctx Context pointer given to rssi_trace_writer_init()
+ * @param[in] data Encoded trace bytes
+ * @param[in] length Number of bytes in data
+ *
+ * @return ESP Error code, any value other than ESP_OK is returned by the writer function that flushed the data
+ */
+typedef esp_err_t (*rssi_trace_sink_t)(void* ctx, const uint8_t* data, size_t length);
+
+/** @brief Single decoded trace record */
+typedef struct {
+    uint32_t time_ms;    /**< Absolute time of the record in milliseconds since the start of the trace */
+    uint16_t address;    /**< Index of the beacon address the record belongs to */
+    bool marker;         /**< Record is a ground truth marker rather than an RSSI sample */
+    int8_t value;        /**< RSSI of the sample, or 1/0 for present/absent markers */
+} rssi_trace_record_t;
+
+/** @brief Buffered trace encoder */
+typedef struct {
+    rssi_trace_sink_t sink;               /**< Output function for full buffers */
+    void* sink_ctx;                       /**< Context passed to the sink */
+    uint32_t last_time_ms;                /**< Time of the previous record for delta encoding */
+    size_t length;                        /**< Number of bytes currently buffered */
+    uint8_t buff[RSSI_TRACE_BUFFER_SIZE]; /**< Buffer of encoded bytes */
+} rssi_trace_writer_t;
+
+/** @brief Trace decoder over an in-memory trace */
+typedef struct {
+    const uint8_t* data;  /**< Encoded trace including header */
+    size_t length;        /**< Number of bytes in data */
+    size_t pos;           /**< Position of the next record */
+    uint32_t time_ms;     /**< Time of the previously decoded record */
+} rssi_trace_reader_t;
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Initializes trace writer and buffers the trace header
+ *
+ * @param[out] p_writer Writer to initialize
+ * @param[in] sink Output function for encoded bytes
+ * @param[in] sink_ctx Context passed to the sink, may be NULL
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Writer initialized
+ * @retval - @c ESP_ERR_INVALID_ARG – p_writer or sink are NULL
+ */
+esp_err_t rssi_trace_writer_init(rssi_trace_writer_t* p_writer, rssi_trace_sink_t sink, void* sink_ctx);
+
+/**
+ * @brief Encodes an RSSI sample into the trace
+ *
+ * @param[in,out] p_writer Writer to encode into
+ * @param[in] time_ms Time of the sample, must not be earlier than the previous record
+ * @param[in] address Index of the beacon address the sample was received from
+ * @param[in] rssi RSSI of the sample
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Sample encoded
+ * @retval - @c ESP_ERR_INVALID_ARG – p_writer is NULL, address is out of range, or time is earlier than previous record
+ * @retval - Other – Error returned by the sink while flushing a full buffer
+ */
+esp_err_t rssi_trace_write_sample(rssi_trace_writer_t* p_writer, uint32_t time_ms, uint16_t address, int8_t rssi);
+
+/**
+ * @brief Encodes a ground truth presence marker into the trace
+ *
+ * @param[in,out] p_writer Writer to encode into
+ * @param[in] time_ms Time of the marker, must not be earlier than the previous record
+ * @param[in] address Index of the beacon address the marker applies to
+ * @param[in] present Beacon actually entered (true) or left (false) range at this time
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Marker encoded
+ * @retval - @c ESP_ERR_INVALID_ARG – p_writer is NULL, address is out of range, or time is earlier than previous record
+ * @retval - Other – Error returned by the sink while flushing a full buffer
+ */
+esp_err_t rssi_trace_write_marker(rssi_trace_writer_t* p_writer, uint32_t time_ms, uint16_t address, bool present);
+
+/**
+ * @brief Passes all buffered bytes to the sink
+ *
+ * @param[in,out] p_writer Writer to flush
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Buffer flushed or already empty
+ * @retval - @c ESP_ERR_INVALID_ARG – p_writer is NULL
+ * @retval - Other – Error returned by the sink, buffered bytes are kept
+ */
+esp_err_t rssi_trace_flush(rssi_trace_writer_t* p_writer);
+
+/**
+ * @brief Initializes trace reader and verifies the trace header
+ *
+ * @param[out] p_reader Reader to initialize
+ * @param[in] data Encoded trace, must remain valid while reading
+ * @param[in] length Number of bytes in data
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Reader initialized
+ * @retval - @c ESP_ERR_INVALID_ARG – p_reader or data are NULL
+ * @retval - @c ESP_ERR_INVALID_VERSION – Magic bytes or version do not match
+ */
+esp_err_t rssi_trace_reader_init(rssi_trace_reader_t* p_reader, const uint8_t* data, size_t length);
+
+/**
+ * @brief Decodes the next record in the trace
+ *
+ * @param[in,out] p_reader Reader to decode from
+ * @param[out] p_record Decoded record
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Record decoded
+ * @retval - @c ESP_ERR_INVALID_ARG – p_reader or p_record are NULL
+ * @retval - @c ESP_ERR_NOT_FOUND – End of trace reached
+ * @retval - @c ESP_ERR_INVALID_SIZE – Trace ends in the middle of a record or a varint is malformed
+ */
+esp_err_t rssi_trace_read(rssi_trace_reader_t* p_reader, rssi_trace_record_t* p_record);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_RSSI_TRACE */
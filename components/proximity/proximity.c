@@ -0,0 +1,145 @@
+/**
+ * @file proximity.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Implementation of the RSSI averaging filter and presence state machine used for proximity detection
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "hue_helpers.h"
+#include "proximity.h"
+
+static const char* tag = "proximity";
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Clears the averaging window and any pending state change
+ *
+ * @param[in,out] p_filter Filter to reset the window of
+ */
+static void reset_window(proximity_filter_t* p_filter);
+
+/**
+ * @brief Commits a state change and fills the edge structure
+ *
+ * @param[in,out] p_filter Filter to change the state of
+ * @param[in] state State to enter
+ * @param[in] edge_time_us Time of the sample or tick committing the state change
+ * @param[in] average_rssi Averaged RSSI at the time of the state change
+ * @param[out] p_edge Edge structure to fill, may be NULL
+ */
+static void commit_state(proximity_filter_t* p_filter, proximity_state_t state, int64_t edge_time_us,
+                         int8_t average_rssi, proximity_edge_t* p_edge);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t proximity_filter_init(proximity_filter_t* p_filter, const proximity_config_t* p_config) {
+    if (HUE_NULL_CHECK(tag, p_filter)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_config)) return ESP_ERR_INVALID_ARG;
+
+    if ((p_config->window_size < 1) || (p_config->window_size > PROXIMITY_MAX_WINDOW)) {
+        ESP_LOGE(tag, "Window size must be in range [1-%d]", PROXIMITY_MAX_WINDOW);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (p_config->exit_rssi > p_config->enter_rssi) {
+        ESP_LOGE(tag, "Exit RSSI must not be above enter RSSI");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(p_filter, 0, sizeof(proximity_filter_t));
+    p_filter->config = *p_config;
+    p_filter->state = PROXIMITY_STATE_ABSENT;
+
+    return ESP_OK;
+}
+
+bool proximity_filter_update(proximity_filter_t* p_filter, int8_t rssi, int64_t timestamp_us,
+                             proximity_edge_t* p_edge) {
+    if (!p_filter) return false;
+
+    /* Check exit timeout first so a sample arriving after a long gap is not averaged with stale samples */
+    bool changed = proximity_filter_tick(p_filter, timestamp_us, p_edge);
+
+    /* Replace the oldest sample in the window once it is full */
+    if (p_filter->window_count == p_filter->config.window_size) {
+        p_filter->window_sum -= p_filter->window[p_filter->window_pos];
+    } else {
+        p_filter->window_count++;
+    }
+    p_filter->window[p_filter->window_pos] = rssi;
+    p_filter->window_sum += rssi;
+    p_filter->window_pos = (p_filter->window_pos + 1) % p_filter->config.window_size;
+    p_filter->last_sample_us = timestamp_us;
+
+    int8_t average = p_filter->window_sum / p_filter->window_count;
+
+    /* Averages between the exit and enter thresholds hold the current state (hysteresis) */
+    bool crossed = (p_filter->state == PROXIMITY_STATE_ABSENT) ? (average >= p_filter->config.enter_rssi)
+                                                                : (average < p_filter->config.exit_rssi);
+    if (!crossed) {
+        p_filter->pending_count = 0;
+        return changed;
+    }
+
+    /* Record the sample that first crossed the threshold for latency measurement */
+    if (p_filter->pending_count == 0) p_filter->crossing_time_us = timestamp_us;
+    p_filter->pending_count++;
+
+    /* State only changes once the average has stayed past the threshold for the debounce period. An exit timeout edge
+     * from this call is reported on its own, the crossing stays pending and commits on the next update */
+    if (changed || (p_filter->pending_count < p_filter->config.debounce_samples)) return changed;
+
+    commit_state(p_filter,
+                 (p_filter->state == PROXIMITY_STATE_ABSENT) ? PROXIMITY_STATE_PRESENT : PROXIMITY_STATE_ABSENT,
+                 timestamp_us, average, p_edge);
+    return true;
+}
+
+bool proximity_filter_tick(proximity_filter_t* p_filter, int64_t timestamp_us, proximity_edge_t* p_edge) {
+    if (!p_filter) return false;
+    if (p_filter->config.exit_timeout_ms == 0) return false;
+    if (p_filter->window_count == 0) return false;
+    if ((timestamp_us - p_filter->last_sample_us) < ((int64_t)p_filter->config.exit_timeout_ms * 1000)) return false;
+
+    /* Beacon has not been heard from within the timeout, drop stale samples */
+    reset_window(p_filter);
+    if (p_filter->state == PROXIMITY_STATE_ABSENT) return false;
+
+    p_filter->crossing_time_us = p_filter->last_sample_us;
+    commit_state(p_filter, PROXIMITY_STATE_ABSENT, timestamp_us, INT8_MIN, p_edge);
+    return true;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static void reset_window(proximity_filter_t* p_filter) {
+    p_filter->window_sum = 0;
+    p_filter->window_pos = 0;
+    p_filter->window_count = 0;
+    p_filter->pending_count = 0;
+}
+
+static void commit_state(proximity_filter_t* p_filter, proximity_state_t state, int64_t edge_time_us,
+                         int8_t average_rssi, proximity_edge_t* p_edge) {
+    p_filter->state = state;
+    p_filter->pending_count = 0;
+
+    ESP_LOGD(tag, "Presence changed to %s, average RSSI %d", (state == PROXIMITY_STATE_PRESENT) ? "present" : "absent",
+             average_rssi);
+
+    if (!p_edge) return;
+    p_edge->state = state;
+    p_edge->crossing_time_us = p_filter->crossing_time_us;
+    p_edge->edge_time_us = edge_time_us;
+    p_edge->average_rssi = average_rssi;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file proximity_monitor.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Implementation of the proximity monitor task for filtering beacon samples and reporting presence transitions
+ */
+
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "hue_helpers.h"
+#include "proximity.h"
+
+static const char* tag = "proximity_monitor";
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+/** Longest time the monitor task waits for a sample before checking the exit timeout */
+#define PROXIMITY_MONITOR_TICK_MS 250
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Single RSSI sample passed from the submitting context to the monitor task */
+typedef struct {
+    int64_t timestamp_us; /**< Time the advertisement was received */
+    int8_t rssi;          /**< RSSI of the advertisement */
+} proximity_sample_t;
+
+/** @brief Storage for all required data for a proximity monitor instance */
+typedef struct proximity_monitor {
+    TaskHandle_t task_handle;     /**< Task handle for the monitor task */
+    QueueHandle_t sample_queue;   /**< Queue of samples waiting to be filtered */
+    proximity_filter_t filter;    /**< Filter for the tracked beacon */
+    proximity_edge_cb_t edge_cb;  /**< Called on every presence transition */
+    void* edge_cb_ctx;            /**< Context passed to edge_cb */
+    rssi_trace_writer_t* p_trace; /**< Optional trace writer for recording samples */
+    int64_t trace_start_us;       /**< Timestamp of the first recorded sample, trace times are relative to this */
+} proximity_monitor_t;
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief FreeRTOS task function for filtering samples and calling the edge callback on presence transitions
+ *
+ * @param[in,out] pvparameters Task required argument, should be passed as proximity_monitor_handle_t
+ */
+static void proximity_monitor_task(void* pvparameters);
+
+/**
+ * @brief Records a sample to the monitor's trace writer if one is configured
+ *
+ * @param[in,out] monitor_handle Proximity monitor the sample was received by
+ * @param[in] p_sample Sample to record
+ */
+static void trace_sample(proximity_monitor_handle_t monitor_handle, const proximity_sample_t* p_sample);
+
+/**
+ * @brief Frees all proximity monitor resources and sets handle to NULL
+ *
+ * @param[in,out] p_monitor_handle Pointer to proximity monitor handle (value will be set to NULL after)
+ */
+static void free_proximity_monitor(proximity_monitor_handle_t* p_monitor_handle);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t proximity_monitor_create(proximity_monitor_handle_t* p_monitor_handle,
+                                   const proximity_monitor_config_t* p_monitor_config) {
+    if (HUE_NULL_CHECK(tag, p_monitor_handle)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_monitor_config)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_monitor_config->edge_cb)) return ESP_ERR_INVALID_ARG;
+    if (p_monitor_config->queue_length == 0) {
+        ESP_LOGE(tag, "Sample queue length must be at least 1");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (p_monitor_config->task_placement_set) {
+        if ((p_monitor_config->task_priority == 0) || (p_monitor_config->task_priority >= configMAX_PRIORITIES)) {
+            ESP_LOGE(tag, "Task priority %u is not between 1 and %d", p_monitor_config->task_priority,
+                     configMAX_PRIORITIES - 1);
+            return ESP_ERR_INVALID_ARG;
+        }
+        if ((p_monitor_config->task_core_id != PROXIMITY_TASK_ANY_CORE) &&
+            ((p_monitor_config->task_core_id < 0) || (p_monitor_config->task_core_id >= portNUM_PROCESSORS))) {
+            ESP_LOGE(tag, "Task core %d does not exist", p_monitor_config->task_core_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    (*p_monitor_handle) = calloc(1, sizeof(proximity_monitor_t));
+    if (!(*p_monitor_handle)) {
+        ESP_LOGE(tag, "Failed to allocate memory for proximity monitor");
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = proximity_filter_init(&((*p_monitor_handle)->filter), &(p_monitor_config->filter_config));
+    if (err != ESP_OK) {
+        free_proximity_monitor(p_monitor_handle);
+        return err;
+    }
+
+    (*p_monitor_handle)->edge_cb = p_monitor_config->edge_cb;
+    (*p_monitor_handle)->edge_cb_ctx = p_monitor_config->edge_cb_ctx;
+    (*p_monitor_handle)->p_trace = p_monitor_config->p_trace;
+
+    if (((*p_monitor_handle)->sample_queue =
+             xQueueCreate(p_monitor_config->queue_length, sizeof(proximity_sample_t))) == NULL) {
+        ESP_LOGE(tag, "Failed to create sample queue");
+        free_proximity_monitor(p_monitor_handle);
+        return ESP_ERR_NO_MEM;
+    }
+
+    UBaseType_t priority = PROXIMITY_DEFAULT_TASK_PRIORITY;
+    BaseType_t core_id = tskNO_AFFINITY;
+    if (p_monitor_config->task_placement_set) {
+        priority = p_monitor_config->task_priority;
+        if (p_monitor_config->task_core_id != PROXIMITY_TASK_ANY_CORE) core_id = p_monitor_config->task_core_id;
+    }
+    if (xTaskCreatePinnedToCore(proximity_monitor_task, p_monitor_config->task_id, 4096, *p_monitor_handle, priority,
+                                &((*p_monitor_handle)->task_handle), core_id) != pdPASS) {
+        ESP_LOGE(tag, "Failed to create proximity monitor task");
+        free_proximity_monitor(p_monitor_handle);
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t proximity_monitor_submit(proximity_monitor_handle_t monitor_handle, int8_t rssi, int64_t timestamp_us) {
+    if (HUE_NULL_CHECK(tag, monitor_handle)) return ESP_ERR_INVALID_ARG;
+
+    proximity_sample_t sample = {.timestamp_us = timestamp_us, .rssi = rssi};
+
+    /* Never block the submitting context, a dropped sample is preferable to stalling the BLE stack */
+    if (xQueueSend(monitor_handle->sample_queue, &sample, 0) != pdTRUE) {
+        ESP_LOGW(tag, "Sample queue full, sample dropped");
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static void proximity_monitor_task(void* pvparameters) {
+    if (HUE_NULL_CHECK(tag, pvparameters)) vTaskDelete(NULL);
+
+    proximity_monitor_handle_t monitor_handle = (proximity_monitor_handle_t)pvparameters;
+    proximity_sample_t sample;
+    proximity_edge_t edge;
+    bool changed;
+
+    while (true) {
+        if (xQueueReceive(monitor_handle->sample_queue, &sample, pdMS_TO_TICKS(PROXIMITY_MONITOR_TICK_MS))) {
+            trace_sample(monitor_handle, &sample);
+            changed = proximity_filter_update(&(monitor_handle->filter), sample.rssi, sample.timestamp_us, &edge);
+        } else {
+            changed = proximity_filter_tick(&(monitor_handle->filter), esp_timer_get_time(), &edge);
+        }
+
+        /* Edge is handed straight to the callback rather than posted to an event loop to keep actuation latency low */
+        if (changed) monitor_handle->edge_cb(&edge, monitor_handle->edge_cb_ctx);
+    }
+
+    vTaskDelete(NULL);
+}
+
+static void trace_sample(proximity_monitor_handle_t monitor_handle, const proximity_sample_t* p_sample) {
+    if (!(monitor_handle->p_trace)) return;
+
+    if (monitor_handle->trace_start_us == 0) monitor_handle->trace_start_us = p_sample->timestamp_us;
+    rssi_trace_write_sample(monitor_handle->p_trace,
+                            (p_sample->timestamp_us - monitor_handle->trace_start_us) / 1000, 0, p_sample->rssi);
+}
+
+static void free_proximity_monitor(proximity_monitor_handle_t* p_monitor_handle) {
+    /* If p_monitor_handle or proximity monitor handle are already NULL, nothing needs to be done */
+    if (!p_monitor_handle) return;
+    if (!(*p_monitor_handle)) return;
+
+    /* Free any resources that are allocated */
+    if ((*p_monitor_handle)->task_handle) vTaskDelete((*p_monitor_handle)->task_handle);
+    if ((*p_monitor_handle)->sample_queue) vQueueDelete((*p_monitor_handle)->sample_queue);
+
+    free(*p_monitor_handle);
+
+    /* Sets the value of the handle to NULL to ensure handle cannot be used to access deallocated memory */
+    *p_monitor_handle = NULL;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file rssi_trace.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Implementation of the compact binary RSSI trace encoder and decoder
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "hue_helpers.h"
+#include "rssi_trace.h"
+
+static const char* tag = "rssi_trace";
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Encodes value as an unsigned LEB128 varint
+ *
+ * @param[out] p_out Output buffer, must have room for 5 bytes
+ * @param[in] value Value to encode
+ *
+ * @return Number of bytes written
+ */
+static size_t varint_encode(uint8_t* p_out, uint32_t value);
+
+/**
+ * @brief Decodes an unsigned LEB128 varint
+ *
+ * @param[in,out] p_reader Reader to decode from, position is advanced past the varint
+ * @param[out] p_value Decoded value
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Varint decoded
+ * @retval - @c ESP_ERR_INVALID_SIZE – Trace ended before the varint or the varint is longer than 32 bits
+ */
+static esp_err_t varint_decode(rssi_trace_reader_t* p_reader, uint32_t* p_value);
+
+/**
+ * @brief Encodes a single record into the writer buffer, flushing first if the record may not fit
+ *
+ * @param[in,out] p_writer Writer to encode into
+ * @param[in] time_ms Time of the record
+ * @param[in] address Index of the beacon address
+ * @param[in] marker Record is a ground truth marker
+ * @param[in] value RSSI or marker value
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Record encoded
+ * @retval - @c ESP_ERR_INVALID_ARG – p_writer is NULL, address is out of range, or time is earlier than previous record
+ * @retval - Other – Error returned by the sink while flushing
+ */
+static esp_err_t write_record(rssi_trace_writer_t* p_writer, uint32_t time_ms, uint16_t address, bool marker,
+                              int8_t value);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t rssi_trace_writer_init(rssi_trace_writer_t* p_writer, rssi_trace_sink_t sink, void* sink_ctx) {
+    if (HUE_NULL_CHECK(tag, p_writer)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, sink)) return ESP_ERR_INVALID_ARG;
+
+    p_writer->sink = sink;
+    p_writer->sink_ctx = sink_ctx;
+    p_writer->last_time_ms = 0;
+
+    /* Header is buffered so that it is written along with the first records */
+    memcpy(p_writer->buff, RSSI_TRACE_MAGIC, RSSI_TRACE_MAGIC_LENGTH);
+    p_writer->buff[RSSI_TRACE_MAGIC_LENGTH] = RSSI_TRACE_VERSION;
+    p_writer->length = RSSI_TRACE_HEADER_LENGTH;
+
+    return ESP_OK;
+}
+
+esp_err_t rssi_trace_write_sample(rssi_trace_writer_t* p_writer, uint32_t time_ms, uint16_t address, int8_t rssi) {
+    return write_record(p_writer, time_ms, address, false, rssi);
+}
+
+esp_err_t rssi_trace_write_marker(rssi_trace_writer_t* p_writer, uint32_t time_ms, uint16_t address, bool present) {
+    return write_record(p_writer, time_ms, address, true, present ? 1 : 0);
+}
+
+esp_err_t rssi_trace_flush(rssi_trace_writer_t* p_writer) {
+    if (HUE_NULL_CHECK(tag, p_writer)) return ESP_ERR_INVALID_ARG;
+    if (p_writer->length == 0) return ESP_OK;
+
+    esp_err_t err = p_writer->sink(p_writer->sink_ctx, p_writer->buff, p_writer->length);
+    if (err != ESP_OK) {
+        ESP_LOGE(tag, "Trace sink failed with %d, keeping %d buffered bytes", err, (int)p_writer->length);
+        return err;
+    }
+
+    p_writer->length = 0;
+    return ESP_OK;
+}
+
+esp_err_t rssi_trace_reader_init(rssi_trace_reader_t* p_reader, const uint8_t* data, size_t length) {
+    if (HUE_NULL_CHECK(tag, p_reader)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, data)) return ESP_ERR_INVALID_ARG;
+
+    if ((length < RSSI_TRACE_HEADER_LENGTH) || (memcmp(data, RSSI_TRACE_MAGIC, RSSI_TRACE_MAGIC_LENGTH) != 0)) {
+        ESP_LOGE(tag, "Data is not an RSSI trace");
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (data[RSSI_TRACE_MAGIC_LENGTH] != RSSI_TRACE_VERSION) {
+        ESP_LOGE(tag, "Unsupported trace version %d", data[RSSI_TRACE_MAGIC_LENGTH]);
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    p_reader->data = data;
+    p_reader->length = length;
+    p_reader->pos = RSSI_TRACE_HEADER_LENGTH;
+    p_reader->time_ms = 0;
+
+    return ESP_OK;
+}
+
+esp_err_t rssi_trace_read(rssi_trace_reader_t* p_reader, rssi_trace_record_t* p_record) {
+    if (HUE_NULL_CHECK(tag, p_reader)) return ESP_ERR_INVALID_ARG;
+    if (HUE_NULL_CHECK(tag, p_record)) return ESP_ERR_INVALID_ARG;
+    if (p_reader->pos >= p_reader->length) return ESP_ERR_NOT_FOUND;
+
+    uint32_t delta_ms;
+    uint32_t address_field;
+    esp_err_t err;
+
+    if ((err = varint_decode(p_reader, &delta_ms)) != ESP_OK) return err;
+    if ((err = varint_decode(p_reader, &address_field)) != ESP_OK) return err;
+    if ((p_reader->pos >= p_reader->length) || ((address_field >> 1) > RSSI_TRACE_MAX_ADDRESS)) {
+        ESP_LOGE(tag, "Trace record truncated or malformed at byte %d", (int)p_reader->pos);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    p_reader->time_ms += delta_ms;
+    p_record->time_ms = p_reader->time_ms;
+    p_record->address = address_field >> 1;
+    p_record->marker = address_field & 1;
+    p_record->value = (int8_t)p_reader->data[p_reader->pos++];
+
+    return ESP_OK;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static size_t varint_encode(uint8_t* p_out, uint32_t value) {
+    size_t length = 0;
+
+    /* Low 7 bits first, high bit set on every byte except the last */
+    while (value >= 0x80) {
+        p_out[length++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    p_out[length++] = value;
+
+    return length;
+}
+
+static esp_err_t varint_decode(rssi_trace_reader_t* p_reader, uint32_t* p_value) {
+    uint32_t value = 0;
+
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+        if (p_reader->pos >= p_reader->length) {
+            ESP_LOGE(tag, "Trace ended in the middle of a record");
+            return ESP_ERR_INVALID_SIZE;
+        }
+
+        uint8_t byte = p_reader->data[p_reader->pos++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+
+        if (!(byte & 0x80)) {
+            *p_value = value;
+            return ESP_OK;
+        }
+    }
+
+    ESP_LOGE(tag, "Trace varint longer than 32 bits at byte %d", (int)p_reader->pos);
+    return ESP_ERR_INVALID_SIZE;
+}
+
+static esp_err_t write_record(rssi_trace_writer_t* p_writer, uint32_t time_ms, uint16_t address, bool marker,
+                              int8_t value) {
+    if (HUE_NULL_CHECK(tag, p_writer)) return ESP_ERR_INVALID_ARG;
+    if (address > RSSI_TRACE_MAX_ADDRESS) {
+        ESP_LOGE(tag, "Address index %d out of range", address);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (time_ms < p_writer->last_time_ms) {
+        ESP_LOGE(tag, "Trace records must be written in time order");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Flush ahead of time so a record is never split between sink calls */
+    if ((RSSI_TRACE_BUFFER_SIZE - p_writer->length) < RSSI_TRACE_RECORD_MAX) {
+        esp_err_t err = rssi_trace_flush(p_writer);
+        if (err != ESP_OK) return err;
+    }
+
+    uint8_t* p_out = p_writer->buff + p_writer->length;
+    size_t length = varint_encode(p_out, time_ms - p_writer->last_time_ms);
+    length += varint_encode(p_out + length, ((uint32_t)address << 1) | (marker ? 1 : 0));
+    p_out[length++] = (uint8_t)value;
+
+    p_writer->length += length;
+    p_writer->last_time_ms = time_ms;
+
+    return ESP_OK;
+}
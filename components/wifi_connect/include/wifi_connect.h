@@ -14,6 +14,8 @@ extern "C" {
 
 #include "esp_event.h"
 #include "esp_err.h"
+#include "esp_netif_types.h"
+#include "esp_wifi_types.h"
 
 /* Event base for simplified WiFi connection events */
 ESP_EVENT_DECLARE_BASE(WIFI_CONNECT_EVENT);
@@ -27,16 +29,57 @@ ESP_EVENT_DECLARE_BASE(WIFI_CONNECT_EVENT);
 
 #define MACSTR_PARSE "%2hhx:%2hhx:%2hhx:%2hhx:%2hhx:%2hhx"
 
+/** Number of disconnect reasons stored in wifi_connect_summary_t */
+#define WIFI_CONNECT_MAX_REASONS 8
+
 /*====================================================================================================================*/
 /*=========================================== Public Structure Definitions ===========================================*/
 /*====================================================================================================================*/
 
 /** @brief WiFi connect event declarations */
 typedef enum {
-    WIFI_CONNECT_EVENT_CONNECTED,   /**< WiFi successfully connected, data as esp_netif_ip_info_t */
+    WIFI_CONNECT_EVENT_CONNECTED,   /**< WiFi successfully connected, data as wifi_connect_connected_data_t */
     WIFI_CONNECT_EVENT_DISCONNECTED /**< WiFi disconnected or failed to connect, data as wifi_err_reason_t */
 } wifi_connect_event_t;
 
+/** @brief Recovery actions taken in order each time the WiFi connection timeout expires without associating */
+typedef enum {
+    WIFI_CONNECT_RECOVERY_NONE = 0, /**< No recovery action taken */
+    WIFI_CONNECT_RECOVERY_RESCAN,   /**< Drop BSSID/channel restrictions and scan all channels for any AP */
+    WIFI_CONNECT_RECOVERY_REINIT,   /**< Stop, deinitialize and reinitialize only the WiFi driver */
+    WIFI_CONNECT_RECOVERY_RESTART   /**< Restart the ESP, last resort */
+} wifi_connect_recovery_t;
+
+/**
+ * @brief Timestamps and attempt details of a single connection process, from wifi_connect() or from the loss of an
+ * established connection until an IP is obtained
+ *
+ * @note Timestamps are from esp_timer_get_time(), phases not run during a reconnect are left as 0
+ */
+typedef struct {
+    int64_t start_us;                          /**< wifi_connect() called or established connection lost */
+    int64_t init_us;                           /**< Phase 1 (initialization) complete */
+    int64_t config_us;                         /**< Phase 2 (configuration) complete */
+    int64_t start_event_us;                    /**< Phase 3 (start) complete, WIFI_EVENT_STA_START received */
+    int64_t associated_us;                     /**< Phase 4 (connect) complete, WIFI_EVENT_STA_CONNECTED received */
+    int64_t got_ip_us;                         /**< Phase 5 (got IP) complete, IP_EVENT_STA_GOT_IP received */
+    uint8_t attempts;                          /**< Number of association attempts made */
+    uint8_t reason_count;                      /**< Number of failed attempts, may exceed WIFI_CONNECT_MAX_REASONS */
+    uint8_t reasons[WIFI_CONNECT_MAX_REASONS]; /**< wifi_err_reason_t of the first failed attempts, oldest first */
+    uint8_t channel;                           /**< Primary channel of the AP connected to */
+    wifi_connect_recovery_t recovery;          /**< Last timeout recovery action needed to connect */
+    bool bssid_set;                            /**< Connection was pinned to the configured BSSID, not after a rescan */
+    bool ap_cache_used;                        /**< Connection started as a directed connect from the AP cache */
+    bool static_ip_set;                        /**< Static IP was used instead of DHCP */
+    wifi_scan_method_t scan_method;            /**< Scan of the attempt that associated, all channel after a rescan */
+} wifi_connect_summary_t;
+
+/** @brief Data posted with WIFI_CONNECT_EVENT_CONNECTED */
+typedef struct {
+    esp_netif_ip_info_t ip_info;    /**< IP information assigned to the station */
+    wifi_connect_summary_t summary; /**< Timing and attempt details of the connection process */
+} wifi_connect_connected_data_t;
+
 /** @brief Advanced WiFi Connect configuration arguments */
 typedef struct {
     bool bssid_set;          /**< Enable setting of AP BSSID to connect to */
@@ -45,8 +88,9 @@ typedef struct {
     char ip_str[16];         /**< IP address as string to request from DHCP */
     char gateway_str[16];    /**< Gateway address as string to request from DHCP */
     char netmask_str[16];    /**< Netmask as string to request from DHCP */
-    bool timeout_set;        /**< Enable use of WiFi connection timeout */
+    bool timeout_set;        /**< Enable use of WiFi connection timeout and the wifi_connect_recovery_t actions */
     uint8_t timeout_seconds; /**< Period of time before timeout is triggered, must be in range [1-10] */
+    bool ap_cache_set;       /**< Enable directed connect to the last successful AP's BSSID and channel stored in NVS */
 } wifi_connect_advanced_config_t;
 
 /** @brief WiFi Connect configuration arguments */
@@ -78,6 +122,7 @@ void wifi_disconnect();
  *
  * @attention \c WIFI_CONNECT_EVENT events will post to the default event loop for WiFi connection and disconnection and
  *            should be registered with esp_event_handler_instance_register to detect and respond to events
+ * @attention NVS must be initialized with nvs_flash_init() before calling when ap_cache_set is enabled
  */
 esp_err_t wifi_connect(wifi_connect_config_t* wifi_config);
 
@@ -17,6 +17,8 @@
 #include "esp_err.h"
 #include "esp_netif.h"
 #include "esp_mac.h"
+#include "esp_timer.h"
+#include "nvs.h"
 #include "lwip/ip4_addr.h"
 
 #include "wifi_connect.h"
@@ -26,14 +28,41 @@ static const char* tag = "wifi_connect";
 
 /* Event base for simplified WiFi connection events */
 ESP_EVENT_DEFINE_BASE(WIFI_CONNECT_EVENT);
+/* Private event base the timeout timer posts to, so recovery runs on the event loop rather than the timer task */
+static ESP_EVENT_DEFINE_BASE(WIFI_CONNECT_RECOVERY_EVENT);
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define WIFI_CONNECT_NVS_NAMESPACE "wifi_connect" /**< NVS namespace for storing the AP cache */
+#define WIFI_CONNECT_NVS_AP_CACHE_KEY "ap_cache"  /**< NVS key for the AP cache blob */
 
 /*====================================================================================================================*/
 /*========================================== Private Structure Definitions ===========================================*/
 /*====================================================================================================================*/
 
-static TimerHandle_t timer_handle = NULL;                        /**< WiFi timeout timer handle */
-static esp_event_handler_instance_t wifi_event_handler_instance; /**< WIFI_EVENT handler instance */
-static esp_event_handler_instance_t ip_event_handler_instance;   /**< IP_EVENT handler instance */
+/** @brief BSSID and channel of the last AP an IP was successfully obtained from, stored in NVS */
+typedef struct {
+    uint8_t bssid[6]; /**< BSSID of the AP */
+    uint8_t channel;  /**< Primary channel of the AP */
+} wifi_connect_ap_cache_t;
+
+static TimerHandle_t timer_handle = NULL;                            /**< WiFi timeout timer handle */
+static esp_event_handler_instance_t wifi_event_handler_instance;     /**< WIFI_EVENT handler instance */
+static esp_event_handler_instance_t ip_event_handler_instance;       /**< IP_EVENT handler instance */
+static esp_event_handler_instance_t recovery_event_handler_instance; /**< WIFI_CONNECT_RECOVERY_EVENT instance */
+
+/** Station configuration every connection process starts from */
+static const wifi_config_t sta_config_default = {
+    .sta = {.scan_method = WIFI_FAST_SCAN, .threshold.authmode = WIFI_AUTH_WPA_PSK, .threshold.rssi = -90}};
+static wifi_config_t sta_config; /**< WiFi configuration with SSID and Password provided in ESP-IDF config */
+
+static bool ap_cache_enabled = false; /**< Saving of the AP cache after a successful connection is enabled */
+static bool ap_cache_in_use = false;  /**< Current connection attempt is directed using the AP cache */
+static wifi_connect_summary_t summary; /**< Timing and attempt details of the current connection process */
+static wifi_connect_recovery_t recovery = WIFI_CONNECT_RECOVERY_NONE; /**< Last recovery action taken */
+static volatile bool recovery_posted = false; /**< Timeout posted a recovery that no association has made stale */
 
 /*====================================================================================================================*/
 /*========================================== Private Function Declarations ===========================================*/
@@ -63,12 +92,34 @@ static esp_err_t strtomac(uint8_t* a_output, const char* p_mac);
 static void event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data);
 
 /**
- * @brief Callback function for WiFi timeout timer to restart esp on timeout
+ * @brief Callback function for WiFi timeout timer, posts WIFI_CONNECT_RECOVERY_EVENT for event_handler to take the
+ * next recovery action
  *
  * @param timer_handle Handle for timer calling the function
+ *
+ * @note The recovery actions call into the WiFi driver and block, which the timer service task must never do
  */
 static void wifi_timer_callback(TimerHandle_t timer_handle);
 
+/**
+ * @brief Takes the next recovery action, called by event_handler for a posted WIFI_CONNECT_RECOVERY_EVENT
+ *
+ * @note Each consecutive timeout escalates through wifi_connect_recovery_t, restarting the esp only once the less
+ * disruptive actions have failed so that application state survives transient AP problems
+ */
+static void run_recovery(void);
+
+/**
+ * @brief Drops any BSSID/channel restriction and reconnects with a full scan so any AP of the network can be used
+ */
+static void recover_rescan(void);
+
+/**
+ * @brief Stops, deinitializes and reinitializes the WiFi driver with the current station configuration, leaving netif
+ * and event handlers intact
+ */
+static void recover_reinit(void);
+
 /**
  * @brief Sets IP for station to request from DHCP server based on ESP-IDF config
  *
@@ -77,6 +128,44 @@ static void wifi_timer_callback(TimerHandle_t timer_handle);
  */
 static void set_static_ip(esp_netif_t* sta_netif, wifi_connect_config_t* wifi_connect_config);
 
+/**
+ * @brief Starts a new connection summary, keeping the configuration flags of the previous one
+ *
+ * @param[in] start_us Time the connection process started
+ */
+static void reset_summary(int64_t start_us);
+
+/**
+ * @brief Records an association attempt and calls esp_wifi_connect()
+ */
+static void connect_attempt(void);
+
+/**
+ * @brief Logs the phase durations of a completed connection summary
+ */
+static void log_summary(void);
+
+/**
+ * @brief Loads the AP cache from NVS
+ *
+ * @param[out] p_ap_cache Storage for the loaded AP cache
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – AP cache loaded
+ * @retval - Other – AP cache not stored or NVS failure (from nvs_open() or nvs_get_blob())
+ */
+static esp_err_t load_ap_cache(wifi_connect_ap_cache_t* p_ap_cache);
+
+/**
+ * @brief Stores the BSSID and channel of the currently connected AP to NVS if it differs from the stored AP cache
+ */
+static void save_ap_cache(void);
+
+/**
+ * @brief Removes the directed BSSID and channel from the station configuration so the next attempt scans for the AP
+ */
+static void fall_back_to_scan(void);
+
 /**
  * @brief Run WiFi/LwIP initialization phase of WiFi connection
  *
@@ -100,12 +189,21 @@ void wifi_disconnect() {
     /* Unregister event handler to prevent reconnect attempts during disconnect process */
     if (wifi_event_handler_instance) {
         ESP_LOGD(tag, "Unregistering WiFi event handler instance...");
-        esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, &wifi_event_handler_instance);
+        esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_event_handler_instance);
+        wifi_event_handler_instance = NULL;
     }
 
     if (ip_event_handler_instance) {
         ESP_LOGD(tag, "Unregistering IP event handler instance...");
-        esp_event_handler_instance_unregister(IP_EVENT, IP_EVENT_STA_GOT_IP, &ip_event_handler_instance);
+        esp_event_handler_instance_unregister(IP_EVENT, IP_EVENT_STA_GOT_IP, ip_event_handler_instance);
+        ip_event_handler_instance = NULL;
+    }
+
+    if (recovery_event_handler_instance) {
+        ESP_LOGD(tag, "Unregistering WiFi recovery event handler instance...");
+        esp_event_handler_instance_unregister(WIFI_CONNECT_RECOVERY_EVENT, ESP_EVENT_ANY_ID,
+                                              recovery_event_handler_instance);
+        recovery_event_handler_instance = NULL;
     }
 
     /* If enabled, delete WiFi timeout timer task */
@@ -139,8 +237,12 @@ esp_err_t wifi_connect(wifi_connect_config_t* wifi_config) {
     ESP_LOGI(tag, "WiFi connection process started");
 
     wifi_connect_advanced_config_t* adv_config = &(wifi_config->advanced_configs);
+    memset(&summary, 0, sizeof(summary));
+    summary.start_us = esp_timer_get_time();
+    summary.bssid_set = adv_config->bssid_set;
+    summary.static_ip_set = adv_config->static_ip_set;
 
-    /* If enabled, setup WiFi timeout timer for restarting esp if timeout period has passed during connection */
+    /* If enabled, setup WiFi timeout timer for recovering if timeout period has passed during connection */
     if (adv_config->timeout_set && (adv_config->timeout_seconds >= 1) && (adv_config->timeout_seconds <= 10)) {
         timer_handle = xTimerCreate("WiFi timer", pdMS_TO_TICKS(adv_config->timeout_seconds * 1000), pdFALSE, (void*)0,
                                     wifi_timer_callback);
@@ -148,8 +250,11 @@ esp_err_t wifi_connect(wifi_connect_config_t* wifi_config) {
 
     ESP_LOGD(tag, "Starting WiFi Phase 1: Initialization");
     wifi_phase_init(wifi_config); /* Phase 1 of WiFi connection */
+    summary.init_us = esp_timer_get_time();
     ESP_LOGD(tag, "Starting WiFi Phase 2: Configuration");
     wifi_phase_config(wifi_config); /* Phase 2 of WiFi connection */
+    summary.config_us = esp_timer_get_time();
+    summary.ap_cache_used = ap_cache_in_use;
     ESP_LOGD(tag, "Starting WiFi Phase 3: Start");
     ESP_ERROR_CHECK(esp_wifi_start()); /* Phase 3 of WiFi connection */
     /* Phase 3 posts WIFI_EVENT_STA_START to event_handler to begin Phase 4 */
@@ -186,10 +291,11 @@ static void event_handler(void* arg, esp_event_base_t event_base, int32_t event_
         switch (event_id) {
             case WIFI_EVENT_STA_START: /* WiFi event for starting connection attempt */
                 wifi_connected = false;
+                summary.start_event_us = esp_timer_get_time();
                 /* If WiFi timeout is enabled, start timer for connection */
                 if (timer_handle) xTimerStart(timer_handle, 0);
                 ESP_LOGD(tag, "Starting WiFi Phase 4: Connect");
-                esp_wifi_connect();
+                connect_attempt();
                 break;
             case WIFI_EVENT_STA_DISCONNECTED: /* WiFi event for connection failure */
                 /* Cast event_data for WiFi disconnect specific data */
@@ -200,13 +306,31 @@ static void event_handler(void* arg, esp_event_base_t event_base, int32_t event_
                                                sizeof(event->reason), portMAX_DELAY));
                 ESP_LOGI(tag, "Failed to connect to AP, Reason: %d", event->reason);
 
-                /* If WiFi timeout is enabled, start timer for connection */
-                if (timer_handle) xTimerStart(timer_handle, 0);
-                esp_wifi_connect();
+                /* Time the reconnect from the point the connection was lost, otherwise record the failed attempt */
+                if (wifi_connected) {
+                    reset_summary(esp_timer_get_time());
+                } else {
+                    if (summary.reason_count < WIFI_CONNECT_MAX_REASONS) {
+                        summary.reasons[summary.reason_count] = event->reason;
+                    }
+                    if (summary.reason_count < UINT8_MAX) summary.reason_count++;
+                }
+                wifi_connected = false;
+
+                /* Directed connect to the cached AP failed, scan for the AP on the next attempt */
+                if (ap_cache_in_use) fall_back_to_scan();
+
+                /* If WiFi timeout is enabled, start timer for connection unless already timing repeated failures */
+                if (timer_handle && !xTimerIsTimerActive(timer_handle)) xTimerStart(timer_handle, 0);
+                connect_attempt();
                 break;
             case WIFI_EVENT_STA_CONNECTED: /* WiFi event for connection success */
-                /* If WiFi timeout is enabled, stop timer to prevent esp restart */
+                /* If WiFi timeout is enabled, stop timer and drop any recovery it posted to prevent recovery actions */
                 if (timer_handle) xTimerStop(timer_handle, 0);
+                recovery_posted = false;
+                summary.associated_us = esp_timer_get_time();
+                summary.channel = ((wifi_event_sta_connected_t*)event_data)->channel;
+                summary.scan_method = sta_config.sta.scan_method;
                 ESP_LOGI(tag, "AP connected successfully, requesting IP...");
                 ESP_LOGD(tag, "Starting WiFi Phase 5: 'Got IP'");
                 break;
@@ -232,23 +356,87 @@ static void event_handler(void* arg, esp_event_base_t event_base, int32_t event_
                                                    sizeof(reason), portMAX_DELAY));
                 }
 
-                /* Post connect event for wifi_connect event handling with IP info */
-                ESP_ERROR_CHECK(esp_event_post(WIFI_CONNECT_EVENT, WIFI_CONNECT_EVENT_CONNECTED, &(event->ip_info),
-                                               sizeof(event->ip_info), portMAX_DELAY));
+                /* Post connect event for wifi_connect event handling with IP info and connection summary */
+                summary.got_ip_us = esp_timer_get_time();
+                summary.recovery = recovery;
+                recovery = WIFI_CONNECT_RECOVERY_NONE;
+                wifi_connect_connected_data_t connected_data = {.ip_info = event->ip_info, .summary = summary};
+                ESP_ERROR_CHECK(esp_event_post(WIFI_CONNECT_EVENT, WIFI_CONNECT_EVENT_CONNECTED, &connected_data,
+                                               sizeof(connected_data), portMAX_DELAY));
                 wifi_connected = true;
                 ESP_LOGI(tag, "Got ip: " IPSTR, IP2STR(&event->ip_info.ip));
+                log_summary();
+
+                /* Remember the AP for a directed connect next time */
+                if (ap_cache_enabled) save_ap_cache();
                 break;
             default: /* IP events not accounted for */
                 ESP_LOGI(tag, "Unexpected IP Event ID: %ld", event_id);
         };
+    } else if (event_base == WIFI_CONNECT_RECOVERY_EVENT) { /* Timeout recovery handler */
+        /* Skipped if an association was made while the recovery waited in the event queue */
+        if (recovery_posted) run_recovery();
     } else { /* Unexpected Event handler */
         ESP_LOGI(tag, "Unexpected Event base: %s, ID: %ld", event_base, event_id);
     }
 }
 
 static void wifi_timer_callback(TimerHandle_t timer_handle) {
-    ESP_LOGW(tag, "WiFi connection timed out, restarting to refresh connection...");
-    esp_restart();
+    /* Never blocks the timer task, a full event queue retries on the next timeout instead */
+    recovery_posted = true;
+    if (esp_event_post(WIFI_CONNECT_RECOVERY_EVENT, 0, NULL, 0, 0) != ESP_OK) {
+        ESP_LOGE(tag, "Failed to post WiFi recovery, retrying on the next timeout");
+        xTimerStart(timer_handle, 0);
+    }
+}
+
+static void run_recovery(void) {
+    recovery_posted = false;
+    if (recovery < WIFI_CONNECT_RECOVERY_RESTART) recovery++;
+
+    /* Escalate again if the recovery action does not lead to a connection. Restarted before recovering so a connection
+     * made by the recovery action stops the timer for good instead of racing this restart */
+    xTimerStart(timer_handle, 0);
+
+    switch (recovery) {
+        case WIFI_CONNECT_RECOVERY_RESCAN:
+            ESP_LOGW(tag, "WiFi connection timed out, rescanning all channels for any AP...");
+            recover_rescan();
+            break;
+        case WIFI_CONNECT_RECOVERY_REINIT:
+            ESP_LOGW(tag, "WiFi connection timed out, reinitializing WiFi driver...");
+            recover_reinit();
+            break;
+        default:
+            ESP_LOGW(tag, "WiFi connection timed out after all recovery actions, restarting to refresh connection...");
+            esp_restart();
+    }
+}
+
+static void recover_rescan(void) {
+    /* Connections from here on are no longer pinned, so the summary and log stop reporting the pin */
+    ap_cache_in_use = false;
+    summary.bssid_set = false;
+    sta_config.sta.bssid_set = false;
+    sta_config.sta.channel = 0;
+    sta_config.sta.scan_method = WIFI_ALL_CHANNEL_SCAN;
+    sta_config.sta.sort_method = WIFI_CONNECT_AP_BY_SIGNAL;
+
+    /* Disconnect before reconfiguring, the disconnect event starts the next attempt with the new configuration */
+    esp_wifi_disconnect();
+    esp_wifi_set_config(WIFI_IF_STA, &sta_config);
+}
+
+static void recover_reinit(void) {
+    esp_wifi_stop();
+    esp_wifi_deinit();
+
+    /* Driver start posts WIFI_EVENT_STA_START, which begins Phase 4 again in event_handler */
+    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+    if ((esp_wifi_init(&cfg) != ESP_OK) || (esp_wifi_set_mode(WIFI_MODE_STA) != ESP_OK) ||
+        (esp_wifi_set_config(WIFI_IF_STA, &sta_config) != ESP_OK) || (esp_wifi_start() != ESP_OK)) {
+        ESP_LOGE(tag, "Failed to reinitialize WiFi driver");
+    }
 }
 
 static void set_static_ip(esp_netif_t* sta_netif, wifi_connect_config_t* wifi_connect_config) {
@@ -264,6 +452,92 @@ static void set_static_ip(esp_netif_t* sta_netif, wifi_connect_config_t* wifi_co
     esp_netif_set_ip_info(sta_netif, &info);
 }
 
+static void reset_summary(int64_t start_us) {
+    bool bssid_set = summary.bssid_set;
+    bool static_ip_set = summary.static_ip_set;
+
+    memset(&summary, 0, sizeof(summary));
+    summary.start_us = start_us;
+    summary.bssid_set = bssid_set;
+    summary.static_ip_set = static_ip_set;
+    summary.ap_cache_used = ap_cache_in_use;
+}
+
+static void connect_attempt(void) {
+    if (summary.attempts < UINT8_MAX) summary.attempts++;
+    esp_wifi_connect();
+}
+
+static void log_summary(void) {
+    /* Reconnects skip phases 1-3, so measure from whichever phase boundary was last reached */
+    int64_t phase_3_end = summary.start_event_us ? summary.start_event_us : summary.start_us;
+
+    ESP_LOGI(tag, "Connected in %lld ms (%d attempt%s, channel %d, %s scan%s%s%s%s)",
+             (summary.got_ip_us - summary.start_us) / 1000, summary.attempts, (summary.attempts == 1) ? "" : "s",
+             summary.channel, (summary.scan_method == WIFI_ALL_CHANNEL_SCAN) ? "all channel" : "fast",
+             summary.bssid_set ? ", BSSID pinned" : "", summary.ap_cache_used ? ", AP cache" : "",
+             summary.static_ip_set ? ", static IP" : "",
+             (summary.recovery == WIFI_CONNECT_RECOVERY_RESCAN)   ? ", after rescan"
+             : (summary.recovery == WIFI_CONNECT_RECOVERY_REINIT) ? ", after driver reinit"
+                                                                  : "");
+    if (summary.init_us) {
+        ESP_LOGI(tag, "  Init %lld us, config %lld us, start %lld us", summary.init_us - summary.start_us,
+                 summary.config_us - summary.init_us, summary.start_event_us - summary.config_us);
+    }
+    ESP_LOGI(tag, "  Connect %lld us, got IP %lld us", summary.associated_us - phase_3_end,
+             summary.got_ip_us - summary.associated_us);
+    for (uint8_t i = 0; (i < summary.reason_count) && (i < WIFI_CONNECT_MAX_REASONS); i++) {
+        ESP_LOGI(tag, "  Attempt %d failed, reason %d", i + 1, summary.reasons[i]);
+    }
+}
+
+static esp_err_t load_ap_cache(wifi_connect_ap_cache_t* p_ap_cache) {
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(WIFI_CONNECT_NVS_NAMESPACE, NVS_READONLY, &nvs);
+    if (err != ESP_OK) return err;
+
+    size_t length = sizeof(wifi_connect_ap_cache_t);
+    err = nvs_get_blob(nvs, WIFI_CONNECT_NVS_AP_CACHE_KEY, p_ap_cache, &length);
+    nvs_close(nvs);
+
+    /* Reject data stored by an incompatible layout */
+    if ((err == ESP_OK) && (length != sizeof(wifi_connect_ap_cache_t))) return ESP_ERR_INVALID_SIZE;
+    return err;
+}
+
+static void save_ap_cache(void) {
+    wifi_ap_record_t ap_info;
+    if (esp_wifi_sta_get_ap_info(&ap_info) != ESP_OK) return;
+
+    wifi_connect_ap_cache_t ap_cache = {.channel = ap_info.primary};
+    memcpy(ap_cache.bssid, ap_info.bssid, sizeof(ap_cache.bssid));
+
+    /* Avoid flash wear when reconnecting to the same AP */
+    wifi_connect_ap_cache_t stored;
+    if ((load_ap_cache(&stored) == ESP_OK) && (memcmp(&stored, &ap_cache, sizeof(ap_cache)) == 0)) return;
+
+    nvs_handle_t nvs;
+    if (nvs_open(WIFI_CONNECT_NVS_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK) {
+        ESP_LOGW(tag, "Failed to open NVS, AP cache not saved");
+        return;
+    }
+    if ((nvs_set_blob(nvs, WIFI_CONNECT_NVS_AP_CACHE_KEY, &ap_cache, sizeof(ap_cache)) == ESP_OK) &&
+        (nvs_commit(nvs) == ESP_OK)) {
+        ESP_LOGD(tag, "AP cache saved: " MACSTR " channel %d", MAC2STR(ap_cache.bssid), ap_cache.channel);
+    } else {
+        ESP_LOGW(tag, "Failed to save AP cache");
+    }
+    nvs_close(nvs);
+}
+
+static void fall_back_to_scan(void) {
+    ESP_LOGI(tag, "Directed connect to cached AP failed, falling back to scan");
+    ap_cache_in_use = false;
+    sta_config.sta.bssid_set = false;
+    sta_config.sta.channel = 0;
+    esp_wifi_set_config(WIFI_IF_STA, &sta_config);
+}
+
 static void wifi_phase_init(wifi_connect_config_t* wifi_connect_config) {
     if (HUE_NULL_CHECK(tag, wifi_connect_config)) return; /* Stop if WiFi config instance does not exist */
 
@@ -276,6 +550,11 @@ static void wifi_phase_init(wifi_connect_config_t* wifi_connect_config) {
                                                         &wifi_event_handler_instance));
     ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP, &event_handler, NULL,
                                                         &ip_event_handler_instance));
+    /*   Register timeout recovery with event_handler if the WiFi timeout is enabled */
+    if (timer_handle) {
+        ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_CONNECT_RECOVERY_EVENT, ESP_EVENT_ANY_ID,
+                                                            &event_handler, NULL, &recovery_event_handler_instance));
+    }
 
     /* Step 1.3: create default network interface instance */
     /* Use static IP settings if enabled */
@@ -291,23 +570,33 @@ static void wifi_phase_init(wifi_connect_config_t* wifi_connect_config) {
 }
 
 static void wifi_phase_config(wifi_connect_config_t* wifi_connect_config) {
-    /* WiFi configuration with SSID and Password provided in ESP-IDF config */
-    static wifi_config_t wifi_config = {
-        .sta = {.scan_method = WIFI_FAST_SCAN, .threshold.authmode = WIFI_AUTH_WPA_PSK, .threshold.rssi = -90}};
-
-    memcpy(wifi_config.sta.ssid, wifi_connect_config->ssid, 32);
-    memcpy(wifi_config.sta.password, wifi_connect_config->password, 64);
+    /* Start from the defaults, a connection after wifi_disconnect() would otherwise keep the last rescan's settings */
+    sta_config = sta_config_default;
+    ap_cache_in_use = false;
+    memcpy(sta_config.sta.ssid, wifi_connect_config->ssid, 32);
+    memcpy(sta_config.sta.password, wifi_connect_config->password, 64);
 
     /* Set BSSID of specific AP to connect to if enabled                         *
      * Intended to speed up connection if other APs are known to fail more often */
     if (wifi_connect_config->advanced_configs.bssid_set) {
-        wifi_config.sta.bssid_set = true;
-        ESP_ERROR_CHECK(strtomac(wifi_config.sta.bssid, wifi_connect_config->advanced_configs.bssid_str));
+        sta_config.sta.bssid_set = true;
+        ESP_ERROR_CHECK(strtomac(sta_config.sta.bssid, wifi_connect_config->advanced_configs.bssid_str));
+    }
+
+    /* Connect directly to the last successful AP on its channel if enabled, skipping the scan of other channels */
+    ap_cache_enabled = wifi_connect_config->advanced_configs.ap_cache_set;
+    wifi_connect_ap_cache_t ap_cache;
+    if (ap_cache_enabled && !sta_config.sta.bssid_set && (load_ap_cache(&ap_cache) == ESP_OK)) {
+        sta_config.sta.bssid_set = true;
+        memcpy(sta_config.sta.bssid, ap_cache.bssid, sizeof(ap_cache.bssid));
+        sta_config.sta.channel = ap_cache.channel;
+        ap_cache_in_use = true;
+        ESP_LOGD(tag, "Using cached AP " MACSTR " on channel %d", MAC2STR(ap_cache.bssid), ap_cache.channel);
     }
 
     /* Set WiFi to station mode and apply configuration */
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
-    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
+    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &sta_config));
 
     /* TODO: Test if actually helps with connection stability */
     // ESP_ERROR_CHECK(esp_wifi_set_ps(WIFI_PS_NONE));
@@ -0,0 +1,92 @@
+/**
+ * @file fuzz_hue_https_response.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Fuzz harness feeding arbitrary streams of response body chunks into the hue_https response buffer
+ *
+ * Input is a sequence of operations: a length byte followed by that many chunk bytes appends a chunk (chunks are
+ * copied to exact size allocations and may contain null characters), 0xFF resets the buffer as a new request would,
+ * 0xFE appends an empty chunk with no data, and 0xFD followed by a length byte and that many bytes parses them as a
+ * Retry-After header value. After every operation the buffer must hold exactly the truncated concatenation of the
+ * chunks since the last reset, null-terminated, and the Retry-After must be unset or within its cap.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hue_https_private.h"
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define FUZZ_OP_RESET 0xFF       /**< Operation byte resetting the response buffer */
+#define FUZZ_OP_EMPTY 0xFE       /**< Operation byte appending an empty chunk with no data */
+#define FUZZ_OP_RETRY_AFTER 0xFD /**< Operation byte parsing a length-prefixed Retry-After header value */
+
+/** Aborts so the fuzzer records the input when a response buffer invariant does not hold */
+#define FUZZ_CHECK(condition)                                                                                          \
+    do {                                                                                                               \
+        if (!(condition)) abort();                                                                                     \
+    } while (0)
+
+/*====================================================================================================================*/
+/*=========================================== Harness Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static hue_https_response_t response;
+    static char expected[HUE_REQUEST_BUFFER_SIZE]; /* Model of what the buffer should hold */
+    size_t expected_len = 0;
+
+    hue_https_response_reset(&response);
+
+    size_t pos = 0;
+    while (pos < size) {
+        uint8_t op = data[pos++];
+
+        if (op == FUZZ_OP_RESET) {
+            hue_https_response_reset(&response);
+            expected_len = 0;
+        } else if (op == FUZZ_OP_EMPTY) {
+            hue_https_response_append(&response, NULL, 0);
+        } else if (op == FUZZ_OP_RETRY_AFTER) {
+            size_t value_len = (pos < size) ? data[pos++] : 0;
+            if (value_len > (size - pos)) value_len = size - pos;
+
+            /* Header values arrive null-terminated, stopping at any null inside the input like a header would */
+            char* value = malloc(value_len + 1);
+            if (!value) return 0;
+            memcpy(value, &data[pos], value_len);
+            value[value_len] = '\0';
+            hue_https_response_parse_retry_after(&response, value);
+            free(value);
+            pos += value_len;
+
+            FUZZ_CHECK(response.retry_after_ms >= -1);
+            FUZZ_CHECK(response.retry_after_ms <= HUE_HTTPS_RETRY_AFTER_MAX_MS);
+        } else {
+            size_t chunk_len = (op < (size - pos)) ? op : (size - pos);
+
+            /* Exact size copy without a terminator, like the chunks esp_http_client hands out */
+            char* chunk = malloc(chunk_len ? chunk_len : 1);
+            if (!chunk) return 0;
+            memcpy(chunk, &data[pos], chunk_len);
+            hue_https_response_append(&response, chunk, (int)chunk_len);
+            free(chunk);
+
+            size_t space = HUE_REQUEST_BUFFER_SIZE - 1 - expected_len;
+            size_t copy_len = (chunk_len < space) ? chunk_len : space;
+            memcpy(&expected[expected_len], &data[pos], copy_len);
+            expected_len += copy_len;
+            pos += chunk_len;
+        }
+
+        FUZZ_CHECK(response.length == expected_len);
+        FUZZ_CHECK(response.buff[response.length] == '\0');
+        FUZZ_CHECK(memcmp(response.buff, expected, expected_len) == 0);
+    }
+
+    return 0;
+}
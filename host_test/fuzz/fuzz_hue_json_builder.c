@@ -0,0 +1,149 @@
+/**
+ * @file fuzz_hue_json_builder.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Fuzz harness driving every hue_json_builder serializer with arbitrary light, smart scene and scene bitfields
+ *
+ * Input layout: 11 bytes of bitfield values followed by the resource ID string. Every combination is in range once
+ * clamped, so any error, an unterminated buffer, or malformed JSON aborts.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "hue_json_builder.h"
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define FUZZ_FIELD_BYTES 11 /**< Input bytes used for hue_light_data_t fields */
+
+/** Aborts so the fuzzer records the input when a serializer invariant does not hold */
+#define FUZZ_CHECK(condition)                                                                                          \
+    do {                                                                                                               \
+        if (!(condition)) abort();                                                                                     \
+    } while (0)
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Aborts unless the buffer holds a null-terminated, balanced JSON object for the given resource
+ */
+static void check_json(const hue_json_buffer_t* p_buffer, const char* resource_type, const char* resource_id);
+
+/**
+ * @brief Aborts unless a numeric field, if present in the JSON, is within the inclusive range
+ */
+static void check_field_range(const char* json, const char* field, int minimum, int maximum);
+
+/*====================================================================================================================*/
+/*=========================================== Harness Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+int LLVMFuzzerInitialize(int* argc, char*** argv) {
+    /* Clamping warns on every out of range value, which would drown the fuzzer output */
+    esp_log_level_set("*", ESP_LOG_NONE);
+    return 0;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size < FUZZ_FIELD_BYTES) return 0;
+
+    /* Remaining input is the resource ID, which the serializers pass through without reading */
+    char* resource_id = malloc(size - FUZZ_FIELD_BYTES + 1);
+    if (!resource_id) return 0;
+    memcpy(resource_id, &data[FUZZ_FIELD_BYTES], size - FUZZ_FIELD_BYTES);
+    resource_id[size - FUZZ_FIELD_BYTES] = '\0';
+
+    hue_light_data_t light = {
+        .resource_id = resource_id,
+        .off = data[0] & 0x01,
+        .brightness_action = (data[0] >> 1) & 0x03,
+        .brightness = data[1],
+        .color_temp_action = (data[0] >> 3) & 0x03,
+        .color_temp = data[2] | (data[3] << 8),
+        .set_color = (data[0] >> 5) & 0x01,
+        .color_gamut_x = data[4] | (data[5] << 8),
+        .color_gamut_y = data[6] | (data[7] << 8),
+        .set_duration = (data[10] >> 6) & 0x01,
+        .duration = data[8] | (data[9] << 8),
+        .effect = data[10] & 0x0F,
+        .timed_effect = (data[10] >> 4) & 0x03,
+    };
+    hue_smart_scene_data_t smart_scene = {.resource_id = resource_id, .deactivate = (data[0] >> 6) & 0x01};
+    hue_scene_data_t scene = {
+        .resource_id = resource_id,
+        .action = (data[0] >> 6) & 0x03,
+        .set_duration = light.set_duration,
+        .duration = light.duration,
+        .set_brightness = (data[10] >> 7) & 0x01,
+        .brightness = data[1],
+    };
+
+    /* Start from a dirty buffer, the serializers must not depend on its previous contents */
+    hue_json_buffer_t buffer;
+    memset(&buffer, data[7], sizeof(buffer));
+
+    FUZZ_CHECK(hue_light_data_to_json(&buffer, &light) == ESP_OK);
+    check_json(&buffer, "light", resource_id);
+    check_field_range(buffer.buff, "\"brightness\":", HUE_MIN_B_SET, HUE_MAX_B_SET);
+    check_field_range(buffer.buff, "\"brightness_delta\":", HUE_MIN_B_ADD, HUE_MAX_B_ADD);
+    check_field_range(buffer.buff, "\"mirek\":", HUE_MIN_CT_SET, HUE_MAX_CT_SET);
+    check_field_range(buffer.buff, "\"mirek_delta\":", HUE_MIN_CT_ADD, HUE_MAX_CT_ADD);
+
+    /* The duration goes to either dynamics or the timed effect, never both */
+    const char* p_duration = strstr(buffer.buff, "\"duration\":");
+    FUZZ_CHECK(!p_duration || !strstr(p_duration + 1, "\"duration\":"));
+
+    FUZZ_CHECK(hue_grouped_light_data_to_json(&buffer, &light) == ESP_OK);
+    check_json(&buffer, "grouped_light", resource_id);
+    FUZZ_CHECK(!strstr(buffer.buff, "effects\""));
+
+    FUZZ_CHECK(hue_smart_scene_data_to_json(&buffer, &smart_scene) == ESP_OK);
+    check_json(&buffer, "smart_scene", resource_id);
+
+    FUZZ_CHECK(hue_scene_data_to_json(&buffer, &scene) == ESP_OK);
+    check_json(&buffer, "scene", resource_id);
+    check_field_range(buffer.buff, "\"brightness\":", HUE_MIN_B_SET, HUE_MAX_B_SET);
+
+    free(resource_id);
+    return 0;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static void check_json(const hue_json_buffer_t* p_buffer, const char* resource_type, const char* resource_id) {
+    FUZZ_CHECK(strcmp(p_buffer->resource_type, resource_type) == 0);
+    FUZZ_CHECK(p_buffer->resource_id == resource_id);
+
+    size_t length = strnlen(p_buffer->buff, HUE_JSON_BUFFER_SIZE);
+    FUZZ_CHECK(length < HUE_JSON_BUFFER_SIZE);
+    FUZZ_CHECK((length >= 2) && (p_buffer->buff[0] == '{') && (p_buffer->buff[length - 1] == '}'));
+
+    /* Braces must balance and close only at the end, quotes must pair up */
+    int depth = 0;
+    size_t quotes = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (p_buffer->buff[i] == '{') depth++;
+        if (p_buffer->buff[i] == '}') depth--;
+        if (p_buffer->buff[i] == '"') quotes++;
+        FUZZ_CHECK((depth > 0) || (i == length - 1));
+    }
+    FUZZ_CHECK((depth == 0) && ((quotes % 2) == 0));
+}
+
+static void check_field_range(const char* json, const char* field, int minimum, int maximum) {
+    const char* p_field = strstr(json, field);
+    if (!p_field) return;
+
+    int value = atoi(p_field + strlen(field));
+    FUZZ_CHECK((value >= minimum) && (value <= maximum));
+}
@@ -0,0 +1,192 @@
+/**
+ * @file fuzz_main.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Standalone driver for the libFuzzer style harnesses, for compilers without -fsanitize=fuzzer and for AFL
+ *
+ * Usage: <harness> [--runs <n>] [--seed <n>] [--max-len <n>] [file|directory...]
+ *  With files, each file (or each file in a corpus directory) is passed to the harness once (AFL runs the harness as
+ *  "<harness> @@"). Without files, runs
+ *  that many random inputs of up to max-len bytes, so the harnesses can be exercised by ctest under the sanitizers.
+ */
+
+#include <dirent.h>
+#include <getopt.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define FUZZ_DEFAULT_RUNS 10000   /**< Random inputs run without files */
+#define FUZZ_DEFAULT_MAX_LEN 1024 /**< Longest random input */
+
+/*====================================================================================================================*/
+/*========================================== Harness Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+int LLVMFuzzerInitialize(int* argc, char*** argv) __attribute__((weak));
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Runs the harness once with the contents of a file
+ *
+ * @return 0 on success, 1 if the file could not be read
+ */
+static int run_file(const char* path);
+
+/**
+ * @brief Runs the harness with a file, or with every regular file in a directory
+ *
+ * @param[in] path File or directory path
+ * @param[in,out] p_count Incremented for every input run
+ *
+ * @return 0 on success, 1 if anything could not be read
+ */
+static int run_path(const char* path, uint32_t* p_count);
+
+/**
+ * @brief xorshift32 step, deterministic for a given seed
+ */
+static uint32_t next_random(uint32_t* p_state);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+int main(int argc, char** argv) {
+    uint32_t runs = FUZZ_DEFAULT_RUNS;
+    uint32_t seed = 1;
+    size_t max_len = FUZZ_DEFAULT_MAX_LEN;
+
+    static const struct option options[] = {
+        {"runs", required_argument, NULL, 'r'},
+        {"seed", required_argument, NULL, 's'},
+        {"max-len", required_argument, NULL, 'm'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "", options, NULL)) != -1) {
+        switch (opt) {
+            case 'r':
+                runs = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                seed = strtoul(optarg, NULL, 10);
+                break;
+            case 'm':
+                max_len = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [--runs <n>] [--seed <n>] [--max-len <n>] [file...]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if (LLVMFuzzerInitialize) LLVMFuzzerInitialize(&argc, &argv);
+
+    if (optind < argc) {
+        uint32_t count = 0;
+        for (int i = optind; i < argc; i++) {
+            if (run_path(argv[i], &count) != 0) return 1;
+        }
+        printf("%u inputs run\n", count);
+        return 0;
+    }
+
+    uint32_t state = seed ? seed : 1;
+    for (uint32_t run = 0; run < runs; run++) {
+        /* Favour short inputs, which reach every branch of the harnesses far more often */
+        size_t size = (next_random(&state) % (max_len + 1)) >> (next_random(&state) % 4);
+
+        /* Exact size allocation so the sanitizers catch reads past the end of the input */
+        uint8_t* data = malloc(size ? size : 1);
+        if (!data) return 1;
+        for (size_t i = 0; i < size; i++) data[i] = (uint8_t)next_random(&state);
+        LLVMFuzzerTestOneInput(data, size);
+        free(data);
+    }
+
+    printf("%u random inputs run, seed %u\n", runs, seed);
+    return 0;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static int run_file(const char* path) {
+    FILE* p_file = fopen(path, "rb");
+    if (!p_file) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return 1;
+    }
+
+    fseek(p_file, 0, SEEK_END);
+    long size = ftell(p_file);
+    fseek(p_file, 0, SEEK_SET);
+
+    /* Exact size allocation so the sanitizers catch reads past the end of the input */
+    uint8_t* data = malloc(size > 0 ? size : 1);
+    if (!data || (size < 0) || (fread(data, 1, size, p_file) != (size_t)size)) {
+        fprintf(stderr, "Failed to read %s\n", path);
+        free(data);
+        fclose(p_file);
+        return 1;
+    }
+    fclose(p_file);
+
+    LLVMFuzzerTestOneInput(data, size);
+    free(data);
+    return 0;
+}
+
+static int run_path(const char* path, uint32_t* p_count) {
+    struct stat path_stat;
+    if (stat(path, &path_stat) != 0) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return 1;
+    }
+
+    if (!S_ISDIR(path_stat.st_mode)) {
+        (*p_count)++;
+        return run_file(path);
+    }
+
+    DIR* p_dir = opendir(path);
+    if (!p_dir) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return 1;
+    }
+
+    int err = 0;
+    struct dirent* p_entry;
+    while (!err && (p_entry = readdir(p_dir))) {
+        if (p_entry->d_name[0] == '.') continue;
+
+        char entry_path[PATH_MAX];
+        snprintf(entry_path, sizeof(entry_path), "%s/%s", path, p_entry->d_name);
+        if ((stat(entry_path, &path_stat) == 0) && S_ISREG(path_stat.st_mode)) {
+            (*p_count)++;
+            err = run_file(entry_path);
+        }
+    }
+    closedir(p_dir);
+    return err;
+}
+
+static uint32_t next_random(uint32_t* p_state) {
+    uint32_t x = *p_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *p_state = x;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file hue_config_test.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host tests for hue_config.h as generated by main/hue_config.cmake from the sample settings in CMakeLists.txt
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "hue_config.h"
+#include "hue_validate.h"
+#include "unity.h"
+#include "unity_test_runner.h"
+
+TEST_CASE("Bridge IP is dotted decimal without leading zeros", "[hue_config]") {
+    TEST_ASSERT_EQUAL_STRING("192.168.50.2", HUE_CONFIG_BRIDGE_IP);
+}
+
+TEST_CASE("Bridge IP integer is in host order", "[hue_config]") {
+    TEST_ASSERT_EQUAL_UINT32(0xC0A83202, HUE_CONFIG_BRIDGE_IP_U32);
+}
+
+TEST_CASE("Resource IDs are lowercase and pass the hue_https check", "[hue_config]") {
+    TEST_ASSERT_EQUAL_STRING("8c2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f5a6b", HUE_CONFIG_LIGHT_ID);
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_resource_id(HUE_CONFIG_LIGHT_ID));
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_resource_id(HUE_CONFIG_GROUPED_LIGHT_ID));
+    TEST_ASSERT_EQUAL(ESP_OK, hue_validate_resource_id(HUE_CONFIG_SMART_SCENE_ID));
+}
+
+TEST_CASE("Resource UUIDs hold the ID bytes in order", "[hue_config]") {
+    static const uint8_t light[] = HUE_CONFIG_LIGHT_UUID;
+    static const uint8_t grouped_light[] = HUE_CONFIG_GROUPED_LIGHT_UUID;
+    static const uint8_t smart_scene[] = HUE_CONFIG_SMART_SCENE_UUID;
+    static const uint8_t expected_light[] = {0x8c, 0x2e, 0x1f, 0x6a, 0x3b, 0x4d, 0x4e, 0x5f,
+                                             0x9a, 0x0b, 0x1c, 0x2d, 0x3e, 0x4f, 0x5a, 0x6b};
+    static const uint8_t expected_smart_scene[] = {0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x11, 0x11,
+                                                   0x22, 0x22, 0x01, 0x23, 0x45, 0x67, 0x89, 0xab};
+
+    TEST_ASSERT_EQUAL(16, sizeof(light));
+    TEST_ASSERT_EQUAL_MEMORY(expected_light, light, sizeof(light));
+    for (size_t i = 0; i < sizeof(grouped_light); i++) TEST_ASSERT_EQUAL_UINT8(0, grouped_light[i]);
+    TEST_ASSERT_EQUAL_MEMORY(expected_smart_scene, smart_scene, sizeof(smart_scene));
+}
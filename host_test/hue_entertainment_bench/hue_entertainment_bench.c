@@ -0,0 +1,331 @@
+/**
+ * @file hue_entertainment_bench.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host benchmark streaming hue_entertainment to the mock entertainment receiver, reporting the frame rate and
+ * interval jitter measured on arrival
+ *
+ * The entertainment configuration is started and stopped on the mock bridge over CLIP v2 like on a real bridge, and
+ * the channels are animated from the main task while the stream runs, so frames are paced against concurrent updates.
+ *
+ * Usage: hue_entertainment_bench [options]
+ *  --rate-hz <n>            Frames per second, 25-50 (default 50)
+ *  --seconds <n>            Time to stream for (default 5)
+ *  --channels <n>           Channels in every frame, 1-20 (default 10)
+ *  --color-space <space>    rgb or xy (default rgb)
+ *  --core <n>               Core to pin the stream task to (default either core)
+ *  --max-jitter-ms <ms>     Exit with failure if the p99 difference between arrival intervals and the period is larger
+ *  --min-rate-percent <n>   Exit with failure if fewer frames arrive per second than this share of --rate-hz
+ *  --verbose                Keep hue_entertainment, HTTP client and receiver logging
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "host_mocks.h"
+#include "hue_entertainment.h"
+#include "mock_bridge.h"
+#include "mock_entertainment.h"
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define BENCH_BRIDGE_IP "127.000.000.001" /**< Loopback in the fixed width form hue_entertainment expects */
+#define BENCH_BRIDGE_ID "001788fffe4b1e55"
+#define BENCH_APP_KEY "benchbenchbenchbenchbenchbenchbenchbench"
+#define BENCH_CLIENT_KEY "0123456789ABCDEF0123456789abcdef"
+#define BENCH_CONFIGURATION_ID "4f3c2b1a-9e8d-4c7b-8a69-584736251403"
+
+#define BENCH_UPDATE_INTERVAL_MS 7      /**< Time between channel updates, deliberately not a multiple of any period */
+#define BENCH_SETTLE_PERIODS 5          /**< Frame periods waited for the final channels to arrive */
+#define BENCH_CLOSE_TIMEOUT_US 1000000  /**< Longest close_notify may take to reach the receiver after stopping */
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Fills channels with colors for an animation step, each channel offset from the previous one
+ *
+ * @param[out] p_channels Channels to fill
+ * @param[in] count Number of channels
+ * @param[in] step Animation step, 0 for the final colors checked at the end
+ */
+static void animate_channels(hue_entertainment_channel_t* p_channels, uint8_t count, uint32_t step);
+
+/**
+ * @brief Checks that a received frame carries exactly the given channels
+ *
+ * @return true if every channel ID and value matches
+ */
+static bool frame_matches(const uint8_t* frame, size_t length, const hue_entertainment_channel_t* p_channels,
+                          uint8_t count);
+
+/**
+ * @brief qsort comparator for int64_t
+ */
+static int compare_int64(const void* a, const void* b);
+
+/**
+ * @brief Returns the nearest-rank percentile of sorted samples in milliseconds
+ */
+static double percentile_ms(const int64_t* sorted, uint32_t count, double percent);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+int main(int argc, char** argv) {
+    uint32_t rate_hz = 50;
+    uint32_t seconds = 5;
+    uint32_t channel_count = 10;
+    hue_entertainment_color_space_t color_space = HUE_ENTERTAINMENT_COLOR_SPACE_RGB;
+    int core_id = HUE_ENTERTAINMENT_TASK_ANY_CORE;
+    double max_jitter_ms = -1;
+    double min_rate_percent = -1;
+    bool verbose = false;
+
+    static const struct option options[] = {
+        {"rate-hz", required_argument, NULL, 'r'},       {"seconds", required_argument, NULL, 's'},
+        {"channels", required_argument, NULL, 'n'},      {"color-space", required_argument, NULL, 'x'},
+        {"core", required_argument, NULL, 'c'},          {"max-jitter-ms", required_argument, NULL, 'j'},
+        {"min-rate-percent", required_argument, NULL, 'm'}, {"verbose", no_argument, NULL, 'v'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "", options, NULL)) != -1) {
+        switch (opt) {
+            case 'r':
+                rate_hz = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                seconds = strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                channel_count = strtoul(optarg, NULL, 10);
+                break;
+            case 'x':
+                if (strcmp(optarg, "xy") == 0) {
+                    color_space = HUE_ENTERTAINMENT_COLOR_SPACE_XY;
+                } else if (strcmp(optarg, "rgb") != 0) {
+                    fprintf(stderr, "--color-space must be rgb or xy\n");
+                    return 2;
+                }
+                break;
+            case 'c':
+                core_id = atoi(optarg);
+                break;
+            case 'j':
+                max_jitter_ms = strtod(optarg, NULL);
+                break;
+            case 'm':
+                min_rate_percent = strtod(optarg, NULL);
+                break;
+            case 'v':
+                verbose = true;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [options], see hue_entertainment_bench.c for options\n", argv[0]);
+                return 2;
+        }
+    }
+    if ((rate_hz < HUE_ENTERTAINMENT_MIN_RATE_HZ) || (rate_hz > HUE_ENTERTAINMENT_MAX_RATE_HZ)) {
+        fprintf(stderr, "--rate-hz must be between %d and %d\n", HUE_ENTERTAINMENT_MIN_RATE_HZ,
+                HUE_ENTERTAINMENT_MAX_RATE_HZ);
+        return 2;
+    }
+    if ((channel_count == 0) || (channel_count > HUE_ENTERTAINMENT_MAX_CHANNELS) || (seconds == 0)) {
+        fprintf(stderr, "--channels must be between 1 and %d and --seconds at least 1\n",
+                HUE_ENTERTAINMENT_MAX_CHANNELS);
+        return 2;
+    }
+
+    if (!verbose) {
+        esp_log_level_set("hue_entertainment_instance", ESP_LOG_NONE);
+        esp_log_level_set("hue_entertainment_dtls", ESP_LOG_NONE);
+        esp_log_level_set("host_http_client", ESP_LOG_NONE);
+        esp_log_level_set("mock_entertainment", ESP_LOG_NONE);
+    }
+
+    /* The bridge takes the start and stop requests, the receiver takes the stream, each on an ephemeral port */
+    mock_bridge_handle_t bridge = NULL;
+    mock_bridge_config_t bridge_config = {
+        .bridge_id = BENCH_BRIDGE_ID,
+        .application_key = BENCH_APP_KEY,
+        .seed = 1,
+    };
+    mock_entertainment_handle_t receiver = NULL;
+    mock_entertainment_config_t receiver_config = {
+        .application_key = BENCH_APP_KEY,
+        .client_key = BENCH_CLIENT_KEY,
+        .entertainment_configuration_id = BENCH_CONFIGURATION_ID,
+    };
+    if ((mock_bridge_start(&bridge, &bridge_config) != ESP_OK) ||
+        (mock_entertainment_start(&receiver, &receiver_config) != ESP_OK)) {
+        fprintf(stderr, "Failed to start mock bridge or entertainment receiver\n");
+        mock_bridge_stop(&bridge);
+        return 1;
+    }
+    host_http_client_set_port_override(mock_bridge_get_port(bridge));
+    host_http_client_set_ca_override(mock_bridge_get_cert_pem(bridge));
+    host_dtls_set_port_override(mock_entertainment_get_port(receiver));
+
+    hue_entertainment_handle_t stream = NULL;
+    hue_entertainment_config_t stream_config = {
+        .bridge_ip = BENCH_BRIDGE_IP,
+        .bridge_id = BENCH_BRIDGE_ID,
+        .application_key = BENCH_APP_KEY,
+        .client_key = BENCH_CLIENT_KEY,
+        .entertainment_configuration_id = BENCH_CONFIGURATION_ID,
+        .task_id = "hue_ent_bench",
+        .color_space = color_space,
+        .rate_hz = rate_hz,
+        .task_placement_set = true,
+        .task_priority = HUE_ENTERTAINMENT_DEFAULT_TASK_PRIORITY,
+        .task_core_id = core_id,
+    };
+    esp_err_t err = hue_entertainment_start(&stream, &stream_config);
+    char start_body[64];
+    mock_bridge_get_last_body(bridge, start_body, sizeof(start_body));
+    if (err != ESP_OK) {
+        fprintf(stderr, "Failed to start stream, %s\n", esp_err_to_name(err));
+        mock_entertainment_stop(&receiver);
+        mock_bridge_stop(&bridge);
+        return 1;
+    }
+
+    /* Channels change faster than frames are sent, every frame takes whatever was set last */
+    hue_entertainment_channel_t channels[HUE_ENTERTAINMENT_MAX_CHANNELS];
+    int64_t end_us = esp_timer_get_time() + (int64_t)seconds * 1000000;
+    uint32_t updates = 0;
+    while (esp_timer_get_time() < end_us) {
+        animate_channels(channels, channel_count, ++updates);
+        hue_entertainment_set_channels(stream, channels, channel_count);
+        vTaskDelay(pdMS_TO_TICKS(BENCH_UPDATE_INTERVAL_MS));
+    }
+
+    /* The final colors must be what the bridge ends up showing */
+    animate_channels(channels, channel_count, 0);
+    hue_entertainment_set_channels(stream, channels, channel_count);
+    vTaskDelay(pdMS_TO_TICKS(BENCH_SETTLE_PERIODS * 1000 / rate_hz));
+
+    hue_entertainment_stats_t stream_stats;
+    hue_entertainment_get_stats(stream, &stream_stats);
+    err = hue_entertainment_stop(&stream);
+    char stop_body[64];
+    mock_bridge_get_last_body(bridge, stop_body, sizeof(stop_body));
+
+    /* close_notify is sent before the stop request, it only needs to be received */
+    mock_entertainment_stats_t receiver_stats;
+    int64_t close_deadline_us = esp_timer_get_time() + BENCH_CLOSE_TIMEOUT_US;
+    do {
+        vTaskDelay(1);
+        mock_entertainment_get_stats(receiver, &receiver_stats);
+    } while (!receiver_stats.sessions_closed && (esp_timer_get_time() < close_deadline_us));
+
+    uint8_t last_frame[HUE_ENTERTAINMENT_FRAME_MAX_SIZE];
+    size_t last_frame_length = mock_entertainment_get_last_frame(receiver, last_frame, sizeof(last_frame));
+    bool final_state = frame_matches(last_frame, last_frame_length, channels, channel_count) &&
+                       (last_frame[14] == color_space);
+
+    static int64_t intervals[MOCK_ENTERTAINMENT_MAX_INTERVALS];
+    static int64_t jitter[MOCK_ENTERTAINMENT_MAX_INTERVALS];
+    uint32_t interval_count = mock_entertainment_get_intervals(receiver, intervals, MOCK_ENTERTAINMENT_MAX_INTERVALS);
+    int64_t period_us = 1000000 / rate_hz;
+    for (uint32_t i = 0; i < interval_count; i++) {
+        jitter[i] = (intervals[i] > period_us) ? (intervals[i] - period_us) : (period_us - intervals[i]);
+    }
+    qsort(intervals, interval_count, sizeof(int64_t), compare_int64);
+    qsort(jitter, interval_count, sizeof(int64_t), compare_int64);
+
+    double stream_s = (receiver_stats.last_frame_us - receiver_stats.first_frame_us) / 1e6;
+    double measured_hz = (stream_s > 0) ? ((receiver_stats.frames - 1) / stream_s) : 0;
+    double rate_percent = 100.0 * measured_hz / rate_hz;
+    bool bodies_ok = (strcmp(start_body, "{\"action\":\"start\"}") == 0) &&
+                     (strcmp(stop_body, "{\"action\":\"stop\"}") == 0) && (err == ESP_OK);
+
+    printf("hue_entertainment_bench: %u Hz for %u s, %u %s channels, %u channel updates\n", rate_hz, seconds,
+           channel_count, (color_space == HUE_ENTERTAINMENT_COLOR_SPACE_XY) ? "xy" : "rgb", updates);
+    printf("  handshake   %.2f ms\n", stream_stats.handshake_us / 1e3);
+    printf("  sender      %u sent, %u failed, %u late, jitter avg %.3f ms, max %.3f ms\n", stream_stats.frames_sent,
+           stream_stats.send_failures, stream_stats.frames_late,
+           (stream_stats.frames_sent > 1) ? (stream_stats.total_jitter_us / 1e3 / (stream_stats.frames_sent - 1)) : 0.0,
+           stream_stats.max_jitter_us / 1e3);
+    printf("  receiver    %u frames, %u bad, %u sequence gaps, %u handshakes, %u failed, %u closed\n",
+           receiver_stats.frames, receiver_stats.bad_frames, receiver_stats.sequence_gaps, receiver_stats.handshakes,
+           receiver_stats.handshake_failures, receiver_stats.sessions_closed);
+    printf("  rate        %.2f frames/s measured on arrival (%.1f%% of %u Hz)\n", measured_hz, rate_percent, rate_hz);
+    if (interval_count) {
+        printf("  interval    p50 %.3f ms, p99 %.3f ms, min %.3f ms, max %.3f ms (period %.3f ms)\n",
+               percentile_ms(intervals, interval_count, 50), percentile_ms(intervals, interval_count, 99),
+               intervals[0] / 1e3, intervals[interval_count - 1] / 1e3, period_us / 1e3);
+        printf("  jitter      p50 %.3f ms, p99 %.3f ms, max %.3f ms (|interval - period|)\n",
+               percentile_ms(jitter, interval_count, 50), percentile_ms(jitter, interval_count, 99),
+               jitter[interval_count - 1] / 1e3);
+    }
+    printf("  bridge      start %s, stop %s, final state %s\n", start_body, stop_body,
+           final_state ? "received" : "lost");
+
+    mock_entertainment_stop(&receiver);
+    mock_bridge_stop(&bridge);
+
+    /* A session with no bad or missing frames is required however loose the timing bounds are */
+    bool ok = bodies_ok && final_state && (receiver_stats.handshakes == 1) && (receiver_stats.sessions_closed == 1) &&
+              (receiver_stats.bad_frames == 0) && (receiver_stats.sequence_gaps == 0) && (interval_count > 0);
+    if ((min_rate_percent >= 0) && (rate_percent < min_rate_percent)) ok = false;
+    if ((max_jitter_ms >= 0) && interval_count && (percentile_ms(jitter, interval_count, 99) > max_jitter_ms)) {
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static void animate_channels(hue_entertainment_channel_t* p_channels, uint8_t count, uint32_t step) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t phase = (uint16_t)((step * 257) + (i * 3277));
+        p_channels[i] = (hue_entertainment_channel_t){
+            .channel_id = i,
+            .values = {phase, (uint16_t)(UINT16_MAX - phase), (uint16_t)(phase ^ 0x5a5a)},
+        };
+    }
+}
+
+static bool frame_matches(const uint8_t* frame, size_t length, const hue_entertainment_channel_t* p_channels,
+                          uint8_t count) {
+    if (length != (HUE_ENTERTAINMENT_FRAME_HEADER_SIZE + (count * HUE_ENTERTAINMENT_CHANNEL_SIZE))) return false;
+
+    /* Values are big-endian on the wire */
+    for (uint8_t i = 0; i < count; i++) {
+        const uint8_t* p_channel = &frame[HUE_ENTERTAINMENT_FRAME_HEADER_SIZE + (i * HUE_ENTERTAINMENT_CHANNEL_SIZE)];
+        if (p_channel[0] != p_channels[i].channel_id) return false;
+        for (uint8_t v = 0; v < 3; v++) {
+            if ((uint16_t)((p_channel[1 + v * 2] << 8) | p_channel[2 + v * 2]) != p_channels[i].values[v]) return false;
+        }
+    }
+    return true;
+}
+
+static int compare_int64(const void* a, const void* b) {
+    int64_t lhs = *(const int64_t*)a;
+    int64_t rhs = *(const int64_t*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static double percentile_ms(const int64_t* sorted, uint32_t count, double percent) {
+    uint32_t rank = (uint32_t)((percent / 100.0) * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1] / 1e3;
+}
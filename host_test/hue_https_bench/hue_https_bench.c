@@ -0,0 +1,1189 @@
+/**
+ * @file hue_https_bench.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host benchmark driving hue_https against the mock bridge, reporting trigger to 200 OK latency percentiles and
+ * request throughput
+ *
+ * Usage: hue_https_bench [options]
+ *  --requests <n>          Number of requests to send one after another (default 200)
+ *  --resource <type>       light, grouped_light, smart_scene or scene (default light)
+ *  --template              Perform a const request template instead of a created request handle
+ *  --core <n>              Core to pin the hue_https task to (default either core)
+ *  --scan-load <percent>   CPU time taken by a simulated BLE scan task, busy for that share of every 10 ms
+ *  --scan-core <n>         Core to pin the simulated BLE scan task to (default 0)
+ *  --reconnect-every <n>   Disconnect and reconnect WiFi before every nth request (default never)
+ *  --offline-requests <n>  After the run, disconnect WiFi, make n requests and reconnect, timing how long the held
+ *                          requests take to reach the bridge
+ *  --flush-forced <n>      After the run, disconnect WiFi, hold a request for each of several lights and reconnect,
+ *                          forcing n requests through while the held ones are sent, reporting their queueing delay
+ *  --burst <n>             After the run, force n commands with changing brightness through, reporting how many reach
+ *                          the bridge, their success rate, and if the final state arrived
+ *  --burst-interval-ms <ms> Time between burst commands (default 20)
+ *  --room-lights <n>       After the run, set a room of n lights to one look, first with a light request per light and
+ *                          then by recalling a scene, reporting the bridge requests and time each took
+ *  --batch-lights <n>      After the run, set n lights to one look as a light batch over rooms of 8 lights, the last
+ *                          of which has lights outside the batch, reporting the requests it took instead of n
+ *  --batch-grouped <n>     Grouped light requests the light batch must take, failing the run otherwise (default any
+ *                          up to the whole rooms of the batch)
+ *  --no-rate-limit         Send every resource type without pacing
+ *  --rate-interval-ms <ms> Pace every resource type to one request per ms instead of the defaults, lower than the
+ *                          bridge budget to leave it to 429s and the send rate controller
+ *  --bridge-budget         Throttle the bridge to 10 light and 1 group command a second like a real bridge
+ *  --retry-attempts <n>    hue_https retry attempts per request (default 0)
+ *  --background-every-ms <ms> After the run, perform background light requests for several resources this often
+ *                          while interactive ones are made, reporting the queueing delay of each priority class
+ *  --preempt-background    Interactive requests abort a background request being sent
+ *  --ttl-ms <ms>           Deadline of every request from its trigger, failing the run if a request is answered
+ *                          later than that (default none)
+ *  --latency-ms <ms>       Bridge response latency
+ *  --jitter-ms <ms>        Random extra bridge latency in range [0-ms]
+ *  --drop <percent>        Requests the bridge answers by closing the connection
+ *  --throttle <percent>    Requests the bridge answers with 429
+ *  --unavailable <percent> Requests the bridge answers with 503
+ *  --error <percent>       Requests the bridge answers with 500
+ *  --retry-after <s>       Retry-After sent with 429 and 503
+ *  --seed <n>              Fault injection seed (default 1)
+ *  --min-success <percent> Exit with failure if fewer requests succeed, for use in tests
+ *  --verbose               Keep hue_https and HTTP client logging
+ */
+
+#include <getopt.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_event.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "host_mocks.h"
+#include "hue_https.h"
+#include "mock_bridge.h"
+#include "wifi_connect.h"
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define BENCH_BRIDGE_IP "127.000.000.001" /**< Loopback in the fixed width form hue_https expects */
+#define BENCH_BRIDGE_ID "001788fffe4b1e55"
+#define BENCH_APP_KEY "benchbenchbenchbenchbenchbenchbenchbench"
+#define BENCH_RESOURCE_ID "8c2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f5a6b"
+/** BENCH_RESOURCE_ID as UUID bytes, like the HUE_CONFIG_[resource]_UUID initializers generated from sdkconfig */
+#define BENCH_RESOURCE_UUID                                                                                            \
+    {0x8c, 0x2e, 0x1f, 0x6a, 0x3b, 0x4d, 0x4e, 0x5f, 0x9a, 0x0b, 0x1c, 0x2d, 0x3e, 0x4f, 0x5a, 0x6b}
+
+#define BENCH_REQUEST_TIMEOUT_US 60000000 /**< Longest a single request may take including every retry */
+#define BENCH_PREWARM_TIMEOUT_US 10000000 /**< Longest the bridge connection may take to open after WiFi connects */
+#define BENCH_BRIDGE_LIGHT_BUDGET 10      /**< Light commands a second a real bridge handles, for --bridge-budget */
+#define BENCH_BRIDGE_GROUP_BUDGET 1       /**< Group commands a second a real bridge handles, for --bridge-budget */
+#define BENCH_SCAN_PERIOD_US 10000        /**< Period of the simulated BLE scan load, like a short scan window */
+#define BENCH_BACKGROUND_RESOURCES 8      /**< Resources the background load cycles through */
+#define BENCH_BACKGROUND_INTERACTIVE 10   /**< Interactive requests made during the background load */
+#define BENCH_BACKGROUND_SPACING_MS 250   /**< Time between those interactive requests, like separate presence edges */
+/** Queueing delay interactive requests must stay under with background load, one light token interval and slack */
+#define BENCH_INTERACTIVE_QUEUE_BOUND_US 250000
+#define BENCH_DEADLINE_SLACK_US 250000    /**< Round trip allowed past --ttl-ms for an attempt started just inside it */
+#define BENCH_ROOM_BRIGHTNESS 60          /**< Brightness the room is set to, per light and as the scene override */
+#define BENCH_ROOM_MAX_LIGHTS 16          /**< Most --room-lights, leaving table room for the other resources */
+#define BENCH_BATCH_ROOM_LIGHTS 8           /**< Lights in each room configured for --batch-lights */
+#define BENCH_FLUSH_HELD 8                /**< Lights a request is held for before --flush-forced reconnects */
+#define BENCH_FLUSH_FORCED_SPACING_MS 50  /**< Time between the requests forced through while held ones are sent */
+/** Queueing delay forced requests must stay under while held requests are sent, the token of the held request being
+ * sent, their own and slack */
+#define BENCH_FLUSH_QUEUE_BOUND_US 350000
+/** Resource ID of the batch lights and rooms, differing in the last byte */
+#define BENCH_BATCH_RESOURCE_ID_FORMAT "8c2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f5a%02x"
+/** Resource ID of the rooms set next to the batch rooms and their lights, differing in the last 2 bytes */
+#define BENCH_FILLER_RESOURCE_ID_FORMAT "8c2e1f6a-3b4d-4e5f-9a0b-1c2d3e4f%04x"
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static uint32_t scan_load_percent;    /**< Busy share of each period, set before the scan task is created */
+static atomic_bool scan_load_stop;    /**< Set to end the simulated BLE scan task */
+static atomic_uint scan_load_periods; /**< Periods completed by the simulated BLE scan task */
+
+static hue_https_handle_t background_handle; /**< Instance the background load task performs requests with */
+static uint32_t background_every_ms;         /**< Time between background requests */
+static atomic_bool background_stop;          /**< Set to end the background load task */
+static atomic_bool background_stopped;       /**< Set by the background load task once it has stopped */
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Creates the request sent on every iteration
+ *
+ * @param[out] p_request_handle Request handle to create
+ * @param[in] resource Resource type name
+ *
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG for an unknown resource type
+ */
+static esp_err_t create_request(hue_https_request_handle_t* p_request_handle, const char* resource);
+
+/**
+ * @brief Returns the const template performing the same actions create_request() creates a request for
+ *
+ * @param[in] resource Resource type name
+ *
+ * @return Template, or NULL for an unknown resource type
+ */
+static const hue_https_request_template_t* find_template(const char* resource);
+
+/**
+ * @brief Simulated BLE scan load, busy for scan_load_percent of every period like advertising report processing
+ */
+static void scan_load_task(void* pvParameters);
+
+/**
+ * @brief Posts WIFI_CONNECT_EVENT_CONNECTED, optionally preceded by a disconnection, like wifi_connect does
+ *
+ * @param[in] hue_https_handle Instance following the events
+ * @param[in] reconnect Post WIFI_CONNECT_EVENT_DISCONNECTED first
+ *
+ * @return true once the instance has pre-warmed its bridge connection, false on timeout
+ */
+static bool connect_wifi(hue_https_handle_t hue_https_handle, bool reconnect);
+
+/**
+ * @brief Disconnects WiFi, performs requests while offline and reconnects, waiting for the held requests to be sent
+ *
+ * @param[in] hue_https_handle Instance to perform requests with
+ * @param[in] request_handle Request to perform, or NULL to perform p_template
+ * @param[in] p_template Template to perform if request_handle is NULL
+ * @param[in] count Number of requests to perform while disconnected
+ * @param[out] p_stats Statistics once the held requests have been sent
+ *
+ * @return true once every held request has been sent, false on timeout
+ */
+static bool run_offline(hue_https_handle_t hue_https_handle, hue_https_request_handle_t request_handle,
+                        const hue_https_request_template_t* p_template, uint32_t count, hue_https_stats_t* p_stats);
+
+/** @brief Outcome of run_flush() */
+typedef struct {
+    uint32_t held_ok;            /**< Held requests answered with 200 OK */
+    uint32_t failed;             /**< Requests that failed, held or forced */
+    uint32_t forced_started;     /**< Forced requests sent, the rest were replaced by a newer one */
+    int64_t max_forced_delay_us; /**< Longest queueing delay of an interactive request over the whole run */
+    int64_t converge_us;         /**< Reconnection to the last held request being answered */
+} bench_flush_t;
+
+/**
+ * @brief Disconnects WiFi, holds a request for each of BENCH_FLUSH_HELD lights and reconnects, forcing requests for
+ * another light through while the held ones are sent
+ *
+ * @param[in] hue_https_handle Instance to perform requests with
+ * @param[in] count Number of requests to force through
+ * @param[out] p_flush Outcome
+ *
+ * @return true once every held and forced request has been answered, false on timeout
+ */
+static bool run_flush(hue_https_handle_t hue_https_handle, uint32_t count, bench_flush_t* p_flush);
+
+/** @brief Outcome of run_burst() */
+typedef struct {
+    uint32_t ok;        /**< Commands answered with 200 OK */
+    uint32_t failed;    /**< Commands that failed, including 429 responses */
+    uint32_t coalesced; /**< Commands replaced by a later one before being sent */
+    int64_t elapsed_us; /**< First command to the last one being accounted for */
+    bool final_state;   /**< The bridge's last accepted command was the final one of the burst */
+} bench_burst_t;
+
+/**
+ * @brief Forces commands for one resource through with changing brightness, waiting for every one to be accounted for
+ *
+ * @param[in] hue_https_handle Instance to perform the commands with
+ * @param[in] bridge Bridge to read the last accepted command from
+ * @param[in] resource Resource type name
+ * @param[in] count Number of commands
+ * @param[in] interval_ms Time between commands
+ * @param[out] p_burst Outcome
+ *
+ * @return true once every command has been sent or replaced, false on timeout
+ */
+static bool run_burst(hue_https_handle_t hue_https_handle, mock_bridge_handle_t bridge, const char* resource,
+                      uint32_t count, uint32_t interval_ms, bench_burst_t* p_burst);
+
+/** @brief Outcome of one way of setting the room in run_room() */
+typedef struct {
+    uint32_t performed; /**< Requests performed */
+    uint32_t ok;        /**< Requests answered with 200 OK */
+    uint32_t bridge;    /**< Requests the bridge received */
+    int64_t elapsed_us; /**< First request performed to the last one answered */
+} bench_room_pass_t;
+
+/** @brief Outcome of run_room() */
+typedef struct {
+    bench_room_pass_t lights; /**< A light request per light */
+    bench_room_pass_t scene;  /**< One scene recall */
+} bench_room_t;
+
+/**
+ * @brief Sets a room of lights to one look with a light request per light, then with a single scene recall
+ *
+ * @param[in] hue_https_handle Instance to perform the requests with
+ * @param[in] bridge Bridge to count the received requests of
+ * @param[in] lights Number of lights in the room
+ * @param[out] p_room Outcome
+ *
+ * @return true once every request of both has been answered, false on timeout
+ */
+static bool run_room(hue_https_handle_t hue_https_handle, mock_bridge_handle_t bridge, uint32_t lights,
+                     bench_room_t* p_room);
+
+/**
+ * @brief Performs templates one after another, one per resource, each once the previous one has been answered or
+ * has failed
+ *
+ * @param[in] hue_https_handle Instance to perform the templates with
+ * @param[in] bridge Bridge to count the received requests of
+ * @param[in] p_base Template to perform, its last resource ID byte is replaced for each resource
+ * @param[in] count Number of resources
+ * @param[out] p_pass Outcome
+ *
+ * @return true once every request has been accounted for, false on timeout
+ */
+static bool run_room_pass(hue_https_handle_t hue_https_handle, mock_bridge_handle_t bridge,
+                          const hue_https_request_template_t* p_base, uint32_t count, bench_room_pass_t* p_pass);
+
+/** @brief Outcome of run_batch() */
+typedef struct {
+    hue_https_batch_result_t result; /**< How the batch was sent */
+    uint32_t ok;                     /**< Requests answered with 200 OK */
+    uint32_t bridge;                 /**< Requests the bridge received */
+    uint32_t consolidated;           /**< Requests saved, as counted by the instance */
+    int64_t elapsed_us;              /**< Batch performed to its last request answered */
+} bench_batch_t;
+
+/**
+ * @brief Configures rooms of BENCH_BATCH_ROOM_LIGHTS lights and sets some of their lights to one look as a light batch.
+ * Rooms of HUE_HTTPS_GROUP_MAX_LIGHTS lights outside the batch fill the membership up to HUE_HTTPS_GROUPS_SIZE rooms,
+ * which must all fit the resource table
+ *
+ * @param[in] hue_https_handle Instance to perform the batch with
+ * @param[in] bridge Bridge to count the received requests of
+ * @param[in] lights Number of lights in the batch, the last room is only partly in it unless lights is a multiple of
+ * BENCH_BATCH_ROOM_LIGHTS
+ * @param[out] p_batch Outcome
+ *
+ * @return true once every request of the batch has been answered, false on timeout
+ */
+static bool run_batch(hue_https_handle_t hue_https_handle, mock_bridge_handle_t bridge, uint32_t lights,
+                      bench_batch_t* p_batch);
+
+/** @brief Outcome of run_background() */
+typedef struct {
+    hue_https_class_stats_t classes[HUE_HTTPS_PRIORITY_COUNT]; /**< Started count and queueing delay during the run */
+    uint32_t preempted;                                        /**< Background requests aborted and queued again */
+} bench_background_t;
+
+/**
+ * @brief Performs background requests for several resources while making interactive requests one after another,
+ * waiting for the queue to drain afterwards
+ *
+ * @param[in] hue_https_handle Instance to perform the requests with
+ * @param[in] every_ms Time between background requests
+ * @param[out] p_background Outcome, maximum delays cover the whole run of the instance
+ *
+ * @return true once every interactive request was started and the queue drained, false on timeout
+ */
+static bool run_background(hue_https_handle_t hue_https_handle, uint32_t every_ms, bench_background_t* p_background);
+
+/**
+ * @brief Simulated background work, performs a background light request for the next resource every
+ * background_every_ms until background_stop is set
+ *
+ * @param[in] pvParameters Unused
+ */
+static void background_load_task(void* pvParameters);
+
+/**
+ * @brief Blocks until the instance has recorded a result beyond the given count
+ *
+ * @param[in] hue_https_handle Instance to watch
+ * @param[in] completed Number of results recorded before the request was sent
+ * @param[out] p_stats Statistics once the result is recorded
+ *
+ * @return true once recorded, false on timeout
+ */
+static bool wait_for_result(hue_https_handle_t hue_https_handle, uint32_t completed, hue_https_stats_t* p_stats);
+
+/**
+ * @brief qsort comparator for int64_t
+ */
+static int compare_int64(const void* a, const void* b);
+
+/**
+ * @brief Returns the nearest-rank percentile of sorted samples in milliseconds
+ */
+static double percentile_ms(const int64_t* sorted, uint32_t count, double percent);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+int main(int argc, char** argv) {
+    uint32_t requests = 200;
+    const char* resource = "light";
+    uint8_t retry_attempts = 0;
+    double min_success = -1;
+    bool verbose = false;
+    bool use_template = false;
+    int core_id = HUE_HTTPS_TASK_ANY_CORE;
+    int scan_core_id = 0;
+    uint32_t reconnect_every = 0;
+    uint32_t offline_requests = 0;
+    uint32_t flush_forced = 0;
+    uint32_t burst = 0;
+    uint32_t burst_interval_ms = 20;
+    bool rate_limit = true;
+    uint32_t rate_interval_ms = 0;
+    uint32_t ttl_ms = 0;
+    uint32_t background_every = 0;
+    bool preempt_background = false;
+    uint32_t room_lights = 0;
+    uint32_t batch_lights = 0;
+    int32_t batch_grouped = -1;
+    mock_bridge_config_t bridge_config = {
+        .bridge_id = BENCH_BRIDGE_ID,
+        .application_key = BENCH_APP_KEY,
+        .seed = 1,
+    };
+
+    static const struct option options[] = {
+        {"requests", required_argument, NULL, 'n'},       {"resource", required_argument, NULL, 'r'},
+        {"retry-attempts", required_argument, NULL, 'a'}, {"latency-ms", required_argument, NULL, 'l'},
+        {"jitter-ms", required_argument, NULL, 'j'},      {"drop", required_argument, NULL, 'd'},
+        {"throttle", required_argument, NULL, 't'},       {"unavailable", required_argument, NULL, 'u'},
+        {"error", required_argument, NULL, 'e'},          {"retry-after", required_argument, NULL, 'A'},
+        {"seed", required_argument, NULL, 's'},           {"min-success", required_argument, NULL, 'm'},
+        {"verbose", no_argument, NULL, 'v'},              {"template", no_argument, NULL, 'T'},
+        {"core", required_argument, NULL, 'c'},           {"scan-load", required_argument, NULL, 'L'},
+        {"scan-core", required_argument, NULL, 'C'},      {"reconnect-every", required_argument, NULL, 'R'},
+        {"offline-requests", required_argument, NULL, 'O'}, {"burst", required_argument, NULL, 'b'},
+        {"burst-interval-ms", required_argument, NULL, 'i'}, {"no-rate-limit", no_argument, NULL, 'N'},
+        {"bridge-budget", no_argument, NULL, 'B'},        {"rate-interval-ms", required_argument, NULL, 'I'},
+        {"ttl-ms", required_argument, NULL, 'D'},         {"background-every-ms", required_argument, NULL, 'G'},
+        {"preempt-background", no_argument, NULL, 'P'},   {"room-lights", required_argument, NULL, 'M'},
+        {"batch-lights", required_argument, NULL, 'K'},   {"flush-forced", required_argument, NULL, 'F'},
+        {"batch-grouped", required_argument, NULL, 'g'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "", options, NULL)) != -1) {
+        switch (opt) {
+            case 'n':
+                requests = strtoul(optarg, NULL, 10);
+                break;
+            case 'r':
+                resource = optarg;
+                break;
+            case 'a':
+                retry_attempts = strtoul(optarg, NULL, 10);
+                break;
+            case 'l':
+                bridge_config.faults.latency_ms = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                bridge_config.faults.jitter_ms = strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                bridge_config.faults.drop_percent = strtoul(optarg, NULL, 10);
+                break;
+            case 't':
+                bridge_config.faults.throttle_percent = strtoul(optarg, NULL, 10);
+                break;
+            case 'u':
+                bridge_config.faults.unavailable_percent = strtoul(optarg, NULL, 10);
+                break;
+            case 'e':
+                bridge_config.faults.error_percent = strtoul(optarg, NULL, 10);
+                break;
+            case 'A':
+                bridge_config.faults.retry_after_s = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                bridge_config.seed = strtoul(optarg, NULL, 10);
+                break;
+            case 'm':
+                min_success = strtod(optarg, NULL);
+                break;
+            case 'v':
+                verbose = true;
+                break;
+            case 'T':
+                use_template = true;
+                break;
+            case 'c':
+                core_id = atoi(optarg);
+                break;
+            case 'L':
+                scan_load_percent = strtoul(optarg, NULL, 10);
+                break;
+            case 'C':
+                scan_core_id = atoi(optarg);
+                break;
+            case 'R':
+                reconnect_every = strtoul(optarg, NULL, 10);
+                break;
+            case 'O':
+                offline_requests = strtoul(optarg, NULL, 10);
+                break;
+            case 'F':
+                flush_forced = strtoul(optarg, NULL, 10);
+                break;
+            case 'b':
+                burst = strtoul(optarg, NULL, 10);
+                break;
+            case 'i':
+                burst_interval_ms = strtoul(optarg, NULL, 10);
+                break;
+            case 'N':
+                rate_limit = false;
+                break;
+            case 'I':
+                rate_interval_ms = strtoul(optarg, NULL, 10);
+                break;
+            case 'D':
+                ttl_ms = strtoul(optarg, NULL, 10);
+                break;
+            case 'G':
+                background_every = strtoul(optarg, NULL, 10);
+                break;
+            case 'P':
+                preempt_background = true;
+                break;
+            case 'M':
+                room_lights = strtoul(optarg, NULL, 10);
+                break;
+            case 'K':
+                batch_lights = strtoul(optarg, NULL, 10);
+                break;
+            case 'g':
+                batch_grouped = strtol(optarg, NULL, 10);
+                break;
+            case 'B':
+                bridge_config.light_budget = BENCH_BRIDGE_LIGHT_BUDGET;
+                bridge_config.group_budget = BENCH_BRIDGE_GROUP_BUDGET;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [options], see hue_https_bench.c for options\n", argv[0]);
+                return 2;
+        }
+    }
+    if (requests == 0) {
+        fprintf(stderr, "--requests must be at least 1\n");
+        return 2;
+    }
+    if ((rate_interval_ms > UINT16_MAX) || (ttl_ms > UINT16_MAX)) {
+        fprintf(stderr, "--rate-interval-ms and --ttl-ms must be at most %u\n", UINT16_MAX);
+        return 2;
+    }
+    if (room_lights > BENCH_ROOM_MAX_LIGHTS) {
+        fprintf(stderr, "--room-lights must be at most %u\n", BENCH_ROOM_MAX_LIGHTS);
+        return 2;
+    }
+    if (batch_lights > HUE_HTTPS_GROUP_MAX_LIGHTS) {
+        fprintf(stderr, "--batch-lights must be at most %u\n", HUE_HTTPS_GROUP_MAX_LIGHTS);
+        return 2;
+    }
+    if (scan_load_percent > 100) {
+        fprintf(stderr, "--scan-load must be at most 100\n");
+        return 2;
+    }
+
+    /* Per-request failures are expected under fault injection and counted below instead */
+    if (!verbose) {
+        esp_log_level_set("hue_https_instance", ESP_LOG_NONE);
+        esp_log_level_set("host_http_client", ESP_LOG_NONE);
+    }
+
+    /* hue_https follows WIFI_CONNECT_EVENT on the default event loop */
+    if (esp_event_loop_create_default() != ESP_OK) {
+        fprintf(stderr, "Failed to create default event loop\n");
+        return 1;
+    }
+
+    mock_bridge_handle_t bridge = NULL;
+    if (mock_bridge_start(&bridge, &bridge_config) != ESP_OK) {
+        fprintf(stderr, "Failed to start mock bridge\n");
+        return 1;
+    }
+    host_http_client_set_port_override(mock_bridge_get_port(bridge));
+    host_http_client_set_ca_override(mock_bridge_get_cert_pem(bridge));
+
+    hue_https_handle_t hue_https_handle = NULL;
+    hue_https_config_t hue_https_config = {
+        .bridge_ip = BENCH_BRIDGE_IP,
+        .bridge_id = BENCH_BRIDGE_ID,
+        .application_key = BENCH_APP_KEY,
+        .task_id = "hue_https_bench",
+        .retry_attempts = retry_attempts,
+        .task_placement_set = true,
+        .task_priority = HUE_HTTPS_DEFAULT_TASK_PRIORITY,
+        .task_core_id = core_id,
+        .rate_limits_set = !rate_limit || rate_interval_ms, /* All zero, no pacing */
+        .preempt_background = preempt_background,
+    };
+    for (uint8_t i = 0; rate_limit && rate_interval_ms && (i < HUE_HTTPS_RESOURCE_COUNT); i++) {
+        hue_https_config.rate_limits[i] = (hue_https_rate_limit_t){.interval_ms = rate_interval_ms, .burst = 1};
+    }
+    hue_https_request_handle_t request_handle = NULL;
+    const hue_https_request_template_t* p_template = use_template ? find_template(resource) : NULL;
+    if ((hue_https_create_instance(&hue_https_handle, &hue_https_config) != ESP_OK) ||
+        (use_template ? !p_template : (create_request(&request_handle, resource) != ESP_OK))) {
+        fprintf(stderr, "Failed to create Hue HTTPS instance or %s request\n", resource);
+        mock_bridge_stop(&bridge);
+        return 1;
+    }
+
+    /* WiFi connects before the first request, like it would on device long before anyone arrives */
+    if (!connect_wifi(hue_https_handle, false)) fprintf(stderr, "Bridge connection was not pre-warmed\n");
+
+    /* Load starts before the first request so every handshake runs against it */
+    if ((scan_load_percent > 0) &&
+        (xTaskCreatePinnedToCore(scan_load_task, "ble_scan_load", 2048, NULL, configMAX_PRIORITIES - 3, NULL,
+                                 scan_core_id) != pdPASS)) {
+        fprintf(stderr, "Failed to create BLE scan load task on core %d\n", scan_core_id);
+        hue_https_destroy_instance(&hue_https_handle);
+        if (request_handle) hue_https_destroy_request(&request_handle);
+        mock_bridge_stop(&bridge);
+        return 1;
+    }
+
+    int64_t* latencies = calloc(requests, sizeof(int64_t));
+    if (!latencies) {
+        fprintf(stderr, "Failed to allocate latency samples\n");
+        hue_https_destroy_instance(&hue_https_handle);
+        if (request_handle) hue_https_destroy_request(&request_handle);
+        mock_bridge_stop(&bridge);
+        return 1;
+    }
+    uint32_t succeeded = 0;
+    uint32_t completed = 0;
+    int64_t first_latency_us = -1;
+    size_t max_footprint = 0;
+
+    /* Closed loop, each request is triggered once the previous one has finished like back to back presence edges */
+    int64_t start_us = esp_timer_get_time();
+    for (uint32_t i = 0; i < requests; i++) {
+        hue_https_stats_t stats;
+        if ((reconnect_every > 0) && (i > 0) && ((i % reconnect_every) == 0) && !connect_wifi(hue_https_handle, true)) {
+            fprintf(stderr, "Bridge connection was not pre-warmed after reconnecting before request %u\n", i);
+        }
+        if (p_template) {
+            hue_https_perform_triggered_template(hue_https_handle, p_template, false, esp_timer_get_time(), ttl_ms);
+        } else {
+            hue_https_perform_triggered_request(hue_https_handle, request_handle, false, esp_timer_get_time(), ttl_ms);
+        }
+
+        /* Sampled while the request is queued or running, unless it already finished */
+        size_t footprint;
+        if ((hue_https_get_queue_footprint(hue_https_handle, &footprint) == ESP_OK) && (footprint > max_footprint)) {
+            max_footprint = footprint;
+        }
+        if (!wait_for_result(hue_https_handle, completed, &stats)) {
+            fprintf(stderr, "Request %u did not complete\n", i);
+            break;
+        }
+        if (stats.requests_ok > succeeded) latencies[succeeded] = stats.last_latency_us;
+        if ((i == 0) && (stats.requests_ok > succeeded)) first_latency_us = stats.last_latency_us;
+        succeeded = stats.requests_ok;
+        completed = stats.requests_ok + stats.requests_failed + stats.requests_expired;
+    }
+    double elapsed_s = (esp_timer_get_time() - start_us) / 1e6;
+
+    /* Every request made while offline is for the same resource, so they must reach the bridge as a single request */
+    hue_https_stats_t offline_stats = {0};
+    bool offline_converged = true;
+    if (offline_requests > 0) {
+        offline_converged = run_offline(hue_https_handle, request_handle, p_template, offline_requests, &offline_stats);
+        if (!offline_converged) fprintf(stderr, "Held requests were not sent after reconnecting\n");
+    }
+
+    /* Forced requests must not wait behind the held ones, nor abort any of them */
+    bench_flush_t flush_result = {0};
+    bool flush_done = true;
+    if (flush_forced > 0) {
+        flush_done = run_flush(hue_https_handle, flush_forced, &flush_result);
+        if (!flush_done) fprintf(stderr, "Held and forced requests were not all answered\n");
+    }
+
+    /* Commands arrive faster than the bridge takes them, pacing should send only what it can, ending on the last */
+    bench_burst_t burst_result = {0};
+    bool burst_done = true;
+    if (burst > 0) {
+        burst_done = run_burst(hue_https_handle, bridge, resource, burst, burst_interval_ms, &burst_result);
+        if (!burst_done) fprintf(stderr, "Burst commands were not all accounted for\n");
+    }
+    /* Interactive requests must not wait behind background work, however much of it is queued */
+    bench_background_t background_result = {0};
+    bool background_done = true;
+    if (background_every > 0) {
+        background_done = run_background(hue_https_handle, background_every, &background_result);
+        if (!background_done) fprintf(stderr, "Background load did not drain or interactive requests were lost\n");
+    }
+    /* A room set light by light costs a request per light, recalling a scene costs one whatever the room's size */
+    bench_room_t room_result = {0};
+    bool room_done = true;
+    if (room_lights > 0) {
+        room_done = run_room(hue_https_handle, bridge, room_lights, &room_result);
+        if (!room_done) fprintf(stderr, "Room requests were not all answered\n");
+    }
+    /* Whole rooms of a batch may cost a grouped light request each, the lights of the partial room go one by one */
+    bench_batch_t batch_result = {0};
+    bool batch_done = true;
+    if (batch_lights > 0) {
+        batch_done = run_batch(hue_https_handle, bridge, batch_lights, &batch_result);
+        if (!batch_done) fprintf(stderr, "Light batch requests were not all answered\n");
+    }
+    atomic_store(&scan_load_stop, true);
+
+    mock_bridge_stats_t bridge_stats;
+    mock_bridge_get_stats(bridge, &bridge_stats);
+
+    qsort(latencies, succeeded, sizeof(int64_t), compare_int64);
+    double success_percent = 100.0 * succeeded / requests;
+
+    printf("hue_https_bench: %u %s %s, bridge latency %u+%u ms, faults drop %u%% 429 %u%% 503 %u%% 500 %u%%\n",
+           requests, resource, p_template ? "templates" : "requests", bridge_config.faults.latency_ms,
+           bridge_config.faults.jitter_ms, bridge_config.faults.drop_percent, bridge_config.faults.throttle_percent,
+           bridge_config.faults.unavailable_percent, bridge_config.faults.error_percent);
+    printf("  succeeded   %u/%u (%.1f%%)\n", succeeded, requests, success_percent);
+    if (succeeded) {
+        printf("  latency     p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms (trigger to 200 OK)\n",
+               percentile_ms(latencies, succeeded, 50), percentile_ms(latencies, succeeded, 90),
+               percentile_ms(latencies, succeeded, 99), latencies[succeeded - 1] / 1e3);
+    }
+    if (first_latency_us >= 0) printf("  first       %.2f ms (trigger to 200 OK)\n", first_latency_us / 1e3);
+    printf("  throughput  %.1f requests/s, %.1f successful/s over %.2f s\n", completed / elapsed_s,
+           succeeded / elapsed_s, elapsed_s);
+    printf("  bridge      %u TLS handshakes, %u requests, %u ok, %u 4xx, %u 429, %u 503, %u 500, %u dropped\n",
+           bridge_stats.connections, bridge_stats.requests, bridge_stats.ok, bridge_stats.client_errors,
+           bridge_stats.throttled, bridge_stats.unavailable, bridge_stats.errors, bridge_stats.dropped);
+    printf("  queue       %zu bytes max footprint\n", max_footprint);
+
+    hue_https_stats_t final_stats;
+    bool final_stats_ok = (hue_https_get_stats(hue_https_handle, &final_stats) == ESP_OK);
+    if (final_stats_ok) {
+        printf("  connection  %u pre-warmed, WiFi reconnected %u times\n", final_stats.connections_prewarmed,
+               reconnect_every ? (requests - 1) / reconnect_every : 0);
+        printf("  send rate   %u throttled responses, ended at %u%% of the configured rates\n",
+               final_stats.responses_throttled, final_stats.send_rate_percent);
+    }
+
+    if (offline_requests > 0) {
+        printf("  offline     %u requests held as %u, %u coalesced, converged %.2f ms after reconnecting\n",
+               offline_requests, offline_stats.requests_held, offline_stats.requests_coalesced,
+               offline_stats.last_converge_us / 1e3);
+    }
+
+    bool flush_interleaved = true;
+    if (flush_forced > 0) {
+        flush_interleaved = (flush_result.held_ok == BENCH_FLUSH_HELD) && (flush_result.failed == 0) &&
+                            (flush_result.forced_started > 0) &&
+                            (flush_result.max_forced_delay_us <= BENCH_FLUSH_QUEUE_BOUND_US);
+        printf("  flush       %u held requests, %u ok, %u failed, converged %.2f ms after reconnecting\n",
+               BENCH_FLUSH_HELD, flush_result.held_ok, flush_result.failed, flush_result.converge_us / 1e3);
+        printf("              %u forced %u ms apart, %u sent, queued max %.2f ms\n", flush_forced,
+               BENCH_FLUSH_FORCED_SPACING_MS, flush_result.forced_started, flush_result.max_forced_delay_us / 1e3);
+    }
+
+    double burst_success = 100.0;
+    if (burst > 0) {
+        uint32_t sent = burst_result.ok + burst_result.failed;
+        if (sent) burst_success = 100.0 * burst_result.ok / sent;
+        printf("  burst       %u commands %u ms apart, %s: %u sent, %u ok (%.1f%%), %u coalesced, done in %.2f ms, "
+               "final state %s\n",
+               burst, burst_interval_ms, rate_limit ? "paced" : "unpaced", sent, burst_result.ok, burst_success,
+               burst_result.coalesced, burst_result.elapsed_us / 1e3, burst_result.final_state ? "sent" : "lost");
+    }
+
+    bool interactive_flat = true;
+    if (background_every > 0) {
+        const hue_https_class_stats_t* p_interactive = &background_result.classes[HUE_HTTPS_PRIORITY_INTERACTIVE];
+        const hue_https_class_stats_t* p_background = &background_result.classes[HUE_HTTPS_PRIORITY_BACKGROUND];
+        interactive_flat = (p_interactive->max_queue_delay_us <= BENCH_INTERACTIVE_QUEUE_BOUND_US);
+        printf("  priority    background every %u ms%s, %u preempted\n", background_every,
+               preempt_background ? " preempted by interactive" : "", background_result.preempted);
+        for (uint8_t i = 0; i < HUE_HTTPS_PRIORITY_COUNT; i++) {
+            const hue_https_class_stats_t* p_class = (i == HUE_HTTPS_PRIORITY_INTERACTIVE) ? p_interactive
+                                                                                           : p_background;
+            printf("  %-11s %u started, queued avg %.2f ms, max %.2f ms\n",
+                   (i == HUE_HTTPS_PRIORITY_INTERACTIVE) ? "interactive" : "background", p_class->requests_started,
+                   p_class->requests_started ? p_class->total_queue_delay_us / 1e3 / p_class->requests_started : 0.0,
+                   p_class->max_queue_delay_us / 1e3);
+        }
+    }
+
+    bool room_reduced = true;
+    if (room_lights > 0) {
+        const bench_room_pass_t* p_lights = &room_result.lights;
+        const bench_room_pass_t* p_scene = &room_result.scene;
+        room_reduced = (p_lights->ok == room_lights) && (p_scene->ok == 1) && (p_scene->bridge == 1);
+        printf("  room        %u lights: %u light requests, %u ok, %u at the bridge in %.2f ms\n", room_lights,
+               p_lights->performed, p_lights->ok, p_lights->bridge, p_lights->elapsed_us / 1e3);
+        printf("              scene recall: %u request, %u ok, %u at the bridge in %.2f ms (%u to %u requests)\n",
+               p_scene->performed, p_scene->ok, p_scene->bridge, p_scene->elapsed_us / 1e3, p_lights->bridge,
+               p_scene->bridge);
+    }
+
+    bool batch_reduced = true;
+    if (batch_lights > 0) {
+        const hue_https_batch_result_t* p_result = &batch_result.result;
+        uint32_t sent = p_result->grouped_requests + p_result->light_requests;
+        uint32_t rooms = batch_lights / BENCH_BATCH_ROOM_LIGHTS;
+        bool grouped_expected = (batch_grouped < 0) ? (p_result->grouped_requests <= rooms)
+                                                    : (p_result->grouped_requests == (uint32_t)batch_grouped);
+        batch_reduced = grouped_expected && (batch_result.ok == sent) && (batch_result.bridge == sent) &&
+                        (batch_result.consolidated == p_result->requests_saved);
+        printf("  batch       %u lights over rooms of %u: %u grouped light and %u light requests, %u ok, %u at the "
+               "bridge in %.2f ms (%u to %u requests)\n",
+               batch_lights, BENCH_BATCH_ROOM_LIGHTS, p_result->grouped_requests, p_result->light_requests,
+               batch_result.ok, batch_result.bridge, batch_result.elapsed_us / 1e3, p_result->lights, sent);
+    }
+
+    /* The last attempt may start just inside the deadline, so its own round trip is allowed on top */
+    bool deadline_met = true;
+    if (ttl_ms > 0) {
+        deadline_met = !succeeded || (latencies[succeeded - 1] <= (int64_t)ttl_ms * 1000 + BENCH_DEADLINE_SLACK_US);
+        printf("  deadline    %u ms, %u expired, latest 200 OK %s\n", ttl_ms,
+               (final_stats_ok ? final_stats.requests_expired : 0), deadline_met ? "within it" : "past it");
+    }
+
+    host_tls_stats_t tls_stats;
+    host_http_client_get_tls_stats(&tls_stats);
+    if (tls_stats.handshakes) {
+        printf("  tls         %u handshakes, avg %.2f ms, max %.2f ms (client side)\n", tls_stats.handshakes,
+               tls_stats.total_us / 1e3 / tls_stats.handshakes, tls_stats.max_us / 1e3);
+    }
+    char core_str[8];
+    snprintf(core_str, sizeof(core_str), "%d", core_id);
+    printf("  placement   hue_https core %s, BLE scan load %u%% on core %d (%u periods)\n",
+           (core_id == HUE_HTTPS_TASK_ANY_CORE) ? "any" : core_str, scan_load_percent, scan_core_id,
+           atomic_load(&scan_load_periods));
+
+    free(latencies);
+    hue_https_destroy_instance(&hue_https_handle);
+    if (request_handle) hue_https_destroy_request(&request_handle);
+    mock_bridge_stop(&bridge);
+
+    if ((completed < requests) || (success_percent < min_success) || !offline_converged || !deadline_met) return 1;
+    if ((background_every > 0) && (!background_done || !interactive_flat)) return 1;
+    if ((room_lights > 0) && (!room_done || !room_reduced)) return 1;
+    if ((batch_lights > 0) && (!batch_done || !batch_reduced)) return 1;
+    if ((flush_forced > 0) && (!flush_done || !flush_interleaved)) return 1;
+    if ((burst > 0) && (!burst_done || !burst_result.final_state || (burst_success < min_success))) return 1;
+    return 0;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static esp_err_t create_request(hue_https_request_handle_t* p_request_handle, const char* resource) {
+    if (strcmp(resource, "light") == 0) {
+        hue_light_data_t light = {.resource_id = BENCH_RESOURCE_ID, .brightness_action = HUE_ACTION_SET,
+                                  .brightness = 80};
+        return hue_https_create_light_request(p_request_handle, &light);
+    }
+    if (strcmp(resource, "grouped_light") == 0) {
+        hue_grouped_light_data_t grouped_light = {.resource_id = BENCH_RESOURCE_ID};
+        return hue_https_create_grouped_light_request(p_request_handle, &grouped_light);
+    }
+    if (strcmp(resource, "smart_scene") == 0) {
+        hue_smart_scene_data_t smart_scene = {.resource_id = BENCH_RESOURCE_ID};
+        return hue_https_create_smart_scene_request(p_request_handle, &smart_scene);
+    }
+    if (strcmp(resource, "scene") == 0) {
+        hue_scene_data_t scene = {.resource_id = BENCH_RESOURCE_ID, .set_brightness = true, .brightness = 80};
+        return hue_https_create_scene_request(p_request_handle, &scene);
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+static const hue_https_request_template_t* find_template(const char* resource) {
+    static const hue_https_request_template_t light = {.resource_id = BENCH_RESOURCE_UUID,
+                                                       .resource_type = HUE_HTTPS_RESOURCE_LIGHT,
+                                                       .brightness_action = HUE_ACTION_SET,
+                                                       .brightness = 80};
+    static const hue_https_request_template_t grouped_light = {.resource_id = BENCH_RESOURCE_UUID,
+                                                               .resource_type = HUE_HTTPS_RESOURCE_GROUPED_LIGHT};
+    static const hue_https_request_template_t smart_scene = {.resource_id = BENCH_RESOURCE_UUID,
+                                                             .resource_type = HUE_HTTPS_RESOURCE_SMART_SCENE};
+    static const hue_https_request_template_t scene = {.resource_id = BENCH_RESOURCE_UUID,
+                                                       .resource_type = HUE_HTTPS_RESOURCE_SCENE,
+                                                       .brightness_action = HUE_ACTION_SET,
+                                                       .brightness = 80};
+
+    if (strcmp(resource, "light") == 0) return &light;
+    if (strcmp(resource, "grouped_light") == 0) return &grouped_light;
+    if (strcmp(resource, "smart_scene") == 0) return &smart_scene;
+    if (strcmp(resource, "scene") == 0) return &scene;
+    return NULL;
+}
+
+static void scan_load_task(void* pvParameters) {
+    while (!atomic_load(&scan_load_stop)) {
+        int64_t period_start_us = esp_timer_get_time();
+        int64_t busy_until_us = period_start_us + (BENCH_SCAN_PERIOD_US * scan_load_percent) / 100;
+        while (esp_timer_get_time() < busy_until_us) {
+        }
+        atomic_fetch_add(&scan_load_periods, 1);
+
+        int64_t idle_us = BENCH_SCAN_PERIOD_US - (esp_timer_get_time() - period_start_us);
+        vTaskDelay((idle_us > 1000) ? pdMS_TO_TICKS(idle_us / 1000) : 1);
+    }
+    vTaskDelete(NULL);
+}
+
+static bool connect_wifi(hue_https_handle_t hue_https_handle, bool reconnect) {
+    hue_https_stats_t stats;
+    if (hue_https_get_stats(hue_https_handle, &stats) != ESP_OK) return false;
+    uint32_t prewarmed = stats.connections_prewarmed;
+
+    if (reconnect) {
+        wifi_err_reason_t reason = WIFI_REASON_ASSOC_LEAVE;
+        esp_event_post(WIFI_CONNECT_EVENT, WIFI_CONNECT_EVENT_DISCONNECTED, &reason, sizeof(reason), portMAX_DELAY);
+    }
+    wifi_connect_connected_data_t connected_data = {0};
+    esp_event_post(WIFI_CONNECT_EVENT, WIFI_CONNECT_EVENT_CONNECTED, &connected_data, sizeof(connected_data),
+                   portMAX_DELAY);
+
+    int64_t deadline_us = esp_timer_get_time() + BENCH_PREWARM_TIMEOUT_US;
+    while (esp_timer_get_time() < deadline_us) {
+        if ((hue_https_get_stats(hue_https_handle, &stats) == ESP_OK) && (stats.connections_prewarmed > prewarmed)) {
+            return true;
+        }
+        vTaskDelay(1);
+    }
+    return false;
+}
+
+static bool run_offline(hue_https_handle_t hue_https_handle, hue_https_request_handle_t request_handle,
+                        const hue_https_request_template_t* p_template, uint32_t count, hue_https_stats_t* p_stats) {
+    if (hue_https_get_stats(hue_https_handle, p_stats) != ESP_OK) return false;
+    uint32_t completed = p_stats->requests_ok + p_stats->requests_failed + p_stats->requests_expired;
+
+    /* Requests are only held once the handler has seen the disconnection */
+    wifi_err_reason_t reason = WIFI_REASON_ASSOC_LEAVE;
+    esp_event_post(WIFI_CONNECT_EVENT, WIFI_CONNECT_EVENT_DISCONNECTED, &reason, sizeof(reason), portMAX_DELAY);
+    host_event_loop_wait_idle(portMAX_DELAY);
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (request_handle) {
+            hue_https_perform_triggered_request(hue_https_handle, request_handle, false, esp_timer_get_time(), 0);
+        } else {
+            hue_https_perform_triggered_template(hue_https_handle, p_template, false, esp_timer_get_time(), 0);
+        }
+    }
+
+    connect_wifi(hue_https_handle, false);
+    return wait_for_result(hue_https_handle, completed, p_stats);
+}
+
+static bool run_flush(hue_https_handle_t hue_https_handle, uint32_t count, bench_flush_t* p_flush) {
+    hue_https_request_template_t held = *find_template("light");
+    const hue_https_request_template_t* p_forced = find_template("light");
+    hue_https_stats_t before;
+    hue_https_stats_t after;
+    if (hue_https_get_stats(hue_https_handle, &before) != ESP_OK) return false;
+    after = before;
+
+    wifi_err_reason_t reason = WIFI_REASON_ASSOC_LEAVE;
+    esp_event_post(WIFI_CONNECT_EVENT, WIFI_CONNECT_EVENT_DISCONNECTED, &reason, sizeof(reason), portMAX_DELAY);
+    host_event_loop_wait_idle(portMAX_DELAY);
+
+    /* Each held light differs from the forced one in the last UUID byte, so none of them is replaced */
+    for (uint32_t i = 0; i < BENCH_FLUSH_HELD; i++) {
+        held.resource_id[HUE_RESOURCE_ID_PACKED_SIZE - 1] = 0xb0 + i;
+        hue_https_perform_triggered_template(hue_https_handle, &held, false, esp_timer_get_time(), 0);
+    }
+
+    /* Held requests are sent once the connection is pre-warmed, so the forced ones arrive while they are */
+    if (!connect_wifi(hue_https_handle, false)) return false;
+    for (uint32_t i = 0; i < count; i++) {
+        hue_https_perform_triggered_template(hue_https_handle, p_forced, true, esp_timer_get_time(), 0);
+        vTaskDelay(pdMS_TO_TICKS(BENCH_FLUSH_FORCED_SPACING_MS));
+    }
+
+    /* Done once nothing is waiting and every held and sent forced request has a result */
+    int64_t deadline_us = esp_timer_get_time() + BENCH_REQUEST_TIMEOUT_US;
+    bool done = false;
+    while (!done && (esp_timer_get_time() < deadline_us)) {
+        size_t footprint;
+        if ((hue_https_get_stats(hue_https_handle, &after) != ESP_OK) ||
+            (hue_https_get_queue_footprint(hue_https_handle, &footprint) != ESP_OK)) {
+            continue;
+        }
+        uint32_t results = (after.requests_ok + after.requests_failed + after.requests_expired) -
+                           (before.requests_ok + before.requests_failed + before.requests_expired);
+        uint32_t started = after.classes[HUE_HTTPS_PRIORITY_INTERACTIVE].requests_started -
+                           before.classes[HUE_HTTPS_PRIORITY_INTERACTIVE].requests_started;
+        done = (footprint == 0) && (results >= BENCH_FLUSH_HELD + started);
+        if (!done) vTaskDelay(1);
+    }
+
+    /* Forced requests are the only ones started, held requests skip the queueing statistics */
+    p_flush->forced_started = after.classes[HUE_HTTPS_PRIORITY_INTERACTIVE].requests_started -
+                              before.classes[HUE_HTTPS_PRIORITY_INTERACTIVE].requests_started;
+    p_flush->held_ok = after.requests_ok - before.requests_ok - p_flush->forced_started;
+    p_flush->failed = (after.requests_failed + after.requests_expired) -
+                      (before.requests_failed + before.requests_expired);
+    p_flush->max_forced_delay_us = after.classes[HUE_HTTPS_PRIORITY_INTERACTIVE].max_queue_delay_us;
+    p_flush->converge_us = after.last_converge_us;
+    return done;
+}
+
+static bool run_burst(hue_https_handle_t hue_https_handle, mock_bridge_handle_t bridge, const char* resource,
+                      uint32_t count, uint32_t interval_ms, bench_burst_t* p_burst) {
+    const hue_https_request_template_t* p_base = find_template(resource);
+    hue_https_stats_t before;
+    hue_https_stats_t stats;
+    if (!p_base || (hue_https_get_stats(hue_https_handle, &before) != ESP_OK)) return false;
+
+    /* Every command sets a different brightness, smart scenes have none so only their delivery is checked */
+    bool smart_scene = (p_base->resource_type == HUE_HTTPS_RESOURCE_SMART_SCENE);
+    hue_https_request_template_t command = *p_base;
+    if (!smart_scene) command.brightness_action = HUE_ACTION_SET;
+
+    int64_t start_us = esp_timer_get_time();
+    for (uint32_t i = 0; i < count; i++) {
+        command.brightness = (i % 100) + 1;
+        hue_https_perform_triggered_template(hue_https_handle, &command, true, esp_timer_get_time(), 0);
+        if (interval_ms) vTaskDelay(pdMS_TO_TICKS(interval_ms));
+    }
+
+    /* Every command ends up answered, failed, or replaced by a later one */
+    int64_t deadline_us = esp_timer_get_time() + BENCH_REQUEST_TIMEOUT_US;
+    bool done = false;
+    while (!done && (esp_timer_get_time() < deadline_us)) {
+        if (hue_https_get_stats(hue_https_handle, &stats) != ESP_OK) continue;
+        p_burst->ok = stats.requests_ok - before.requests_ok;
+        p_burst->failed = stats.requests_failed - before.requests_failed;
+        p_burst->coalesced = stats.requests_coalesced - before.requests_coalesced;
+        done = (p_burst->ok + p_burst->failed + p_burst->coalesced) >= count;
+        if (!done) vTaskDelay(1);
+    }
+    p_burst->elapsed_us = esp_timer_get_time() - start_us;
+
+    char last_body[256];
+    char expected[32];
+    mock_bridge_get_last_body(bridge, last_body, sizeof(last_body));
+    snprintf(expected, sizeof(expected), "\"brightness\":%u}", command.brightness);
+    p_burst->final_state = smart_scene ? (last_body[0] != '\0') : (strstr(last_body, expected) != NULL);
+
+    return done;
+}
+
+static bool run_room(hue_https_handle_t hue_https_handle, mock_bridge_handle_t bridge, uint32_t lights,
+                     bench_room_t* p_room) {
+    /* Both set the same look, the scene overrides its stored brightness with the one each light is set to */
+    hue_https_request_template_t light = *find_template("light");
+    light.brightness = BENCH_ROOM_BRIGHTNESS;
+    light.set_duration = true;
+    light.duration = 4;
+    hue_https_request_template_t scene = *find_template("scene");
+    scene.brightness = BENCH_ROOM_BRIGHTNESS;
+    scene.set_duration = true;
+    scene.duration = 4;
+
+    return run_room_pass(hue_https_handle, bridge, &light, lights, &p_room->lights) &&
+           run_room_pass(hue_https_handle, bridge, &scene, 1, &p_room->scene);
+}
+
+static bool run_room_pass(hue_https_handle_t hue_https_handle, mock_bridge_handle_t bridge,
+                          const hue_https_request_template_t* p_base, uint32_t count, bench_room_pass_t* p_pass) {
+    hue_https_stats_t before;
+    hue_https_stats_t stats;
+    mock_bridge_stats_t bridge_before;
+    mock_bridge_stats_t bridge_after;
+    if (hue_https_get_stats(hue_https_handle, &before) != ESP_OK) return false;
+    mock_bridge_get_stats(bridge, &bridge_before);
+    uint32_t completed = before.requests_ok + before.requests_failed + before.requests_expired;
+
+    /* Each resource differs in the last UUID byte, and is only performed once the previous one has been answered as
+     * an interactive request would otherwise replace the one waiting behind the running request */
+    hue_https_request_template_t request = *p_base;
+    bool done = true;
+    int64_t start_us = esp_timer_get_time();
+    for (uint32_t i = 0; done && (i < count); i++) {
+        request.resource_id[HUE_RESOURCE_ID_PACKED_SIZE - 1] = 0xc0 + i;
+        hue_https_perform_triggered_template(hue_https_handle, &request, false, esp_timer_get_time(), 0);
+        p_pass->performed++;
+        done = wait_for_result(hue_https_handle, completed, &stats);
+        completed = stats.requests_ok + stats.requests_failed + stats.requests_expired;
+    }
+    p_pass->elapsed_us = esp_timer_get_time() - start_us;
+    p_pass->ok = stats.requests_ok - before.requests_ok;
+
+    mock_bridge_get_stats(bridge, &bridge_after);
+    p_pass->bridge = bridge_after.requests - bridge_before.requests;
+    return done;
+}
+
+static bool run_batch(hue_https_handle_t hue_https_handle, mock_bridge_handle_t bridge, uint32_t lights,
+                      bench_batch_t* p_batch) {
+    char light_ids[HUE_HTTPS_GROUP_MAX_LIGHTS + BENCH_BATCH_ROOM_LIGHTS][sizeof(BENCH_RESOURCE_ID)];
+    char grouped_light_ids[HUE_HTTPS_GROUPS_SIZE][sizeof(BENCH_RESOURCE_ID)];
+    const char* light_id_ptrs[HUE_HTTPS_GROUP_MAX_LIGHTS + BENCH_BATCH_ROOM_LIGHTS];
+    hue_https_group_t rooms[HUE_HTTPS_GROUPS_SIZE];
+
+    static char filler_ids[HUE_HTTPS_GROUPS_SIZE][HUE_HTTPS_GROUP_MAX_LIGHTS][sizeof(BENCH_RESOURCE_ID)];
+    static const char* filler_id_ptrs[HUE_HTTPS_GROUPS_SIZE][HUE_HTTPS_GROUP_MAX_LIGHTS];
+
+    /* Rooms are filled in order and the last one always holds BENCH_BATCH_ROOM_LIGHTS lights, those past the batch are
+     * members the batch does not set, so that room must not be used */
+    uint32_t room_count = (lights + BENCH_BATCH_ROOM_LIGHTS - 1) / BENCH_BATCH_ROOM_LIGHTS;
+    for (uint32_t i = 0; i < room_count * BENCH_BATCH_ROOM_LIGHTS; i++) {
+        snprintf(light_ids[i], sizeof(light_ids[i]), BENCH_BATCH_RESOURCE_ID_FORMAT, (uint8_t)(0xd0 + i));
+        light_id_ptrs[i] = light_ids[i];
+    }
+    for (uint32_t g = 0; g < room_count; g++) {
+        snprintf(grouped_light_ids[g], sizeof(grouped_light_ids[g]), BENCH_BATCH_RESOURCE_ID_FORMAT,
+                 (uint8_t)(0xf0 + g));
+        rooms[g] = (hue_https_group_t){.grouped_light_id = grouped_light_ids[g],
+                                       .light_ids = &light_id_ptrs[g * BENCH_BATCH_ROOM_LIGHTS],
+                                       .light_count = BENCH_BATCH_ROOM_LIGHTS};
+    }
+
+    /* Full rooms sharing no light with the batch leave its plan as it is, each room's IDs follow its grouped light */
+    for (uint32_t g = room_count; g < HUE_HTTPS_GROUPS_SIZE; g++) {
+        for (uint32_t i = 0; i < HUE_HTTPS_GROUP_MAX_LIGHTS; i++) {
+            snprintf(filler_ids[g][i], sizeof(filler_ids[g][i]), BENCH_FILLER_RESOURCE_ID_FORMAT,
+                     (unsigned)(g * (HUE_HTTPS_GROUP_MAX_LIGHTS + 1) + i + 1));
+            filler_id_ptrs[g][i] = filler_ids[g][i];
+        }
+        snprintf(grouped_light_ids[g], sizeof(grouped_light_ids[g]), BENCH_FILLER_RESOURCE_ID_FORMAT,
+                 (unsigned)(g * (HUE_HTTPS_GROUP_MAX_LIGHTS + 1)));
+        rooms[g] = (hue_https_group_t){.grouped_light_id = grouped_light_ids[g],
+                                       .light_ids = filler_id_ptrs[g],
+                                       .light_count = HUE_HTTPS_GROUP_MAX_LIGHTS};
+    }
+    if (hue_https_set_groups(hue_https_handle, rooms, HUE_HTTPS_GROUPS_SIZE) != ESP_OK) return false;
+
+    hue_https_stats_t before;
+    mock_bridge_stats_t bridge_before;
+    mock_bridge_stats_t bridge_after;
+    if (hue_https_get_stats(hue_https_handle, &before) != ESP_OK) return false;
+    mock_bridge_get_stats(bridge, &bridge_before);
+    hue_https_stats_t stats = before;
+    uint32_t completed = before.requests_ok + before.requests_failed + before.requests_expired;
+
+    hue_light_data_t look = {.brightness_action = HUE_ACTION_SET, .brightness = BENCH_ROOM_BRIGHTNESS,
+                             .set_duration = true, .duration = 4};
+    int64_t start_us = esp_timer_get_time();
+    if (hue_https_perform_light_batch(hue_https_handle, light_id_ptrs, lights, &look, true, &p_batch->result) !=
+        ESP_OK) {
+        return false;
+    }
+
+    /* Every request of the batch is queued at once, so the results are counted rather than waited for one by one */
+    uint32_t sent = p_batch->result.grouped_requests + p_batch->result.light_requests;
+    int64_t deadline_us = esp_timer_get_time() + BENCH_REQUEST_TIMEOUT_US;
+    bool done = false;
+    while (!done && (esp_timer_get_time() < deadline_us)) {
+        if (hue_https_get_stats(hue_https_handle, &stats) != ESP_OK) continue;
+        done = (stats.requests_ok + stats.requests_failed + stats.requests_expired - completed) >= sent;
+        if (!done) vTaskDelay(1);
+    }
+    p_batch->elapsed_us = esp_timer_get_time() - start_us;
+    p_batch->ok = stats.requests_ok - before.requests_ok;
+    p_batch->consolidated = stats.requests_consolidated - before.requests_consolidated;
+
+    mock_bridge_get_stats(bridge, &bridge_after);
+    p_batch->bridge = bridge_after.requests - bridge_before.requests;
+    return done;
+}
+
+static bool run_background(hue_https_handle_t hue_https_handle, uint32_t every_ms, bench_background_t* p_background) {
+    const hue_https_request_template_t* p_interactive = find_template("light");
+    hue_https_stats_t before;
+    hue_https_stats_t after;
+    if (hue_https_get_stats(hue_https_handle, &before) != ESP_OK) return false;
+
+    background_handle = hue_https_handle;
+    background_every_ms = every_ms;
+    atomic_store(&background_stop, false);
+    atomic_store(&background_stopped, false);
+    if (xTaskCreate(background_load_task, "background_load", 4096, NULL, configMAX_PRIORITIES - 4, NULL) != pdPASS) {
+        return false;
+    }
+
+    /* Background work builds up a queue first, then every interactive request arrives behind it */
+    vTaskDelay(pdMS_TO_TICKS(BENCH_BACKGROUND_SPACING_MS));
+    for (uint32_t i = 0; i < BENCH_BACKGROUND_INTERACTIVE; i++) {
+        hue_https_perform_triggered_template(hue_https_handle, p_interactive, false, esp_timer_get_time(), 0);
+        vTaskDelay(pdMS_TO_TICKS(BENCH_BACKGROUND_SPACING_MS));
+    }
+    atomic_store(&background_stop, true);
+
+    /* Drained once nothing is queued, running or waiting */
+    int64_t deadline_us = esp_timer_get_time() + BENCH_REQUEST_TIMEOUT_US;
+    size_t footprint = 1;
+    while ((!atomic_load(&background_stopped) || (footprint > 0)) && (esp_timer_get_time() < deadline_us)) {
+        if (hue_https_get_queue_footprint(hue_https_handle, &footprint) != ESP_OK) footprint = 1;
+        vTaskDelay(1);
+    }
+    if (hue_https_get_stats(hue_https_handle, &after) != ESP_OK) return false;
+
+    for (uint8_t i = 0; i < HUE_HTTPS_PRIORITY_COUNT; i++) {
+        p_background->classes[i].requests_started =
+            after.classes[i].requests_started - before.classes[i].requests_started;
+        p_background->classes[i].total_queue_delay_us =
+            after.classes[i].total_queue_delay_us - before.classes[i].total_queue_delay_us;
+        p_background->classes[i].max_queue_delay_us = after.classes[i].max_queue_delay_us;
+    }
+    p_background->preempted = after.requests_preempted - before.requests_preempted;
+
+    return (footprint == 0) &&
+           (p_background->classes[HUE_HTTPS_PRIORITY_INTERACTIVE].requests_started == BENCH_BACKGROUND_INTERACTIVE);
+}
+
+static void background_load_task(void* pvParameters) {
+    hue_https_request_template_t request = *find_template("light");
+    request.priority = HUE_HTTPS_PRIORITY_BACKGROUND;
+
+    /* Each resource differs from the interactive one in the last UUID byte, so their queue entries never merge */
+    for (uint32_t i = 0; !atomic_load(&background_stop); i++) {
+        request.resource_id[HUE_RESOURCE_ID_PACKED_SIZE - 1] = 0xb0 + (i % BENCH_BACKGROUND_RESOURCES);
+        request.brightness = (i % 100) + 1;
+        hue_https_perform_triggered_template(background_handle, &request, false, esp_timer_get_time(), 0);
+        vTaskDelay(pdMS_TO_TICKS(background_every_ms));
+    }
+    atomic_store(&background_stopped, true);
+    vTaskDelete(NULL);
+}
+
+static bool wait_for_result(hue_https_handle_t hue_https_handle, uint32_t completed, hue_https_stats_t* p_stats) {
+    int64_t deadline_us = esp_timer_get_time() + BENCH_REQUEST_TIMEOUT_US;
+    while (esp_timer_get_time() < deadline_us) {
+        if ((hue_https_get_stats(hue_https_handle, p_stats) == ESP_OK) &&
+            ((p_stats->requests_ok + p_stats->requests_failed + p_stats->requests_expired) > completed)) {
+            return true;
+        }
+        vTaskDelay(1);
+    }
+    return false;
+}
+
+static int compare_int64(const void* a, const void* b) {
+    int64_t lhs = *(const int64_t*)a;
+    int64_t rhs = *(const int64_t*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static double percentile_ms(const int64_t* sorted, uint32_t count, double percent) {
+    uint32_t rank = (uint32_t)((percent / 100.0) * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1] / 1e3;
+}
@@ -0,0 +1,774 @@
+/**
+ * @file mock_bridge.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Implementation of the local HTTPS stand-in for a Philips Hue bridge
+ *
+ * One thread per connection serves keep-alive requests in order, matching how a bridge handles a single
+ * client. Fault injection is rolled per request from a seeded generator shared by all connections.
+ */
+
+#define _GNU_SOURCE /* memmem() */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "mock_bridge.h"
+
+static const char* tag = "mock_bridge";
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define MOCK_BRIDGE_BUFFER_SIZE 8192   /**< Receive buffer per connection, bounds request headers plus body */
+#define MOCK_BRIDGE_PATH_SIZE 256      /**< Maximum request path length */
+#define MOCK_BRIDGE_KEY_SIZE 64        /**< Maximum hue-application-key header length */
+#define MOCK_BRIDGE_ID_LENGTH 36       /**< Resource ID length, "[8]-[4]-[4]-[4]-[12]" hexadecimal characters */
+#define MOCK_BRIDGE_LAST_BODY_SIZE 256 /**< Size of the copy of the last accepted command body */
+
+#define MOCK_BRIDGE_RESOURCE_PATH "/clip/v2/resource/" /**< Path prefix of all served resources */
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Injected outcome of a single request */
+typedef enum {
+    MOCK_FAULT_NONE = 0,    /**< Request served normally */
+    MOCK_FAULT_DROP,        /**< Connection closed without response */
+    MOCK_FAULT_THROTTLE,    /**< 429 Too Many Requests */
+    MOCK_FAULT_UNAVAILABLE, /**< 503 Service Unavailable */
+    MOCK_FAULT_ERROR        /**< 500 Internal Server Error */
+} mock_fault_t;
+
+/** @brief Parsed request */
+typedef struct {
+    char method[8];                     /**< Request method */
+    char path[MOCK_BRIDGE_PATH_SIZE];   /**< Request path */
+    char app_key[MOCK_BRIDGE_KEY_SIZE]; /**< hue-application-key header value, empty if not sent */
+    bool close;                         /**< Client sent "Connection: close" */
+    const char* body;                   /**< Request body within the connection buffer, not null-terminated */
+    size_t body_length;                 /**< Request body length */
+} mock_request_t;
+
+/** @brief Open client connection */
+typedef struct mock_conn {
+    mock_bridge_handle_t bridge;          /**< Bridge the connection belongs to */
+    int fd;                               /**< Connected socket */
+    SSL* ssl;                             /**< TLS session on fd */
+    char buffer[MOCK_BRIDGE_BUFFER_SIZE]; /**< Receive buffer */
+    size_t length;                        /**< Number of valid bytes in buffer */
+    pthread_t thread;                     /**< Thread serving the connection */
+    struct mock_conn* next;               /**< Next connection in the bridge's conns or finished list */
+} mock_conn_t;
+
+/** @brief Command budget of one class of resources, a token bucket holding up to a second's worth of commands */
+typedef struct {
+    uint16_t per_s;    /**< Commands refilled per second and bucket size, 0 for no limit */
+    double tokens;     /**< Commands currently available */
+    int64_t refill_us; /**< Time tokens was last refilled */
+} mock_budget_t;
+
+/** @brief Running mock bridge */
+struct mock_bridge {
+    char* bridge_id;       /**< Copy of the configured bridge ID */
+    char* application_key; /**< Copy of the configured application key, NULL to accept any */
+    SSL_CTX* ssl_ctx;      /**< Server TLS context with the generated certificate */
+    char* cert_pem;        /**< PEM encoded generated certificate */
+    int listen_fd;         /**< Listening socket */
+    uint16_t port;         /**< Port listened on */
+    pthread_t accept_thread;
+
+    pthread_mutex_t mutex;       /**< Protects all fields below */
+    pthread_cond_t conns_closed; /**< Signalled whenever a connection is moved from conns to finished */
+    bool stopping;               /**< mock_bridge_stop() has been called */
+    mock_bridge_faults_t faults; /**< Faults to inject */
+    mock_bridge_stats_t stats;   /**< Counters */
+    unsigned int rand_state;     /**< Fault injection generator state */
+    mock_budget_t light_budget;  /**< Light command budget */
+    mock_budget_t group_budget;  /**< Command budget of every other resource type */
+
+    /** Body of the last command answered with 200 OK */
+    char last_body[MOCK_BRIDGE_LAST_BODY_SIZE];
+    mock_conn_t* conns;          /**< Open connections */
+    mock_conn_t* finished;       /**< Connections whose threads are exiting, waiting for reap_connections() */
+};
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Generates a P-256 key and a self-signed certificate with the bridge ID as CN into a server TLS context
+ *
+ * @param[in,out] p_bridge Bridge to fill ssl_ctx and cert_pem of
+ *
+ * @return ESP_OK, or ESP_FAIL if any OpenSSL call fails
+ */
+static esp_err_t create_tls_context(mock_bridge_handle_t p_bridge);
+
+/**
+ * @brief Opens the listening socket on 127.0.0.1
+ *
+ * @param[in,out] p_bridge Bridge to fill listen_fd and port of
+ * @param[in] port Port to bind, 0 for ephemeral
+ *
+ * @return ESP_OK, or ESP_FAIL if the socket cannot be bound
+ */
+static esp_err_t open_listener(mock_bridge_handle_t p_bridge, uint16_t port);
+
+/**
+ * @brief Thread accepting connections until the bridge is stopped
+ */
+static void* accept_thread(void* arg);
+
+/**
+ * @brief Thread serving requests on a single connection until it closes
+ */
+static void* conn_thread(void* arg);
+
+/**
+ * @brief Takes one command from a budget, must be called while holding the bridge mutex
+ *
+ * @return true if the command is within budget, false if it should be answered with 429
+ */
+static bool take_budget(mock_budget_t* p_budget);
+
+/**
+ * @brief Reads the next complete request from a connection
+ *
+ * @param[in,out] p_conn Connection to read from
+ * @param[out] p_request Parsed request, body points into the connection buffer
+ * @param[out] p_consumed Number of buffer bytes the request occupies, to be discarded once handled
+ *
+ * @return 0 on success, an HTTP status to reply with if the request is malformed, or -1 if the connection closed
+ */
+static int read_request(mock_conn_t* p_conn, mock_request_t* p_request, size_t* p_consumed);
+
+/**
+ * @brief Applies latency and faults and replies to a request
+ *
+ * @return true if the connection should stay open
+ */
+static bool handle_request(mock_conn_t* p_conn, const mock_request_t* p_request);
+
+/**
+ * @brief Rolls the fault for a request and the latency to apply before replying
+ */
+static mock_fault_t roll_fault(mock_bridge_handle_t p_bridge, uint32_t* p_delay_ms, uint32_t* p_retry_after_s);
+
+/**
+ * @brief Checks that a resource ID has the "[8]-[4]-[4]-[4]-[12]" hexadecimal shape
+ */
+static bool is_resource_id(const char* id);
+
+/**
+ * @brief Sends a JSON response
+ *
+ * @param[in] retry_after_s Retry-After header value, 0 to omit
+ *
+ * @return true if the whole response was written
+ */
+static bool send_response(mock_conn_t* p_conn, int status, const char* body, uint32_t retry_after_s, bool close);
+
+/**
+ * @brief Returns the reason phrase for a status code
+ */
+static const char* status_reason(int status);
+
+/**
+ * @brief Joins and frees every finished connection thread
+ *
+ * @note Threads are joined rather than detached so OpenSSL's thread exit handlers have run before the TLS context is
+ * freed
+ */
+static void reap_connections(mock_bridge_handle_t p_bridge);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t mock_bridge_start(mock_bridge_handle_t* p_bridge_handle, const mock_bridge_config_t* p_config) {
+    if (!p_bridge_handle || !p_config || !p_config->bridge_id) return ESP_ERR_INVALID_ARG;
+
+    mock_bridge_handle_t p_bridge = calloc(1, sizeof(struct mock_bridge));
+    if (!p_bridge) return ESP_ERR_NO_MEM;
+
+    p_bridge->listen_fd = -1;
+    p_bridge->faults = p_config->faults;
+    p_bridge->rand_state = p_config->seed;
+    p_bridge->light_budget = (mock_budget_t){.per_s = p_config->light_budget, .tokens = p_config->light_budget};
+    p_bridge->group_budget = (mock_budget_t){.per_s = p_config->group_budget, .tokens = p_config->group_budget};
+    pthread_mutex_init(&p_bridge->mutex, NULL);
+    pthread_cond_init(&p_bridge->conns_closed, NULL);
+
+    p_bridge->bridge_id = strdup(p_config->bridge_id);
+    if (p_config->application_key) p_bridge->application_key = strdup(p_config->application_key);
+
+    esp_err_t err = ESP_OK;
+    if (!p_bridge->bridge_id || (p_config->application_key && !p_bridge->application_key)) err = ESP_ERR_NO_MEM;
+    if (err == ESP_OK) err = create_tls_context(p_bridge);
+    if (err == ESP_OK) err = open_listener(p_bridge, p_config->port);
+    if ((err == ESP_OK) && (pthread_create(&p_bridge->accept_thread, NULL, accept_thread, p_bridge) != 0)) {
+        err = ESP_ERR_NO_MEM;
+    }
+
+    if (err != ESP_OK) {
+        if (p_bridge->listen_fd >= 0) close(p_bridge->listen_fd);
+        SSL_CTX_free(p_bridge->ssl_ctx);
+        free(p_bridge->cert_pem);
+        free(p_bridge->bridge_id);
+        free(p_bridge->application_key);
+        free(p_bridge);
+        return err;
+    }
+
+    ESP_LOGI(tag, "Mock bridge %s listening on 127.0.0.1:%u", p_bridge->bridge_id, p_bridge->port);
+    *p_bridge_handle = p_bridge;
+    return ESP_OK;
+}
+
+void mock_bridge_stop(mock_bridge_handle_t* p_bridge_handle) {
+    if (!p_bridge_handle || !(*p_bridge_handle)) return;
+    mock_bridge_handle_t p_bridge = *p_bridge_handle;
+
+    /* Shutting down the listening socket wakes the blocked accept() */
+    pthread_mutex_lock(&p_bridge->mutex);
+    p_bridge->stopping = true;
+    pthread_mutex_unlock(&p_bridge->mutex);
+    shutdown(p_bridge->listen_fd, SHUT_RDWR);
+    pthread_join(p_bridge->accept_thread, NULL);
+    close(p_bridge->listen_fd);
+
+    /* Wake every connection blocked in a read and wait for them to exit */
+    pthread_mutex_lock(&p_bridge->mutex);
+    for (mock_conn_t* p_conn = p_bridge->conns; p_conn; p_conn = p_conn->next) shutdown(p_conn->fd, SHUT_RDWR);
+    while (p_bridge->conns) pthread_cond_wait(&p_bridge->conns_closed, &p_bridge->mutex);
+    pthread_mutex_unlock(&p_bridge->mutex);
+    reap_connections(p_bridge);
+
+    SSL_CTX_free(p_bridge->ssl_ctx);
+    pthread_cond_destroy(&p_bridge->conns_closed);
+    pthread_mutex_destroy(&p_bridge->mutex);
+    free(p_bridge->cert_pem);
+    free(p_bridge->bridge_id);
+    free(p_bridge->application_key);
+    free(p_bridge);
+    *p_bridge_handle = NULL;
+}
+
+uint16_t mock_bridge_get_port(mock_bridge_handle_t bridge_handle) { return bridge_handle ? bridge_handle->port : 0; }
+
+const char* mock_bridge_get_cert_pem(mock_bridge_handle_t bridge_handle) {
+    return bridge_handle ? bridge_handle->cert_pem : NULL;
+}
+
+void mock_bridge_set_faults(mock_bridge_handle_t bridge_handle, const mock_bridge_faults_t* p_faults) {
+    if (!bridge_handle || !p_faults) return;
+    pthread_mutex_lock(&bridge_handle->mutex);
+    bridge_handle->faults = *p_faults;
+    pthread_mutex_unlock(&bridge_handle->mutex);
+}
+
+void mock_bridge_get_stats(mock_bridge_handle_t bridge_handle, mock_bridge_stats_t* p_stats) {
+    if (!bridge_handle || !p_stats) return;
+    pthread_mutex_lock(&bridge_handle->mutex);
+    *p_stats = bridge_handle->stats;
+    pthread_mutex_unlock(&bridge_handle->mutex);
+}
+
+void mock_bridge_get_last_body(mock_bridge_handle_t bridge_handle, char* buff, size_t size) {
+    if (!bridge_handle || !buff || !size) return;
+    pthread_mutex_lock(&bridge_handle->mutex);
+    snprintf(buff, size, "%s", bridge_handle->last_body);
+    pthread_mutex_unlock(&bridge_handle->mutex);
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static esp_err_t create_tls_context(mock_bridge_handle_t p_bridge) {
+    esp_err_t err = ESP_FAIL;
+    EVP_PKEY* p_key = EVP_PKEY_Q_keygen(NULL, NULL, "EC", "P-256");
+    X509* p_cert = X509_new();
+    BIO* p_bio = BIO_new(BIO_s_mem());
+    if (!p_key || !p_cert || !p_bio) goto cleanup;
+
+    /* Self-signed like a bridge certificate, with the bridge ID as CN so hue_https can verify it as the common name */
+    X509_set_version(p_cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(p_cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(p_cert), -3600);
+    X509_gmtime_adj(X509_getm_notAfter(p_cert), 365L * 24 * 3600);
+    X509_set_pubkey(p_cert, p_key);
+
+    X509_NAME* p_name = X509_get_subject_name(p_cert);
+    X509_NAME_add_entry_by_txt(p_name, "C", MBSTRING_ASC, (const unsigned char*)"NL", -1, -1, 0);
+    X509_NAME_add_entry_by_txt(p_name, "O", MBSTRING_ASC, (const unsigned char*)"Philips Hue", -1, -1, 0);
+    X509_NAME_add_entry_by_txt(p_name, "CN", MBSTRING_ASC, (const unsigned char*)p_bridge->bridge_id, -1, -1, 0);
+    X509_set_issuer_name(p_cert, p_name);
+
+    /* Marked as a CA so it can be trusted directly as the root, like the Signify root */
+    X509V3_CTX ext_ctx;
+    X509V3_set_ctx_nodb(&ext_ctx);
+    X509V3_set_ctx(&ext_ctx, p_cert, p_cert, NULL, NULL, 0);
+    X509_EXTENSION* p_ext = X509V3_EXT_conf_nid(NULL, &ext_ctx, NID_basic_constraints, "critical,CA:TRUE");
+    if (!p_ext) goto cleanup;
+    X509_add_ext(p_cert, p_ext, -1);
+    X509_EXTENSION_free(p_ext);
+
+    if (!X509_sign(p_cert, p_key, EVP_sha256())) goto cleanup;
+
+    /* Keep the PEM for clients to trust */
+    if (!PEM_write_bio_X509(p_bio, p_cert)) goto cleanup;
+    char* p_pem_data;
+    long pem_length = BIO_get_mem_data(p_bio, &p_pem_data);
+    if (!(p_bridge->cert_pem = strndup(p_pem_data, pem_length))) goto cleanup;
+
+    p_bridge->ssl_ctx = SSL_CTX_new(TLS_server_method());
+    if (!p_bridge->ssl_ctx) goto cleanup;
+    SSL_CTX_set_min_proto_version(p_bridge->ssl_ctx, TLS1_2_VERSION);
+    if ((SSL_CTX_use_certificate(p_bridge->ssl_ctx, p_cert) != 1) ||
+        (SSL_CTX_use_PrivateKey(p_bridge->ssl_ctx, p_key) != 1)) {
+        goto cleanup;
+    }
+
+    err = ESP_OK;
+
+cleanup:
+    if (err != ESP_OK) {
+        ESP_LOGE(tag, "Failed to create TLS context: %s", ERR_reason_error_string(ERR_peek_last_error()));
+        ERR_clear_error();
+    }
+    BIO_free(p_bio);
+    X509_free(p_cert);
+    EVP_PKEY_free(p_key);
+    return err;
+}
+
+static esp_err_t open_listener(mock_bridge_handle_t p_bridge, uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return ESP_FAIL;
+
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_port = htons(port)};
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    if ((bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) || (listen(fd, 16) != 0) ||
+        (getsockname(fd, (struct sockaddr*)&addr, &addr_len) != 0)) {
+        ESP_LOGE(tag, "Failed to listen on port %u: %s", port, strerror(errno));
+        close(fd);
+        return ESP_FAIL;
+    }
+
+    p_bridge->listen_fd = fd;
+    p_bridge->port = ntohs(addr.sin_port);
+    return ESP_OK;
+}
+
+static void* accept_thread(void* arg) {
+    mock_bridge_handle_t p_bridge = arg;
+
+    while (true) {
+        int fd = accept(p_bridge->listen_fd, NULL, NULL);
+
+        pthread_mutex_lock(&p_bridge->mutex);
+        bool stopping = p_bridge->stopping;
+        pthread_mutex_unlock(&p_bridge->mutex);
+        if (stopping) {
+            if (fd >= 0) close(fd);
+            break;
+        }
+        reap_connections(p_bridge);
+        if (fd < 0) continue;
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        mock_conn_t* p_conn = calloc(1, sizeof(mock_conn_t));
+        if (!p_conn) {
+            close(fd);
+            continue;
+        }
+        p_conn->bridge = p_bridge;
+        p_conn->fd = fd;
+
+        /* Linked before the thread starts so mock_bridge_stop() always waits for it */
+        pthread_mutex_lock(&p_bridge->mutex);
+        p_conn->next = p_bridge->conns;
+        p_bridge->conns = p_conn;
+        pthread_mutex_unlock(&p_bridge->mutex);
+
+        if (pthread_create(&p_conn->thread, NULL, conn_thread, p_conn) != 0) {
+            ESP_LOGE(tag, "Failed to create connection thread");
+            pthread_mutex_lock(&p_bridge->mutex);
+            p_bridge->conns = p_conn->next;
+            pthread_mutex_unlock(&p_bridge->mutex);
+            close(fd);
+            free(p_conn);
+            continue;
+        }
+    }
+
+    return NULL;
+}
+
+static void* conn_thread(void* arg) {
+    mock_conn_t* p_conn = arg;
+    mock_bridge_handle_t p_bridge = p_conn->bridge;
+
+    p_conn->ssl = SSL_new(p_bridge->ssl_ctx);
+    if (p_conn->ssl) {
+        SSL_set_fd(p_conn->ssl, p_conn->fd);
+        if (SSL_accept(p_conn->ssl) == 1) {
+            pthread_mutex_lock(&p_bridge->mutex);
+            p_bridge->stats.connections++;
+            pthread_mutex_unlock(&p_bridge->mutex);
+
+            /* Serve requests in order until either side closes the connection */
+            while (true) {
+                mock_request_t request;
+                size_t consumed = 0;
+                int status = read_request(p_conn, &request, &consumed);
+                if (status < 0) break;
+                if (status > 0) {
+                    send_response(p_conn, status, "{\"data\":[],\"errors\":[{\"description\":\"bad request\"}]}", 0,
+                                  true);
+                    break;
+                }
+                bool keep_open = handle_request(p_conn, &request);
+
+                /* Discard the handled request, keeping any pipelined bytes after it */
+                memmove(p_conn->buffer, p_conn->buffer + consumed, p_conn->length - consumed);
+                p_conn->length -= consumed;
+                if (!keep_open) break;
+            }
+        } else {
+            ERR_clear_error();
+        }
+        SSL_free(p_conn->ssl);
+    }
+
+    /* Unlinked before closing so mock_bridge_stop() can never shut down a reused descriptor */
+    pthread_mutex_lock(&p_bridge->mutex);
+    for (mock_conn_t** pp_conn = &p_bridge->conns; *pp_conn; pp_conn = &(*pp_conn)->next) {
+        if (*pp_conn == p_conn) {
+            *pp_conn = p_conn->next;
+            break;
+        }
+    }
+    p_conn->next = p_bridge->finished;
+    p_bridge->finished = p_conn;
+    pthread_cond_broadcast(&p_bridge->conns_closed);
+    pthread_mutex_unlock(&p_bridge->mutex);
+
+    /* p_conn is freed by reap_connections() once this thread has been joined */
+    close(p_conn->fd);
+    return NULL;
+}
+
+static void reap_connections(mock_bridge_handle_t p_bridge) {
+    pthread_mutex_lock(&p_bridge->mutex);
+    mock_conn_t* p_conn = p_bridge->finished;
+    p_bridge->finished = NULL;
+    pthread_mutex_unlock(&p_bridge->mutex);
+
+    while (p_conn) {
+        mock_conn_t* p_next = p_conn->next;
+        pthread_join(p_conn->thread, NULL);
+        free(p_conn);
+        p_conn = p_next;
+    }
+}
+
+static int read_request(mock_conn_t* p_conn, mock_request_t* p_request, size_t* p_consumed) {
+    memset(p_request, 0, sizeof(mock_request_t));
+
+    /* Read until the end of the headers is buffered */
+    char* p_headers_end;
+    while (!(p_headers_end = memmem(p_conn->buffer, p_conn->length, "\r\n\r\n", 4))) {
+        if (p_conn->length == sizeof(p_conn->buffer)) return 431;
+        int received = SSL_read(p_conn->ssl, p_conn->buffer + p_conn->length, sizeof(p_conn->buffer) - p_conn->length);
+        if (received <= 0) {
+            ERR_clear_error();
+            return -1;
+        }
+        p_conn->length += received;
+    }
+    size_t headers_length = (p_headers_end - p_conn->buffer) + 4;
+    *p_headers_end = '\0'; /* Headers are parsed as a string, the terminator is discarded with the request */
+
+    /* Request line */
+    char* p_save;
+    char* p_line = strtok_r(p_conn->buffer, "\r\n", &p_save);
+    if (!p_line || (sscanf(p_line, "%7s %255s HTTP/1.%*d", p_request->method, p_request->path) != 2)) return 400;
+
+    /* Headers */
+    size_t content_length = 0;
+    while ((p_line = strtok_r(NULL, "\r\n", &p_save))) {
+        char* p_value = strchr(p_line, ':');
+        if (!p_value) return 400;
+        *p_value++ = '\0';
+        while (*p_value == ' ') p_value++;
+
+        if (strcasecmp(p_line, "Content-Length") == 0) {
+            content_length = strtoul(p_value, NULL, 10);
+        } else if (strcasecmp(p_line, "hue-application-key") == 0) {
+            snprintf(p_request->app_key, sizeof(p_request->app_key), "%s", p_value);
+        } else if (strcasecmp(p_line, "Connection") == 0) {
+            p_request->close = (strcasecmp(p_value, "close") == 0);
+        } else if (strcasecmp(p_line, "Transfer-Encoding") == 0) {
+            return 411; /* Clients send bodies with Content-Length */
+        }
+    }
+    if (headers_length + content_length > sizeof(p_conn->buffer)) return 413;
+
+    /* Read the rest of the body */
+    while (p_conn->length < headers_length + content_length) {
+        int received = SSL_read(p_conn->ssl, p_conn->buffer + p_conn->length, sizeof(p_conn->buffer) - p_conn->length);
+        if (received <= 0) {
+            ERR_clear_error();
+            return -1;
+        }
+        p_conn->length += received;
+    }
+
+    p_request->body = p_conn->buffer + headers_length;
+    p_request->body_length = content_length;
+    *p_consumed = headers_length + content_length;
+    return 0;
+}
+
+static bool handle_request(mock_conn_t* p_conn, const mock_request_t* p_request) {
+    mock_bridge_handle_t p_bridge = p_conn->bridge;
+
+    uint32_t delay_ms;
+    uint32_t retry_after_s;
+    mock_fault_t fault = roll_fault(p_bridge, &delay_ms, &retry_after_s);
+
+    if (delay_ms) {
+        struct timespec ts = {.tv_sec = delay_ms / 1000, .tv_nsec = (long)(delay_ms % 1000) * 1000000};
+        while ((nanosleep(&ts, &ts) == -1) && (errno == EINTR)) {
+        }
+    }
+
+    int status = 200;
+    char body[256];
+
+    /* Injected faults take precedence over request validation, like an overloaded bridge */
+    switch (fault) {
+        case MOCK_FAULT_DROP:
+            ESP_LOGD(tag, "%s %s: dropping connection", p_request->method, p_request->path);
+            return false;
+        case MOCK_FAULT_THROTTLE:
+            status = 429;
+            break;
+        case MOCK_FAULT_UNAVAILABLE:
+            status = 503;
+            break;
+        case MOCK_FAULT_ERROR:
+            status = 500;
+            break;
+        default:
+            break;
+    }
+
+    /* Split "/clip/v2/resource/<type>/<id>" */
+    const char* p_type = NULL;
+    const char* p_id = NULL;
+    size_t type_length = 0;
+    if (strncmp(p_request->path, MOCK_BRIDGE_RESOURCE_PATH, strlen(MOCK_BRIDGE_RESOURCE_PATH)) == 0) {
+        p_type = p_request->path + strlen(MOCK_BRIDGE_RESOURCE_PATH);
+        const char* p_slash = strchr(p_type, '/');
+        if (p_slash) {
+            type_length = p_slash - p_type;
+            p_id = p_slash + 1;
+        }
+    }
+
+    /* GET /clip/v2/resource/bridge is what clients use to check their key, it returns the bridge itself */
+    bool bridge_get = (strcmp(p_request->path, MOCK_BRIDGE_RESOURCE_PATH "bridge") == 0);
+    if ((status == 200) && bridge_get) {
+        if (strcmp(p_request->method, "GET") != 0) {
+            status = 405;
+        } else if (p_bridge->application_key && (strcmp(p_request->app_key, p_bridge->application_key) != 0)) {
+            status = 403;
+        }
+    } else if (status == 200) {
+        bool known_type = p_id && (((type_length == 5) && (strncmp(p_type, "light", 5) == 0)) ||
+                                   ((type_length == 13) && (strncmp(p_type, "grouped_light", 13) == 0)) ||
+                                   ((type_length == 11) && (strncmp(p_type, "smart_scene", 11) == 0)) ||
+                                   ((type_length == 5) && (strncmp(p_type, "scene", 5) == 0)) ||
+                                   ((type_length == 27) && (strncmp(p_type, "entertainment_configuration", 27) == 0)));
+        if (!known_type || !is_resource_id(p_id)) {
+            status = 404;
+        } else if (strcmp(p_request->method, "PUT") != 0) {
+            status = 405;
+        } else if (p_bridge->application_key && (strcmp(p_request->app_key, p_bridge->application_key) != 0)) {
+            status = 403;
+        } else if ((p_request->body_length < 2) || (p_request->body[0] != '{') ||
+                   (p_request->body[p_request->body_length - 1] != '}')) {
+            status = 400;
+        } else {
+            /* Valid commands count against their class's budget, anything over it is throttled like an injected 429 */
+            bool light = (type_length == 5) && (strncmp(p_type, "light", 5) == 0);
+            pthread_mutex_lock(&p_bridge->mutex);
+            if (!take_budget(light ? &p_bridge->light_budget : &p_bridge->group_budget)) {
+                status = 429;
+                if (retry_after_s == 0) retry_after_s = 1;
+            } else {
+                snprintf(p_bridge->last_body, sizeof(p_bridge->last_body), "%.*s", (int)p_request->body_length,
+                         p_request->body);
+            }
+            pthread_mutex_unlock(&p_bridge->mutex);
+        }
+    }
+
+    if ((status == 200) && bridge_get) {
+        snprintf(body, sizeof(body), "{\"data\":[{\"bridge_id\":\"%s\",\"type\":\"bridge\"}],\"errors\":[]}",
+                 p_bridge->bridge_id);
+    } else if (status == 200) {
+        snprintf(body, sizeof(body), "{\"data\":[{\"rid\":\"%s\",\"rtype\":\"%.*s\"}],\"errors\":[]}", p_id,
+                 (int)type_length, p_type);
+    } else {
+        snprintf(body, sizeof(body), "{\"data\":[],\"errors\":[{\"description\":\"%s\"}]}", status_reason(status));
+    }
+
+    pthread_mutex_lock(&p_bridge->mutex);
+    switch (status) {
+        case 200:
+            p_bridge->stats.ok++;
+            break;
+        case 429:
+            p_bridge->stats.throttled++;
+            break;
+        case 503:
+            p_bridge->stats.unavailable++;
+            break;
+        case 500:
+            p_bridge->stats.errors++;
+            break;
+        default:
+            p_bridge->stats.client_errors++;
+    }
+    pthread_mutex_unlock(&p_bridge->mutex);
+
+    ESP_LOGD(tag, "%s %s: %d", p_request->method, p_request->path, status);
+    bool retry_status = (status == 429) || (status == 503);
+    return send_response(p_conn, status, body, retry_status ? retry_after_s : 0, p_request->close) &&
+           !p_request->close;
+}
+
+static bool take_budget(mock_budget_t* p_budget) {
+    if (p_budget->per_s == 0) return true;
+
+    int64_t now_us = esp_timer_get_time();
+    p_budget->tokens += (now_us - p_budget->refill_us) * p_budget->per_s / 1e6;
+    if (p_budget->tokens > p_budget->per_s) p_budget->tokens = p_budget->per_s;
+    p_budget->refill_us = now_us;
+
+    if (p_budget->tokens < 1) return false;
+    p_budget->tokens -= 1;
+    return true;
+}
+
+static mock_fault_t roll_fault(mock_bridge_handle_t p_bridge, uint32_t* p_delay_ms, uint32_t* p_retry_after_s) {
+    pthread_mutex_lock(&p_bridge->mutex);
+    p_bridge->stats.requests++;
+    mock_bridge_faults_t faults = p_bridge->faults;
+    int roll = rand_r(&p_bridge->rand_state) % 100;
+    uint32_t jitter = faults.jitter_ms ? (uint32_t)rand_r(&p_bridge->rand_state) % (faults.jitter_ms + 1) : 0;
+    if (roll < faults.drop_percent) p_bridge->stats.dropped++;
+    pthread_mutex_unlock(&p_bridge->mutex);
+
+    *p_delay_ms = faults.latency_ms + jitter;
+    *p_retry_after_s = faults.retry_after_s;
+
+    /* Percentages are cumulative, so each fault covers its own slice of the roll */
+    if ((roll -= faults.drop_percent) < 0) return MOCK_FAULT_DROP;
+    if ((roll -= faults.throttle_percent) < 0) return MOCK_FAULT_THROTTLE;
+    if ((roll -= faults.unavailable_percent) < 0) return MOCK_FAULT_UNAVAILABLE;
+    if ((roll -= faults.error_percent) < 0) return MOCK_FAULT_ERROR;
+    return MOCK_FAULT_NONE;
+}
+
+static bool is_resource_id(const char* id) {
+    if (strlen(id) != MOCK_BRIDGE_ID_LENGTH) return false;
+    for (int i = 0; i < MOCK_BRIDGE_ID_LENGTH; i++) {
+        bool dash = (i == 8) || (i == 13) || (i == 18) || (i == 23);
+        if (dash ? (id[i] != '-') : !((id[i] >= '0' && id[i] <= '9') || (id[i] >= 'a' && id[i] <= 'f') ||
+                                        (id[i] >= 'A' && id[i] <= 'F'))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool send_response(mock_conn_t* p_conn, int status, const char* body, uint32_t retry_after_s, bool close) {
+    char response[512];
+    int length = snprintf(response, sizeof(response), "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\n",
+                          status, status_reason(status));
+    if (retry_after_s) {
+        length += snprintf(response + length, sizeof(response) - length, "Retry-After: %u\r\n", retry_after_s);
+    }
+    length += snprintf(response + length, sizeof(response) - length, "Content-Length: %zu\r\n%s\r\n%s",
+                       strlen(body), close ? "Connection: close\r\n" : "", body);
+    if ((length < 0) || ((size_t)length >= sizeof(response))) return false;
+
+    if (SSL_write(p_conn->ssl, response, length) != length) {
+        ERR_clear_error();
+        return false;
+    }
+    return true;
+}
+
+static const char* status_reason(int status) {
+    switch (status) {
+        case 200:
+            return "OK";
+        case 400:
+            return "Bad Request";
+        case 403:
+            return "Forbidden";
+        case 404:
+            return "Not Found";
+        case 405:
+            return "Method Not Allowed";
+        case 411:
+            return "Length Required";
+        case 413:
+            return "Payload Too Large";
+        case 429:
+            return "Too Many Requests";
+        case 431:
+            return "Request Header Fields Too Large";
+        case 500:
+            return "Internal Server Error";
+        case 503:
+            return "Service Unavailable";
+        default:
+            return "Unknown";
+    }
+}
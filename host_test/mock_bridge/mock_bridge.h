@@ -0,0 +1,126 @@
+/**
+ * @file mock_bridge.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Local HTTPS stand-in for a Philips Hue bridge with fault injection, for driving the host build of hue_https
+ *
+ * Serves PUT /clip/v2/resource/{light,grouped_light,smart_scene,scene,entertainment_configuration}/<id> and
+ * GET /clip/v2/resource/bridge over TLS with a freshly generated self-signed certificate whose CN is the configured
+ * bridge ID, so hue_https verifies it exactly as it would a real bridge once the certificate is trusted (see
+ * host_http_client_set_ca_override()).
+ */
+
+#ifndef H_MOCK_BRIDGE
+#define H_MOCK_BRIDGE
+
+#include "esp_types.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*====================================================================================================================*/
+/*=========================================== Public Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Faults injected into requests
+ *
+ * One roll per request picks at most one fault, so the percentages are cumulative and their sum should not exceed 100
+ */
+typedef struct {
+    uint32_t latency_ms;         /**< Delay added before every response */
+    uint32_t jitter_ms;          /**< Random extra delay in range [0-jitter_ms] added to latency_ms */
+    uint8_t drop_percent;        /**< Requests answered by closing the connection without a response */
+    uint8_t throttle_percent;    /**< Requests answered with 429 Too Many Requests */
+    uint8_t unavailable_percent; /**< Requests answered with 503 Service Unavailable */
+    uint8_t error_percent;       /**< Requests answered with 500 Internal Server Error */
+    uint32_t retry_after_s;      /**< Retry-After sent with 429 and 503 responses, 0 to omit the header */
+} mock_bridge_faults_t;
+
+/** @brief Mock bridge configuration */
+typedef struct {
+    const char* bridge_id;       /**< Bridge ID used as certificate CN, 16 hexadecimal characters */
+    const char* application_key; /**< Required hue-application-key header value, NULL to accept any */
+    uint16_t port;               /**< Port to listen on 127.0.0.1, 0 for an ephemeral port */
+    uint32_t seed;               /**< Seed for fault injection, making runs repeatable */
+    mock_bridge_faults_t faults; /**< Initial faults */
+
+    /* Command budgets, refilled continuously with up to a second's worth available at once, like the bridge */
+    uint16_t light_budget; /**< Light commands accepted per second before 429 responses, 0 for no limit */
+    uint16_t group_budget; /**< Commands to every other resource type accepted per second, 0 for no limit */
+} mock_bridge_config_t;
+
+/** @brief Counters of everything the mock bridge has served */
+typedef struct {
+    uint32_t connections;   /**< TLS handshakes completed */
+    uint32_t requests;      /**< Requests received */
+    uint32_t ok;            /**< 200 OK responses */
+    uint32_t client_errors; /**< 4xx responses other than 429 (bad path, method, body or key) */
+    uint32_t throttled;     /**< Injected 429 responses and commands over budget */
+    uint32_t unavailable;   /**< Injected 503 responses */
+    uint32_t errors;        /**< Injected 500 responses */
+    uint32_t dropped;       /**< Injected connection drops */
+} mock_bridge_stats_t;
+
+typedef struct mock_bridge* mock_bridge_handle_t; /**< Handle for a running mock bridge */
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Generates the bridge certificate and starts serving on a background thread
+ *
+ * @param[out] p_bridge_handle Handle to store the running bridge into
+ * @param[in] p_config Bridge configuration
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Bridge listening
+ * @retval - @c ESP_ERR_INVALID_ARG – p_bridge_handle, p_config, or the bridge ID are NULL
+ * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory or start the server thread
+ * @retval - @c ESP_FAIL – Certificate generation, TLS setup, or binding the port failed
+ */
+esp_err_t mock_bridge_start(mock_bridge_handle_t* p_bridge_handle, const mock_bridge_config_t* p_config);
+
+/**
+ * @brief Stops serving, closes every open connection and frees the bridge
+ *
+ * @param[in,out] p_bridge_handle Pointer to bridge handle to stop (Will be set to NULL after)
+ */
+void mock_bridge_stop(mock_bridge_handle_t* p_bridge_handle);
+
+/**
+ * @brief Returns the port the bridge is listening on
+ */
+uint16_t mock_bridge_get_port(mock_bridge_handle_t bridge_handle);
+
+/**
+ * @brief Returns the PEM encoded bridge certificate, valid until the bridge is stopped
+ */
+const char* mock_bridge_get_cert_pem(mock_bridge_handle_t bridge_handle);
+
+/**
+ * @brief Replaces the injected faults, affecting requests received after the call
+ */
+void mock_bridge_set_faults(mock_bridge_handle_t bridge_handle, const mock_bridge_faults_t* p_faults);
+
+/**
+ * @brief Copies the bridge counters
+ */
+void mock_bridge_get_stats(mock_bridge_handle_t bridge_handle, mock_bridge_stats_t* p_stats);
+
+/**
+ * @brief Copies the body of the most recent command answered with 200 OK, empty if there has been none
+ *
+ * @param[in] bridge_handle Bridge to query
+ * @param[out] buff Buffer for the null-terminated body, truncated to fit
+ * @param[in] size Size of buff
+ */
+void mock_bridge_get_last_body(mock_bridge_handle_t bridge_handle, char* buff, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_MOCK_BRIDGE */
@@ -0,0 +1,424 @@
+/**
+ * @file mock_entertainment.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Implementation of the local DTLS stand-in for the entertainment receiver of a Philips Hue bridge
+ *
+ * A single thread serves one session at a time on one UDP socket. The first datagram from a new client connects the
+ * socket to it, so every datagram of the session arrives through the same DTLS BIO, and close_notify or a handshake
+ * failure disconnects it again for the next client.
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "mock_entertainment.h"
+
+static const char* tag = "mock_entertainment";
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define MOCK_ENTERTAINMENT_PSK_SIZE 16       /**< PSK bytes packed from the 32 hexadecimal client key characters */
+#define MOCK_ENTERTAINMENT_ID_LENGTH 36      /**< Entertainment configuration ID length */
+#define MOCK_ENTERTAINMENT_KEY_SIZE 64       /**< Maximum application key length plus terminator */
+#define MOCK_ENTERTAINMENT_HEADER_SIZE 52    /**< HueStream v2 header size */
+#define MOCK_ENTERTAINMENT_CHANNEL_SIZE 7    /**< Channel ID byte followed by three 16 bit color values */
+#define MOCK_ENTERTAINMENT_MAX_CHANNELS 20   /**< Most channels a frame may carry */
+#define MOCK_ENTERTAINMENT_RECORD_SIZE 2048  /**< Receive buffer, larger than any valid frame to catch oversized ones */
+#define MOCK_ENTERTAINMENT_POLL_MS 20        /**< Longest the thread blocks before checking for a stop */
+#define MOCK_ENTERTAINMENT_HANDSHAKE_MS 5000 /**< Longest a handshake may take before the client is dropped */
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Running mock receiver */
+struct mock_entertainment {
+    char application_key[MOCK_ENTERTAINMENT_KEY_SIZE]; /**< Required PSK identity, empty to accept any */
+    uint8_t psk[MOCK_ENTERTAINMENT_PSK_SIZE];          /**< PSK packed from the client key */
+    SSL_CTX* ssl_ctx;                                  /**< Server DTLS context with the PSK callback */
+    int fd;                                            /**< UDP socket, connected to the client during a session */
+    uint16_t port;                                     /**< Port listened on */
+    pthread_t thread;                                  /**< Thread receiving sessions */
+    atomic_bool stopping;                              /**< mock_entertainment_stop() has been called */
+
+    /** Configuration ID every frame must carry, empty to accept any */
+    char configuration_id[MOCK_ENTERTAINMENT_ID_LENGTH + 1];
+
+    pthread_mutex_t mutex;            /**< Protects all fields below */
+    mock_entertainment_stats_t stats; /**< Counters */
+    uint32_t interval_count;          /**< Intervals recorded */
+    size_t last_frame_length;         /**< Length of last_frame, 0 if there has been none */
+
+    /** Arrival intervals between consecutive frames of a session */
+    int64_t intervals_us[MOCK_ENTERTAINMENT_MAX_INTERVALS];
+    /** Copy of the most recent valid frame */
+    uint8_t last_frame[MOCK_ENTERTAINMENT_RECORD_SIZE];
+};
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Packs 32 hexadecimal characters into PSK bytes
+ *
+ * @return true if client_key is exactly 32 hexadecimal characters
+ */
+static bool pack_client_key(uint8_t* psk, const char* client_key);
+
+/**
+ * @brief Creates the server DTLS context, limited to what the bridge accepts
+ *
+ * @return ESP_OK, or ESP_FAIL if any OpenSSL call fails
+ */
+static esp_err_t create_dtls_context(mock_entertainment_handle_t p_receiver);
+
+/**
+ * @brief Opens the non-blocking UDP socket on 127.0.0.1
+ *
+ * @param[in] port Port to bind, 0 for ephemeral
+ *
+ * @return ESP_OK, or ESP_FAIL if the socket cannot be bound
+ */
+static esp_err_t open_socket(mock_entertainment_handle_t p_receiver, uint16_t port);
+
+/**
+ * @brief OpenSSL PSK server callback, answers with the PSK if the identity is the configured application key
+ */
+static unsigned int psk_server_callback(SSL* ssl, const char* identity, unsigned char* psk, unsigned int max_psk_len);
+
+/**
+ * @brief Thread waiting for a client and serving its session until the receiver is stopped
+ */
+static void* receive_thread(void* arg);
+
+/**
+ * @brief Performs the handshake and receives frames until the session ends or the receiver is stopped
+ *
+ * @param[in] ssl Session on the socket connected to the client
+ */
+static void serve_session(mock_entertainment_handle_t p_receiver, SSL* ssl);
+
+/**
+ * @brief Waits for the socket to become readable or the next DTLS retransmission to be due
+ *
+ * @return true if the receiver is still running
+ */
+static bool wait_readable(mock_entertainment_handle_t p_receiver, SSL* ssl);
+
+/**
+ * @brief Checks a record against the HueStream v2 layout and the configuration, recording it as a frame if valid
+ *
+ * @param[in,out] p_last_sequence Sequence number of the previous frame of the session, -1 before the first
+ * @param[in,out] p_last_arrival_us Arrival time of the previous frame of the session, 0 before the first
+ */
+static void record_frame(mock_entertainment_handle_t p_receiver, const uint8_t* data, size_t length,
+                         int* p_last_sequence, int64_t* p_last_arrival_us);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t mock_entertainment_start(mock_entertainment_handle_t* p_receiver_handle,
+                                   const mock_entertainment_config_t* p_config) {
+    if (!p_receiver_handle || !p_config || !p_config->client_key) return ESP_ERR_INVALID_ARG;
+    if ((p_config->application_key && (strlen(p_config->application_key) >= MOCK_ENTERTAINMENT_KEY_SIZE)) ||
+        (p_config->entertainment_configuration_id &&
+         (strlen(p_config->entertainment_configuration_id) != MOCK_ENTERTAINMENT_ID_LENGTH))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    mock_entertainment_handle_t p_receiver = calloc(1, sizeof(struct mock_entertainment));
+    if (!p_receiver) return ESP_ERR_NO_MEM;
+    if (!pack_client_key(p_receiver->psk, p_config->client_key)) {
+        free(p_receiver);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    p_receiver->fd = -1;
+    if (p_config->application_key) {
+        snprintf(p_receiver->application_key, sizeof(p_receiver->application_key), "%s", p_config->application_key);
+    }
+    if (p_config->entertainment_configuration_id) {
+        memcpy(p_receiver->configuration_id, p_config->entertainment_configuration_id, MOCK_ENTERTAINMENT_ID_LENGTH);
+    }
+    pthread_mutex_init(&p_receiver->mutex, NULL);
+
+    esp_err_t err = create_dtls_context(p_receiver);
+    if (err == ESP_OK) err = open_socket(p_receiver, p_config->port);
+    if ((err == ESP_OK) && (pthread_create(&p_receiver->thread, NULL, receive_thread, p_receiver) != 0)) {
+        err = ESP_ERR_NO_MEM;
+    }
+
+    if (err != ESP_OK) {
+        if (p_receiver->fd >= 0) close(p_receiver->fd);
+        SSL_CTX_free(p_receiver->ssl_ctx);
+        pthread_mutex_destroy(&p_receiver->mutex);
+        free(p_receiver);
+        return err;
+    }
+
+    ESP_LOGI(tag, "Mock entertainment receiver listening on 127.0.0.1:%u", p_receiver->port);
+    *p_receiver_handle = p_receiver;
+    return ESP_OK;
+}
+
+void mock_entertainment_stop(mock_entertainment_handle_t* p_receiver_handle) {
+    if (!p_receiver_handle || !(*p_receiver_handle)) return;
+    mock_entertainment_handle_t p_receiver = *p_receiver_handle;
+
+    /* The thread never blocks for longer than MOCK_ENTERTAINMENT_POLL_MS, so it sees the flag promptly */
+    atomic_store(&p_receiver->stopping, true);
+    pthread_join(p_receiver->thread, NULL);
+
+    close(p_receiver->fd);
+    SSL_CTX_free(p_receiver->ssl_ctx);
+    pthread_mutex_destroy(&p_receiver->mutex);
+    free(p_receiver);
+    *p_receiver_handle = NULL;
+}
+
+uint16_t mock_entertainment_get_port(mock_entertainment_handle_t receiver_handle) {
+    return receiver_handle ? receiver_handle->port : 0;
+}
+
+void mock_entertainment_get_stats(mock_entertainment_handle_t receiver_handle, mock_entertainment_stats_t* p_stats) {
+    if (!receiver_handle || !p_stats) return;
+    pthread_mutex_lock(&receiver_handle->mutex);
+    *p_stats = receiver_handle->stats;
+    pthread_mutex_unlock(&receiver_handle->mutex);
+}
+
+uint32_t mock_entertainment_get_intervals(mock_entertainment_handle_t receiver_handle, int64_t* p_intervals_us,
+                                          uint32_t size) {
+    if (!receiver_handle || !p_intervals_us) return 0;
+    pthread_mutex_lock(&receiver_handle->mutex);
+    uint32_t count = (receiver_handle->interval_count < size) ? receiver_handle->interval_count : size;
+    memcpy(p_intervals_us, receiver_handle->intervals_us, count * sizeof(int64_t));
+    pthread_mutex_unlock(&receiver_handle->mutex);
+    return count;
+}
+
+size_t mock_entertainment_get_last_frame(mock_entertainment_handle_t receiver_handle, uint8_t* buff, size_t size) {
+    if (!receiver_handle || !buff) return 0;
+    pthread_mutex_lock(&receiver_handle->mutex);
+    size_t length = receiver_handle->last_frame_length;
+    memcpy(buff, receiver_handle->last_frame, (length < size) ? length : size);
+    pthread_mutex_unlock(&receiver_handle->mutex);
+    return length;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static bool pack_client_key(uint8_t* psk, const char* client_key) {
+    static const char hex[] = "0123456789abcdefABCDEF";
+    if ((strlen(client_key) != (MOCK_ENTERTAINMENT_PSK_SIZE * 2)) || (strspn(client_key, hex) != strlen(client_key))) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < MOCK_ENTERTAINMENT_PSK_SIZE; i++) {
+        unsigned int byte;
+        sscanf(&client_key[i * 2], "%2x", &byte);
+        psk[i] = (uint8_t)byte;
+    }
+    return true;
+}
+
+static esp_err_t create_dtls_context(mock_entertainment_handle_t p_receiver) {
+    p_receiver->ssl_ctx = SSL_CTX_new(DTLS_server_method());
+    if (!p_receiver->ssl_ctx || !SSL_CTX_set_min_proto_version(p_receiver->ssl_ctx, DTLS1_2_VERSION) ||
+        !SSL_CTX_set_max_proto_version(p_receiver->ssl_ctx, DTLS1_2_VERSION) ||
+        !SSL_CTX_set_cipher_list(p_receiver->ssl_ctx, "PSK-AES128-GCM-SHA256")) {
+        ESP_LOGE(tag, "Failed to create DTLS context: %s", ERR_reason_error_string(ERR_peek_last_error()));
+        ERR_clear_error();
+        return ESP_FAIL;
+    }
+    SSL_CTX_set_psk_server_callback(p_receiver->ssl_ctx, psk_server_callback);
+    return ESP_OK;
+}
+
+static esp_err_t open_socket(mock_entertainment_handle_t p_receiver, uint16_t port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return ESP_FAIL;
+
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_port = htons(port)};
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    if ((bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) ||
+        (getsockname(fd, (struct sockaddr*)&addr, &addr_len) != 0)) {
+        ESP_LOGE(tag, "Failed to bind port %u: %s", port, strerror(errno));
+        close(fd);
+        return ESP_FAIL;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    p_receiver->fd = fd;
+    p_receiver->port = ntohs(addr.sin_port);
+    return ESP_OK;
+}
+
+static unsigned int psk_server_callback(SSL* ssl, const char* identity, unsigned char* psk, unsigned int max_psk_len) {
+    mock_entertainment_handle_t p_receiver = (mock_entertainment_handle_t)SSL_get_app_data(ssl);
+
+    /* Like the bridge, an identity other than the application key ends the handshake */
+    if (p_receiver->application_key[0] && (!identity || (strcmp(identity, p_receiver->application_key) != 0))) {
+        ESP_LOGW(tag, "Unknown PSK identity %s", identity ? identity : "(none)");
+        return 0;
+    }
+    if (max_psk_len < MOCK_ENTERTAINMENT_PSK_SIZE) return 0;
+
+    memcpy(psk, p_receiver->psk, MOCK_ENTERTAINMENT_PSK_SIZE);
+    return MOCK_ENTERTAINMENT_PSK_SIZE;
+}
+
+static void* receive_thread(void* arg) {
+    mock_entertainment_handle_t p_receiver = arg;
+
+    while (!atomic_load(&p_receiver->stopping)) {
+        struct pollfd pfd = {.fd = p_receiver->fd, .events = POLLIN};
+        if (poll(&pfd, 1, MOCK_ENTERTAINMENT_POLL_MS) <= 0) continue;
+
+        /* Peeked so the ClientHello stays queued for the session, only the sender's address is taken */
+        struct sockaddr_storage peer;
+        socklen_t peer_length = sizeof(peer);
+        uint8_t byte;
+        if ((recvfrom(p_receiver->fd, &byte, sizeof(byte), MSG_PEEK, (struct sockaddr*)&peer, &peer_length) < 0) ||
+            (connect(p_receiver->fd, (struct sockaddr*)&peer, peer_length) != 0)) {
+            continue;
+        }
+
+        BIO* bio = BIO_new_dgram(p_receiver->fd, BIO_NOCLOSE);
+        SSL* ssl = SSL_new(p_receiver->ssl_ctx);
+        if (bio && ssl) {
+            BIO_ctrl(bio, BIO_CTRL_DGRAM_SET_CONNECTED, 0, &peer);
+            SSL_set_bio(ssl, bio, bio);
+            SSL_set_app_data(ssl, p_receiver);
+            serve_session(p_receiver, ssl);
+        } else {
+            BIO_free(bio);
+        }
+        SSL_free(ssl);
+        ERR_clear_error();
+
+        /* Disconnecting takes datagrams from any address again */
+        struct sockaddr unspec = {.sa_family = AF_UNSPEC};
+        connect(p_receiver->fd, &unspec, sizeof(unspec));
+    }
+
+    return NULL;
+}
+
+static void serve_session(mock_entertainment_handle_t p_receiver, SSL* ssl) {
+    int64_t handshake_deadline_us = esp_timer_get_time() + MOCK_ENTERTAINMENT_HANDSHAKE_MS * 1000LL;
+    int ret;
+    while ((ret = SSL_accept(ssl)) != 1) {
+        int err = SSL_get_error(ssl, ret);
+        if (((err != SSL_ERROR_WANT_READ) && (err != SSL_ERROR_WANT_WRITE)) ||
+            (esp_timer_get_time() > handshake_deadline_us) || !wait_readable(p_receiver, ssl)) {
+            ESP_LOGW(tag, "DTLS handshake failed: %s", ERR_reason_error_string(ERR_peek_last_error()));
+            pthread_mutex_lock(&p_receiver->mutex);
+            p_receiver->stats.handshake_failures++;
+            pthread_mutex_unlock(&p_receiver->mutex);
+            return;
+        }
+    }
+
+    pthread_mutex_lock(&p_receiver->mutex);
+    p_receiver->stats.handshakes++;
+    pthread_mutex_unlock(&p_receiver->mutex);
+    ESP_LOGI(tag, "DTLS session open with %s", SSL_get_cipher_name(ssl));
+
+    uint8_t record[MOCK_ENTERTAINMENT_RECORD_SIZE];
+    int last_sequence = -1;
+    int64_t last_arrival_us = 0;
+    while (true) {
+        ret = SSL_read(ssl, record, sizeof(record));
+        if (ret > 0) {
+            record_frame(p_receiver, record, ret, &last_sequence, &last_arrival_us);
+            continue;
+        }
+
+        int err = SSL_get_error(ssl, ret);
+        if (err == SSL_ERROR_ZERO_RETURN) {
+            pthread_mutex_lock(&p_receiver->mutex);
+            p_receiver->stats.sessions_closed++;
+            pthread_mutex_unlock(&p_receiver->mutex);
+            return;
+        }
+        if ((err != SSL_ERROR_WANT_READ) || !wait_readable(p_receiver, ssl)) return;
+    }
+}
+
+static bool wait_readable(mock_entertainment_handle_t p_receiver, SSL* ssl) {
+    int timeout_ms = MOCK_ENTERTAINMENT_POLL_MS;
+    struct timeval retransmit;
+    if (DTLSv1_get_timeout(ssl, &retransmit)) {
+        int retransmit_ms = (int)(retransmit.tv_sec * 1000 + (retransmit.tv_usec + 999) / 1000);
+        if (retransmit_ms < timeout_ms) timeout_ms = retransmit_ms;
+    }
+
+    struct pollfd pfd = {.fd = p_receiver->fd, .events = POLLIN};
+    if (poll(&pfd, 1, timeout_ms) == 0) DTLSv1_handle_timeout(ssl);
+    return !atomic_load(&p_receiver->stopping);
+}
+
+static void record_frame(mock_entertainment_handle_t p_receiver, const uint8_t* data, size_t length,
+                         int* p_last_sequence, int64_t* p_last_arrival_us) {
+    int64_t arrival_us = esp_timer_get_time();
+
+    /* Header, then whole channels with in range IDs, see hue_entertainment_frame.c for the layout */
+    bool valid = (length >= MOCK_ENTERTAINMENT_HEADER_SIZE) &&
+                 (((length - MOCK_ENTERTAINMENT_HEADER_SIZE) % MOCK_ENTERTAINMENT_CHANNEL_SIZE) == 0) &&
+                 (length <= (MOCK_ENTERTAINMENT_HEADER_SIZE +
+                             (MOCK_ENTERTAINMENT_MAX_CHANNELS * MOCK_ENTERTAINMENT_CHANNEL_SIZE))) &&
+                 (memcmp(data, "HueStream\x02\x00", 11) == 0) && (data[12] == 0) && (data[13] == 0) &&
+                 (data[14] <= 1) && (data[15] == 0) &&
+                 (!p_receiver->configuration_id[0] ||
+                  (memcmp(&data[16], p_receiver->configuration_id, MOCK_ENTERTAINMENT_ID_LENGTH) == 0));
+    for (size_t pos = MOCK_ENTERTAINMENT_HEADER_SIZE; valid && (pos < length); pos += MOCK_ENTERTAINMENT_CHANNEL_SIZE) {
+        if (data[pos] >= MOCK_ENTERTAINMENT_MAX_CHANNELS) valid = false;
+    }
+
+    pthread_mutex_lock(&p_receiver->mutex);
+    mock_entertainment_stats_t* p_stats = &p_receiver->stats;
+    if (!valid) {
+        p_stats->bad_frames++;
+        pthread_mutex_unlock(&p_receiver->mutex);
+        return;
+    }
+
+    p_stats->frames++;
+    if (!p_stats->first_frame_us) p_stats->first_frame_us = arrival_us;
+    p_stats->last_frame_us = arrival_us;
+    if ((*p_last_sequence >= 0) && (data[11] != (uint8_t)(*p_last_sequence + 1))) p_stats->sequence_gaps++;
+    if (*p_last_arrival_us && (p_receiver->interval_count < MOCK_ENTERTAINMENT_MAX_INTERVALS)) {
+        p_receiver->intervals_us[p_receiver->interval_count++] = arrival_us - *p_last_arrival_us;
+    }
+    memcpy(p_receiver->last_frame, data, length);
+    p_receiver->last_frame_length = length;
+    pthread_mutex_unlock(&p_receiver->mutex);
+
+    *p_last_sequence = data[11];
+    *p_last_arrival_us = arrival_us;
+}
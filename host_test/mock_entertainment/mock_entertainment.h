@@ -0,0 +1,119 @@
+/**
+ * @file mock_entertainment.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Local DTLS stand-in for the entertainment receiver of a Philips Hue bridge, for measuring the frame rate and
+ * jitter of the host build of hue_entertainment
+ *
+ * Accepts one DTLS 1.2 PSK-AES128-GCM-SHA256 session at a time on 127.0.0.1 with the application key as identity and
+ * the client key as PSK, like the bridge on port 2100, and checks every frame received against the HueStream v2 layout.
+ * Arrival times are taken on receipt, so intervals include the sender's pacing and the loopback path but not the DTLS
+ * decryption of later frames.
+ */
+
+#ifndef H_MOCK_ENTERTAINMENT
+#define H_MOCK_ENTERTAINMENT
+
+#include "esp_types.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define MOCK_ENTERTAINMENT_MAX_INTERVALS 8192 /**< Arrival intervals kept, later frames are only counted */
+
+/*====================================================================================================================*/
+/*=========================================== Public Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Mock entertainment receiver configuration */
+typedef struct {
+    const char* application_key;                /**< Required PSK identity, NULL to accept any */
+    const char* client_key;                     /**< Client key whose 32 hexadecimal characters are the PSK */
+    const char* entertainment_configuration_id; /**< Configuration ID every frame must carry, NULL to accept any */
+    uint16_t port;                              /**< Port to listen on 127.0.0.1, 0 for an ephemeral port */
+} mock_entertainment_config_t;
+
+/** @brief Counters of everything the mock receiver has received */
+typedef struct {
+    uint32_t handshakes;         /**< DTLS handshakes completed */
+    uint32_t handshake_failures; /**< DTLS handshakes failed, including unknown identities */
+    uint32_t sessions_closed;    /**< Sessions ended by close_notify */
+    uint32_t frames;             /**< Valid frames received */
+    uint32_t bad_frames;         /**< Records that were not a valid frame for the configuration */
+    uint32_t sequence_gaps;      /**< Frames whose sequence number did not follow the previous frame of the session */
+    int64_t first_frame_us;      /**< Arrival time of the first valid frame, 0 if there has been none */
+    int64_t last_frame_us;       /**< Arrival time of the most recent valid frame */
+} mock_entertainment_stats_t;
+
+typedef struct mock_entertainment* mock_entertainment_handle_t; /**< Handle for a running mock receiver */
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Opens the UDP socket and starts receiving on a background thread
+ *
+ * @param[out] p_receiver_handle Handle to store the running receiver into
+ * @param[in] p_config Receiver configuration
+ *
+ * @return ESP Error code
+ * @retval - @c ESP_OK – Receiver listening
+ * @retval - @c ESP_ERR_INVALID_ARG – p_receiver_handle, p_config, or the client key are NULL, or the client key is not
+ * 32 hexadecimal characters
+ * @retval - @c ESP_ERR_NO_MEM – Failed to allocate memory or start the receiver thread
+ * @retval - @c ESP_FAIL – DTLS setup or binding the port failed
+ */
+esp_err_t mock_entertainment_start(mock_entertainment_handle_t* p_receiver_handle,
+                                   const mock_entertainment_config_t* p_config);
+
+/**
+ * @brief Stops receiving, drops any open session and frees the receiver
+ *
+ * @param[in,out] p_receiver_handle Pointer to receiver handle to stop (Will be set to NULL after)
+ */
+void mock_entertainment_stop(mock_entertainment_handle_t* p_receiver_handle);
+
+/**
+ * @brief Returns the port the receiver is listening on
+ */
+uint16_t mock_entertainment_get_port(mock_entertainment_handle_t receiver_handle);
+
+/**
+ * @brief Copies the receiver counters
+ */
+void mock_entertainment_get_stats(mock_entertainment_handle_t receiver_handle, mock_entertainment_stats_t* p_stats);
+
+/**
+ * @brief Copies the intervals between the arrivals of consecutive valid frames of a session, in arrival order
+ *
+ * @param[in] receiver_handle Receiver to query
+ * @param[out] p_intervals_us Storage for the intervals in microseconds
+ * @param[in] size Number of intervals p_intervals_us can hold
+ *
+ * @return Number of intervals copied
+ */
+uint32_t mock_entertainment_get_intervals(mock_entertainment_handle_t receiver_handle, int64_t* p_intervals_us,
+                                          uint32_t size);
+
+/**
+ * @brief Copies the most recent valid frame
+ *
+ * @param[in] receiver_handle Receiver to query
+ * @param[out] buff Storage for the frame
+ * @param[in] size Size of buff, the frame is truncated to fit
+ *
+ * @return Length of the frame, 0 if there has been none
+ */
+size_t mock_entertainment_get_last_frame(mock_entertainment_handle_t receiver_handle, uint8_t* buff, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_MOCK_ENTERTAINMENT */
@@ -0,0 +1,213 @@
+/**
+ * @file esp_event.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the ESP-IDF default event loop
+ *
+ * Posted events are copied into a queue and dispatched in post order from a dedicated task, so handlers run
+ * asynchronously to the poster as they do on device.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "esp_event.h"
+#include "host_mocks.h"
+
+#define HOST_EVENT_MAX_HANDLERS 32   /**< Number of handlers that can be registered at once */
+#define HOST_EVENT_QUEUE_LENGTH 32   /**< Number of events that can be pending dispatch */
+#define HOST_EVENT_DISPATCH_BATCH 32 /**< Handlers copied out of the table per dispatched event */
+
+/** @brief Registered event handler, the address of an entry doubles as its instance handle */
+typedef struct {
+    bool in_use;                 /**< Entry holds a registration */
+    esp_event_base_t base;       /**< Base to match, ESP_EVENT_ANY_BASE for all */
+    int32_t id;                  /**< ID to match, ESP_EVENT_ANY_ID for all */
+    esp_event_handler_t handler; /**< Handler function */
+    void* arg;                   /**< Handler argument */
+} host_event_handler_t;
+
+/** @brief Event waiting for dispatch */
+typedef struct {
+    esp_event_base_t base; /**< Event base */
+    int32_t id;            /**< Event ID */
+    void* data;            /**< Heap copy of the event data, may be NULL */
+} host_event_t;
+
+static pthread_mutex_t loop_mutex = PTHREAD_MUTEX_INITIALIZER;
+static host_event_handler_t handlers[HOST_EVENT_MAX_HANDLERS];
+static QueueHandle_t event_queue = NULL;
+static uint32_t events_pending = 0; /**< Events posted but not fully dispatched */
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Event loop task dispatching queued events to matching handlers
+ */
+static void event_loop_task(void* pvParameters);
+
+/**
+ * @brief Adds a handler registration
+ */
+static esp_err_t add_handler(esp_event_base_t event_base, int32_t event_id, esp_event_handler_t event_handler,
+                             void* event_handler_arg, esp_event_handler_instance_t* instance);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t esp_event_loop_create_default(void) {
+    pthread_mutex_lock(&loop_mutex);
+    if (event_queue) {
+        pthread_mutex_unlock(&loop_mutex);
+        return ESP_ERR_INVALID_STATE;
+    }
+    event_queue = xQueueCreate(HOST_EVENT_QUEUE_LENGTH, sizeof(host_event_t));
+    pthread_mutex_unlock(&loop_mutex);
+    if (!event_queue) return ESP_ERR_NO_MEM;
+
+    if (xTaskCreate(event_loop_task, "sys_evt", 2304, NULL, 20, NULL) != pdPASS) return ESP_ERR_NO_MEM;
+    return ESP_OK;
+}
+
+esp_err_t esp_event_loop_delete_default(void) { return ESP_ERR_NOT_SUPPORTED; }
+
+esp_err_t esp_event_handler_register(esp_event_base_t event_base, int32_t event_id, esp_event_handler_t event_handler,
+                                     void* event_handler_arg) {
+    return add_handler(event_base, event_id, event_handler, event_handler_arg, NULL);
+}
+
+esp_err_t esp_event_handler_unregister(esp_event_base_t event_base, int32_t event_id,
+                                       esp_event_handler_t event_handler) {
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+
+    pthread_mutex_lock(&loop_mutex);
+    for (size_t i = 0; i < HOST_EVENT_MAX_HANDLERS; i++) {
+        if (handlers[i].in_use && (handlers[i].base == event_base) && (handlers[i].id == event_id) &&
+            (handlers[i].handler == event_handler)) {
+            handlers[i].in_use = false;
+            err = ESP_OK;
+        }
+    }
+    pthread_mutex_unlock(&loop_mutex);
+
+    return err;
+}
+
+esp_err_t esp_event_handler_instance_register(esp_event_base_t event_base, int32_t event_id,
+                                              esp_event_handler_t event_handler, void* event_handler_arg,
+                                              esp_event_handler_instance_t* instance) {
+    return add_handler(event_base, event_id, event_handler, event_handler_arg, instance);
+}
+
+esp_err_t esp_event_handler_instance_unregister(esp_event_base_t event_base, int32_t event_id,
+                                                esp_event_handler_instance_t instance) {
+    host_event_handler_t* p_entry = (host_event_handler_t*)instance;
+    if ((p_entry < handlers) || (p_entry >= handlers + HOST_EVENT_MAX_HANDLERS)) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&loop_mutex);
+    p_entry->in_use = false;
+    pthread_mutex_unlock(&loop_mutex);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_event_post(esp_event_base_t event_base, int32_t event_id, const void* event_data,
+                         size_t event_data_size, TickType_t ticks_to_wait) {
+    if (!event_queue) return ESP_ERR_INVALID_STATE;
+
+    host_event_t event = {.base = event_base, .id = event_id, .data = NULL};
+    if (event_data && event_data_size) {
+        if (!(event.data = malloc(event_data_size))) return ESP_ERR_NO_MEM;
+        memcpy(event.data, event_data, event_data_size);
+    }
+
+    pthread_mutex_lock(&loop_mutex);
+    events_pending++;
+    pthread_mutex_unlock(&loop_mutex);
+
+    if (xQueueSend(event_queue, &event, ticks_to_wait) != pdTRUE) {
+        pthread_mutex_lock(&loop_mutex);
+        events_pending--;
+        pthread_mutex_unlock(&loop_mutex);
+        free(event.data);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t host_event_loop_wait_idle(TickType_t ticks_to_wait) {
+    TickType_t start = xTaskGetTickCount();
+
+    /* Polling keeps the idle wait independent of the tick-based mock primitives and their clocks */
+    while (true) {
+        pthread_mutex_lock(&loop_mutex);
+        bool idle = (events_pending == 0);
+        pthread_mutex_unlock(&loop_mutex);
+        if (idle) return ESP_OK;
+        if ((ticks_to_wait != portMAX_DELAY) && ((xTaskGetTickCount() - start) >= ticks_to_wait)) {
+            return ESP_ERR_TIMEOUT;
+        }
+        vTaskDelay(1);
+    }
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static void event_loop_task(void* pvParameters) {
+    host_event_t event;
+    host_event_handler_t batch[HOST_EVENT_DISPATCH_BATCH];
+
+    while (true) {
+        if (!xQueueReceive(event_queue, &event, portMAX_DELAY)) continue;
+
+        /* Handlers are called outside of the lock so they can register, unregister and post events */
+        size_t count = 0;
+        pthread_mutex_lock(&loop_mutex);
+        for (size_t i = 0; (i < HOST_EVENT_MAX_HANDLERS) && (count < HOST_EVENT_DISPATCH_BATCH); i++) {
+            if (!handlers[i].in_use) continue;
+            if ((handlers[i].base != ESP_EVENT_ANY_BASE) && (handlers[i].base != event.base)) continue;
+            if ((handlers[i].id != ESP_EVENT_ANY_ID) && (handlers[i].id != event.id)) continue;
+            batch[count++] = handlers[i];
+        }
+        pthread_mutex_unlock(&loop_mutex);
+
+        for (size_t i = 0; i < count; i++) batch[i].handler(batch[i].arg, event.base, event.id, event.data);
+        free(event.data);
+
+        pthread_mutex_lock(&loop_mutex);
+        events_pending--;
+        pthread_mutex_unlock(&loop_mutex);
+    }
+}
+
+static esp_err_t add_handler(esp_event_base_t event_base, int32_t event_id, esp_event_handler_t event_handler,
+                             void* event_handler_arg, esp_event_handler_instance_t* instance) {
+    if (!event_handler) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&loop_mutex);
+    for (size_t i = 0; i < HOST_EVENT_MAX_HANDLERS; i++) {
+        if (handlers[i].in_use) continue;
+        handlers[i] = (host_event_handler_t){.in_use = true,
+                                             .base = event_base,
+                                             .id = event_id,
+                                             .handler = event_handler,
+                                             .arg = event_handler_arg};
+        if (instance) *instance = &handlers[i];
+        pthread_mutex_unlock(&loop_mutex);
+        return ESP_OK;
+    }
+    pthread_mutex_unlock(&loop_mutex);
+
+    return ESP_ERR_NO_MEM;
+}
@@ -0,0 +1,774 @@
+/**
+ * @file esp_http_client.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the ESP-IDF HTTP client over POSIX sockets and OpenSSL
+ *
+ * Connections stay open between performs on the same client unless the server sends "Connection: close" or the URL
+ * moves to another host, matching the connection reuse of the original client. A request on a reused connection that
+ * fails before any response byte arrives is retried once on a fresh connection, as the server may have closed an idle
+ * connection in the meantime.
+ */
+
+#define _GNU_SOURCE /* strcasestr() */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+#include "esp_http_client.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "host_mocks.h"
+
+static const char* tag = "host_http_client";
+
+#define HOST_HTTP_MAX_HEADERS 16    /**< Number of request headers that can be set */
+#define HOST_HTTP_BUFFER_SIZE 4096  /**< Receive buffer size */
+#define HOST_HTTP_LINE_SIZE 1024    /**< Maximum length of a status or header line */
+#define HOST_HTTP_REQUEST_SIZE 2048 /**< Maximum length of the request line and headers */
+
+/** @brief Request header set with esp_http_client_set_header() */
+typedef struct {
+    char* key;   /**< Header name */
+    char* value; /**< Header value */
+} host_http_header_t;
+
+/** @brief HTTP client instance */
+struct esp_http_client {
+    esp_http_client_config_t config; /**< Configuration, string members point to caller storage */
+
+    bool https;      /**< Scheme is https */
+    char* host;      /**< Host from the current URL */
+    int port;        /**< Port from the current URL */
+    char* path;      /**< Path and query from the current URL */
+    char* verify_cn; /**< Name the server certificate must match, NULL to skip */
+
+    host_http_header_t headers[HOST_HTTP_MAX_HEADERS]; /**< Request headers */
+    const char* post_data;                             /**< Request body, not copied like the original */
+    int post_len;                                      /**< Request body length */
+
+    int fd;           /**< Connected socket, -1 when closed */
+    SSL_CTX* ssl_ctx; /**< TLS context with the configured CA, created on first https connect */
+    SSL* ssl;         /**< TLS session on fd */
+    char* conn_host;  /**< Host the open connection was made to */
+    int conn_port;    /**< Port the open connection was made to */
+
+    uint8_t rx[HOST_HTTP_BUFFER_SIZE]; /**< Receive buffer */
+    size_t rx_pos;                     /**< Position of the next unread byte in rx */
+    size_t rx_len;                     /**< Number of valid bytes in rx */
+
+    int status_code;        /**< Status of the last response */
+    int64_t content_length; /**< Content-Length of the last response, -1 if not sent */
+};
+
+static pthread_once_t sigpipe_once = PTHREAD_ONCE_INIT;
+
+static pthread_mutex_t override_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint16_t port_override = 0; /**< Port connected to instead of the URL port, 0 when unset */
+static char* ca_override = NULL;   /**< Certificates trusted instead of the client cert_pem, NULL when unset */
+
+static pthread_mutex_t tls_stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+static host_tls_stats_t tls_stats; /**< Handshake timing of every client */
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Ignores SIGPIPE so writes to connections closed by the server return errors instead of ending the process
+ */
+static void ignore_sigpipe(void);
+
+/**
+ * @brief Calls the configured event handler
+ */
+static void dispatch_event(esp_http_client_handle_t client, esp_http_client_event_id_t event_id, void* data,
+                           int data_len, char* header_key, char* header_value);
+
+/**
+ * @brief Parses "scheme://host[:port][/path]" into the client
+ *
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG if the URL cannot be parsed or its host is an IP with a zero padded octet
+ */
+static esp_err_t parse_url(esp_http_client_handle_t client, const char* url);
+
+/**
+ * @brief Checks if a host is a dotted IPV4 address with an octet that has a leading zero
+ *
+ * @return true if lwIP would read an octet of the host as octal, which getaddrinfo() here would not show
+ */
+static bool host_has_octal_octet(const char* host, size_t host_len);
+
+/**
+ * @brief Opens a TCP (and TLS for https) connection to the current host
+ *
+ * @return ESP_OK or ESP_ERR_HTTP_CONNECT
+ */
+static esp_err_t open_connection(esp_http_client_handle_t client);
+
+/**
+ * @brief Closes the connection if open, dispatching HTTP_EVENT_DISCONNECTED
+ */
+static void close_connection(esp_http_client_handle_t client);
+
+/**
+ * @brief Creates the TLS context trusting the configured PEM certificates
+ *
+ * @return ESP_OK or ESP_ERR_HTTP_CONNECT
+ */
+static esp_err_t create_ssl_ctx(esp_http_client_handle_t client);
+
+/**
+ * @brief Writes all bytes to the connection
+ *
+ * @return true on success
+ */
+static bool conn_write(esp_http_client_handle_t client, const void* data, size_t length);
+
+/**
+ * @brief Fills the receive buffer if it is empty
+ *
+ * @return Number of buffered bytes available, 0 on connection close or error
+ */
+static size_t conn_fill(esp_http_client_handle_t client);
+
+/**
+ * @brief Reads a CRLF terminated line without the line ending
+ *
+ * @return true if a complete line was read
+ */
+static bool conn_read_line(esp_http_client_handle_t client, char* line, size_t size);
+
+/**
+ * @brief Reads up to length body bytes, dispatching them as HTTP_EVENT_ON_DATA
+ *
+ * @param[in] length Number of bytes to read, -1 to read until the connection closes
+ *
+ * @return true if all requested bytes were read
+ */
+static bool read_body(esp_http_client_handle_t client, int64_t length);
+
+/**
+ * @brief Sends the request and reads the full response on the open connection
+ *
+ * @param[out] p_received Set once any response byte was received
+ *
+ * @return ESP_OK or an ESP_ERR_HTTP_* error
+ */
+static esp_err_t request_once(esp_http_client_handle_t client, bool* p_received);
+
+/**
+ * @brief Returns the request line token for a method
+ */
+static const char* method_str(esp_http_client_method_t method);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t* config) {
+    if (!config) return NULL;
+    pthread_once(&sigpipe_once, ignore_sigpipe);
+
+    esp_http_client_handle_t client = calloc(1, sizeof(struct esp_http_client));
+    if (!client) return NULL;
+
+    client->config = *config;
+    client->fd = -1;
+    client->content_length = -1;
+    if (client->config.timeout_ms <= 0) client->config.timeout_ms = 5000;
+
+    esp_err_t err;
+    if (config->url) {
+        err = parse_url(client, config->url);
+    } else if (config->host) {
+        char url[HOST_HTTP_LINE_SIZE];
+        bool https = (config->transport_type == HTTP_TRANSPORT_OVER_SSL);
+        snprintf(url, sizeof(url), "%s://%s:%d%s", https ? "https" : "http", config->host,
+                 config->port ? config->port : (https ? 443 : 80), config->path ? config->path : "/");
+        err = parse_url(client, url);
+    } else {
+        err = ESP_ERR_INVALID_ARG;
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(tag, "Failed to parse URL");
+        esp_http_client_cleanup(client);
+        return NULL;
+    }
+
+    return client;
+}
+
+esp_err_t esp_http_client_perform(esp_http_client_handle_t client) {
+    if (!client) return ESP_ERR_INVALID_ARG;
+
+    /* A different host needs a different connection */
+    if ((client->fd >= 0) && ((client->conn_port != client->port) || strcmp(client->conn_host, client->host))) {
+        close_connection(client);
+    }
+
+    bool reused = (client->fd >= 0);
+    if (!reused) {
+        esp_err_t err = open_connection(client);
+        if (err != ESP_OK) {
+            dispatch_event(client, HTTP_EVENT_ERROR, NULL, 0, NULL, NULL);
+            return err;
+        }
+    }
+
+    bool received = false;
+    esp_err_t err = request_once(client, &received);
+
+    /* The server may have closed the idle connection since the previous request, retry once on a new connection */
+    if ((err != ESP_OK) && reused && !received) {
+        ESP_LOGD(tag, "Reused connection failed, reconnecting");
+        close_connection(client);
+        if ((err = open_connection(client)) == ESP_OK) err = request_once(client, &received);
+    }
+
+    if (err != ESP_OK) {
+        dispatch_event(client, HTTP_EVENT_ERROR, NULL, 0, NULL, NULL);
+        close_connection(client);
+    }
+
+    return err;
+}
+
+esp_err_t esp_http_client_set_url(esp_http_client_handle_t client, const char* url) {
+    if (!client || !url) return ESP_ERR_INVALID_ARG;
+    return parse_url(client, url);
+}
+
+esp_err_t esp_http_client_set_method(esp_http_client_handle_t client, esp_http_client_method_t method) {
+    if (!client) return ESP_ERR_INVALID_ARG;
+    client->config.method = method;
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t client, const char* key, const char* value) {
+    if (!client || !key || !value) return ESP_ERR_INVALID_ARG;
+
+    host_http_header_t* p_free = NULL;
+    for (size_t i = 0; i < HOST_HTTP_MAX_HEADERS; i++) {
+        host_http_header_t* p_header = &client->headers[i];
+        if (p_header->key && !strcasecmp(p_header->key, key)) {
+            char* copy = strdup(value);
+            if (!copy) return ESP_ERR_NO_MEM;
+            free(p_header->value);
+            p_header->value = copy;
+            return ESP_OK;
+        }
+        if (!p_header->key && !p_free) p_free = p_header;
+    }
+    if (!p_free) return ESP_ERR_NO_MEM;
+
+    p_free->key = strdup(key);
+    p_free->value = strdup(value);
+    if (!p_free->key || !p_free->value) {
+        free(p_free->key);
+        free(p_free->value);
+        *p_free = (host_http_header_t){0};
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_delete_header(esp_http_client_handle_t client, const char* key) {
+    if (!client || !key) return ESP_ERR_INVALID_ARG;
+
+    for (size_t i = 0; i < HOST_HTTP_MAX_HEADERS; i++) {
+        host_http_header_t* p_header = &client->headers[i];
+        if (p_header->key && !strcasecmp(p_header->key, key)) {
+            free(p_header->key);
+            free(p_header->value);
+            *p_header = (host_http_header_t){0};
+            return ESP_OK;
+        }
+    }
+
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t esp_http_client_set_post_field(esp_http_client_handle_t client, const char* data, int len) {
+    if (!client || (len < 0)) return ESP_ERR_INVALID_ARG;
+    client->post_data = data;
+    client->post_len = data ? len : 0;
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_timeout_ms(esp_http_client_handle_t client, int timeout_ms) {
+    if (!client || (timeout_ms <= 0)) return ESP_ERR_INVALID_ARG;
+    client->config.timeout_ms = timeout_ms;
+    return ESP_OK;
+}
+
+int esp_http_client_get_status_code(esp_http_client_handle_t client) { return client ? client->status_code : -1; }
+
+int64_t esp_http_client_get_content_length(esp_http_client_handle_t client) {
+    return client ? client->content_length : -1;
+}
+
+esp_err_t esp_http_client_close(esp_http_client_handle_t client) {
+    if (!client) return ESP_ERR_INVALID_ARG;
+    close_connection(client);
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client) {
+    if (!client) return ESP_ERR_INVALID_ARG;
+
+    close_connection(client);
+    if (client->ssl_ctx) SSL_CTX_free(client->ssl_ctx);
+    for (size_t i = 0; i < HOST_HTTP_MAX_HEADERS; i++) {
+        free(client->headers[i].key);
+        free(client->headers[i].value);
+    }
+    free(client->host);
+    free(client->path);
+    free(client->verify_cn);
+    free(client->conn_host);
+    free(client);
+
+    return ESP_OK;
+}
+
+void host_http_client_set_port_override(uint16_t port) {
+    pthread_mutex_lock(&override_mutex);
+    port_override = port;
+    pthread_mutex_unlock(&override_mutex);
+}
+
+void host_http_client_set_ca_override(const char* cert_pem) {
+    pthread_mutex_lock(&override_mutex);
+    free(ca_override);
+    ca_override = cert_pem ? strdup(cert_pem) : NULL;
+    pthread_mutex_unlock(&override_mutex);
+}
+
+void host_http_client_get_tls_stats(host_tls_stats_t* p_stats) {
+    pthread_mutex_lock(&tls_stats_mutex);
+    *p_stats = tls_stats;
+    pthread_mutex_unlock(&tls_stats_mutex);
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static void ignore_sigpipe(void) { signal(SIGPIPE, SIG_IGN); }
+
+static void dispatch_event(esp_http_client_handle_t client, esp_http_client_event_id_t event_id, void* data,
+                           int data_len, char* header_key, char* header_value) {
+    if (!client->config.event_handler) return;
+
+    esp_http_client_event_t evt = {.event_id = event_id,
+                                   .client = client,
+                                   .data = data,
+                                   .data_len = data_len,
+                                   .user_data = client->config.user_data,
+                                   .header_key = header_key,
+                                   .header_value = header_value};
+    client->config.event_handler(&evt);
+}
+
+static esp_err_t parse_url(esp_http_client_handle_t client, const char* url) {
+    const char* p_host;
+    bool https;
+    if (!strncasecmp(url, "https://", 8)) {
+        https = true;
+        p_host = url + 8;
+    } else if (!strncasecmp(url, "http://", 7)) {
+        https = false;
+        p_host = url + 7;
+    } else {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t host_len = strcspn(p_host, ":/?");
+    if (host_len == 0) return ESP_ERR_INVALID_ARG;
+    if (host_has_octal_octet(p_host, host_len)) return ESP_ERR_INVALID_ARG;
+
+    int port = https ? 443 : 80;
+    const char* p_rest = p_host + host_len;
+    if (*p_rest == ':') {
+        char* p_end;
+        long parsed = strtol(p_rest + 1, &p_end, 10);
+        if ((p_end == p_rest + 1) || (parsed <= 0) || (parsed > 65535)) return ESP_ERR_INVALID_ARG;
+        port = (int)parsed;
+        p_rest = p_end;
+    }
+
+    char* host = strndup(p_host, host_len);
+    char* path;
+    if (*p_rest == '/') {
+        path = strdup(p_rest);
+    } else if (*p_rest == '?') {
+        if ((path = malloc(strlen(p_rest) + 2))) sprintf(path, "/%s", p_rest);
+    } else {
+        path = strdup("/");
+    }
+
+    const char* cn = client->config.skip_cert_common_name_check
+                         ? NULL
+                         : (client->config.common_name ? client->config.common_name : host);
+    char* verify_cn = cn ? strdup(cn) : NULL;
+
+    if (!host || !path || (cn && !verify_cn)) {
+        free(host);
+        free(path);
+        free(verify_cn);
+        return ESP_ERR_NO_MEM;
+    }
+
+    free(client->host);
+    free(client->path);
+    free(client->verify_cn);
+    client->https = https;
+    client->host = host;
+    client->port = port;
+    client->path = path;
+    client->verify_cn = verify_cn;
+
+    return ESP_OK;
+}
+
+static bool host_has_octal_octet(const char* host, size_t host_len) {
+    if (strspn(host, "0123456789.") < host_len) return false;
+
+    /* Octets start at the host and after every '.', "0" alone is the decimal zero */
+    for (size_t i = 0; i + 1 < host_len; i++) {
+        if (((i == 0) || (host[i - 1] == '.')) && (host[i] == '0') && (host[i + 1] != '.')) return true;
+    }
+    return false;
+}
+
+static esp_err_t open_connection(esp_http_client_handle_t client) {
+    struct addrinfo hints = {.ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM};
+    struct addrinfo* p_result = NULL;
+    pthread_mutex_lock(&override_mutex);
+    int port = port_override ? port_override : client->port;
+    pthread_mutex_unlock(&override_mutex);
+    char port_str[8];
+    snprintf(port_str, sizeof(port_str), "%d", port);
+
+    if (getaddrinfo(client->host, port_str, &hints, &p_result) != 0) {
+        ESP_LOGE(tag, "Failed to resolve %s", client->host);
+        return ESP_ERR_HTTP_CONNECT;
+    }
+
+    int fd = -1;
+    for (struct addrinfo* p_addr = p_result; p_addr && (fd < 0); p_addr = p_addr->ai_next) {
+        fd = socket(p_addr->ai_family, p_addr->ai_socktype, p_addr->ai_protocol);
+        if (fd < 0) continue;
+
+        /* Non-blocking connect so the configured timeout also bounds connection establishment */
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        int rc = connect(fd, p_addr->ai_addr, p_addr->ai_addrlen);
+        if ((rc < 0) && (errno == EINPROGRESS)) {
+            struct pollfd pfd = {.fd = fd, .events = POLLOUT};
+            int so_error = 0;
+            socklen_t so_len = sizeof(so_error);
+            rc = ((poll(&pfd, 1, client->config.timeout_ms) == 1) &&
+                  (getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &so_len) == 0) && (so_error == 0))
+                     ? 0
+                     : -1;
+        }
+        if (rc < 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(p_result);
+
+    if (fd < 0) {
+        ESP_LOGE(tag, "Failed to connect to %s:%d", client->host, port);
+        return ESP_ERR_HTTP_CONNECT;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    struct timeval tv = {.tv_sec = client->config.timeout_ms / 1000,
+                         .tv_usec = (client->config.timeout_ms % 1000) * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (client->config.keep_alive_enable) setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one));
+
+    client->fd = fd;
+    client->rx_pos = 0;
+    client->rx_len = 0;
+
+    if (client->https) {
+        if (!client->ssl_ctx && (create_ssl_ctx(client) != ESP_OK)) {
+            close_connection(client);
+            return ESP_ERR_HTTP_CONNECT;
+        }
+
+        client->ssl = SSL_new(client->ssl_ctx);
+        if (!client->ssl) {
+            close_connection(client);
+            return ESP_ERR_HTTP_CONNECT;
+        }
+        SSL_set_fd(client->ssl, fd);
+        if (client->verify_cn) SSL_set1_host(client->ssl, client->verify_cn);
+
+        int64_t handshake_start_us = esp_timer_get_time();
+        if (SSL_connect(client->ssl) != 1) {
+            long verify = SSL_get_verify_result(client->ssl);
+            ESP_LOGE(tag, "TLS handshake with %s:%d failed: %s", client->host, client->port,
+                     (verify != X509_V_OK) ? X509_verify_cert_error_string(verify)
+                                           : ERR_reason_error_string(ERR_peek_last_error()));
+            ERR_clear_error();
+            close_connection(client);
+            return ESP_ERR_HTTP_CONNECT;
+        }
+
+        int64_t handshake_us = esp_timer_get_time() - handshake_start_us;
+        pthread_mutex_lock(&tls_stats_mutex);
+        tls_stats.handshakes++;
+        tls_stats.total_us += handshake_us;
+        if (handshake_us > tls_stats.max_us) tls_stats.max_us = handshake_us;
+        pthread_mutex_unlock(&tls_stats_mutex);
+    }
+
+    free(client->conn_host);
+    client->conn_host = strdup(client->host);
+    client->conn_port = client->port;
+
+    dispatch_event(client, HTTP_EVENT_ON_CONNECTED, NULL, 0, NULL, NULL);
+    return ESP_OK;
+}
+
+static void close_connection(esp_http_client_handle_t client) {
+    if (client->fd < 0) return;
+
+    if (client->ssl) {
+        SSL_shutdown(client->ssl);
+        SSL_free(client->ssl);
+        client->ssl = NULL;
+    }
+    close(client->fd);
+    client->fd = -1;
+    client->rx_pos = 0;
+    client->rx_len = 0;
+
+    dispatch_event(client, HTTP_EVENT_DISCONNECTED, NULL, 0, NULL, NULL);
+}
+
+static esp_err_t create_ssl_ctx(esp_http_client_handle_t client) {
+    pthread_mutex_lock(&override_mutex);
+    char* cert_pem = ca_override ? strdup(ca_override) : NULL;
+    pthread_mutex_unlock(&override_mutex);
+    if (!cert_pem && client->config.cert_pem) cert_pem = strdup(client->config.cert_pem);
+    if (!cert_pem) {
+        ESP_LOGE(tag, "No CA certificate configured for https");
+        return ESP_ERR_HTTP_CONNECT;
+    }
+
+    client->ssl_ctx = SSL_CTX_new(TLS_client_method());
+    if (!client->ssl_ctx) {
+        free(cert_pem);
+        return ESP_ERR_HTTP_CONNECT;
+    }
+    SSL_CTX_set_min_proto_version(client->ssl_ctx, TLS1_2_VERSION);
+    SSL_CTX_set_verify(client->ssl_ctx, SSL_VERIFY_PEER, NULL);
+
+    /* Every certificate in the PEM is trusted, like a CA chain passed to esp-tls */
+    BIO* bio = BIO_new_mem_buf(cert_pem, -1);
+    X509_STORE* store = SSL_CTX_get_cert_store(client->ssl_ctx);
+    size_t count = 0;
+    X509* cert;
+    while (bio && (cert = PEM_read_bio_X509(bio, NULL, NULL, NULL))) {
+        if (X509_STORE_add_cert(store, cert) == 1) count++;
+        X509_free(cert);
+    }
+    ERR_clear_error();
+    BIO_free(bio);
+    free(cert_pem);
+
+    if (count == 0) {
+        ESP_LOGE(tag, "No certificates could be parsed from cert_pem");
+        SSL_CTX_free(client->ssl_ctx);
+        client->ssl_ctx = NULL;
+        return ESP_ERR_HTTP_CONNECT;
+    }
+
+    return ESP_OK;
+}
+
+static bool conn_write(esp_http_client_handle_t client, const void* data, size_t length) {
+    const uint8_t* p_data = data;
+    while (length > 0) {
+        int written = client->ssl ? SSL_write(client->ssl, p_data, (int)length)
+                                  : (int)send(client->fd, p_data, length, MSG_NOSIGNAL);
+        if (written <= 0) {
+            if (!client->ssl && (written < 0) && (errno == EINTR)) continue;
+            return false;
+        }
+        p_data += written;
+        length -= written;
+    }
+    return true;
+}
+
+static size_t conn_fill(esp_http_client_handle_t client) {
+    if (client->rx_pos < client->rx_len) return client->rx_len - client->rx_pos;
+
+    int received;
+    do {
+        received = client->ssl ? SSL_read(client->ssl, client->rx, sizeof(client->rx))
+                               : (int)recv(client->fd, client->rx, sizeof(client->rx), 0);
+    } while (!client->ssl && (received < 0) && (errno == EINTR));
+
+    client->rx_pos = 0;
+    client->rx_len = (received > 0) ? (size_t)received : 0;
+    return client->rx_len;
+}
+
+static bool conn_read_line(esp_http_client_handle_t client, char* line, size_t size) {
+    size_t length = 0;
+    while (true) {
+        if (conn_fill(client) == 0) return false;
+
+        char c = (char)client->rx[client->rx_pos++];
+        if (c == '\n') break;
+        if (length + 1 >= size) return false;
+        line[length++] = c;
+    }
+    if ((length > 0) && (line[length - 1] == '\r')) length--;
+    line[length] = '\0';
+    return true;
+}
+
+static bool read_body(esp_http_client_handle_t client, int64_t length) {
+    while (length != 0) {
+        size_t available = conn_fill(client);
+        if (available == 0) return (length < 0);
+
+        size_t chunk = ((length > 0) && ((int64_t)available > length)) ? (size_t)length : available;
+        dispatch_event(client, HTTP_EVENT_ON_DATA, client->rx + client->rx_pos, (int)chunk, NULL, NULL);
+        client->rx_pos += chunk;
+        if (length > 0) length -= chunk;
+    }
+    return true;
+}
+
+static esp_err_t request_once(esp_http_client_handle_t client, bool* p_received) {
+    char request[HOST_HTTP_REQUEST_SIZE];
+    bool has_body = (client->config.method != HTTP_METHOD_GET) && (client->config.method != HTTP_METHOD_HEAD);
+
+    int length = snprintf(request, sizeof(request),
+                          "%s %s HTTP/1.1\r\nHost: %s\r\nUser-Agent: ESP32 HTTP Client/1.0\r\n",
+                          method_str(client->config.method), client->path, client->host);
+    if (has_body) {
+        length += snprintf(request + length, sizeof(request) - length, "Content-Length: %d\r\n", client->post_len);
+    }
+    for (size_t i = 0; (i < HOST_HTTP_MAX_HEADERS) && (length < (int)sizeof(request)); i++) {
+        if (!client->headers[i].key) continue;
+        length += snprintf(request + length, sizeof(request) - length, "%s: %s\r\n", client->headers[i].key,
+                           client->headers[i].value);
+    }
+    if (length < (int)sizeof(request)) length += snprintf(request + length, sizeof(request) - length, "\r\n");
+    if (length >= (int)sizeof(request)) {
+        ESP_LOGE(tag, "Request headers too long");
+        return ESP_ERR_HTTP_WRITE_DATA;
+    }
+
+    if (!conn_write(client, request, length) ||
+        (has_body && client->post_len && !conn_write(client, client->post_data, client->post_len))) {
+        return ESP_ERR_HTTP_WRITE_DATA;
+    }
+    dispatch_event(client, HTTP_EVENT_HEADERS_SENT, NULL, 0, NULL, NULL);
+
+    /* Status line */
+    char line[HOST_HTTP_LINE_SIZE];
+    client->status_code = -1;
+    client->content_length = -1;
+    if (!conn_read_line(client, line, sizeof(line))) return ESP_ERR_HTTP_FETCH_HEADER;
+    *p_received = true;
+    if (sscanf(line, "HTTP/%*d.%*d %d", &client->status_code) != 1) {
+        ESP_LOGE(tag, "Malformed status line \"%s\"", line);
+        return ESP_ERR_HTTP_FETCH_HEADER;
+    }
+
+    /* Headers */
+    bool chunked = false;
+    bool close_after = false;
+    while (true) {
+        if (!conn_read_line(client, line, sizeof(line))) return ESP_ERR_HTTP_FETCH_HEADER;
+        if (line[0] == '\0') break;
+
+        char* p_value = strchr(line, ':');
+        if (!p_value) continue;
+        *p_value++ = '\0';
+        while (*p_value == ' ') p_value++;
+
+        if (!strcasecmp(line, "Content-Length")) client->content_length = strtoll(p_value, NULL, 10);
+        if (!strcasecmp(line, "Transfer-Encoding") && strcasestr(p_value, "chunked")) chunked = true;
+        if (!strcasecmp(line, "Connection") && strcasestr(p_value, "close")) close_after = true;
+        dispatch_event(client, HTTP_EVENT_ON_HEADER, NULL, 0, line, p_value);
+    }
+
+    /* Body */
+    bool no_body = (client->config.method == HTTP_METHOD_HEAD) || (client->status_code == 204) ||
+                   (client->status_code == 304) || (client->status_code < 200);
+    if (no_body) {
+        /* Nothing to read */
+    } else if (chunked) {
+        while (true) {
+            if (!conn_read_line(client, line, sizeof(line))) return ESP_ERR_HTTP_FETCH_HEADER;
+            int64_t chunk = strtoll(line, NULL, 16);
+            if (chunk <= 0) break;
+            if (!read_body(client, chunk) || !conn_read_line(client, line, sizeof(line))) {
+                return ESP_ERR_HTTP_FETCH_HEADER;
+            }
+        }
+        /* Trailers up to the final empty line */
+        while (conn_read_line(client, line, sizeof(line)) && (line[0] != '\0')) {
+        }
+    } else if (client->content_length >= 0) {
+        if (!read_body(client, client->content_length)) return ESP_ERR_HTTP_FETCH_HEADER;
+    } else {
+        read_body(client, -1);
+        close_after = true;
+    }
+
+    dispatch_event(client, HTTP_EVENT_ON_FINISH, NULL, 0, NULL, NULL);
+    if (close_after) close_connection(client);
+
+    return ESP_OK;
+}
+
+static const char* method_str(esp_http_client_method_t method) {
+    switch (method) {
+        case HTTP_METHOD_POST:
+            return "POST";
+        case HTTP_METHOD_PUT:
+            return "PUT";
+        case HTTP_METHOD_PATCH:
+            return "PATCH";
+        case HTTP_METHOD_DELETE:
+            return "DELETE";
+        case HTTP_METHOD_HEAD:
+            return "HEAD";
+        default:
+            return "GET";
+    }
+}
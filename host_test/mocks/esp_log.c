@@ -0,0 +1,96 @@
+/**
+ * @file esp_log.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF logging and error name functions
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_log.h"
+
+#define HOST_LOG_MAX_TAGS 32
+
+/** @brief Log level override for a single tag */
+typedef struct {
+    const char* tag;
+    esp_log_level_t level;
+} host_log_tag_level_t;
+
+static host_log_tag_level_t tag_levels[HOST_LOG_MAX_TAGS];
+static size_t tag_level_count = 0;
+static esp_log_level_t default_level = ESP_LOG_WARN;
+
+void esp_log_level_set(const char* tag, esp_log_level_t level) {
+    if (strcmp(tag, "*") == 0) {
+        default_level = level;
+        tag_level_count = 0;
+        return;
+    }
+
+    for (size_t i = 0; i < tag_level_count; i++) {
+        if (strcmp(tag_levels[i].tag, tag) == 0) {
+            tag_levels[i].level = level;
+            return;
+        }
+    }
+
+    if (tag_level_count < HOST_LOG_MAX_TAGS) {
+        tag_levels[tag_level_count].tag = tag;
+        tag_levels[tag_level_count].level = level;
+        tag_level_count++;
+    }
+}
+
+esp_log_level_t esp_log_level_get(const char* tag) {
+    for (size_t i = 0; i < tag_level_count; i++) {
+        if (strcmp(tag_levels[i].tag, tag) == 0) return tag_levels[i].level;
+    }
+    return default_level;
+}
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+const char* esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK:
+            return "ESP_OK";
+        case ESP_FAIL:
+            return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:
+            return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:
+            return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE:
+            return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:
+            return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:
+            return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED:
+            return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT:
+            return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_INVALID_RESPONSE:
+            return "ESP_ERR_INVALID_RESPONSE";
+        case ESP_ERR_INVALID_CRC:
+            return "ESP_ERR_INVALID_CRC";
+        case ESP_ERR_INVALID_VERSION:
+            return "ESP_ERR_INVALID_VERSION";
+        case ESP_ERR_INVALID_MAC:
+            return "ESP_ERR_INVALID_MAC";
+        case ESP_ERR_NOT_FINISHED:
+            return "ESP_ERR_NOT_FINISHED";
+        case ESP_ERR_NOT_ALLOWED:
+            return "ESP_ERR_NOT_ALLOWED";
+        default:
+            return "UNKNOWN ERROR";
+    }
+}
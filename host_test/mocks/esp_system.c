@@ -0,0 +1,35 @@
+/**
+ * @file esp_system.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF system and timer functions
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "esp_system.h"
+#include "esp_timer.h"
+
+static int64_t start_us = 0; /**< Monotonic time of process start, treated as boot */
+
+/**
+ * @brief Records the process start time before main() so esp_timer_get_time() counts from "boot"
+ */
+__attribute__((constructor)) static void record_start(void) {
+    start_us = 0;
+    start_us = esp_timer_get_time();
+}
+
+int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000) - start_us;
+}
+
+void esp_restart(void) {
+    fprintf(stderr, "esp_restart() called, exiting with %d\n", HOST_RESTART_EXIT_CODE);
+    fflush(NULL);
+    _Exit(HOST_RESTART_EXIT_CODE);
+}
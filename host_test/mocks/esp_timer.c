@@ -0,0 +1,219 @@
+/**
+ * @file esp_timer.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF high resolution timers, dispatched from one timer thread like the esp_timer task
+ *
+ * Expiries are kept in microseconds on CLOCK_MONOTONIC, the same clock as esp_timer_get_time(), so periodic timers
+ * keep their period without drifting by the callback run time.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "esp_timer.h"
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief High resolution timer, linked into the timer list */
+struct esp_timer {
+    struct esp_timer* next;       /**< Next timer in the timer list */
+    esp_timer_create_args_t args; /**< Configuration, the name points to caller storage */
+    bool active;                  /**< Timer is running */
+    uint64_t period_us;           /**< Period of a periodic timer, 0 for a one-shot timer */
+    int64_t expiry_us;            /**< Monotonic time of the next expiry */
+};
+
+static pthread_once_t timer_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t timer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t timer_changed;    /**< Broadcast when a timer starts, stops or is deleted, or a callback ends */
+static pthread_t timer_thread;          /**< Thread dispatching every callback */
+static struct esp_timer* timer_list;    /**< Every created timer */
+static struct esp_timer* timer_running; /**< Timer whose callback is running, NULL between callbacks */
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Returns CLOCK_MONOTONIC in microseconds, unlike esp_timer_get_time() not offset by process start
+ */
+static int64_t monotonic_us(void);
+
+/**
+ * @brief Creates the timer thread on first use
+ */
+static void timer_thread_init(void);
+
+/**
+ * @brief Dispatches callbacks of expired timers in expiry order
+ */
+static void* timer_thread_main(void* arg);
+
+/**
+ * @brief Starts a timer, replacing an earlier start
+ */
+static esp_err_t timer_start(esp_timer_handle_t timer, uint64_t timeout_us, uint64_t period_us);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* create_args, esp_timer_handle_t* out_handle) {
+    if (!create_args || !create_args->callback || !out_handle) return ESP_ERR_INVALID_ARG;
+
+    pthread_once(&timer_once, timer_thread_init);
+
+    struct esp_timer* p_timer = calloc(1, sizeof(struct esp_timer));
+    if (!p_timer) return ESP_ERR_NO_MEM;
+    p_timer->args = *create_args;
+
+    pthread_mutex_lock(&timer_mutex);
+    p_timer->next = timer_list;
+    timer_list = p_timer;
+    pthread_mutex_unlock(&timer_mutex);
+
+    *out_handle = p_timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+    return timer_start(timer, timeout_us, 0);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period) {
+    if (period == 0) return ESP_ERR_INVALID_ARG;
+    return timer_start(timer, period, period);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&timer_mutex);
+    bool was_active = timer->active;
+    timer->active = false;
+    pthread_cond_broadcast(&timer_changed);
+    pthread_mutex_unlock(&timer_mutex);
+
+    return was_active ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    if (!timer) return ESP_OK;
+
+    pthread_mutex_lock(&timer_mutex);
+    if (timer->active) {
+        pthread_mutex_unlock(&timer_mutex);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Once deleted the callback's argument may be freed, so a callback still running must finish first */
+    while ((timer_running == timer) && !pthread_equal(pthread_self(), timer_thread)) {
+        pthread_cond_wait(&timer_changed, &timer_mutex);
+    }
+    for (struct esp_timer** pp_timer = &timer_list; *pp_timer; pp_timer = &(*pp_timer)->next) {
+        if (*pp_timer == timer) {
+            *pp_timer = timer->next;
+            break;
+        }
+    }
+    if (timer_running == timer) timer_running = NULL;
+    pthread_mutex_unlock(&timer_mutex);
+
+    free(timer);
+    return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer) {
+    if (!timer) return false;
+
+    pthread_mutex_lock(&timer_mutex);
+    bool active = timer->active;
+    pthread_mutex_unlock(&timer_mutex);
+    return active;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static int64_t monotonic_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void timer_thread_init(void) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timer_changed, &attr);
+    pthread_condattr_destroy(&attr);
+
+    pthread_create(&timer_thread, NULL, timer_thread_main, NULL);
+    pthread_detach(timer_thread);
+}
+
+static void* timer_thread_main(void* arg) {
+    pthread_mutex_lock(&timer_mutex);
+    while (true) {
+        /* Find the next timer to expire */
+        struct esp_timer* p_next = NULL;
+        for (struct esp_timer* p_timer = timer_list; p_timer; p_timer = p_timer->next) {
+            if (p_timer->active && (!p_next || (p_timer->expiry_us < p_next->expiry_us))) p_next = p_timer;
+        }
+
+        if (!p_next) {
+            pthread_cond_wait(&timer_changed, &timer_mutex);
+            continue;
+        }
+
+        int64_t now_us = monotonic_us();
+        if (p_next->expiry_us > now_us) {
+            struct timespec deadline = {.tv_sec = p_next->expiry_us / 1000000,
+                                        .tv_nsec = (long)(p_next->expiry_us % 1000000) * 1000};
+            pthread_cond_timedwait(&timer_changed, &timer_mutex, &deadline);
+            continue;
+        }
+
+        /* Periodic timers advance from the expiry rather than now, skipping whole periods already missed if asked */
+        if (p_next->period_us) {
+            p_next->expiry_us += p_next->period_us;
+            if (p_next->args.skip_unhandled_events && (p_next->expiry_us <= now_us)) {
+                p_next->expiry_us += ((now_us - p_next->expiry_us) / p_next->period_us + 1) * p_next->period_us;
+            }
+        } else {
+            p_next->active = false;
+        }
+
+        /* Callbacks run without the lock so they can start, stop and delete timers */
+        timer_running = p_next;
+        pthread_mutex_unlock(&timer_mutex);
+        p_next->args.callback(p_next->args.arg);
+        pthread_mutex_lock(&timer_mutex);
+        timer_running = NULL;
+        pthread_cond_broadcast(&timer_changed);
+    }
+    return NULL;
+}
+
+static esp_err_t timer_start(esp_timer_handle_t timer, uint64_t timeout_us, uint64_t period_us) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&timer_mutex);
+    if (timer->active) {
+        pthread_mutex_unlock(&timer_mutex);
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->active = true;
+    timer->period_us = period_us;
+    timer->expiry_us = monotonic_us() + (int64_t)timeout_us;
+    pthread_cond_broadcast(&timer_changed);
+    pthread_mutex_unlock(&timer_mutex);
+
+    return ESP_OK;
+}
@@ -0,0 +1,308 @@
+/**
+ * @file esp_wifi.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the ESP-IDF WiFi station driver and station netif
+ *
+ * Each esp_wifi_connect() runs a short-lived task that waits out the simulated association and DHCP times and then
+ * posts the same WIFI_EVENT and IP_EVENT sequence as the real driver. Any disconnect, stop or new attempt invalidates
+ * attempts already in flight.
+ */
+
+#include <pthread.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "esp_netif.h"
+#include "esp_wifi.h"
+#include "host_mocks.h"
+
+static const char* tag = "host_wifi";
+
+ESP_EVENT_DEFINE_BASE(WIFI_EVENT);
+ESP_EVENT_DEFINE_BASE(IP_EVENT);
+
+/** @brief Station network interface */
+struct esp_netif_obj {
+    bool dhcpc_stopped;             /**< Static IP in use */
+    esp_netif_ip_info_t ip_info;    /**< Current or static IP information */
+};
+
+static pthread_mutex_t wifi_mutex = PTHREAD_MUTEX_INITIALIZER;
+static host_wifi_ap_t ap = {.present = true,
+                            .bssid = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01},
+                            .channel = 6,
+                            .associate_ms = 20,
+                            .dhcp_ms = 10,
+                            .ip = 0x3201A8C0}; /* 192.168.1.50 */
+static struct esp_netif_obj sta_netif;
+static wifi_config_t sta_config;
+static bool initialized = false;
+static bool started = false;
+static bool associated = false;
+static uint32_t generation = 0;   /**< Incremented to invalidate attempts in flight */
+static uint32_t connect_count = 0;
+static uint32_t init_count = 0;
+static uint32_t last_ip = 0;
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Task simulating a single connection attempt
+ *
+ * @param[in] pvParameters Generation of the attempt cast to a pointer
+ */
+static void attempt_task(void* pvParameters);
+
+/**
+ * @brief Posts WIFI_EVENT_STA_DISCONNECTED, must be called with the mutex held
+ *
+ * @param[in] reason Disconnect reason
+ */
+static void post_disconnected(wifi_err_reason_t reason);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+esp_err_t esp_netif_init(void) { return ESP_OK; }
+
+esp_netif_t* esp_netif_create_default_wifi_sta(void) { return &sta_netif; }
+
+esp_err_t esp_netif_dhcpc_stop(esp_netif_t* esp_netif) {
+    if (!esp_netif) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&wifi_mutex);
+    esp_netif->dhcpc_stopped = true;
+    pthread_mutex_unlock(&wifi_mutex);
+    return ESP_OK;
+}
+
+esp_err_t esp_netif_set_ip_info(esp_netif_t* esp_netif, const esp_netif_ip_info_t* ip_info) {
+    if (!esp_netif || !ip_info) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&wifi_mutex);
+    esp_netif->ip_info = *ip_info;
+    pthread_mutex_unlock(&wifi_mutex);
+    return ESP_OK;
+}
+
+esp_err_t esp_netif_get_ip_info(esp_netif_t* esp_netif, esp_netif_ip_info_t* ip_info) {
+    if (!esp_netif || !ip_info) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&wifi_mutex);
+    *ip_info = esp_netif->ip_info;
+    pthread_mutex_unlock(&wifi_mutex);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_init(const wifi_init_config_t* config) {
+    if (!config) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&wifi_mutex);
+    initialized = true;
+    init_count++;
+    pthread_mutex_unlock(&wifi_mutex);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_deinit(void) {
+    pthread_mutex_lock(&wifi_mutex);
+    esp_err_t err = initialized ? ESP_OK : ESP_ERR_WIFI_NOT_INIT;
+    initialized = false;
+    started = false;
+    generation++;
+    pthread_mutex_unlock(&wifi_mutex);
+    return err;
+}
+
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode) {
+    pthread_mutex_lock(&wifi_mutex);
+    esp_err_t err = initialized ? ESP_OK : ESP_ERR_WIFI_NOT_INIT;
+    pthread_mutex_unlock(&wifi_mutex);
+    return err;
+}
+
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t* conf) {
+    if (!conf) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&wifi_mutex);
+    esp_err_t err = initialized ? ESP_OK : ESP_ERR_WIFI_NOT_INIT;
+    if (err == ESP_OK) sta_config = *conf;
+    pthread_mutex_unlock(&wifi_mutex);
+    return err;
+}
+
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t* conf) {
+    if (!conf) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&wifi_mutex);
+    esp_err_t err = initialized ? ESP_OK : ESP_ERR_WIFI_NOT_INIT;
+    if (err == ESP_OK) *conf = sta_config;
+    pthread_mutex_unlock(&wifi_mutex);
+    return err;
+}
+
+esp_err_t esp_wifi_set_ps(wifi_ps_type_t type) { return ESP_OK; }
+
+esp_err_t esp_wifi_start(void) {
+    pthread_mutex_lock(&wifi_mutex);
+    esp_err_t err = initialized ? ESP_OK : ESP_ERR_WIFI_NOT_INIT;
+    if ((err == ESP_OK) && !started) {
+        started = true;
+        esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_START, NULL, 0, portMAX_DELAY);
+    }
+    pthread_mutex_unlock(&wifi_mutex);
+    return err;
+}
+
+esp_err_t esp_wifi_stop(void) {
+    pthread_mutex_lock(&wifi_mutex);
+    esp_err_t err = initialized ? ESP_OK : ESP_ERR_WIFI_NOT_INIT;
+    if ((err == ESP_OK) && started) {
+        generation++;
+        if (associated) post_disconnected(WIFI_REASON_ASSOC_LEAVE);
+        associated = false;
+        started = false;
+        esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_STOP, NULL, 0, portMAX_DELAY);
+    }
+    pthread_mutex_unlock(&wifi_mutex);
+    return err;
+}
+
+esp_err_t esp_wifi_connect(void) {
+    pthread_mutex_lock(&wifi_mutex);
+    esp_err_t err = !initialized ? ESP_ERR_WIFI_NOT_INIT : (!started ? ESP_ERR_WIFI_NOT_STARTED : ESP_OK);
+    if (err == ESP_OK) {
+        connect_count++;
+        uint32_t attempt = ++generation;
+        if (xTaskCreate(attempt_task, "host_wifi", 2048, (void*)(uintptr_t)attempt, 23, NULL) != pdPASS) {
+            err = ESP_ERR_NO_MEM;
+        }
+    }
+    pthread_mutex_unlock(&wifi_mutex);
+    return err;
+}
+
+esp_err_t esp_wifi_disconnect(void) {
+    pthread_mutex_lock(&wifi_mutex);
+    esp_err_t err = !initialized ? ESP_ERR_WIFI_NOT_INIT : (!started ? ESP_ERR_WIFI_NOT_STARTED : ESP_OK);
+    if (err == ESP_OK) {
+        generation++;
+        post_disconnected(WIFI_REASON_ASSOC_LEAVE);
+        associated = false;
+    }
+    pthread_mutex_unlock(&wifi_mutex);
+    return err;
+}
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t* ap_info) {
+    if (!ap_info) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&wifi_mutex);
+    esp_err_t err = associated ? ESP_OK : ESP_ERR_WIFI_NOT_CONNECT;
+    if (err == ESP_OK) {
+        memset(ap_info, 0, sizeof(wifi_ap_record_t));
+        memcpy(ap_info->bssid, ap.bssid, sizeof(ap.bssid));
+        memcpy(ap_info->ssid, sta_config.sta.ssid, sizeof(sta_config.sta.ssid));
+        ap_info->primary = ap.channel;
+        ap_info->rssi = -50;
+    }
+    pthread_mutex_unlock(&wifi_mutex);
+    return err;
+}
+
+void host_wifi_sim_set_ap(const host_wifi_ap_t* p_ap) {
+    pthread_mutex_lock(&wifi_mutex);
+    ap = *p_ap;
+    pthread_mutex_unlock(&wifi_mutex);
+}
+
+void host_wifi_sim_drop(wifi_err_reason_t reason) {
+    pthread_mutex_lock(&wifi_mutex);
+    if (associated) {
+        generation++;
+        associated = false;
+        post_disconnected(reason);
+    }
+    pthread_mutex_unlock(&wifi_mutex);
+}
+
+void host_wifi_sim_get_counts(uint32_t* p_connects, uint32_t* p_inits) {
+    pthread_mutex_lock(&wifi_mutex);
+    if (p_connects) *p_connects = connect_count;
+    if (p_inits) *p_inits = init_count;
+    pthread_mutex_unlock(&wifi_mutex);
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static void attempt_task(void* pvParameters) {
+    uint32_t attempt = (uint32_t)(uintptr_t)pvParameters;
+
+    pthread_mutex_lock(&wifi_mutex);
+    uint32_t associate_ms = ap.associate_ms;
+    pthread_mutex_unlock(&wifi_mutex);
+    vTaskDelay(pdMS_TO_TICKS(associate_ms));
+
+    pthread_mutex_lock(&wifi_mutex);
+    if (attempt != generation) {
+        pthread_mutex_unlock(&wifi_mutex);
+        vTaskDelete(NULL);
+    }
+
+    /* Directed connects only find the AP with the configured BSSID on the configured channel */
+    wifi_err_reason_t reason = 0;
+    if (!ap.present || (sta_config.sta.bssid_set && memcmp(sta_config.sta.bssid, ap.bssid, sizeof(ap.bssid))) ||
+        (sta_config.sta.channel && (sta_config.sta.channel != ap.channel))) {
+        reason = WIFI_REASON_NO_AP_FOUND;
+    } else if (ap.fail_attempts > 0) {
+        ap.fail_attempts--;
+        reason = ap.fail_reason ? ap.fail_reason : WIFI_REASON_AUTH_EXPIRE;
+    }
+
+    if (reason) {
+        ESP_LOGD(tag, "Simulated attempt failed with reason %d", reason);
+        post_disconnected(reason);
+        pthread_mutex_unlock(&wifi_mutex);
+        vTaskDelete(NULL);
+    }
+
+    associated = true;
+    wifi_event_sta_connected_t connected = {.channel = ap.channel, .authmode = sta_config.sta.threshold.authmode};
+    memcpy(connected.ssid, sta_config.sta.ssid, sizeof(connected.ssid));
+    connected.ssid_len = strnlen((const char*)sta_config.sta.ssid, sizeof(sta_config.sta.ssid));
+    memcpy(connected.bssid, ap.bssid, sizeof(ap.bssid));
+    esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, &connected, sizeof(connected), portMAX_DELAY);
+    uint32_t dhcp_ms = sta_netif.dhcpc_stopped ? 0 : ap.dhcp_ms;
+    pthread_mutex_unlock(&wifi_mutex);
+
+    vTaskDelay(pdMS_TO_TICKS(dhcp_ms));
+
+    pthread_mutex_lock(&wifi_mutex);
+    if ((attempt == generation) && associated) {
+        ip_event_got_ip_t got_ip = {.esp_netif = &sta_netif};
+        if (sta_netif.dhcpc_stopped) {
+            got_ip.ip_info = sta_netif.ip_info;
+        } else {
+            got_ip.ip_info.ip.addr = ap.ip;
+            got_ip.ip_info.netmask.addr = 0x00FFFFFF;
+            got_ip.ip_info.gw.addr = (ap.ip & 0x00FFFFFF) | 0x01000000;
+            sta_netif.ip_info = got_ip.ip_info;
+        }
+        got_ip.ip_changed = (last_ip != 0) && (last_ip != got_ip.ip_info.ip.addr);
+        last_ip = got_ip.ip_info.ip.addr;
+        esp_event_post(IP_EVENT, IP_EVENT_STA_GOT_IP, &got_ip, sizeof(got_ip), portMAX_DELAY);
+    }
+    pthread_mutex_unlock(&wifi_mutex);
+
+    vTaskDelete(NULL);
+}
+
+static void post_disconnected(wifi_err_reason_t reason) {
+    wifi_event_sta_disconnected_t disconnected = {.reason = reason, .rssi = -90};
+    memcpy(disconnected.ssid, sta_config.sta.ssid, sizeof(disconnected.ssid));
+    disconnected.ssid_len = strnlen((const char*)sta_config.sta.ssid, sizeof(sta_config.sta.ssid));
+    if (sta_config.sta.bssid_set) memcpy(disconnected.bssid, sta_config.sta.bssid, sizeof(disconnected.bssid));
+    esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, &disconnected, sizeof(disconnected), portMAX_DELAY);
+}
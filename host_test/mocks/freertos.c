@@ -0,0 +1,703 @@
+/**
+ * @file freertos.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the FreeRTOS primitives used by the components, implemented with POSIX threads
+ *
+ * Blocking calls use CLOCK_MONOTONIC deadlines derived from the tick timeout (one tick per millisecond), and every
+ * wait releases its mutex on thread cancellation so that vTaskDelete() of a blocked task does not deadlock others.
+ */
+
+#define _GNU_SOURCE /* pthread_attr_setaffinity_np(), CPU_SET() */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Host thread running a FreeRTOS task function */
+struct host_task {
+    pthread_t thread;         /**< Thread running the task */
+    char name[16];            /**< Task name, truncated like configMAX_TASK_NAME_LEN */
+    TaskFunction_t function;  /**< Task function */
+    void* parameters;         /**< Task function argument */
+    UBaseType_t priority;     /**< Requested priority, not applied */
+    BaseType_t core_id;       /**< Requested core affinity, applied as a host CPU by pin_to_host_cpu() */
+    uint32_t stack_depth;     /**< Requested stack depth */
+    struct host_task* next;   /**< Next created task */
+};
+
+/** @brief Ring buffer of fixed size items */
+struct host_queue {
+    pthread_mutex_t mutex;  /**< Protects all fields */
+    pthread_cond_t changed; /**< Signalled whenever an item is added or removed */
+    uint8_t* storage;       /**< length * item_size bytes of item storage */
+    UBaseType_t length;     /**< Maximum number of items */
+    UBaseType_t item_size;  /**< Size of each item in bytes */
+    UBaseType_t head;       /**< Index of the oldest item */
+    UBaseType_t count;      /**< Number of items stored */
+};
+
+/** @brief Counting semaphore, also used for mutexes and binary semaphores */
+struct host_semaphore {
+    pthread_mutex_t mutex;  /**< Protects count */
+    pthread_cond_t changed; /**< Signalled on every give */
+    UBaseType_t count;      /**< Current count */
+    UBaseType_t max_count;  /**< Count limit */
+};
+
+/** @brief Event group bits */
+struct host_event_group {
+    pthread_mutex_t mutex;  /**< Protects bits */
+    pthread_cond_t changed; /**< Broadcast whenever bits are set */
+    EventBits_t bits;       /**< Current bits */
+};
+
+/** @brief Software timer, linked into the timer service list */
+struct host_timer {
+    struct host_timer* next;          /**< Next timer in the service list */
+    char name[16];                    /**< Timer name */
+    TickType_t period;                /**< Period in ticks */
+    bool auto_reload;                 /**< Restart after expiring */
+    void* id;                         /**< Timer ID */
+    TimerCallbackFunction_t callback; /**< Called from the timer service thread on expiry */
+    bool active;                      /**< Timer is running */
+    bool deleted;                     /**< Delete was requested while the callback was running */
+    int64_t expiry_ms;                /**< Monotonic time of the next expiry */
+};
+
+/*====================================================================================================================*/
+/*================================================= Private Variables ================================================*/
+/*====================================================================================================================*/
+
+static __thread struct host_task* current_task = NULL; /**< Task running on the calling thread, NULL for main */
+
+/* Tasks are never freed so handles of deleted tasks stay valid, the list keeps them reachable */
+static pthread_mutex_t task_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct host_task* task_list = NULL; /**< All created tasks, newest first */
+
+static pthread_once_t timer_service_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t timer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t timer_changed;
+static struct host_timer* timer_list = NULL;    /**< All created timers */
+static struct host_timer* timer_running = NULL; /**< Timer whose callback is currently executing */
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Returns CLOCK_MONOTONIC time in milliseconds
+ */
+static int64_t monotonic_ms(void);
+
+/**
+ * @brief Initializes a condition variable that waits against CLOCK_MONOTONIC
+ *
+ * @param[out] p_cond Condition variable to initialize
+ */
+static void cond_init_monotonic(pthread_cond_t* p_cond);
+
+/**
+ * @brief Waits on a condition variable until signalled or the tick timeout from start_ms has passed
+ *
+ * @param[in] p_cond Condition variable to wait on
+ * @param[in] p_mutex Locked mutex protecting the condition
+ * @param[in] start_ms monotonic_ms() when the blocking call started
+ * @param[in] ticks Tick timeout, portMAX_DELAY to wait forever
+ *
+ * @return false once the timeout has expired, true otherwise
+ */
+static bool cond_wait_ticks(pthread_cond_t* p_cond, pthread_mutex_t* p_mutex, int64_t start_ms, TickType_t ticks);
+
+/**
+ * @brief Cancellation cleanup handler unlocking the mutex passed as argument
+ */
+static void unlock_mutex(void* p_mutex);
+
+/**
+ * @brief Thread entry running a task function
+ */
+static void* task_entry(void* arg);
+
+/**
+ * @brief Copies an item into a queue that has room, must be called with the queue mutex held
+ */
+static void queue_push(QueueHandle_t xQueue, const void* pvItemToQueue, bool front);
+
+/**
+ * @brief Common implementation of xQueueSendToBack() and xQueueSendToFront()
+ */
+static BaseType_t queue_send(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait, bool front);
+
+/**
+ * @brief Common implementation of xQueueReceive() and xQueuePeek()
+ */
+static BaseType_t queue_receive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait, bool remove);
+
+/**
+ * @brief Restricts a thread to one host CPU standing in for a core, core N runs on the Nth CPU the process may use
+ * (wrapping around), so tasks pinned to different cores only run in parallel on hosts with more than one CPU
+ *
+ * @return 0 on success, an errno value otherwise
+ */
+static int pin_to_host_cpu(pthread_attr_t* p_attr, BaseType_t core_id);
+
+/**
+ * @brief Creates the timer service task on first use of a timer
+ */
+static void timer_service_init(void);
+
+/**
+ * @brief Timer service task running timer callbacks in expiry order
+ */
+static void timer_service_task(void* pvParameters);
+
+/**
+ * @brief Unlinks and frees a timer, must be called with the timer mutex held
+ */
+static void timer_free(struct host_timer* p_timer);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+/* Tasks */
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char* const pcName, const uint32_t usStackDepth,
+                                   void* const pvParameters, UBaseType_t uxPriority, TaskHandle_t* const pxCreatedTask,
+                                   const BaseType_t xCoreID) {
+    struct host_task* p_task = calloc(1, sizeof(struct host_task));
+    if (!p_task) return pdFAIL;
+
+    if (pcName) strncpy(p_task->name, pcName, sizeof(p_task->name) - 1);
+    p_task->function = pxTaskCode;
+    p_task->parameters = pvParameters;
+    p_task->priority = uxPriority;
+    p_task->core_id = xCoreID;
+    p_task->stack_depth = usStackDepth;
+
+    /* Handle is stored before the thread starts so the task can never observe an unset handle */
+    if (pxCreatedTask) *pxCreatedTask = p_task;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (((xCoreID != tskNO_AFFINITY) && (pin_to_host_cpu(&attr, xCoreID) != 0)) ||
+        (pthread_create(&p_task->thread, &attr, task_entry, p_task) != 0)) {
+        pthread_attr_destroy(&attr);
+        if (pxCreatedTask) *pxCreatedTask = NULL;
+        free(p_task);
+        return pdFAIL;
+    }
+    pthread_attr_destroy(&attr);
+    pthread_detach(p_task->thread);
+
+    pthread_mutex_lock(&task_mutex);
+    p_task->next = task_list;
+    task_list = p_task;
+    pthread_mutex_unlock(&task_mutex);
+
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+    if (!xTaskToDelete || (xTaskToDelete == current_task)) pthread_exit(NULL);
+    pthread_cancel(xTaskToDelete->thread);
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay) {
+    struct timespec ts = {.tv_sec = xTicksToDelay / 1000, .tv_nsec = (long)(xTicksToDelay % 1000) * 1000000};
+    while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {
+    }
+}
+
+TickType_t xTaskGetTickCount(void) { return (TickType_t)monotonic_ms(); }
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return current_task; }
+
+char* pcTaskGetName(TaskHandle_t xTaskToQuery) {
+    static char main_name[] = "main";
+    struct host_task* p_task = xTaskToQuery ? xTaskToQuery : current_task;
+    return p_task ? p_task->name : main_name;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask) {
+    struct host_task* p_task = xTask ? xTask : current_task;
+    return p_task ? p_task->priority : 1;
+}
+
+BaseType_t xTaskGetCoreID(TaskHandle_t xTask) {
+    struct host_task* p_task = xTask ? xTask : current_task;
+    return p_task ? p_task->core_id : 0;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask) {
+    struct host_task* p_task = xTask ? xTask : current_task;
+    return p_task ? p_task->stack_depth : 0;
+}
+
+/* Queues */
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+    if ((uxQueueLength == 0) || (uxItemSize == 0)) return NULL;
+
+    QueueHandle_t xQueue = calloc(1, sizeof(struct host_queue));
+    if (!xQueue) return NULL;
+    xQueue->storage = malloc((size_t)uxQueueLength * uxItemSize);
+    if (!xQueue->storage) {
+        free(xQueue);
+        return NULL;
+    }
+
+    pthread_mutex_init(&xQueue->mutex, NULL);
+    cond_init_monotonic(&xQueue->changed);
+    xQueue->length = uxQueueLength;
+    xQueue->item_size = uxItemSize;
+
+    return xQueue;
+}
+
+void vQueueDelete(QueueHandle_t xQueue) {
+    if (!xQueue) return;
+    pthread_cond_destroy(&xQueue->changed);
+    pthread_mutex_destroy(&xQueue->mutex);
+    free(xQueue->storage);
+    free(xQueue);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait) {
+    return queue_send(xQueue, pvItemToQueue, xTicksToWait, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait) {
+    return queue_send(xQueue, pvItemToQueue, xTicksToWait, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait) {
+    return queue_receive(xQueue, pvBuffer, xTicksToWait, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait) {
+    return queue_receive(xQueue, pvBuffer, xTicksToWait, false);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue) {
+    pthread_mutex_lock(&xQueue->mutex);
+    UBaseType_t count = xQueue->count;
+    pthread_mutex_unlock(&xQueue->mutex);
+    return count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue) {
+    pthread_mutex_lock(&xQueue->mutex);
+    UBaseType_t spaces = xQueue->length - xQueue->count;
+    pthread_mutex_unlock(&xQueue->mutex);
+    return spaces;
+}
+
+BaseType_t xQueueReset(QueueHandle_t xQueue) {
+    pthread_mutex_lock(&xQueue->mutex);
+    xQueue->head = 0;
+    xQueue->count = 0;
+    pthread_cond_broadcast(&xQueue->changed);
+    pthread_mutex_unlock(&xQueue->mutex);
+    return pdPASS;
+}
+
+/* Semaphores */
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount) {
+    if ((uxMaxCount == 0) || (uxInitialCount > uxMaxCount)) return NULL;
+
+    SemaphoreHandle_t xSemaphore = calloc(1, sizeof(struct host_semaphore));
+    if (!xSemaphore) return NULL;
+
+    pthread_mutex_init(&xSemaphore->mutex, NULL);
+    cond_init_monotonic(&xSemaphore->changed);
+    xSemaphore->count = uxInitialCount;
+    xSemaphore->max_count = uxMaxCount;
+
+    return xSemaphore;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore) {
+    if (!xSemaphore) return;
+    pthread_cond_destroy(&xSemaphore->changed);
+    pthread_mutex_destroy(&xSemaphore->mutex);
+    free(xSemaphore);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime) {
+    int64_t start_ms = monotonic_ms();
+    BaseType_t taken = pdFALSE;
+
+    pthread_mutex_lock(&xSemaphore->mutex);
+    pthread_cleanup_push(unlock_mutex, &xSemaphore->mutex);
+    while (xSemaphore->count == 0) {
+        if (!cond_wait_ticks(&xSemaphore->changed, &xSemaphore->mutex, start_ms, xBlockTime)) break;
+    }
+    if (xSemaphore->count > 0) {
+        xSemaphore->count--;
+        taken = pdTRUE;
+    }
+    pthread_cleanup_pop(1);
+
+    return taken;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+    BaseType_t given = pdFALSE;
+
+    pthread_mutex_lock(&xSemaphore->mutex);
+    if (xSemaphore->count < xSemaphore->max_count) {
+        xSemaphore->count++;
+        given = pdTRUE;
+        pthread_cond_signal(&xSemaphore->changed);
+    }
+    pthread_mutex_unlock(&xSemaphore->mutex);
+
+    return given;
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t xSemaphore) {
+    pthread_mutex_lock(&xSemaphore->mutex);
+    UBaseType_t count = xSemaphore->count;
+    pthread_mutex_unlock(&xSemaphore->mutex);
+    return count;
+}
+
+/* Event groups */
+
+EventGroupHandle_t xEventGroupCreate(void) {
+    EventGroupHandle_t xEventGroup = calloc(1, sizeof(struct host_event_group));
+    if (!xEventGroup) return NULL;
+
+    pthread_mutex_init(&xEventGroup->mutex, NULL);
+    cond_init_monotonic(&xEventGroup->changed);
+
+    return xEventGroup;
+}
+
+void vEventGroupDelete(EventGroupHandle_t xEventGroup) {
+    if (!xEventGroup) return;
+    pthread_cond_destroy(&xEventGroup->changed);
+    pthread_mutex_destroy(&xEventGroup->mutex);
+    free(xEventGroup);
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor,
+                                const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits,
+                                TickType_t xTicksToWait) {
+    int64_t start_ms = monotonic_ms();
+    EventBits_t bits;
+
+    pthread_mutex_lock(&xEventGroup->mutex);
+    pthread_cleanup_push(unlock_mutex, &xEventGroup->mutex);
+    while (true) {
+        bits = xEventGroup->bits;
+        bool satisfied = xWaitForAllBits ? ((bits & uxBitsToWaitFor) == uxBitsToWaitFor) : (bits & uxBitsToWaitFor);
+        if (satisfied) {
+            if (xClearOnExit) xEventGroup->bits &= ~uxBitsToWaitFor;
+            break;
+        }
+        if (!cond_wait_ticks(&xEventGroup->changed, &xEventGroup->mutex, start_ms, xTicksToWait)) break;
+    }
+    pthread_cleanup_pop(1);
+
+    /* Like FreeRTOS, the returned value is the bits at the time the wait ended, before any clearing */
+    return bits;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet) {
+    pthread_mutex_lock(&xEventGroup->mutex);
+    xEventGroup->bits |= uxBitsToSet;
+    EventBits_t bits = xEventGroup->bits;
+    pthread_cond_broadcast(&xEventGroup->changed);
+    pthread_mutex_unlock(&xEventGroup->mutex);
+    return bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear) {
+    pthread_mutex_lock(&xEventGroup->mutex);
+    EventBits_t bits = xEventGroup->bits;
+    xEventGroup->bits &= ~uxBitsToClear;
+    pthread_mutex_unlock(&xEventGroup->mutex);
+    return bits;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t xEventGroup) {
+    pthread_mutex_lock(&xEventGroup->mutex);
+    EventBits_t bits = xEventGroup->bits;
+    pthread_mutex_unlock(&xEventGroup->mutex);
+    return bits;
+}
+
+/* Timers */
+
+TimerHandle_t xTimerCreate(const char* const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                           const BaseType_t xAutoReload, void* const pvTimerID,
+                           TimerCallbackFunction_t pxCallbackFunction) {
+    if ((xTimerPeriodInTicks == 0) || !pxCallbackFunction) return NULL;
+    pthread_once(&timer_service_once, timer_service_init);
+
+    TimerHandle_t xTimer = calloc(1, sizeof(struct host_timer));
+    if (!xTimer) return NULL;
+
+    if (pcTimerName) strncpy(xTimer->name, pcTimerName, sizeof(xTimer->name) - 1);
+    xTimer->period = xTimerPeriodInTicks;
+    xTimer->auto_reload = xAutoReload;
+    xTimer->id = pvTimerID;
+    xTimer->callback = pxCallbackFunction;
+
+    pthread_mutex_lock(&timer_mutex);
+    xTimer->next = timer_list;
+    timer_list = xTimer;
+    pthread_mutex_unlock(&timer_mutex);
+
+    return xTimer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait) {
+    if (!xTimer) return pdFAIL;
+
+    pthread_mutex_lock(&timer_mutex);
+    xTimer->active = true;
+    xTimer->expiry_ms = monotonic_ms() + xTimer->period;
+    pthread_cond_signal(&timer_changed);
+    pthread_mutex_unlock(&timer_mutex);
+
+    return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait) {
+    if (!xTimer) return pdFAIL;
+
+    pthread_mutex_lock(&timer_mutex);
+    xTimer->active = false;
+    pthread_cond_signal(&timer_changed);
+    pthread_mutex_unlock(&timer_mutex);
+
+    return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait) {
+    if (!xTimer || (xNewPeriod == 0)) return pdFAIL;
+
+    /* Like FreeRTOS, changing the period also starts the timer */
+    pthread_mutex_lock(&timer_mutex);
+    xTimer->period = xNewPeriod;
+    pthread_mutex_unlock(&timer_mutex);
+
+    return xTimerStart(xTimer, xTicksToWait);
+}
+
+BaseType_t xTimerDelete(TimerHandle_t xTimer, TickType_t xTicksToWait) {
+    if (!xTimer) return pdFAIL;
+
+    pthread_mutex_lock(&timer_mutex);
+    if (xTimer == timer_running) {
+        /* Freed by the timer service once the callback returns */
+        xTimer->active = false;
+        xTimer->deleted = true;
+    } else {
+        timer_free(xTimer);
+    }
+    pthread_cond_signal(&timer_changed);
+    pthread_mutex_unlock(&timer_mutex);
+
+    return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t xTimer) {
+    pthread_mutex_lock(&timer_mutex);
+    BaseType_t active = xTimer->active ? pdTRUE : pdFALSE;
+    pthread_mutex_unlock(&timer_mutex);
+    return active;
+}
+
+void* pvTimerGetTimerID(const TimerHandle_t xTimer) {
+    pthread_mutex_lock(&timer_mutex);
+    void* id = xTimer->id;
+    pthread_mutex_unlock(&timer_mutex);
+    return id;
+}
+
+void vTimerSetTimerID(TimerHandle_t xTimer, void* pvNewID) {
+    pthread_mutex_lock(&timer_mutex);
+    xTimer->id = pvNewID;
+    pthread_mutex_unlock(&timer_mutex);
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static int64_t monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void cond_init_monotonic(pthread_cond_t* p_cond) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(p_cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+static bool cond_wait_ticks(pthread_cond_t* p_cond, pthread_mutex_t* p_mutex, int64_t start_ms, TickType_t ticks) {
+    if (ticks == portMAX_DELAY) {
+        pthread_cond_wait(p_cond, p_mutex);
+        return true;
+    }
+
+    int64_t deadline_ms = start_ms + ticks;
+    if (monotonic_ms() >= deadline_ms) return false;
+
+    struct timespec deadline = {.tv_sec = deadline_ms / 1000, .tv_nsec = (long)(deadline_ms % 1000) * 1000000};
+    return pthread_cond_timedwait(p_cond, p_mutex, &deadline) != ETIMEDOUT;
+}
+
+static void unlock_mutex(void* p_mutex) { pthread_mutex_unlock((pthread_mutex_t*)p_mutex); }
+
+static void* task_entry(void* arg) {
+    current_task = (struct host_task*)arg;
+    current_task->function(current_task->parameters);
+    return NULL;
+}
+
+static void queue_push(QueueHandle_t xQueue, const void* pvItemToQueue, bool front) {
+    UBaseType_t index;
+    if (front) {
+        xQueue->head = (xQueue->head + xQueue->length - 1) % xQueue->length;
+        index = xQueue->head;
+    } else {
+        index = (xQueue->head + xQueue->count) % xQueue->length;
+    }
+    memcpy(xQueue->storage + (size_t)index * xQueue->item_size, pvItemToQueue, xQueue->item_size);
+    xQueue->count++;
+}
+
+static BaseType_t queue_send(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait, bool front) {
+    int64_t start_ms = monotonic_ms();
+    BaseType_t sent = pdFALSE;
+
+    pthread_mutex_lock(&xQueue->mutex);
+    pthread_cleanup_push(unlock_mutex, &xQueue->mutex);
+    while (xQueue->count == xQueue->length) {
+        if (!cond_wait_ticks(&xQueue->changed, &xQueue->mutex, start_ms, xTicksToWait)) break;
+    }
+    if (xQueue->count < xQueue->length) {
+        queue_push(xQueue, pvItemToQueue, front);
+        pthread_cond_broadcast(&xQueue->changed);
+        sent = pdTRUE;
+    }
+    pthread_cleanup_pop(1);
+
+    return sent;
+}
+
+static BaseType_t queue_receive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait, bool remove) {
+    int64_t start_ms = monotonic_ms();
+    BaseType_t received = pdFALSE;
+
+    pthread_mutex_lock(&xQueue->mutex);
+    pthread_cleanup_push(unlock_mutex, &xQueue->mutex);
+    while (xQueue->count == 0) {
+        if (!cond_wait_ticks(&xQueue->changed, &xQueue->mutex, start_ms, xTicksToWait)) break;
+    }
+    if (xQueue->count > 0) {
+        memcpy(pvBuffer, xQueue->storage + (size_t)xQueue->head * xQueue->item_size, xQueue->item_size);
+        if (remove) {
+            xQueue->head = (xQueue->head + 1) % xQueue->length;
+            xQueue->count--;
+            pthread_cond_broadcast(&xQueue->changed);
+        }
+        received = pdTRUE;
+    }
+    pthread_cleanup_pop(1);
+
+    return received;
+}
+
+static int pin_to_host_cpu(pthread_attr_t* p_attr, BaseType_t core_id) {
+    if ((core_id < 0) || (core_id >= portNUM_PROCESSORS)) return EINVAL;
+
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return errno;
+
+    int remaining = core_id % CPU_COUNT(&allowed);
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed) || (remaining-- > 0)) continue;
+
+        cpu_set_t pinned;
+        CPU_ZERO(&pinned);
+        CPU_SET(cpu, &pinned);
+        return pthread_attr_setaffinity_np(p_attr, sizeof(pinned), &pinned);
+    }
+    return EINVAL;
+}
+
+static void timer_service_init(void) {
+    cond_init_monotonic(&timer_changed);
+    xTaskCreate(timer_service_task, "Tmr Svc", 2048, NULL, 1, NULL);
+}
+
+static void timer_service_task(void* pvParameters) {
+    pthread_mutex_lock(&timer_mutex);
+    while (true) {
+        /* Find the next timer to expire */
+        struct host_timer* p_next = NULL;
+        for (struct host_timer* p_timer = timer_list; p_timer; p_timer = p_timer->next) {
+            if (p_timer->active && (!p_next || (p_timer->expiry_ms < p_next->expiry_ms))) p_next = p_timer;
+        }
+
+        if (!p_next) {
+            pthread_cond_wait(&timer_changed, &timer_mutex);
+            continue;
+        }
+
+        int64_t now_ms = monotonic_ms();
+        if (p_next->expiry_ms > now_ms) {
+            cond_wait_ticks(&timer_changed, &timer_mutex, now_ms, (TickType_t)(p_next->expiry_ms - now_ms));
+            continue;
+        }
+
+        if (p_next->auto_reload) {
+            p_next->expiry_ms += p_next->period;
+        } else {
+            p_next->active = false;
+        }
+
+        /* Callbacks run without the lock so they can start, stop and delete timers */
+        timer_running = p_next;
+        pthread_mutex_unlock(&timer_mutex);
+        p_next->callback(p_next);
+        pthread_mutex_lock(&timer_mutex);
+        timer_running = NULL;
+        if (p_next->deleted) timer_free(p_next);
+    }
+}
+
+static void timer_free(struct host_timer* p_timer) {
+    for (struct host_timer** pp_timer = &timer_list; *pp_timer; pp_timer = &(*pp_timer)->next) {
+        if (*pp_timer == p_timer) {
+            *pp_timer = p_timer->next;
+            break;
+        }
+    }
+    free(p_timer);
+}
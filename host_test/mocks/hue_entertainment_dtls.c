@@ -0,0 +1,219 @@
+/**
+ * @file hue_entertainment_dtls.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the mbedtls DTLS session of hue_entertainment, the same PSK client over OpenSSL
+ *
+ * Replaces components/hue_entertainment/hue_entertainment_dtls.c in the host build, as mbedtls is not available on the
+ * host, keeping the DTLS 1.2 version and the PSK-AES128-GCM-SHA256 suite the bridge requires so the stand-in receiver
+ * rejects anything the bridge would. The socket is non-blocking and retransmissions are driven by OpenSSL's DTLS timer,
+ * so the handshake timeout covers retransmissions like the device's handshake timeout.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "host_mocks.h"
+
+#include "hue_entertainment_private.h"
+
+static const char* tag = "hue_entertainment_dtls";
+
+/** @brief Open DTLS session */
+struct hue_entertainment_dtls {
+    int fd;                                        /**< Connected UDP socket */
+    SSL_CTX* ssl_ctx;                              /**< Client context with the PSK callback */
+    SSL* ssl;                                      /**< DTLS session on fd */
+    char identity[HUE_APPLICATION_KEY_LENGTH + 1]; /**< PSK identity */
+    uint8_t psk[HUE_ENTERTAINMENT_PSK_SIZE];       /**< PSK */
+    size_t psk_length;                             /**< Bytes of psk in use */
+};
+
+static pthread_mutex_t override_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint16_t port_override = 0; /**< Port connected to instead of the requested port, 0 when unset */
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief OpenSSL PSK client callback, answers with the session's identity and PSK whatever the hint
+ */
+static unsigned int psk_client_callback(SSL* ssl, const char* hint, char* identity, unsigned int max_identity_len,
+                                        unsigned char* psk, unsigned int max_psk_len);
+
+/**
+ * @brief Connects a non-blocking UDP socket to host and port
+ *
+ * @return Socket, or -1 on failure
+ */
+static int connect_udp(const char* host, uint16_t port);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+void host_dtls_set_port_override(uint16_t port) {
+    pthread_mutex_lock(&override_mutex);
+    port_override = port;
+    pthread_mutex_unlock(&override_mutex);
+}
+
+/*====================================================================================================================*/
+/*======================================= Shared Private Function Definitions ========================================*/
+/*====================================================================================================================*/
+
+esp_err_t hue_entertainment_dtls_open(hue_entertainment_dtls_handle_t* p_dtls_handle, const char* host, uint16_t port,
+                                      const char* identity, const uint8_t* psk, size_t psk_length,
+                                      uint32_t timeout_ms) {
+    if (!p_dtls_handle || !host || !identity || !psk || (psk_length > HUE_ENTERTAINMENT_PSK_SIZE)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    hue_entertainment_dtls_handle_t dtls = calloc(1, sizeof(struct hue_entertainment_dtls));
+    if (!dtls) return ESP_ERR_NO_MEM;
+    dtls->fd = -1;
+    snprintf(dtls->identity, sizeof(dtls->identity), "%s", identity);
+    memcpy(dtls->psk, psk, psk_length);
+    dtls->psk_length = psk_length;
+    *p_dtls_handle = dtls;
+
+    pthread_mutex_lock(&override_mutex);
+    if (port_override) port = port_override;
+    pthread_mutex_unlock(&override_mutex);
+
+    if ((dtls->fd = connect_udp(host, port)) < 0) {
+        ESP_LOGE(tag, "Failed to connect UDP socket to %s:%u", host, port);
+        hue_entertainment_dtls_close(p_dtls_handle);
+        return ESP_FAIL;
+    }
+
+    dtls->ssl_ctx = SSL_CTX_new(DTLS_client_method());
+    if (!dtls->ssl_ctx || !SSL_CTX_set_min_proto_version(dtls->ssl_ctx, DTLS1_2_VERSION) ||
+        !SSL_CTX_set_max_proto_version(dtls->ssl_ctx, DTLS1_2_VERSION) ||
+        !SSL_CTX_set_cipher_list(dtls->ssl_ctx, "PSK-AES128-GCM-SHA256")) {
+        ESP_LOGE(tag, "Failed to create DTLS context: %s", ERR_reason_error_string(ERR_peek_last_error()));
+        ERR_clear_error();
+        hue_entertainment_dtls_close(p_dtls_handle);
+        return ESP_FAIL;
+    }
+    SSL_CTX_set_psk_client_callback(dtls->ssl_ctx, psk_client_callback);
+
+    BIO* bio = BIO_new_dgram(dtls->fd, BIO_NOCLOSE);
+    dtls->ssl = SSL_new(dtls->ssl_ctx);
+    if (!bio || !dtls->ssl) {
+        BIO_free(bio);
+        hue_entertainment_dtls_close(p_dtls_handle);
+        return ESP_ERR_NO_MEM;
+    }
+    struct sockaddr_storage peer;
+    socklen_t peer_length = sizeof(peer);
+    getpeername(dtls->fd, (struct sockaddr*)&peer, &peer_length);
+    BIO_ctrl(bio, BIO_CTRL_DGRAM_SET_CONNECTED, 0, &peer);
+    SSL_set_bio(dtls->ssl, bio, bio);
+    SSL_set_app_data(dtls->ssl, dtls);
+
+    /* Waits on the socket until the next retransmission is due, never past the overall timeout */
+    int64_t deadline_us = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    int ret;
+    while ((ret = SSL_connect(dtls->ssl)) != 1) {
+        int err = SSL_get_error(dtls->ssl, ret);
+        if ((err != SSL_ERROR_WANT_READ) && (err != SSL_ERROR_WANT_WRITE)) {
+            ESP_LOGE(tag, "DTLS handshake failed: %s", ERR_reason_error_string(ERR_peek_last_error()));
+            ERR_clear_error();
+            hue_entertainment_dtls_close(p_dtls_handle);
+            return ESP_FAIL;
+        }
+
+        int64_t remaining_us = deadline_us - esp_timer_get_time();
+        if (remaining_us <= 0) {
+            hue_entertainment_dtls_close(p_dtls_handle);
+            return ESP_ERR_TIMEOUT;
+        }
+        struct timeval retransmit;
+        if (DTLSv1_get_timeout(dtls->ssl, &retransmit)) {
+            int64_t retransmit_us = (int64_t)retransmit.tv_sec * 1000000 + retransmit.tv_usec;
+            if (retransmit_us < remaining_us) remaining_us = retransmit_us;
+        }
+
+        struct pollfd pfd = {.fd = dtls->fd, .events = (err == SSL_ERROR_WANT_WRITE) ? POLLOUT : POLLIN};
+        if (poll(&pfd, 1, (int)((remaining_us + 999) / 1000)) == 0) DTLSv1_handle_timeout(dtls->ssl);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t hue_entertainment_dtls_send(hue_entertainment_dtls_handle_t dtls_handle, const uint8_t* data,
+                                      size_t length) {
+    if (!dtls_handle || !data) return ESP_ERR_INVALID_ARG;
+
+    /* A datagram is written whole or not at all, there is no partial write to continue */
+    int ret = SSL_write(dtls_handle->ssl, data, (int)length);
+    if (ret != (int)length) {
+        ERR_clear_error();
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+void hue_entertainment_dtls_close(hue_entertainment_dtls_handle_t* p_dtls_handle) {
+    if (!p_dtls_handle || !(*p_dtls_handle)) return;
+
+    hue_entertainment_dtls_handle_t dtls = *p_dtls_handle;
+    if (dtls->ssl) {
+        if (SSL_is_init_finished(dtls->ssl)) SSL_shutdown(dtls->ssl);
+        SSL_free(dtls->ssl);
+    }
+    SSL_CTX_free(dtls->ssl_ctx);
+    if (dtls->fd >= 0) close(dtls->fd);
+    free(dtls);
+
+    *p_dtls_handle = NULL;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static unsigned int psk_client_callback(SSL* ssl, const char* hint, char* identity, unsigned int max_identity_len,
+                                        unsigned char* psk, unsigned int max_psk_len) {
+    hue_entertainment_dtls_handle_t dtls = (hue_entertainment_dtls_handle_t)SSL_get_app_data(ssl);
+    if ((strlen(dtls->identity) >= max_identity_len) || (dtls->psk_length > max_psk_len)) return 0;
+
+    strcpy(identity, dtls->identity);
+    memcpy(psk, dtls->psk, dtls->psk_length);
+    return (unsigned int)dtls->psk_length;
+}
+
+static int connect_udp(const char* host, uint16_t port) {
+    char port_str[6];
+    snprintf(port_str, sizeof(port_str), "%u", port);
+
+    struct addrinfo hints = {.ai_family = AF_INET, .ai_socktype = SOCK_DGRAM};
+    struct addrinfo* p_result = NULL;
+    if (getaddrinfo(host, port_str, &hints, &p_result) != 0) return -1;
+
+    int fd = socket(p_result->ai_family, p_result->ai_socktype, p_result->ai_protocol);
+    if ((fd >= 0) && (connect(fd, p_result->ai_addr, p_result->ai_addrlen) != 0)) {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(p_result);
+
+    if (fd >= 0) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
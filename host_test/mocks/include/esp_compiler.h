@@ -0,0 +1,14 @@
+/**
+ * @file esp_compiler.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF esp_compiler.h
+ */
+
+#ifndef H_HOST_ESP_COMPILER
+#define H_HOST_ESP_COMPILER
+
+#define likely(x) __builtin_expect(!!(x), 1)
+#define unlikely(x) __builtin_expect(!!(x), 0)
+
+#endif /* H_HOST_ESP_COMPILER */
@@ -0,0 +1,44 @@
+/**
+ * @file esp_event.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the ESP-IDF default event loop, dispatching posted events from a dedicated task
+ */
+
+#ifndef H_HOST_ESP_EVENT
+#define H_HOST_ESP_EVENT
+
+#include "freertos/FreeRTOS.h"
+
+#include "esp_err.h"
+#include "esp_event_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_err_t esp_event_loop_create_default(void);
+esp_err_t esp_event_loop_delete_default(void);
+
+esp_err_t esp_event_handler_register(esp_event_base_t event_base, int32_t event_id, esp_event_handler_t event_handler,
+                                     void* event_handler_arg);
+esp_err_t esp_event_handler_unregister(esp_event_base_t event_base, int32_t event_id,
+                                       esp_event_handler_t event_handler);
+esp_err_t esp_event_handler_instance_register(esp_event_base_t event_base, int32_t event_id,
+                                              esp_event_handler_t event_handler, void* event_handler_arg,
+                                              esp_event_handler_instance_t* instance);
+esp_err_t esp_event_handler_instance_unregister(esp_event_base_t event_base, int32_t event_id,
+                                                esp_event_handler_instance_t instance);
+
+/**
+ * @brief Copies event data and queues the event for the event loop task
+ *
+ * @return ESP_OK, ESP_ERR_INVALID_STATE if the default loop was not created, ESP_ERR_TIMEOUT if the queue stayed full
+ */
+esp_err_t esp_event_post(esp_event_base_t event_base, int32_t event_id, const void* event_data,
+                         size_t event_data_size, TickType_t ticks_to_wait);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_ESP_EVENT */
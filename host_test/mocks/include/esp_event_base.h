@@ -0,0 +1,31 @@
+/**
+ * @file esp_event_base.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF esp_event_base.h
+ */
+
+#ifndef H_HOST_ESP_EVENT_BASE
+#define H_HOST_ESP_EVENT_BASE
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef const char* esp_event_base_t; /**< Event bases are compared by pointer, like on device */
+typedef void* esp_event_handler_instance_t;
+typedef void (*esp_event_handler_t)(void* event_handler_arg, esp_event_base_t event_base, int32_t event_id,
+                                    void* event_data);
+
+#define ESP_EVENT_DECLARE_BASE(id) extern esp_event_base_t const id
+#define ESP_EVENT_DEFINE_BASE(id) esp_event_base_t const id = #id
+
+#define ESP_EVENT_ANY_BASE NULL
+#define ESP_EVENT_ANY_ID -1
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_ESP_EVENT_BASE */
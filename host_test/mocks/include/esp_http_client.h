@@ -0,0 +1,127 @@
+/**
+ * @file esp_http_client.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the ESP-IDF HTTP client, performing real HTTP/1.1 requests over OpenSSL so components can
+ * be run against local servers
+ *
+ * Supports the subset used by the components: blocking esp_http_client_perform() with the same event sequence as
+ * the original, PEM CA verification with the common_name override, keep-alive connection reuse between performs on
+ * the same client, and Content-Length or chunked response bodies.
+ */
+
+#ifndef H_HOST_ESP_HTTP_CLIENT
+#define H_HOST_ESP_HTTP_CLIENT
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_ERR_HTTP_MAX_REDIRECT (ESP_ERR_HTTP_BASE + 1)
+#define ESP_ERR_HTTP_CONNECT (ESP_ERR_HTTP_BASE + 2)
+#define ESP_ERR_HTTP_WRITE_DATA (ESP_ERR_HTTP_BASE + 3)
+#define ESP_ERR_HTTP_FETCH_HEADER (ESP_ERR_HTTP_BASE + 4)
+#define ESP_ERR_HTTP_INVALID_TRANSPORT (ESP_ERR_HTTP_BASE + 5)
+#define ESP_ERR_HTTP_CONNECTING (ESP_ERR_HTTP_BASE + 6)
+#define ESP_ERR_HTTP_EAGAIN (ESP_ERR_HTTP_BASE + 7)
+#define ESP_ERR_HTTP_CONNECTION_CLOSED (ESP_ERR_HTTP_BASE + 8)
+
+typedef struct esp_http_client* esp_http_client_handle_t;
+
+typedef enum {
+    HTTP_EVENT_ERROR = 0,
+    HTTP_EVENT_ON_CONNECTED,
+    HTTP_EVENT_HEADERS_SENT,
+    HTTP_EVENT_HEADER_SENT = HTTP_EVENT_HEADERS_SENT,
+    HTTP_EVENT_ON_HEADER,
+    HTTP_EVENT_ON_DATA,
+    HTTP_EVENT_ON_FINISH,
+    HTTP_EVENT_DISCONNECTED,
+    HTTP_EVENT_REDIRECT,
+} esp_http_client_event_id_t;
+
+typedef struct esp_http_client_event {
+    esp_http_client_event_id_t event_id; /**< Event ID */
+    esp_http_client_handle_t client;     /**< Client the event belongs to */
+    void* data;                          /**< Response body data for HTTP_EVENT_ON_DATA, not null-terminated */
+    int data_len;                        /**< Length of data */
+    void* user_data;                     /**< user_data from the client configuration */
+    char* header_key;                    /**< Header key for HTTP_EVENT_ON_HEADER */
+    char* header_value;                  /**< Header value for HTTP_EVENT_ON_HEADER */
+} esp_http_client_event_t;
+
+typedef esp_err_t (*http_event_handle_cb)(esp_http_client_event_t* evt);
+
+typedef enum {
+    HTTP_METHOD_GET = 0,
+    HTTP_METHOD_POST,
+    HTTP_METHOD_PUT,
+    HTTP_METHOD_PATCH,
+    HTTP_METHOD_DELETE,
+    HTTP_METHOD_HEAD,
+} esp_http_client_method_t;
+
+typedef enum {
+    HTTP_TRANSPORT_UNKNOWN = 0,
+    HTTP_TRANSPORT_OVER_TCP,
+    HTTP_TRANSPORT_OVER_SSL,
+} esp_http_client_transport_t;
+
+typedef enum {
+    HttpStatus_Ok = 200,
+    HttpStatus_MultipleChoices = 300,
+    HttpStatus_MovedPermanently = 301,
+    HttpStatus_Found = 302,
+    HttpStatus_TemporaryRedirect = 307,
+    HttpStatus_BadRequest = 400,
+    HttpStatus_Unauthorized = 401,
+    HttpStatus_Forbidden = 403,
+    HttpStatus_NotFound = 404,
+    HttpStatus_TooManyRequests = 429,
+    HttpStatus_InternalError = 500,
+    HttpStatus_ServiceUnavailable = 503,
+} HttpStatus_Code;
+
+typedef struct {
+    const char* url;                            /**< Full request URL, overrides host, port and path */
+    const char* host;                           /**< Host when url is not set */
+    int port;                                   /**< Port, 0 for the scheme default */
+    const char* path;                           /**< Path when url is not set */
+    const char* cert_pem;                       /**< PEM CA certificate(s) to verify the server against */
+    const char* common_name;                    /**< Name to verify the server certificate against instead of host */
+    bool skip_cert_common_name_check;           /**< Skip server name verification */
+    esp_http_client_method_t method;            /**< Request method */
+    int timeout_ms;                             /**< Connect, send and receive timeout */
+    http_event_handle_cb event_handler;         /**< HTTP event handler */
+    esp_http_client_transport_t transport_type; /**< Transport when url is not set */
+    int buffer_size;                            /**< Receive buffer size */
+    int buffer_size_tx;                         /**< Transmit buffer size */
+    void* user_data;                            /**< Passed to the event handler in every event */
+    bool keep_alive_enable;                     /**< Enable TCP keep-alive probes */
+    int keep_alive_idle;                        /**< Keep-alive idle time in seconds */
+    int keep_alive_interval;                    /**< Keep-alive probe interval in seconds */
+    int keep_alive_count;                       /**< Keep-alive probe count */
+} esp_http_client_config_t;
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t* config);
+esp_err_t esp_http_client_perform(esp_http_client_handle_t client);
+esp_err_t esp_http_client_set_url(esp_http_client_handle_t client, const char* url);
+esp_err_t esp_http_client_set_method(esp_http_client_handle_t client, esp_http_client_method_t method);
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t client, const char* key, const char* value);
+esp_err_t esp_http_client_delete_header(esp_http_client_handle_t client, const char* key);
+esp_err_t esp_http_client_set_post_field(esp_http_client_handle_t client, const char* data, int len);
+esp_err_t esp_http_client_set_timeout_ms(esp_http_client_handle_t client, int timeout_ms);
+int esp_http_client_get_status_code(esp_http_client_handle_t client);
+int64_t esp_http_client_get_content_length(esp_http_client_handle_t client);
+esp_err_t esp_http_client_close(esp_http_client_handle_t client);
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_ESP_HTTP_CLIENT */
@@ -0,0 +1,14 @@
+/**
+ * @file esp_mac.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF esp_mac.h formatting macros
+ */
+
+#ifndef H_HOST_ESP_MAC
+#define H_HOST_ESP_MAC
+
+#define MAC2STR(a) (a)[0], (a)[1], (a)[2], (a)[3], (a)[4], (a)[5]
+#define MACSTR "%02x:%02x:%02x:%02x:%02x:%02x"
+
+#endif /* H_HOST_ESP_MAC */
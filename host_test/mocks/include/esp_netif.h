@@ -0,0 +1,27 @@
+/**
+ * @file esp_netif.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the ESP-IDF esp_netif calls used for the WiFi station interface
+ */
+
+#ifndef H_HOST_ESP_NETIF
+#define H_HOST_ESP_NETIF
+
+#include "esp_err.h"
+#include "esp_netif_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_err_t esp_netif_init(void);
+esp_netif_t* esp_netif_create_default_wifi_sta(void);
+esp_err_t esp_netif_dhcpc_stop(esp_netif_t* esp_netif);
+esp_err_t esp_netif_set_ip_info(esp_netif_t* esp_netif, const esp_netif_ip_info_t* ip_info);
+esp_err_t esp_netif_get_ip_info(esp_netif_t* esp_netif, esp_netif_ip_info_t* ip_info);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_ESP_NETIF */
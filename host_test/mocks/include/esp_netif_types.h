@@ -0,0 +1,58 @@
+/**
+ * @file esp_netif_types.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF esp_netif_types.h and the IP event definitions
+ */
+
+#ifndef H_HOST_ESP_NETIF_TYPES
+#define H_HOST_ESP_NETIF_TYPES
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_event_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+ESP_EVENT_DECLARE_BASE(IP_EVENT);
+
+/** @brief IP event declarations */
+typedef enum {
+    IP_EVENT_STA_GOT_IP,
+    IP_EVENT_STA_LOST_IP,
+} ip_event_t;
+
+typedef struct esp_netif_obj esp_netif_t;
+
+typedef struct {
+    uint32_t addr; /**< IPv4 address in network byte order */
+} esp_ip4_addr_t;
+
+typedef struct {
+    esp_ip4_addr_t ip;      /**< Interface IPv4 address */
+    esp_ip4_addr_t netmask; /**< Interface IPv4 netmask */
+    esp_ip4_addr_t gw;      /**< Interface IPv4 gateway address */
+} esp_netif_ip_info_t;
+
+typedef struct {
+    esp_netif_t* esp_netif;      /**< Pointer to corresponding esp-netif object */
+    esp_netif_ip_info_t ip_info; /**< IP address, netmask, gateway IP address */
+    bool ip_changed;             /**< Whether the assigned IP has changed or not */
+} ip_event_got_ip_t;
+
+#define esp_ip4_addr_get_byte(ipaddr, idx) (((const uint8_t*)(&(ipaddr)->addr))[idx])
+#define esp_ip4_addr1(ipaddr) esp_ip4_addr_get_byte(ipaddr, 0)
+#define esp_ip4_addr2(ipaddr) esp_ip4_addr_get_byte(ipaddr, 1)
+#define esp_ip4_addr3(ipaddr) esp_ip4_addr_get_byte(ipaddr, 2)
+#define esp_ip4_addr4(ipaddr) esp_ip4_addr_get_byte(ipaddr, 3)
+
+#define IP2STR(ipaddr) esp_ip4_addr1(ipaddr), esp_ip4_addr2(ipaddr), esp_ip4_addr3(ipaddr), esp_ip4_addr4(ipaddr)
+#define IPSTR "%d.%d.%d.%d"
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_ESP_NETIF_TYPES */
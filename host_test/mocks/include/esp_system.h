@@ -0,0 +1,28 @@
+/**
+ * @file esp_system.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF esp_system.h
+ */
+
+#ifndef H_HOST_ESP_SYSTEM
+#define H_HOST_ESP_SYSTEM
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Exit status of the host process when esp_restart() is called */
+#define HOST_RESTART_EXIT_CODE 3
+
+/**
+ * @brief Exits the host process with HOST_RESTART_EXIT_CODE, as there is nothing to restart into
+ */
+void esp_restart(void) __attribute__((noreturn));
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_ESP_SYSTEM */
@@ -0,0 +1,56 @@
+/**
+ * @file esp_timer.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF esp_timer.h time keeping and high resolution timers
+ */
+
+#ifndef H_HOST_ESP_TIMER
+#define H_HOST_ESP_TIMER
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct esp_timer* esp_timer_handle_t; /**< Handle for a created timer */
+typedef void (*esp_timer_cb_t)(void* arg);    /**< Timer callback */
+
+/** @brief How callbacks are dispatched, every timer is dispatched from the timer thread on host */
+typedef enum {
+    ESP_TIMER_TASK, /**< Callback is called from the timer task */
+    ESP_TIMER_ISR,  /**< Callback is called from the timer ISR on device */
+    ESP_TIMER_MAX,  /**< Number of dispatch methods */
+} esp_timer_dispatch_t;
+
+/** @brief Timer configuration */
+typedef struct {
+    esp_timer_cb_t callback;              /**< Called when the timer expires */
+    void* arg;                            /**< Argument passed to callback */
+    esp_timer_dispatch_t dispatch_method; /**< Ignored, callbacks always run on the timer thread */
+    const char* name;                     /**< Timer name, for debugging */
+    bool skip_unhandled_events;           /**< Periodic expiries missed while the callback was late are skipped */
+} esp_timer_create_args_t;
+
+/**
+ * @brief Returns microseconds since process start from CLOCK_MONOTONIC, like the time since boot on device
+ */
+int64_t esp_timer_get_time(void);
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* create_args, esp_timer_handle_t* out_handle);
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+
+/** Waits for a callback of the timer running on the timer thread to return, unless called from that callback */
+esp_err_t esp_timer_delete(esp_timer_handle_t timer);
+bool esp_timer_is_active(esp_timer_handle_t timer);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_ESP_TIMER */
@@ -0,0 +1,18 @@
+/**
+ * @file esp_types.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF esp_types.h
+ */
+
+#ifndef H_HOST_ESP_TYPES
+#define H_HOST_ESP_TYPES
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "esp_compiler.h"
+
+#endif /* H_HOST_ESP_TYPES */
@@ -0,0 +1,118 @@
+/**
+ * @file esp_wifi_types.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the subset of ESP-IDF WiFi station types and events used by the components
+ */
+
+#ifndef H_HOST_ESP_WIFI_TYPES
+#define H_HOST_ESP_WIFI_TYPES
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_event_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+ESP_EVENT_DECLARE_BASE(WIFI_EVENT);
+
+typedef enum { WIFI_MODE_NULL = 0, WIFI_MODE_STA, WIFI_MODE_AP, WIFI_MODE_APSTA } wifi_mode_t;
+
+typedef enum { WIFI_IF_STA = 0, WIFI_IF_AP } wifi_interface_t;
+
+typedef enum { WIFI_FAST_SCAN = 0, WIFI_ALL_CHANNEL_SCAN } wifi_scan_method_t;
+
+typedef enum { WIFI_CONNECT_AP_BY_SIGNAL = 0, WIFI_CONNECT_AP_BY_SECURITY } wifi_sort_method_t;
+
+typedef enum { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+
+typedef enum {
+    WIFI_AUTH_OPEN = 0,
+    WIFI_AUTH_WEP,
+    WIFI_AUTH_WPA_PSK,
+    WIFI_AUTH_WPA2_PSK,
+    WIFI_AUTH_WPA_WPA2_PSK,
+    WIFI_AUTH_WPA2_ENTERPRISE,
+    WIFI_AUTH_WPA3_PSK,
+    WIFI_AUTH_WPA2_WPA3_PSK,
+} wifi_auth_mode_t;
+
+typedef enum {
+    WIFI_REASON_UNSPECIFIED = 1,
+    WIFI_REASON_AUTH_EXPIRE = 2,
+    WIFI_REASON_AUTH_LEAVE = 3,
+    WIFI_REASON_ASSOC_EXPIRE = 4,
+    WIFI_REASON_ASSOC_LEAVE = 8,
+    WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT = 15,
+    WIFI_REASON_BEACON_TIMEOUT = 200,
+    WIFI_REASON_NO_AP_FOUND = 201,
+    WIFI_REASON_AUTH_FAIL = 202,
+    WIFI_REASON_ASSOC_FAIL = 203,
+    WIFI_REASON_HANDSHAKE_TIMEOUT = 204,
+    WIFI_REASON_CONNECTION_FAIL = 205,
+} wifi_err_reason_t;
+
+typedef enum {
+    WIFI_EVENT_WIFI_READY = 0,
+    WIFI_EVENT_SCAN_DONE,
+    WIFI_EVENT_STA_START,
+    WIFI_EVENT_STA_STOP,
+    WIFI_EVENT_STA_CONNECTED,
+    WIFI_EVENT_STA_DISCONNECTED,
+    WIFI_EVENT_STA_AUTHMODE_CHANGE,
+    WIFI_EVENT_STA_BEACON_TIMEOUT = 21,
+} wifi_event_t;
+
+typedef struct {
+    int8_t rssi;               /**< Minimum RSSI of APs to connect to */
+    wifi_auth_mode_t authmode; /**< Weakest auth mode to accept */
+} wifi_scan_threshold_t;
+
+typedef struct {
+    uint8_t ssid[32];                /**< SSID of target AP */
+    uint8_t password[64];            /**< Password of target AP */
+    wifi_scan_method_t scan_method;  /**< Fast scan or all channel scan */
+    bool bssid_set;                  /**< Only connect to the AP with bssid */
+    uint8_t bssid[6];                /**< BSSID of target AP */
+    uint8_t channel;                 /**< Channel of target AP, 0 for unknown */
+    uint16_t listen_interval;        /**< Listen interval for power save */
+    wifi_sort_method_t sort_method;  /**< Sort method for all channel scan results */
+    wifi_scan_threshold_t threshold; /**< Weakest AP accepted in fast scan mode */
+} wifi_sta_config_t;
+
+typedef union {
+    wifi_sta_config_t sta; /**< Configuration of STA */
+} wifi_config_t;
+
+typedef struct {
+    uint8_t bssid[6];  /**< MAC address of AP */
+    uint8_t ssid[33];  /**< SSID of AP */
+    uint8_t primary;   /**< Channel of AP */
+    int8_t rssi;       /**< Signal strength of AP */
+    wifi_auth_mode_t authmode; /**< Auth mode of AP */
+} wifi_ap_record_t;
+
+typedef struct {
+    uint8_t ssid[32];          /**< SSID of connected AP */
+    uint8_t ssid_len;          /**< SSID length of connected AP */
+    uint8_t bssid[6];          /**< BSSID of connected AP */
+    uint8_t channel;           /**< Channel of connected AP */
+    wifi_auth_mode_t authmode; /**< Authentication mode used by AP */
+    uint16_t aid;              /**< Authentication id assigned by the connected AP */
+} wifi_event_sta_connected_t;
+
+typedef struct {
+    uint8_t ssid[32]; /**< SSID of disconnected AP */
+    uint8_t ssid_len; /**< SSID length of disconnected AP */
+    uint8_t bssid[6]; /**< BSSID of disconnected AP */
+    uint8_t reason;   /**< wifi_err_reason_t */
+    int8_t rssi;      /**< RSSI of disconnection */
+} wifi_event_sta_disconnected_t;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_ESP_WIFI_TYPES */
@@ -0,0 +1,45 @@
+/**
+ * @file FreeRTOS.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the FreeRTOS base types and configuration, backed by POSIX threads
+ */
+
+#ifndef H_HOST_FREERTOS
+#define H_HOST_FREERTOS
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "esp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint8_t StackType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+
+/* One tick per millisecond so that tick based delays and timeouts map directly onto host clocks */
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(((TickType_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / 1000U))
+
+#define configMAX_PRIORITIES 25
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+#define portNUM_PROCESSORS 2
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_FREERTOS */
@@ -0,0 +1,32 @@
+/**
+ * @file event_groups.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for FreeRTOS event groups
+ */
+
+#ifndef H_HOST_FREERTOS_EVENT_GROUPS
+#define H_HOST_FREERTOS_EVENT_GROUPS
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct host_event_group* EventGroupHandle_t;
+typedef uint32_t EventBits_t;
+
+EventGroupHandle_t xEventGroupCreate(void);
+void vEventGroupDelete(EventGroupHandle_t xEventGroup);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor,
+                                const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits,
+                                TickType_t xTicksToWait);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear);
+EventBits_t xEventGroupGetBits(EventGroupHandle_t xEventGroup);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_FREERTOS_EVENT_GROUPS */
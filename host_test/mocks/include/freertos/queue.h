@@ -0,0 +1,35 @@
+/**
+ * @file queue.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for FreeRTOS queues, copying fixed size items like the original
+ */
+
+#ifndef H_HOST_FREERTOS_QUEUE
+#define H_HOST_FREERTOS_QUEUE
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct host_queue* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+void vQueueDelete(QueueHandle_t xQueue);
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueSendToFront(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait);
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue);
+BaseType_t xQueueReset(QueueHandle_t xQueue);
+
+#define xQueueSend(xQueue, pvItemToQueue, xTicksToWait) xQueueSendToBack(xQueue, pvItemToQueue, xTicksToWait)
+#define xQueueSendFromISR(xQueue, pvItemToQueue, pxHigherPriorityTaskWoken) xQueueSendToBack(xQueue, pvItemToQueue, 0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_FREERTOS_QUEUE */
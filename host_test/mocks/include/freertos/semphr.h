@@ -0,0 +1,33 @@
+/**
+ * @file semphr.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for FreeRTOS mutexes and semaphores
+ *
+ * @note Mutexes are plain binary semaphores, priority inheritance and recursive taking are not modelled
+ */
+
+#ifndef H_HOST_FREERTOS_SEMPHR
+#define H_HOST_FREERTOS_SEMPHR
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct host_semaphore* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount);
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t xSemaphore);
+
+#define xSemaphoreCreateMutex() xSemaphoreCreateCounting(1, 1)
+#define xSemaphoreCreateBinary() xSemaphoreCreateCounting(1, 0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_FREERTOS_SEMPHR */
@@ -0,0 +1,52 @@
+/**
+ * @file task.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for FreeRTOS tasks, each task runs as a POSIX thread
+ *
+ * @note Priorities are recorded but not applied, host threads are scheduled by the OS. Pinned tasks are restricted to
+ * a host CPU standing in for the core, see xTaskCreatePinnedToCore() in freertos.c
+ */
+
+#ifndef H_HOST_FREERTOS_TASK
+#define H_HOST_FREERTOS_TASK
+
+#include <sched.h>
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct host_task* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char* const pcName, const uint32_t usStackDepth,
+                                   void* const pvParameters, UBaseType_t uxPriority, TaskHandle_t* const pxCreatedTask,
+                                   const BaseType_t xCoreID);
+
+static inline BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char* const pcName, const uint32_t usStackDepth,
+                                     void* const pvParameters, UBaseType_t uxPriority,
+                                     TaskHandle_t* const pxCreatedTask) {
+    return xTaskCreatePinnedToCore(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask,
+                                   tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+void vTaskDelay(const TickType_t xTicksToDelay);
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+char* pcTaskGetName(TaskHandle_t xTaskToQuery);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask);
+BaseType_t xTaskGetCoreID(TaskHandle_t xTask);
+
+/** Stack usage is not tracked on host, always reports the full requested depth as unused */
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask);
+
+#define taskYIELD() sched_yield()
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_FREERTOS_TASK */
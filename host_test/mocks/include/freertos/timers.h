@@ -0,0 +1,36 @@
+/**
+ * @file timers.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for FreeRTOS software timers, callbacks run on a single timer service thread like the original
+ */
+
+#ifndef H_HOST_FREERTOS_TIMERS
+#define H_HOST_FREERTOS_TIMERS
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct host_timer* TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t xTimer);
+
+TimerHandle_t xTimerCreate(const char* const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                           const BaseType_t xAutoReload, void* const pvTimerID,
+                           TimerCallbackFunction_t pxCallbackFunction);
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait);
+BaseType_t xTimerDelete(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerIsTimerActive(TimerHandle_t xTimer);
+void* pvTimerGetTimerID(const TimerHandle_t xTimer);
+void vTimerSetTimerID(TimerHandle_t xTimer, void* pvNewID);
+
+#define xTimerReset(xTimer, xTicksToWait) xTimerStart(xTimer, xTicksToWait)
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_FREERTOS_TIMERS */
@@ -0,0 +1,116 @@
+/**
+ * @file host_mocks.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host-only controls for the simulated ESP-IDF layers, used by host tests and benchmarks to script the
+ * environment the components run in
+ */
+
+#ifndef H_HOST_MOCKS
+#define H_HOST_MOCKS
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "esp_err.h"
+#include "esp_wifi_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Simulated access point seen by the host WiFi driver */
+typedef struct {
+    bool present;                  /**< AP is in range, otherwise every attempt fails with WIFI_REASON_NO_AP_FOUND */
+    uint8_t bssid[6];              /**< BSSID of the AP, directed connects to another BSSID fail */
+    uint8_t channel;               /**< Channel of the AP, directed connects to another channel fail */
+    uint32_t associate_ms;         /**< Time from esp_wifi_connect() to WIFI_EVENT_STA_CONNECTED */
+    uint32_t dhcp_ms;              /**< Time from association to IP_EVENT_STA_GOT_IP */
+    uint8_t fail_attempts;         /**< Number of upcoming attempts that fail with fail_reason before succeeding */
+    wifi_err_reason_t fail_reason; /**< Reason reported for failed attempts */
+    uint32_t ip;                   /**< IP assigned by DHCP in network byte order */
+} host_wifi_ap_t;
+
+/** @brief Client side TLS handshake timing across every esp_http_client, from TCP connected to handshake complete */
+typedef struct {
+    uint32_t handshakes; /**< Successful handshakes */
+    int64_t total_us;    /**< Sum of all handshake durations, for averaging with handshakes */
+    int64_t max_us;      /**< Longest handshake */
+} host_tls_stats_t;
+
+/* esp_event.c */
+
+/**
+ * @brief Blocks until every posted event has been dispatched
+ *
+ * @param[in] ticks_to_wait Maximum time to wait
+ *
+ * @return ESP_OK once idle, ESP_ERR_TIMEOUT otherwise
+ */
+esp_err_t host_event_loop_wait_idle(TickType_t ticks_to_wait);
+
+/* esp_wifi.c */
+
+/**
+ * @brief Replaces the simulated AP, affecting attempts started after the call
+ *
+ * @param[in] p_ap AP description
+ */
+void host_wifi_sim_set_ap(const host_wifi_ap_t* p_ap);
+
+/**
+ * @brief Drops an established association as if the AP went away, posting WIFI_EVENT_STA_DISCONNECTED
+ *
+ * @param[in] reason Reason reported in the disconnect event
+ */
+void host_wifi_sim_drop(wifi_err_reason_t reason);
+
+/**
+ * @brief Returns the number of esp_wifi_connect() calls and driver initializations since process start
+ *
+ * @param[out] p_connects Number of esp_wifi_connect() calls, may be NULL
+ * @param[out] p_inits Number of esp_wifi_init() calls, may be NULL
+ */
+void host_wifi_sim_get_counts(uint32_t* p_connects, uint32_t* p_inits);
+
+/* esp_http_client.c */
+
+/**
+ * @brief Sends every connection to another port on the requested host, e.g. a mock bridge on an ephemeral port in
+ * place of 443
+ *
+ * @param[in] port Port to connect to, 0 to use the port from the URL
+ */
+void host_http_client_set_port_override(uint16_t port);
+
+/**
+ * @brief Trusts the given certificates instead of the cert_pem of each client, e.g. a mock bridge certificate in place
+ * of the embedded Signify root
+ *
+ * @param[in] cert_pem PEM certificate(s) to trust, copied, NULL to use the cert_pem of each client
+ */
+void host_http_client_set_ca_override(const char* cert_pem);
+
+/**
+ * @brief Copies the TLS handshake timing of every client since process start
+ *
+ * @param[out] p_stats Storage for the timing
+ */
+void host_http_client_get_tls_stats(host_tls_stats_t* p_stats);
+
+/* hue_entertainment_dtls.c */
+
+/**
+ * @brief Sends every entertainment stream to another port on the bridge, e.g. a stand-in receiver on an ephemeral port
+ * in place of HUE_ENTERTAINMENT_PORT
+ *
+ * @param[in] port Port to connect to, 0 to use the requested port
+ */
+void host_dtls_set_port_override(uint16_t port);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_MOCKS */
@@ -0,0 +1,16 @@
+/**
+ * @file ip4_addr.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the lwIP IPv4 address helpers
+ */
+
+#ifndef H_HOST_LWIP_IP4_ADDR
+#define H_HOST_LWIP_IP4_ADDR
+
+#include <arpa/inet.h>
+
+/** Parses a dotted decimal address into network byte order, like lwIP */
+#define ipaddr_addr(cp) inet_addr(cp)
+
+#endif /* H_HOST_LWIP_IP4_ADDR */
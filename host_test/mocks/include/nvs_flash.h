@@ -0,0 +1,27 @@
+/**
+ * @file nvs_flash.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF nvs_flash.h
+ */
+
+#ifndef H_HOST_NVS_FLASH
+#define H_HOST_NVS_FLASH
+
+#include "nvs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_err_t nvs_flash_init(void);
+
+/**
+ * @brief Erases every stored key, the host equivalent of a freshly erased partition
+ */
+esp_err_t nvs_flash_erase(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_NVS_FLASH */
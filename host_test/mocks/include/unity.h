@@ -0,0 +1,86 @@
+/**
+ * @file unity.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the subset of the Unity test framework used by the component tests, so the same test
+ * sources run on device through hue_test_app and on host through the host test runner
+ */
+
+#ifndef H_HOST_UNITY
+#define H_HOST_UNITY
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Registered test case */
+typedef struct unity_test_desc {
+    const char* name;             /**< Test name */
+    const char* desc;             /**< Bracketed tags, e.g. "[component][group]" */
+    void (*fn)(void);             /**< Test function */
+    const char* file;             /**< Source file */
+    int line;                     /**< Source line */
+    struct unity_test_desc* next; /**< Next registered test */
+} unity_test_desc_t;
+
+void unity_testcase_register(unity_test_desc_t* desc);
+void unity_run_tests_by_tag(const char* tag, bool invert);
+void unity_run_all_tests(void);
+void unity_begin(void);
+int unity_end(void);
+
+void unity_fail(const char* file, int line, const char* format, ...) __attribute__((noreturn, format(printf, 3, 4)));
+void unity_assert_equal_int(long long expected, long long actual, const char* file, int line);
+void unity_assert_equal_string(const char* expected, const char* actual, const char* file, int line);
+void unity_assert_equal_memory(const void* expected, const void* actual, size_t length, const char* file, int line);
+
+#define UNITY_BEGIN() unity_begin()
+#define UNITY_END() unity_end()
+
+#define TEST_FAIL_MESSAGE(message) unity_fail(__FILE__, __LINE__, "%s", message)
+#define TEST_FAIL() unity_fail(__FILE__, __LINE__, "Test failed")
+#define TEST_ASSERT_MESSAGE(condition, message)                                                                        \
+    do {                                                                                                               \
+        if (!(condition)) unity_fail(__FILE__, __LINE__, "%s", message);                                               \
+    } while (0)
+#define TEST_ASSERT(condition) TEST_ASSERT_MESSAGE(condition, "Expression evaluated to FALSE: " #condition)
+#define TEST_ASSERT_TRUE(condition) TEST_ASSERT_MESSAGE(condition, "Expected TRUE Was FALSE: " #condition)
+#define TEST_ASSERT_FALSE(condition) TEST_ASSERT_MESSAGE(!(condition), "Expected FALSE Was TRUE: " #condition)
+#define TEST_ASSERT_NULL(pointer) TEST_ASSERT_MESSAGE((pointer) == NULL, "Expected NULL: " #pointer)
+#define TEST_ASSERT_NOT_NULL(pointer) TEST_ASSERT_MESSAGE((pointer) != NULL, "Expected Non-NULL: " #pointer)
+
+#define TEST_ASSERT_EQUAL(expected, actual)                                                                            \
+    unity_assert_equal_int((long long)(expected), (long long)(actual), __FILE__, __LINE__)
+#define TEST_ASSERT_EQUAL_INT(expected, actual) TEST_ASSERT_EQUAL(expected, actual)
+#define TEST_ASSERT_EQUAL_INT8(expected, actual) TEST_ASSERT_EQUAL((int8_t)(expected), (int8_t)(actual))
+#define TEST_ASSERT_EQUAL_INT32(expected, actual) TEST_ASSERT_EQUAL((int32_t)(expected), (int32_t)(actual))
+#define TEST_ASSERT_EQUAL_INT64(expected, actual) TEST_ASSERT_EQUAL((int64_t)(expected), (int64_t)(actual))
+#define TEST_ASSERT_EQUAL_UINT(expected, actual) TEST_ASSERT_EQUAL((unsigned)(expected), (unsigned)(actual))
+#define TEST_ASSERT_EQUAL_UINT8(expected, actual) TEST_ASSERT_EQUAL((uint8_t)(expected), (uint8_t)(actual))
+#define TEST_ASSERT_EQUAL_UINT16(expected, actual) TEST_ASSERT_EQUAL((uint16_t)(expected), (uint16_t)(actual))
+#define TEST_ASSERT_EQUAL_UINT32(expected, actual) TEST_ASSERT_EQUAL((uint32_t)(expected), (uint32_t)(actual))
+#define TEST_ASSERT_EQUAL_STRING(expected, actual) unity_assert_equal_string(expected, actual, __FILE__, __LINE__)
+#define TEST_ASSERT_EQUAL_MEMORY(expected, actual, len)                                                                \
+    unity_assert_equal_memory(expected, actual, len, __FILE__, __LINE__)
+
+#define UNITY_COMPARE_(threshold, actual, op, op_str)                                                                  \
+    do {                                                                                                               \
+        long long threshold_ = (long long)(threshold);                                                                 \
+        long long actual_ = (long long)(actual);                                                                       \
+        if (!(actual_ op threshold_)) {                                                                                \
+            unity_fail(__FILE__, __LINE__, "Expected %s " op_str " %lld Was %lld", #actual, threshold_, actual_);      \
+        }                                                                                                              \
+    } while (0)
+#define TEST_ASSERT_GREATER_THAN(threshold, actual) UNITY_COMPARE_(threshold, actual, >, ">")
+#define TEST_ASSERT_GREATER_OR_EQUAL(threshold, actual) UNITY_COMPARE_(threshold, actual, >=, ">=")
+#define TEST_ASSERT_LESS_THAN(threshold, actual) UNITY_COMPARE_(threshold, actual, <, "<")
+#define TEST_ASSERT_LESS_OR_EQUAL(threshold, actual) UNITY_COMPARE_(threshold, actual, <=, "<=")
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* H_HOST_UNITY */
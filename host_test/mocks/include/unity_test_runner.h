@@ -0,0 +1,26 @@
+/**
+ * @file unity_test_runner.h
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the ESP-IDF Unity TEST_CASE registration, registering tests from constructors
+ */
+
+#ifndef H_HOST_UNITY_TEST_RUNNER
+#define H_HOST_UNITY_TEST_RUNNER
+
+#include "unity.h"
+
+#define UNITY_EXPAND_(a, b) a##b
+#define UNITY_CONCAT_(a, b) UNITY_EXPAND_(a, b)
+#define UNITY_TEST_UID(what) UNITY_CONCAT_(what, __LINE__)
+
+#define TEST_CASE(name_, desc_)                                                                                        \
+    static void UNITY_TEST_UID(test_func_)(void);                                                                      \
+    __attribute__((constructor)) static void UNITY_TEST_UID(test_reg_helper_)(void) {                                  \
+        static unity_test_desc_t test_desc_ = {                                                                        \
+            .name = name_, .desc = desc_, .fn = &UNITY_TEST_UID(test_func_), .file = __FILE__, .line = __LINE__};      \
+        unity_testcase_register(&test_desc_);                                                                          \
+    }                                                                                                                  \
+    static void UNITY_TEST_UID(test_func_)(void)
+
+#endif /* H_HOST_UNITY_TEST_RUNNER */
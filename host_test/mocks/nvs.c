@@ -0,0 +1,198 @@
+/**
+ * @file nvs.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for ESP-IDF NVS, storing blobs in memory with namespaces matched by name
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvs.h"
+#include "nvs_flash.h"
+
+#define HOST_NVS_MAX_ENTRIES 32 /**< Number of keys that can be stored across all namespaces */
+#define HOST_NVS_MAX_HANDLES 8  /**< Number of handles that can be open at once */
+#define HOST_NVS_NAME_SIZE 16   /**< Namespace and key size including terminator, matching NVS_KEY_NAME_MAX_SIZE */
+
+/** @brief Stored blob */
+typedef struct {
+    bool in_use;                         /**< Entry holds a blob */
+    char namespace[HOST_NVS_NAME_SIZE];  /**< Namespace of the key */
+    char key[HOST_NVS_NAME_SIZE];        /**< Key name */
+    void* value;                         /**< Heap copy of the blob */
+    size_t length;                       /**< Blob length */
+} host_nvs_entry_t;
+
+/** @brief Open handle */
+typedef struct {
+    bool in_use;                        /**< Handle is open */
+    bool read_only;                     /**< Opened with NVS_READONLY */
+    char namespace[HOST_NVS_NAME_SIZE]; /**< Namespace the handle was opened in */
+} host_nvs_handle_t;
+
+static pthread_mutex_t nvs_mutex = PTHREAD_MUTEX_INITIALIZER;
+static host_nvs_entry_t entries[HOST_NVS_MAX_ENTRIES];
+static host_nvs_handle_t handles[HOST_NVS_MAX_HANDLES];
+static bool initialized = false;
+
+/**
+ * @brief Returns the open handle slot for handle, or NULL, must be called with the mutex held
+ */
+static host_nvs_handle_t* get_handle(nvs_handle_t handle) {
+    if ((handle == 0) || (handle > HOST_NVS_MAX_HANDLES) || !handles[handle - 1].in_use) return NULL;
+    return &handles[handle - 1];
+}
+
+/**
+ * @brief Returns the entry for key in namespace, or NULL, must be called with the mutex held
+ */
+static host_nvs_entry_t* find_entry(const char* namespace, const char* key) {
+    for (size_t i = 0; i < HOST_NVS_MAX_ENTRIES; i++) {
+        if (entries[i].in_use && !strcmp(entries[i].namespace, namespace) && !strcmp(entries[i].key, key)) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t nvs_flash_init(void) {
+    pthread_mutex_lock(&nvs_mutex);
+    initialized = true;
+    pthread_mutex_unlock(&nvs_mutex);
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void) {
+    pthread_mutex_lock(&nvs_mutex);
+    for (size_t i = 0; i < HOST_NVS_MAX_ENTRIES; i++) {
+        free(entries[i].value);
+        entries[i] = (host_nvs_entry_t){0};
+    }
+    pthread_mutex_unlock(&nvs_mutex);
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char* namespace_name, nvs_open_mode_t open_mode, nvs_handle_t* out_handle) {
+    if (!namespace_name || !out_handle || (strlen(namespace_name) >= HOST_NVS_NAME_SIZE)) return ESP_ERR_INVALID_ARG;
+
+    esp_err_t err = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    pthread_mutex_lock(&nvs_mutex);
+    if (!initialized) {
+        err = ESP_ERR_NVS_NOT_INITIALIZED;
+    } else {
+        for (size_t i = 0; i < HOST_NVS_MAX_HANDLES; i++) {
+            if (handles[i].in_use) continue;
+            handles[i].in_use = true;
+            handles[i].read_only = (open_mode == NVS_READONLY);
+            strcpy(handles[i].namespace, namespace_name);
+            *out_handle = i + 1;
+            err = ESP_OK;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&nvs_mutex);
+
+    return err;
+}
+
+void nvs_close(nvs_handle_t handle) {
+    pthread_mutex_lock(&nvs_mutex);
+    host_nvs_handle_t* p_handle = get_handle(handle);
+    if (p_handle) p_handle->in_use = false;
+    pthread_mutex_unlock(&nvs_mutex);
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out_value, size_t* length) {
+    if (!key || !length) return ESP_ERR_INVALID_ARG;
+
+    esp_err_t err = ESP_OK;
+    pthread_mutex_lock(&nvs_mutex);
+    host_nvs_handle_t* p_handle = get_handle(handle);
+    host_nvs_entry_t* p_entry = p_handle ? find_entry(p_handle->namespace, key) : NULL;
+    if (!p_handle) {
+        err = ESP_ERR_INVALID_ARG;
+    } else if (!p_entry) {
+        err = ESP_ERR_NVS_NOT_FOUND;
+    } else if (!out_value) {
+        /* Length query, like NVS */
+        *length = p_entry->length;
+    } else if (*length < p_entry->length) {
+        *length = p_entry->length;
+        err = ESP_ERR_NVS_INVALID_LENGTH;
+    } else {
+        memcpy(out_value, p_entry->value, p_entry->length);
+        *length = p_entry->length;
+    }
+    pthread_mutex_unlock(&nvs_mutex);
+
+    return err;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+    if (!key || !value || (strlen(key) >= HOST_NVS_NAME_SIZE)) return ESP_ERR_INVALID_ARG;
+
+    void* copy = malloc(length ? length : 1);
+    if (!copy) return ESP_ERR_NO_MEM;
+    memcpy(copy, value, length);
+
+    esp_err_t err = ESP_OK;
+    pthread_mutex_lock(&nvs_mutex);
+    host_nvs_handle_t* p_handle = get_handle(handle);
+    host_nvs_entry_t* p_entry = p_handle ? find_entry(p_handle->namespace, key) : NULL;
+    if (!p_handle) {
+        err = ESP_ERR_INVALID_ARG;
+    } else if (p_handle->read_only) {
+        err = ESP_ERR_NVS_READ_ONLY;
+    } else {
+        for (size_t i = 0; !p_entry && (i < HOST_NVS_MAX_ENTRIES); i++) {
+            if (!entries[i].in_use) p_entry = &entries[i];
+        }
+        if (!p_entry) {
+            err = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+        } else {
+            free(p_entry->value);
+            p_entry->in_use = true;
+            strcpy(p_entry->namespace, p_handle->namespace);
+            strcpy(p_entry->key, key);
+            p_entry->value = copy;
+            p_entry->length = length;
+            copy = NULL;
+        }
+    }
+    pthread_mutex_unlock(&nvs_mutex);
+
+    free(copy);
+    return err;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char* key) {
+    if (!key) return ESP_ERR_INVALID_ARG;
+
+    esp_err_t err = ESP_OK;
+    pthread_mutex_lock(&nvs_mutex);
+    host_nvs_handle_t* p_handle = get_handle(handle);
+    host_nvs_entry_t* p_entry = p_handle ? find_entry(p_handle->namespace, key) : NULL;
+    if (!p_handle) {
+        err = ESP_ERR_INVALID_ARG;
+    } else if (p_handle->read_only) {
+        err = ESP_ERR_NVS_READ_ONLY;
+    } else if (!p_entry) {
+        err = ESP_ERR_NVS_NOT_FOUND;
+    } else {
+        free(p_entry->value);
+        *p_entry = (host_nvs_entry_t){0};
+    }
+    pthread_mutex_unlock(&nvs_mutex);
+
+    return err;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    pthread_mutex_lock(&nvs_mutex);
+    esp_err_t err = get_handle(handle) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    pthread_mutex_unlock(&nvs_mutex);
+    return err;
+}
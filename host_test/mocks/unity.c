@@ -0,0 +1,92 @@
+/**
+ * @file unity.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host stand-in for the Unity test framework runner and assertions
+ */
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "unity.h"
+
+static unity_test_desc_t* test_list = NULL; /**< Registered tests, in registration order */
+static jmp_buf test_abort;                  /**< Return point of a failed assertion */
+static unsigned int tests_run = 0;
+static unsigned int tests_failed = 0;
+
+/**
+ * @brief Runs a single test, catching assertion failures
+ */
+static void run_test(const unity_test_desc_t* desc) {
+    tests_run++;
+    if (setjmp(test_abort) == 0) {
+        desc->fn();
+        printf("%s:%d:%s:PASS\n", desc->file, desc->line, desc->name);
+    } else {
+        tests_failed++;
+    }
+}
+
+void unity_testcase_register(unity_test_desc_t* desc) {
+    unity_test_desc_t** pp_tail = &test_list;
+    while (*pp_tail) pp_tail = &(*pp_tail)->next;
+    desc->next = NULL;
+    *pp_tail = desc;
+}
+
+void unity_run_tests_by_tag(const char* tag, bool invert) {
+    for (const unity_test_desc_t* desc = test_list; desc; desc = desc->next) {
+        bool match = (strstr(desc->desc, tag) != NULL);
+        if (match != invert) run_test(desc);
+    }
+}
+
+void unity_run_all_tests(void) {
+    for (const unity_test_desc_t* desc = test_list; desc; desc = desc->next) run_test(desc);
+}
+
+void unity_begin(void) {
+    tests_run = 0;
+    tests_failed = 0;
+}
+
+int unity_end(void) {
+    printf("-----------------------\n%u Tests %u Failures 0 Ignored\n%s\n", tests_run, tests_failed,
+           tests_failed ? "FAIL" : "OK");
+    return (int)tests_failed;
+}
+
+void unity_fail(const char* file, int line, const char* format, ...) {
+    printf("%s:%d:FAIL: ", file, line);
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+    longjmp(test_abort, 1);
+}
+
+void unity_assert_equal_int(long long expected, long long actual, const char* file, int line) {
+    if (expected != actual) unity_fail(file, line, "Expected %lld Was %lld", expected, actual);
+}
+
+void unity_assert_equal_string(const char* expected, const char* actual, const char* file, int line) {
+    if (expected && actual && (strcmp(expected, actual) == 0)) return;
+    if (!expected && !actual) return;
+    unity_fail(file, line, "Expected \"%s\" Was \"%s\"", expected ? expected : "(null)", actual ? actual : "(null)");
+}
+
+void unity_assert_equal_memory(const void* expected, const void* actual, size_t length, const char* file, int line) {
+    if (!expected || !actual) unity_fail(file, line, "Expected Non-NULL memory pointers");
+    const uint8_t* p_expected = expected;
+    const uint8_t* p_actual = actual;
+    for (size_t i = 0; i < length; i++) {
+        if (p_expected[i] != p_actual[i]) {
+            unity_fail(file, line, "Memory mismatch at byte %zu: Expected 0x%02X Was 0x%02X", i, p_expected[i],
+                       p_actual[i]);
+        }
+    }
+}
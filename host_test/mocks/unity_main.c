@@ -0,0 +1,24 @@
+/**
+ * @file unity_main.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host test runner for component Unity tests, the host counterpart of hue_test_app
+ *
+ * Usage: <runner> [tag...] runs tests matching any of the given tags, or every registered test without arguments.
+ */
+
+#include <stdio.h>
+
+#include "unity.h"
+
+int main(int argc, char** argv) {
+    setvbuf(stdout, NULL, _IONBF, 0); /* Keep results that precede a crash */
+
+    UNITY_BEGIN();
+    if (argc < 2) {
+        unity_run_all_tests();
+    } else {
+        for (int i = 1; i < argc; i++) unity_run_tests_by_tag(argv[i], false);
+    }
+    return UNITY_END() ? 1 : 0;
+}
@@ -0,0 +1,391 @@
+/**
+ * @file rssi_replay.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host tool for encoding RSSI traces and replaying them through the proximity filters faster than real time
+ *
+ * Usage:
+ *  rssi_replay encode <input.csv> <output.bin>
+ *  rssi_replay replay [options] <trace.bin>
+ *
+ * CSV lines are "time_ms,address,rssi" for samples or "time_ms,address,present|absent" for ground truth markers.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "proximity.h"
+#include "rssi_trace.h"
+
+/*====================================================================================================================*/
+/*===================================================== Defines ======================================================*/
+/*====================================================================================================================*/
+
+#define RSSI_REPLAY_MAX_ADDRESSES 16 /**< Number of beacon addresses tracked during replay */
+#define RSSI_REPLAY_LINE_SIZE 128    /**< Maximum length of a CSV line */
+
+/*====================================================================================================================*/
+/*========================================== Private Structure Definitions ===========================================*/
+/*====================================================================================================================*/
+
+/** @brief Replay statistics for a single beacon address */
+typedef struct {
+    bool in_use;                 /**< Address has appeared in the trace */
+    proximity_filter_t filter;   /**< Filter under test */
+    proximity_state_t truth;     /**< Ground truth state from the most recent marker */
+    bool awaiting_detection;     /**< A marker has not yet been matched by a filter edge */
+    int64_t marker_time_us;      /**< Time of the most recent marker */
+    uint32_t samples;            /**< Number of samples replayed */
+    uint32_t edges;              /**< Number of state changes reported by the filter */
+    uint32_t flaps;              /**< State changes that disagree with the ground truth */
+    uint32_t detections;         /**< Markers matched by a filter edge */
+    uint32_t missed;             /**< Markers that were replaced before being matched */
+    int64_t latency_sum_us;      /**< Sum of marker to edge latencies */
+    int64_t latency_max_us;      /**< Largest marker to edge latency */
+    int64_t debounce_sum_us;     /**< Sum of threshold crossing to edge latencies */
+} replay_address_t;
+
+/*====================================================================================================================*/
+/*========================================== Private Function Declarations ===========================================*/
+/*====================================================================================================================*/
+
+/**
+ * @brief Sink for rssi_trace_writer_t writing to a stdio file
+ *
+ * @param[in] ctx FILE pointer to write to
+ * @param[in] data Encoded bytes
+ * @param[in] length Number of bytes
+ *
+ * @return ESP_OK on success, ESP_FAIL on a short write
+ */
+static esp_err_t file_sink(void* ctx, const uint8_t* data, size_t length);
+
+/**
+ * @brief Converts a CSV file of samples and markers into a binary trace
+ *
+ * @param[in] input_path CSV file path
+ * @param[in] output_path Binary trace file path
+ *
+ * @return Process exit code
+ */
+static int encode_trace(const char* input_path, const char* output_path);
+
+/**
+ * @brief Processes a single filter edge against the ground truth
+ *
+ * @param[in,out] p_address Address statistics to update
+ * @param[in] p_edge Edge reported by the filter
+ */
+static void handle_edge(replay_address_t* p_address, const proximity_edge_t* p_edge);
+
+/**
+ * @brief Replays a binary trace through the proximity filters and prints the results
+ *
+ * @param[in] argc Argument count after the "replay" command
+ * @param[in] argv Arguments after the "replay" command
+ *
+ * @return Process exit code
+ */
+static int replay_trace(int argc, char** argv);
+
+/**
+ * @brief Reads an entire file into a heap buffer
+ *
+ * @param[in] path File path
+ * @param[out] p_length Number of bytes read
+ *
+ * @return Heap buffer that must be freed, or NULL on failure
+ */
+static uint8_t* read_file(const char* path, size_t* p_length);
+
+/**
+ * @brief Returns elapsed time of a clock in nanoseconds
+ *
+ * @param[in] clock_id Clock to read
+ *
+ * @return Clock time in nanoseconds
+ */
+static int64_t clock_ns(clockid_t clock_id);
+
+/*====================================================================================================================*/
+/*=========================================== Public Function Definitions ============================================*/
+/*====================================================================================================================*/
+
+int main(int argc, char** argv) {
+    if ((argc == 4) && (strcmp(argv[1], "encode") == 0)) return encode_trace(argv[2], argv[3]);
+    if ((argc >= 3) && (strcmp(argv[1], "replay") == 0)) return replay_trace(argc - 1, argv + 1);
+
+    fprintf(stderr,
+            "Usage:\n"
+            "  %s encode <input.csv> <output.bin>\n"
+            "  %s replay [--enter dBm] [--exit dBm] [--window n] [--debounce n] [--timeout-ms ms]\n"
+            "            [--address n] [--expect-detections n] <trace.bin>\n",
+            argv[0], argv[0]);
+    return 2;
+}
+
+/*====================================================================================================================*/
+/*=========================================== Private Function Definitions ===========================================*/
+/*====================================================================================================================*/
+
+static esp_err_t file_sink(void* ctx, const uint8_t* data, size_t length) {
+    return (fwrite(data, 1, length, (FILE*)ctx) == length) ? ESP_OK : ESP_FAIL;
+}
+
+static int encode_trace(const char* input_path, const char* output_path) {
+    FILE* input = fopen(input_path, "r");
+    if (!input) {
+        fprintf(stderr, "Failed to open %s: %s\n", input_path, strerror(errno));
+        return 1;
+    }
+    FILE* output = fopen(output_path, "wb");
+    if (!output) {
+        fprintf(stderr, "Failed to open %s: %s\n", output_path, strerror(errno));
+        fclose(input);
+        return 1;
+    }
+
+    rssi_trace_writer_t writer;
+    rssi_trace_writer_init(&writer, file_sink, output);
+
+    char line[RSSI_REPLAY_LINE_SIZE];
+    char value[16];
+    unsigned long line_num = 0;
+    uint32_t records = 0;
+    unsigned int time_ms, address;
+    esp_err_t err = ESP_OK;
+
+    while (fgets(line, sizeof(line), input)) {
+        line_num++;
+        if ((line[0] == '#') || (line[0] == '\n') || (line[0] == '\r')) continue;
+
+        if (sscanf(line, "%u,%u,%15[^,\r\n]", &time_ms, &address, value) != 3) {
+            fprintf(stderr, "%s:%lu: expected time_ms,address,rssi|present|absent\n", input_path, line_num);
+            err = ESP_FAIL;
+            break;
+        }
+
+        if (strcmp(value, "present") == 0) {
+            err = rssi_trace_write_marker(&writer, time_ms, address, true);
+        } else if (strcmp(value, "absent") == 0) {
+            err = rssi_trace_write_marker(&writer, time_ms, address, false);
+        } else {
+            err = rssi_trace_write_sample(&writer, time_ms, address, (int8_t)atoi(value));
+        }
+        if (err != ESP_OK) {
+            fprintf(stderr, "%s:%lu: failed to encode record (%s)\n", input_path, line_num, esp_err_to_name(err));
+            break;
+        }
+        records++;
+    }
+
+    if (err == ESP_OK) err = rssi_trace_flush(&writer);
+    long size = ftell(output);
+    fclose(output);
+    fclose(input);
+    if (err != ESP_OK) return 1;
+
+    printf("Encoded %u records into %ld bytes (%.2f bytes/record)\n", records, size,
+           records ? (double)(size - RSSI_TRACE_HEADER_LENGTH) / records : 0.0);
+    return 0;
+}
+
+static void handle_edge(replay_address_t* p_address, const proximity_edge_t* p_edge) {
+    p_address->edges++;
+    p_address->debounce_sum_us += p_edge->edge_time_us - p_edge->crossing_time_us;
+
+    /* Any edge into a state the beacon is not actually in is a flap */
+    if (p_edge->state != p_address->truth) {
+        p_address->flaps++;
+        return;
+    }
+
+    if (!p_address->awaiting_detection) return;
+
+    int64_t latency = p_edge->edge_time_us - p_address->marker_time_us;
+    p_address->awaiting_detection = false;
+    p_address->detections++;
+    p_address->latency_sum_us += latency;
+    if (latency > p_address->latency_max_us) p_address->latency_max_us = latency;
+}
+
+static int replay_trace(int argc, char** argv) {
+    proximity_config_t config = {
+        .enter_rssi = -65, .exit_rssi = -75, .window_size = 8, .debounce_samples = 2, .exit_timeout_ms = 10000};
+    long only_address = -1;
+    long expect_detections = -1;
+
+    static const struct option options[] = {{"enter", required_argument, NULL, 'e'},
+                                            {"exit", required_argument, NULL, 'x'},
+                                            {"window", required_argument, NULL, 'w'},
+                                            {"debounce", required_argument, NULL, 'd'},
+                                            {"timeout-ms", required_argument, NULL, 't'},
+                                            {"address", required_argument, NULL, 'a'},
+                                            {"expect-detections", required_argument, NULL, 'D'},
+                                            {NULL, 0, NULL, 0}};
+    int opt;
+    while ((opt = getopt_long(argc, argv, "", options, NULL)) != -1) {
+        switch (opt) {
+            case 'e':
+                config.enter_rssi = atoi(optarg);
+                break;
+            case 'x':
+                config.exit_rssi = atoi(optarg);
+                break;
+            case 'w':
+                config.window_size = atoi(optarg);
+                break;
+            case 'd':
+                config.debounce_samples = atoi(optarg);
+                break;
+            case 't':
+                config.exit_timeout_ms = strtoul(optarg, NULL, 10);
+                break;
+            case 'a':
+                only_address = strtol(optarg, NULL, 10);
+                break;
+            case 'D':
+                expect_detections = strtol(optarg, NULL, 10);
+                break;
+            default:
+                return 2;
+        }
+    }
+    if (optind != argc - 1) {
+        fprintf(stderr, "Expected a single trace file\n");
+        return 2;
+    }
+
+    size_t length;
+    uint8_t* data = read_file(argv[optind], &length);
+    if (!data) return 1;
+
+    rssi_trace_reader_t reader;
+    if (rssi_trace_reader_init(&reader, data, length) != ESP_OK) {
+        free(data);
+        return 1;
+    }
+
+    static replay_address_t addresses[RSSI_REPLAY_MAX_ADDRESSES];
+    rssi_trace_record_t record;
+    proximity_edge_t edge;
+    uint32_t records = 0;
+    uint32_t samples = 0;
+    uint32_t last_time_ms = 0;
+    esp_err_t err;
+
+    int64_t wall_start = clock_ns(CLOCK_MONOTONIC);
+    int64_t cpu_start = clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+
+    while ((err = rssi_trace_read(&reader, &record)) == ESP_OK) {
+        records++;
+        last_time_ms = record.time_ms;
+        if ((only_address >= 0) && (record.address != only_address)) continue;
+        if (record.address >= RSSI_REPLAY_MAX_ADDRESSES) continue;
+
+        replay_address_t* p_address = &addresses[record.address];
+        int64_t time_us = (int64_t)record.time_ms * 1000;
+
+        if (!p_address->in_use) {
+            if (proximity_filter_init(&p_address->filter, &config) != ESP_OK) {
+                free(data);
+                return 2;
+            }
+            p_address->in_use = true;
+        }
+
+        /* Let every tracked filter notice beacon loss at the current trace time */
+        for (size_t i = 0; i < RSSI_REPLAY_MAX_ADDRESSES; i++) {
+            if (addresses[i].in_use && proximity_filter_tick(&addresses[i].filter, time_us, &edge)) {
+                handle_edge(&addresses[i], &edge);
+            }
+        }
+
+        if (record.marker) {
+            proximity_state_t truth = record.value ? PROXIMITY_STATE_PRESENT : PROXIMITY_STATE_ABSENT;
+            if (truth == p_address->truth) continue;
+            if (p_address->awaiting_detection) p_address->missed++;
+            p_address->truth = truth;
+            p_address->marker_time_us = time_us;
+            p_address->awaiting_detection = (p_address->filter.state != truth);
+            continue;
+        }
+
+        samples++;
+        p_address->samples++;
+        if (proximity_filter_update(&p_address->filter, record.value, time_us, &edge)) {
+            handle_edge(p_address, &edge);
+        }
+    }
+
+    int64_t cpu_ns = clock_ns(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+    int64_t wall_ns = clock_ns(CLOCK_MONOTONIC) - wall_start;
+    free(data);
+
+    if (err != ESP_ERR_NOT_FOUND) {
+        fprintf(stderr, "Trace decoding stopped after %u records (%s)\n", records, esp_err_to_name(err));
+        return 1;
+    }
+
+    printf("Config: enter %d dBm, exit %d dBm, window %u, debounce %u, timeout %u ms\n", config.enter_rssi,
+           config.exit_rssi, config.window_size, config.debounce_samples, config.exit_timeout_ms);
+    printf("Replayed %u records (%u samples) covering %.1f s in %.3f ms (%.0fx real time)\n", records, samples,
+           last_time_ms / 1000.0, wall_ns / 1e6, wall_ns ? (last_time_ms * 1e6) / wall_ns : 0.0);
+    printf("CPU time: %.1f ns/sample\n", samples ? (double)cpu_ns / samples : 0.0);
+    printf("%-8s %8s %6s %6s %10s %7s %14s %14s %15s\n", "address", "samples", "edges", "flaps", "detections",
+           "missed", "latency avg ms", "latency max ms", "debounce avg ms");
+
+    long total_detections = 0;
+    for (size_t i = 0; i < RSSI_REPLAY_MAX_ADDRESSES; i++) {
+        replay_address_t* p_address = &addresses[i];
+        if (!p_address->in_use) continue;
+
+        /* A marker never matched by the end of the trace counts as missed */
+        uint32_t missed = p_address->missed + (p_address->awaiting_detection ? 1 : 0);
+        total_detections += p_address->detections;
+
+        printf("%-8zu %8u %6u %6u %10u %7u %14.1f %14.1f %15.1f\n", i, p_address->samples, p_address->edges,
+               p_address->flaps, p_address->detections, missed,
+               p_address->detections ? p_address->latency_sum_us / 1000.0 / p_address->detections : 0.0,
+               p_address->latency_max_us / 1000.0,
+               p_address->edges ? p_address->debounce_sum_us / 1000.0 / p_address->edges : 0.0);
+    }
+
+    if ((expect_detections >= 0) && (total_detections != expect_detections)) {
+        fprintf(stderr, "Expected %ld detections, got %ld\n", expect_detections, total_detections);
+        return 1;
+    }
+    return 0;
+}
+
+static uint8_t* read_file(const char* path, size_t* p_length) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s: %s\n", path, strerror(errno));
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t* data = malloc(size > 0 ? size : 1);
+    if (data && (fread(data, 1, size, file) != (size_t)size)) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+
+    *p_length = size;
+    return data;
+}
+
+static int64_t clock_ns(clockid_t clock_id) {
+    struct timespec ts;
+    clock_gettime(clock_id, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
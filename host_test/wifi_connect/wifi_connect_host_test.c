@@ -0,0 +1,202 @@
+/**
+ * @file wifi_connect_host_test.c
+ * @author Tanner Baccus
+ * @date 16 October 2026
+ * @brief Host tests for wifi_connect against the simulated WiFi driver
+ *
+ * The tests share a single connection and run in order: the first establishes it through a timeout recovery, the next
+ * script disconnects and escalating recoveries against it, and the last connects again after wifi_disconnect() as a
+ * restart would, with the AP cache the first connection saved to NVS.
+ */
+
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "esp_event.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "lwip/ip4_addr.h"
+
+#include "host_mocks.h"
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "wifi_connect.h"
+
+#define CONNECT_WAIT_TICKS pdMS_TO_TICKS(5000) /**< Longest time to wait for WIFI_CONNECT_EVENT_CONNECTED */
+#define AP_CACHE_SIZE 7                        /**< BSSID then channel, as wifi_connect stores the AP cache */
+
+static SemaphoreHandle_t connected_sem;                /**< Given on every WIFI_CONNECT_EVENT_CONNECTED */
+static wifi_connect_connected_data_t connected_data;   /**< Data of the most recent WIFI_CONNECT_EVENT_CONNECTED */
+static volatile uint32_t disconnected_events;          /**< Number of WIFI_CONNECT_EVENT_DISCONNECTED received */
+
+static void connect_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data) {
+    if (event_id == WIFI_CONNECT_EVENT_CONNECTED) {
+        memcpy(&connected_data, event_data, sizeof(connected_data));
+        xSemaphoreGive(connected_sem);
+    } else if (event_id == WIFI_CONNECT_EVENT_DISCONNECTED) {
+        disconnected_events++;
+    }
+}
+
+static void read_ap_cache(uint8_t* ap_cache) {
+    nvs_handle_t nvs;
+    size_t length = AP_CACHE_SIZE;
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_open("wifi_connect", NVS_READONLY, &nvs));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_get_blob(nvs, "ap_cache", ap_cache, &length));
+    nvs_close(nvs);
+    TEST_ASSERT_EQUAL(AP_CACHE_SIZE, length);
+}
+
+TEST_CASE("Connect recovers from a pinned BSSID that is not in range", "[wifi_connect]") {
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_init());
+    TEST_ASSERT_EQUAL(ESP_OK, esp_event_loop_create_default());
+    TEST_ASSERT_NOT_NULL(connected_sem = xSemaphoreCreateBinary());
+    TEST_ASSERT_EQUAL(ESP_OK, esp_event_handler_register(WIFI_CONNECT_EVENT, ESP_EVENT_ANY_ID, connect_event_handler,
+                                                         NULL));
+
+    /* Pinned BSSID differs from the simulated AP, so only the rescan after the timeout can connect. The pin keeps the
+     * AP cache from being used, but the AP connected to is still saved */
+    wifi_connect_config_t config = {
+        .ssid = "host_ssid",
+        .password = "host_password",
+        .advanced_configs = {.bssid_set = true, .bssid_str = "02:00:00:00:00:99", .timeout_set = true,
+                             .timeout_seconds = 1, .ap_cache_set = true},
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, wifi_connect(&config));
+    TEST_ASSERT_TRUE(xSemaphoreTake(connected_sem, CONNECT_WAIT_TICKS));
+
+    wifi_connect_summary_t* p_summary = &connected_data.summary;
+    TEST_ASSERT_EQUAL(WIFI_CONNECT_RECOVERY_RESCAN, p_summary->recovery);
+    TEST_ASSERT_EQUAL(WIFI_ALL_CHANNEL_SCAN, p_summary->scan_method);
+    TEST_ASSERT_FALSE(p_summary->bssid_set); /* The rescan dropped the pin */
+    TEST_ASSERT_FALSE(p_summary->ap_cache_used);
+    TEST_ASSERT_GREATER_THAN(1, p_summary->attempts);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, p_summary->reason_count);
+    TEST_ASSERT_EQUAL(WIFI_REASON_NO_AP_FOUND, p_summary->reasons[0]);
+    TEST_ASSERT_EQUAL(6, p_summary->channel);
+    TEST_ASSERT_GREATER_OR_EQUAL(p_summary->associated_us, p_summary->got_ip_us);
+    TEST_ASSERT_EQUAL(ipaddr_addr("192.168.1.50"), connected_data.ip_info.ip.addr);
+}
+
+TEST_CASE("Reconnect after a dropped connection records failed attempts", "[wifi_connect]") {
+    host_wifi_ap_t ap = {
+        .present = true,
+        .bssid = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01},
+        .channel = 6,
+        .associate_ms = 20,
+        .dhcp_ms = 10,
+        .fail_attempts = 2,
+        .fail_reason = WIFI_REASON_AUTH_FAIL,
+        .ip = ipaddr_addr("192.168.1.50"),
+    };
+    host_wifi_sim_set_ap(&ap);
+
+    uint32_t disconnects_before = disconnected_events;
+    host_wifi_sim_drop(WIFI_REASON_BEACON_TIMEOUT);
+    TEST_ASSERT_TRUE(xSemaphoreTake(connected_sem, CONNECT_WAIT_TICKS));
+
+    /* Reconnect is timed from the drop, so only the attempts after it are counted */
+    wifi_connect_summary_t* p_summary = &connected_data.summary;
+    TEST_ASSERT_EQUAL(WIFI_CONNECT_RECOVERY_NONE, p_summary->recovery);
+    TEST_ASSERT_EQUAL(3, p_summary->attempts);
+    TEST_ASSERT_EQUAL(2, p_summary->reason_count);
+    TEST_ASSERT_EQUAL(WIFI_REASON_AUTH_FAIL, p_summary->reasons[0]);
+    TEST_ASSERT_EQUAL(WIFI_REASON_AUTH_FAIL, p_summary->reasons[1]);
+    TEST_ASSERT_EQUAL(0, p_summary->init_us);
+    TEST_ASSERT_EQUAL(disconnects_before + 3, disconnected_events);
+}
+
+TEST_CASE("Reconnect reinitializes the driver once the rescan finds no AP either", "[wifi_connect]") {
+    host_wifi_ap_t ap = {
+        .present = false,
+        .bssid = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01},
+        .channel = 6,
+        .associate_ms = 20,
+        .dhcp_ms = 10,
+        .ip = ipaddr_addr("192.168.1.50"),
+    };
+    host_wifi_sim_set_ap(&ap);
+
+    uint32_t inits_before;
+    host_wifi_sim_get_counts(NULL, &inits_before);
+    host_wifi_sim_drop(WIFI_REASON_BEACON_TIMEOUT);
+
+    /* The first timeout rescans and the second reinitializes the driver, the AP returns before a third restarts */
+    uint32_t inits = inits_before;
+    for (uint32_t i = 0; (i < 500) && (inits == inits_before); i++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+        host_wifi_sim_get_counts(NULL, &inits);
+    }
+    TEST_ASSERT_EQUAL(inits_before + 1, inits);
+    ap.present = true;
+    host_wifi_sim_set_ap(&ap);
+    TEST_ASSERT_TRUE(xSemaphoreTake(connected_sem, CONNECT_WAIT_TICKS));
+
+    wifi_connect_summary_t* p_summary = &connected_data.summary;
+    TEST_ASSERT_EQUAL(WIFI_CONNECT_RECOVERY_REINIT, p_summary->recovery);
+    TEST_ASSERT_EQUAL(WIFI_ALL_CHANNEL_SCAN, p_summary->scan_method);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, p_summary->reason_count);
+    TEST_ASSERT_EQUAL(WIFI_REASON_NO_AP_FOUND, p_summary->reasons[0]);
+    TEST_ASSERT_EQUAL(6, p_summary->channel);
+}
+
+TEST_CASE("Disconnect deinitializes the driver without reconnecting", "[wifi_connect]") {
+    uint32_t connects_before;
+    host_wifi_sim_get_counts(&connects_before, NULL);
+
+    wifi_disconnect();
+    TEST_ASSERT_EQUAL(ESP_OK, host_event_loop_wait_idle(pdMS_TO_TICKS(1000)));
+
+    uint32_t connects_after;
+    host_wifi_sim_get_counts(&connects_after, NULL);
+    TEST_ASSERT_EQUAL(connects_before, connects_after);
+    TEST_ASSERT_FALSE(xSemaphoreTake(connected_sem, pdMS_TO_TICKS(100)));
+}
+
+TEST_CASE("Connect after a restart is directed to the cached AP and scans once the AP has moved", "[wifi_connect]") {
+    static const uint8_t saved[AP_CACHE_SIZE] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 6};
+    static const uint8_t moved[AP_CACHE_SIZE] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x02, 11};
+    uint8_t ap_cache[AP_CACHE_SIZE];
+    read_ap_cache(ap_cache);
+    TEST_ASSERT_EQUAL_MEMORY(saved, ap_cache, AP_CACHE_SIZE);
+
+    /* The cached AP was replaced by one on another channel, so only the scan after the directed connect finds it */
+    host_wifi_ap_t ap = {
+        .present = true,
+        .bssid = {0x02, 0x00, 0x00, 0x00, 0x00, 0x02},
+        .channel = 11,
+        .associate_ms = 20,
+        .dhcp_ms = 10,
+        .ip = ipaddr_addr("192.168.1.50"),
+    };
+    host_wifi_sim_set_ap(&ap);
+
+    wifi_connect_config_t config = {
+        .ssid = "host_ssid",
+        .password = "host_password",
+        .advanced_configs = {.ap_cache_set = true},
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, wifi_connect(&config));
+    TEST_ASSERT_TRUE(xSemaphoreTake(connected_sem, CONNECT_WAIT_TICKS));
+
+    wifi_connect_summary_t* p_summary = &connected_data.summary;
+    TEST_ASSERT_TRUE(p_summary->ap_cache_used);
+    TEST_ASSERT_FALSE(p_summary->bssid_set);
+    TEST_ASSERT_EQUAL(WIFI_CONNECT_RECOVERY_NONE, p_summary->recovery);
+    TEST_ASSERT_EQUAL(WIFI_FAST_SCAN, p_summary->scan_method);
+    TEST_ASSERT_EQUAL(2, p_summary->attempts);
+    TEST_ASSERT_EQUAL(1, p_summary->reason_count);
+    TEST_ASSERT_EQUAL(WIFI_REASON_NO_AP_FOUND, p_summary->reasons[0]);
+    TEST_ASSERT_EQUAL(11, p_summary->channel);
+
+    /* The AP found by the scan replaces the cached one for the next restart */
+    TEST_ASSERT_EQUAL(ESP_OK, host_event_loop_wait_idle(pdMS_TO_TICKS(1000)));
+    read_ap_cache(ap_cache);
+    TEST_ASSERT_EQUAL_MEMORY(moved, ap_cache, AP_CACHE_SIZE);
+
+    wifi_disconnect();
+    TEST_ASSERT_EQUAL(ESP_OK, host_event_loop_wait_idle(pdMS_TO_TICKS(1000)));
+}
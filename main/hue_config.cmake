@@ -0,0 +1,82 @@
+# Configure time validation of the Philips Hue settings in Kconfig.projbuild, generating hue_config.h with the settings
+# in the forms hue_https uses so that a malformed sdkconfig fails the build instead of failing at boot.
+#
+# Included from main/CMakeLists.txt, where the CONFIG_ variables come from sdkconfig, or run in script mode:
+#   cmake -DCONFIG_HUE_BRIDGE_IP=... [other CONFIG_HUE_ values] -DHUE_CONFIG_OUTPUT=<header> -P hue_config.cmake
+
+set(HUE_CONFIG_TEMPLATE ${CMAKE_CURRENT_LIST_DIR}/hue_config.h.in)
+
+# Fails the build with the setting name and the expected format
+function(hue_config_error name value format)
+    message(FATAL_ERROR "CONFIG_${name} \"${value}\" is not ${format}, set it with idf.py menuconfig "
+                        "(Philips Hue Proximity Control Settings > Philips Hue Settings)")
+endfunction()
+
+# Validates an IPV4 bridge IP, setting <out>_DOTTED to the dotted decimal form without leading zeros, which lwIP would
+# read as octal, and <out>_U32 to the address as a host order integer for hue_https
+function(hue_config_bridge_ip value out)
+    if(NOT value MATCHES "^([0-9][0-9]?[0-9]?)\\.([0-9][0-9]?[0-9]?)\\.([0-9][0-9]?[0-9]?)\\.([0-9][0-9]?[0-9]?)$")
+        hue_config_error(HUE_BRIDGE_IP "${value}" "an IPV4 address")
+    endif()
+
+    # Later regex commands overwrite CMAKE_MATCH_<n>, so the octets are saved first
+    set(octets ${CMAKE_MATCH_1} ${CMAKE_MATCH_2} ${CMAKE_MATCH_3} ${CMAKE_MATCH_4})
+    set(dotted "")
+    set(u32 0)
+    foreach(octet IN LISTS octets)
+        # Leading zeros are stripped before math() so that octets are never read as octal
+        string(REGEX REPLACE "^0+([0-9])" "\\1" octet "${octet}")
+        if(octet GREATER 255)
+            hue_config_error(HUE_BRIDGE_IP "${value}" "an IPV4 address, octet ${octet} is over 255")
+        endif()
+        math(EXPR u32 "(${u32} << 8) | ${octet}")
+        list(APPEND dotted "${octet}")
+    endforeach()
+    list(JOIN dotted "." dotted)
+
+    math(EXPR u32 "${u32}" OUTPUT_FORMAT HEXADECIMAL)
+    set(${out}_DOTTED "${dotted}" PARENT_SCOPE)
+    set(${out}_U32 "${u32}" PARENT_SCOPE)
+endfunction()
+
+# Validates a string of <count> characters from <class>
+function(hue_config_chars name value class count format)
+    string(REPEAT "${class}" ${count} pattern)
+    if(NOT value MATCHES "^${pattern}$")
+        hue_config_error(${name} "${value}" "${format}")
+    endif()
+endfunction()
+
+# Validates a resource ID, setting <out>_ID to its lowercase form and <out>_UUID to a C initializer of its 16 bytes
+function(hue_config_resource_id name value out)
+    string(REPEAT "[0-9a-fA-F]" 4 hex4)
+    if(NOT value MATCHES "^${hex4}${hex4}-${hex4}-${hex4}-${hex4}-${hex4}${hex4}${hex4}$")
+        hue_config_error(${name} "${value}" "a resource ID in the format xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx")
+    endif()
+
+    string(TOLOWER "${value}" id)
+    string(REPLACE "-" "" hex "${id}")
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1, " uuid "${hex}")
+    string(REGEX REPLACE ", $" "" uuid "${uuid}")
+    set(${out}_ID "${id}" PARENT_SCOPE)
+    set(${out}_UUID "{${uuid}}" PARENT_SCOPE)
+endfunction()
+
+# Validates every Philips Hue setting and writes the generated header to <output>
+function(hue_generate_config_header output)
+    hue_config_bridge_ip("${CONFIG_HUE_BRIDGE_IP}" HUE_BRIDGE_IP)
+    hue_config_chars(HUE_BRIDGE_ID "${CONFIG_HUE_BRIDGE_ID}" "[0-9a-fA-F]" 16 "16 hexadecimal characters")
+    hue_config_chars(HUE_APP_KEY "${CONFIG_HUE_APP_KEY}" "[-_0-9a-zA-Z]" 40 "40 URL Base64 characters")
+    hue_config_resource_id(HUE_LIGHT_ID "${CONFIG_HUE_LIGHT_ID}" HUE_LIGHT)
+    hue_config_resource_id(HUE_GROUPED_LIGHT_ID "${CONFIG_HUE_GROUPED_LIGHT_ID}" HUE_GROUPED_LIGHT)
+    hue_config_resource_id(HUE_SMART_SCENE_ID "${CONFIG_HUE_SMART_SCENE_ID}" HUE_SMART_SCENE)
+
+    configure_file(${HUE_CONFIG_TEMPLATE} ${output} @ONLY)
+endfunction()
+
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE)
+    if(NOT HUE_CONFIG_OUTPUT)
+        message(FATAL_ERROR "HUE_CONFIG_OUTPUT must be set to the header to generate")
+    endif()
+    hue_generate_config_header(${HUE_CONFIG_OUTPUT})
+endif()
@@ -14,6 +14,8 @@
 #include "wifi_connect.h"
 #include "hue_https.h"
 #include "hue_json_builder.h"
+#include "hue_config.h"
+#include "proximity.h"
 
 // #include "hue_test_app.h"
 
@@ -21,6 +23,14 @@
 
 static const char* tag = "main";
 
+/* Single core chips have no core options, both tasks then run on the only core */
+#ifndef CONFIG_HUE_HTTPS_TASK_CORE
+#define CONFIG_HUE_HTTPS_TASK_CORE -1
+#endif
+#ifndef CONFIG_HUE_PROXIMITY_TASK_CORE
+#define CONFIG_HUE_PROXIMITY_TASK_CORE -1
+#endif
+
 // static TaskHandle_t hue_task_handle;
 
 // static void hue_task(void* pvparameters) {
@@ -45,16 +55,45 @@ static const char* tag = "main";
 //     vTaskDelete(NULL);
 // }
 
+/** @brief Predefined Hue automations */
+typedef enum {
+    AUTOMATION_ARRIVE = 0, /**< Beacon came into range, turn the grouped light on */
+    AUTOMATION_LEAVE,      /**< Beacon left range, deactivate the smart scene */
+    AUTOMATION_COUNT
+} automation_t;
+
+/** Time after a proximity edge its automation is still worth sending, after that the person has moved on */
+#define AUTOMATION_TTL_MS 10000
+
+/** Request performed for each automation, const so they stay in flash and need no request handles */
+static const hue_https_request_template_t automations[AUTOMATION_COUNT] = {
+    [AUTOMATION_ARRIVE] = {.resource_id = HUE_CONFIG_GROUPED_LIGHT_UUID,
+                           .resource_type = HUE_HTTPS_RESOURCE_GROUPED_LIGHT,
+                           .ttl_ms = AUTOMATION_TTL_MS},
+    [AUTOMATION_LEAVE] = {.resource_id = HUE_CONFIG_SMART_SCENE_UUID,
+                          .resource_type = HUE_HTTPS_RESOURCE_SMART_SCENE,
+                          .off = true,
+                          .ttl_ms = AUTOMATION_TTL_MS},
+};
+
 static hue_https_handle_t hue_handle;
-static hue_https_request_handle_t on_handle;
-static hue_https_request_handle_t off_handle;
+static proximity_monitor_handle_t proximity_handle;
+
+static void proximity_edge_handler(const proximity_edge_t* p_edge, void* ctx) {
+    /* Hand the request straight to the Hue HTTPS task, timed from the sample that crossed the threshold */
+    automation_t action = (p_edge->state == PROXIMITY_STATE_PRESENT) ? AUTOMATION_ARRIVE : AUTOMATION_LEAVE;
+    hue_https_perform_triggered_template(hue_handle, &automations[action], true, p_edge->crossing_time_us, 0);
+    ESP_LOGI(tag, "Beacon %s, average RSSI %d", (p_edge->state == PROXIMITY_STATE_PRESENT) ? "present" : "absent",
+             p_edge->average_rssi);
+}
 
 static void event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data) {
     if (event_base == WIFI_CONNECT_EVENT) {
         switch (event_id) {
             case WIFI_CONNECT_EVENT_CONNECTED:
                 gpio_set_level(GPIO_NUM_2, 1);
-                ESP_LOGI(tag, "WiFi connected to AP");
+                wifi_connect_summary_t* summary = &(((wifi_connect_connected_data_t*)event_data)->summary);
+                ESP_LOGI(tag, "WiFi connected to AP in %lld ms", (summary->got_ip_us - summary->start_us) / 1000);
                 break;
             case WIFI_CONNECT_EVENT_DISCONNECTED:
                 gpio_set_level(GPIO_NUM_2, 0);
@@ -87,14 +126,19 @@ void run(void) {
         .ssid = CONFIG_HUE_WIFI_SSID,
         .password = CONFIG_HUE_WIFI_PASSWORD,
         .advanced_configs = {
+#ifdef CONFIG_HUE_WIFI_SET_BSSID
             .bssid_set = true,
             .bssid_str = CONFIG_HUE_WIFI_BSSID,
+#endif
             .timeout_set = true,
             .timeout_seconds = CONFIG_HUE_WIFI_TIMEOUT,
             .static_ip_set = true,
             .ip_str = CONFIG_HUE_WIFI_IP,
             .gateway_str = CONFIG_HUE_WIFI_GW,
-            .netmask_str = CONFIG_HUE_WIFI_NM
+            .netmask_str = CONFIG_HUE_WIFI_NM,
+#ifdef CONFIG_HUE_WIFI_AP_CACHE
+            .ap_cache_set = true
+#endif
         }
     };
 
@@ -105,23 +149,32 @@ void run(void) {
     hue_https_config_t hue_config = {
         .application_key = CONFIG_HUE_APP_KEY,
         .bridge_id = CONFIG_HUE_BRIDGE_ID,
-        .bridge_ip = CONFIG_HUE_BRIDGE_IP,
+        .bridge_ip_addr = HUE_CONFIG_BRIDGE_IP_U32,
         .retry_attempts = 5,
-        .task_id = "hue_https"
+        .task_id = "hue_https",
+        .task_placement_set = true,
+        .task_priority = CONFIG_HUE_HTTPS_TASK_PRIORITY,
+        .task_core_id = CONFIG_HUE_HTTPS_TASK_CORE
     };
     
     hue_https_create_instance(&hue_handle, &hue_config);
 
-    hue_grouped_light_data_t on_data = {
-        .resource_id = CONFIG_HUE_GROUPED_LIGHT_ID
-    };
-    hue_https_create_grouped_light_request(&on_handle, &on_data);
-
-    hue_smart_scene_data_t off_data = {
-        .resource_id = CONFIG_HUE_SMART_SCENE_ID,
-        .deactivate = true
+    proximity_monitor_config_t proximity_config = {
+        .filter_config = {
+            .enter_rssi = CONFIG_HUE_PROXIMITY_ENTER_RSSI,
+            .exit_rssi = CONFIG_HUE_PROXIMITY_EXIT_RSSI,
+            .window_size = CONFIG_HUE_PROXIMITY_WINDOW,
+            .debounce_samples = CONFIG_HUE_PROXIMITY_DEBOUNCE,
+            .exit_timeout_ms = CONFIG_HUE_PROXIMITY_EXIT_TIMEOUT_MS
+        },
+        .edge_cb = proximity_edge_handler,
+        .task_id = "proximity",
+        .queue_length = 16,
+        .task_placement_set = true,
+        .task_priority = CONFIG_HUE_PROXIMITY_TASK_PRIORITY,
+        .task_core_id = CONFIG_HUE_PROXIMITY_TASK_CORE
     };
-    hue_https_create_smart_scene_request(&off_handle, &off_data);
+    proximity_monitor_create(&proximity_handle, &proximity_config);
 
     // wifi_connect(&wifi_config);
 }